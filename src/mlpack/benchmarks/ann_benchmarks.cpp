@@ -0,0 +1,89 @@
+/**
+ * @file ann_benchmarks.cpp
+ *
+ * Benchmarks for training feedforward neural networks.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "benchmark.hpp"
+#include "synthetic_data.hpp"
+
+#include <mlpack/core/optimizers/sgd/sgd.hpp>
+#include <mlpack/core/optimizers/rmsprop/rmsprop.hpp>
+#include <mlpack/methods/ann/layer/layer.hpp>
+#include <mlpack/methods/ann/ffn.hpp>
+
+using namespace mlpack;
+using namespace mlpack::ann;
+using namespace mlpack::benchmark;
+using namespace mlpack::optimization;
+
+namespace {
+
+/**
+ * Time training a network with one sigmoid hidden layer on 4 Gaussians in 20
+ * dimensions.  A new network is created in each iteration, so every iteration
+ * starts from freshly initialized weights.
+ */
+template<typename OptimizerType>
+void RunFFN(BenchmarkState& state,
+            OptimizerType& optimizer,
+            const size_t hiddenLayerSize)
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  GaussianBlobs(20, 5000, 4, dataset, labels, 3.0);
+
+  // The NegativeLogLikelihood layer expects labels starting from 1.
+  const arma::mat responses = arma::conv_to<arma::mat>::from(labels) + 1;
+
+  arma::mat predictions;
+  while (state.KeepRunning())
+  {
+    FFN<NegativeLogLikelihood<>> model;
+    model.Add<Linear<>>(dataset.n_rows, hiddenLayerSize);
+    model.Add<SigmoidLayer<>>();
+    model.Add<Linear<>>(hiddenLayerSize, 4);
+    model.Add<LogSoftMax<>>();
+
+    model.Train(dataset, responses, optimizer);
+
+    state.PauseTiming();
+    model.Predict(dataset, predictions);
+    state.ResumeTiming();
+  }
+
+  // Compute the training accuracy of the last network.
+  size_t correct = 0;
+  for (size_t i = 0; i < predictions.n_cols; ++i)
+  {
+    arma::uword prediction;
+    predictions.col(i).max(prediction);
+    if (prediction == labels[i])
+      ++correct;
+  }
+
+  state.SetCounter("points", dataset.n_cols);
+  state.SetCounter("training_accuracy", double(correct) / dataset.n_cols);
+}
+
+BenchmarkRegistrar annBenchmarks([]()
+{
+  RegisterBenchmark("FFN/Train/SGD", [](BenchmarkState& state)
+      {
+        // Five passes over the data.
+        StandardSGD sgd(0.01, 5 * 5000, 1e-5, true);
+        RunFFN(state, sgd, 64);
+      });
+
+  RegisterBenchmark("FFN/Train/RMSProp", [](BenchmarkState& state)
+      {
+        RMSProp rmsprop(0.01, 0.88, 1e-8, 5 * 5000, 1e-5);
+        RunFFN(state, rmsprop, 64);
+      });
+});
+
+} // anonymous namespace
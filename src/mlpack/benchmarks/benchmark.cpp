@@ -0,0 +1,134 @@
+/**
+ * @file benchmark.cpp
+ *
+ * Implementation of the benchmark harness.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "benchmark.hpp"
+
+using namespace mlpack;
+using namespace mlpack::benchmark;
+
+BenchmarkState::BenchmarkState(const double minTime,
+                               const size_t maxIterations,
+                               const std::string& dataDir,
+                               util::PerfCounters* counters) :
+    minTime(minTime * 1e9),
+    maxIterations(std::max(maxIterations, (size_t) 1)),
+    dataDir(dataDir),
+    counters(counters),
+    running(false),
+    paused(false),
+    elapsed(0.0),
+    totalTime(0.0),
+    skipped(false)
+{
+  for (size_t i = 0; i < util::PerfCounters::NumCounters; ++i)
+  {
+    counterStart[i] = 0;
+    counterTotals[i] = 0;
+  }
+}
+
+bool BenchmarkState::KeepRunning()
+{
+  if (running)
+  {
+    // Finish the iteration that just ended.
+    if (!paused)
+      Accumulate();
+
+    times.push_back(elapsed);
+    totalTime += elapsed;
+    running = false;
+    paused = false;
+  }
+
+  if (skipped)
+    return false;
+
+  if (!times.empty() &&
+      (totalTime >= minTime || times.size() >= maxIterations))
+    return false;
+
+  // Start the next iteration.
+  running = true;
+  elapsed = 0.0;
+  if (counters)
+    counters->Read(counterStart);
+  start = Clock::now();
+  return true;
+}
+
+void BenchmarkState::PauseTiming()
+{
+  if (!running || paused)
+    return;
+
+  Accumulate();
+  paused = true;
+}
+
+void BenchmarkState::ResumeTiming()
+{
+  if (!running || !paused)
+    return;
+
+  paused = false;
+  if (counters)
+    counters->Read(counterStart);
+  start = Clock::now();
+}
+
+void BenchmarkState::Skip(const std::string& reason)
+{
+  skipped = true;
+  skipReason = reason;
+}
+
+bool BenchmarkState::LoadDataset(const std::string& filename,
+                                 arma::mat& dataset)
+{
+  const std::string path = dataDir.empty() ? filename :
+      dataDir + "/" + filename;
+  if (!data::Load(path, dataset, false))
+  {
+    Skip("could not load dataset '" + path + "'");
+    return false;
+  }
+
+  return true;
+}
+
+void BenchmarkState::Accumulate()
+{
+  const Clock::time_point end = Clock::now();
+  elapsed += std::chrono::duration<double, std::nano>(end - start).count();
+
+  if (counters)
+  {
+    uint64_t values[util::PerfCounters::NumCounters];
+    counters->Read(values);
+    for (size_t i = 0; i < util::PerfCounters::NumCounters; ++i)
+      counterTotals[i] += values[i] - counterStart[i];
+  }
+}
+
+std::vector<std::pair<std::string, BenchmarkFunction>>&
+mlpack::benchmark::Benchmarks()
+{
+  // This is a function-local static so that it is constructed before any
+  // benchmark is registered, regardless of static initialization order.
+  static std::vector<std::pair<std::string, BenchmarkFunction>> benchmarks;
+  return benchmarks;
+}
+
+void mlpack::benchmark::RegisterBenchmark(const std::string& name,
+                                          const BenchmarkFunction& function)
+{
+  Benchmarks().push_back(std::make_pair(name, function));
+}
@@ -0,0 +1,201 @@
+/**
+ * @file benchmark.hpp
+ *
+ * A small harness for the mlpack benchmark suite.  Benchmarks are registered
+ * globally with a name and a function, and each benchmark times its own inner
+ * loop through a BenchmarkState object.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BENCHMARKS_BENCHMARK_HPP
+#define MLPACK_BENCHMARKS_BENCHMARK_HPP
+
+#include <mlpack/core.hpp>
+#include <mlpack/core/util/perf_counters.hpp>
+
+#include <chrono>
+#include <functional>
+#include <map>
+
+namespace mlpack {
+namespace benchmark {
+
+/**
+ * The BenchmarkState is given to each benchmark function, and controls how many
+ * times the timed section is run.  A benchmark is expected to perform its setup,
+ * then loop while KeepRunning() returns true:
+ *
+ * @code
+ * void KNNBenchmark(BenchmarkState& state)
+ * {
+ *   arma::mat data(3, 10000, arma::fill::randu);
+ *   while (state.KeepRunning())
+ *   {
+ *     KNN knn(data);
+ *     ...
+ *   }
+ * }
+ * @endcode
+ *
+ * Each pass through the loop is one iteration, and its time (and, if enabled,
+ * hardware counters) is recorded separately.  The loop stops once at least one
+ * iteration has been run and either the total measured time exceeds the
+ * minimum time or the maximum number of iterations has been reached.  Work that
+ * should not be measured (such as copying a dataset that will be moved into a
+ * model) can be excluded with PauseTiming() and ResumeTiming().
+ */
+class BenchmarkState
+{
+ public:
+  /**
+   * Create the state for one run of a benchmark.
+   *
+   * @param minTime Minimum total measured time, in seconds.
+   * @param maxIterations Maximum number of iterations to run.
+   * @param dataDir Directory holding real datasets.
+   * @param counters Hardware counters to read around each iteration, or NULL.
+   */
+  BenchmarkState(const double minTime,
+                 const size_t maxIterations,
+                 const std::string& dataDir,
+                 util::PerfCounters* counters);
+
+  /**
+   * Finish the current iteration (if any), and return whether another one
+   * should be run.
+   */
+  bool KeepRunning();
+
+  //! Stop measuring time until ResumeTiming() is called.
+  void PauseTiming();
+
+  //! Start measuring time again after a call to PauseTiming().
+  void ResumeTiming();
+
+  /**
+   * Mark the benchmark as skipped, with the given reason; KeepRunning() will
+   * return false afterwards.  This is used when a dataset is not available.
+   */
+  void Skip(const std::string& reason);
+
+  /**
+   * Set a user-defined value that will be reported with the results, like the
+   * number of points or the final objective.
+   */
+  void SetCounter(const std::string& name, const double value)
+  {
+    userCounters[name] = value;
+  }
+
+  /**
+   * Load a real dataset from the data directory.  If it cannot be loaded, the
+   * benchmark is skipped and false is returned.
+   *
+   * @param filename Name of the file, relative to the data directory.
+   * @param dataset Matrix to load the dataset into.
+   */
+  bool LoadDataset(const std::string& filename, arma::mat& dataset);
+
+  //! Get the time of each iteration, in nanoseconds.
+  const std::vector<double>& Times() const { return times; }
+  //! Get the total of each hardware counter over all iterations.
+  const uint64_t* CounterTotals() const { return counterTotals; }
+  //! Get whether hardware counters were read.
+  bool HasCounters() const { return counters != NULL; }
+  //! Get the user-defined values.
+  const std::map<std::string, double>& UserCounters() const
+  {
+    return userCounters;
+  }
+  //! Get whether the benchmark was skipped.
+  bool Skipped() const { return skipped; }
+  //! Get the reason the benchmark was skipped.
+  const std::string& SkipReason() const { return skipReason; }
+
+ private:
+  typedef std::chrono::steady_clock Clock;
+
+  //! Add the time and counters since the last start to the current iteration.
+  void Accumulate();
+
+  //! Minimum total measured time, in nanoseconds.
+  double minTime;
+  //! Maximum number of iterations.
+  size_t maxIterations;
+  //! Directory holding real datasets.
+  std::string dataDir;
+  //! Hardware counters, or NULL if they are not used.
+  util::PerfCounters* counters;
+
+  //! Whether an iteration is in progress.
+  bool running;
+  //! Whether timing is paused.
+  bool paused;
+  //! When timing of the current iteration last (re)started.
+  Clock::time_point start;
+  //! Measured time of the current iteration so far, in nanoseconds.
+  double elapsed;
+  //! Total measured time over all iterations, in nanoseconds.
+  double totalTime;
+  //! Counter values when timing last (re)started.
+  uint64_t counterStart[util::PerfCounters::NumCounters];
+  //! Counter totals over all iterations.
+  uint64_t counterTotals[util::PerfCounters::NumCounters];
+
+  //! The time of each iteration, in nanoseconds.
+  std::vector<double> times;
+  //! User-defined values.
+  std::map<std::string, double> userCounters;
+  //! Whether the benchmark was skipped.
+  bool skipped;
+  //! The reason the benchmark was skipped.
+  std::string skipReason;
+};
+
+//! The type of a benchmark function.
+typedef std::function<void(BenchmarkState&)> BenchmarkFunction;
+
+/**
+ * Get the list of all registered benchmarks, in registration order.  Names are
+ * of the form "Group/Variant/...", so that related benchmarks can be selected
+ * together with a filter.
+ */
+std::vector<std::pair<std::string, BenchmarkFunction>>& Benchmarks();
+
+/**
+ * Register a benchmark with the given name.  This is usually called during
+ * static initialization, through a BenchmarkRegistrar.
+ *
+ * @param name Name of the benchmark.
+ * @param function Function that runs the benchmark.
+ */
+void RegisterBenchmark(const std::string& name,
+                       const BenchmarkFunction& function);
+
+/**
+ * Registers benchmarks when it is constructed.  A static BenchmarkRegistrar can
+ * be used to register a benchmark, or (with the second constructor) a whole
+ * family of benchmarks, when the program starts.
+ */
+struct BenchmarkRegistrar
+{
+  //! Register a single benchmark.
+  BenchmarkRegistrar(const std::string& name, const BenchmarkFunction& function)
+  {
+    RegisterBenchmark(name, function);
+  }
+
+  //! Call the given function, which should register benchmarks.
+  BenchmarkRegistrar(const std::function<void()>& registerFunction)
+  {
+    registerFunction();
+  }
+};
+
+} // namespace benchmark
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,301 @@
+/**
+ * @file benchmark_main.cpp
+ *
+ * Entry point of the mlpack_benchmarks program, which runs all registered
+ * benchmarks (or those matching a filter) and reports the results as a table
+ * and, optionally, as JSON.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "benchmark.hpp"
+#include <mlpack/core/util/escape_json.hpp>
+#include <mlpack/core/util/version.hpp>
+
+#include <fstream>
+#include <iomanip>
+#include <regex>
+#include <sstream>
+
+using namespace mlpack;
+using namespace mlpack::benchmark;
+
+// The directory holding the test datasets; this is set by CMake.
+#ifndef MLPACK_BENCHMARK_DATA_DIR
+  #define MLPACK_BENCHMARK_DATA_DIR "."
+#endif
+
+namespace {
+
+//! Options given on the command line.
+struct Options
+{
+  std::string filter = ".*";
+  bool list = false;
+  double minTime = 0.5;
+  size_t maxIterations = 100;
+  size_t seed = 42;
+  std::string output;
+  std::string dataDir = MLPACK_BENCHMARK_DATA_DIR;
+  bool hardwareCounters = false;
+};
+
+//! The results of one benchmark.
+struct Result
+{
+  std::string name;
+  std::vector<double> times;
+  bool hasCounters;
+  uint64_t counterTotals[util::PerfCounters::NumCounters];
+  std::map<std::string, double> values;
+  bool skipped;
+  std::string message;
+};
+
+void PrintUsage(const char* program)
+{
+  std::cout << "Usage: " << program << " [options]" << std::endl
+      << std::endl
+      << "Run the mlpack benchmark suite.  Options:" << std::endl
+      << std::endl
+      << "  --filter <regex>        Only run benchmarks whose name matches."
+      << std::endl
+      << "  --list                  List the benchmarks and exit." << std::endl
+      << "  --min_time <seconds>    Minimum measured time per benchmark "
+      << "(default 0.5)." << std::endl
+      << "  --max_iterations <n>    Maximum iterations per benchmark "
+      << "(default 100)." << std::endl
+      << "  --seed <n>              Random seed used before each benchmark "
+      << "(default 42)." << std::endl
+      << "  --output <file>         Write the results as JSON to this file."
+      << std::endl
+      << "  --data_dir <dir>        Directory holding the real datasets."
+      << std::endl
+      << "  --hardware_counters     Also read hardware counters (Linux only)."
+      << std::endl;
+}
+
+void WriteJSON(std::ostream& stream,
+               const Options& options,
+               const std::vector<Result>& results)
+{
+  size_t threads = 1;
+  #ifdef HAS_OPENMP
+    threads = omp_get_max_threads();
+  #endif
+
+  stream << std::setprecision(17);
+  stream << "{" << std::endl;
+  stream << "  \"context\": {" << std::endl;
+  stream << "    \"mlpack_version\": \"" << util::EscapeJSON(util::GetVersion())
+      << "\"," << std::endl;
+  stream << "    \"seed\": " << options.seed << "," << std::endl;
+  stream << "    \"min_time\": " << options.minTime << "," << std::endl;
+  stream << "    \"max_iterations\": " << options.maxIterations << ","
+      << std::endl;
+  stream << "    \"threads\": " << threads << "," << std::endl;
+  stream << "    \"hardware_counters\": "
+      << (options.hardwareCounters ? "true" : "false") << std::endl;
+  stream << "  }," << std::endl;
+  stream << "  \"benchmarks\": [";
+
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    const Result& r = results[i];
+    stream << ((i == 0) ? "" : ",") << std::endl;
+    stream << "    {" << std::endl;
+    stream << "      \"name\": \"" << util::EscapeJSON(r.name) << "\","
+        << std::endl;
+    stream << "      \"skipped\": " << (r.skipped ? "true" : "false");
+    if (!r.message.empty())
+    {
+      stream << "," << std::endl << "      \"message\": \""
+          << util::EscapeJSON(r.message) << "\"";
+    }
+
+    if (!r.times.empty())
+    {
+      const arma::vec times(r.times);
+      stream << "," << std::endl;
+      stream << "      \"iterations\": " << times.n_elem << "," << std::endl;
+      stream << "      \"time_ns\": {" << std::endl;
+      stream << "        \"min\": " << arma::min(times) << "," << std::endl;
+      stream << "        \"median\": " << arma::median(times) << ","
+          << std::endl;
+      stream << "        \"mean\": " << arma::mean(times) << "," << std::endl;
+      stream << "        \"max\": " << arma::max(times) << "," << std::endl;
+      stream << "        \"stddev\": "
+          << ((times.n_elem > 1) ? arma::stddev(times) : 0.0) << std::endl;
+      stream << "      }";
+
+      if (r.hasCounters)
+      {
+        // Counters are reported as the mean per iteration.
+        stream << "," << std::endl << "      \"counters\": {";
+        for (size_t c = 0; c < util::PerfCounters::NumCounters; ++c)
+        {
+          stream << ((c == 0) ? "" : ",") << std::endl;
+          stream << "        \"" << util::PerfCounters::Name(c) << "\": "
+              << double(r.counterTotals[c]) / times.n_elem;
+        }
+        stream << std::endl << "      }";
+      }
+    }
+
+    if (!r.values.empty())
+    {
+      stream << "," << std::endl << "      \"values\": {";
+      std::map<std::string, double>::const_iterator it = r.values.begin();
+      for (; it != r.values.end(); ++it)
+      {
+        stream << ((it == r.values.begin()) ? "" : ",") << std::endl;
+        stream << "        \"" << util::EscapeJSON(it->first) << "\": "
+            << it->second;
+      }
+      stream << std::endl << "      }";
+    }
+
+    stream << std::endl << "    }";
+  }
+
+  stream << std::endl << "  ]" << std::endl << "}" << std::endl;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+  Options options;
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    const bool hasValue = (i + 1 < argc);
+    if (arg == "--help" || arg == "-h")
+    {
+      PrintUsage(argv[0]);
+      return 0;
+    }
+    else if (arg == "--list")
+      options.list = true;
+    else if (arg == "--hardware_counters")
+      options.hardwareCounters = true;
+    else if (arg == "--filter" && hasValue)
+      options.filter = argv[++i];
+    else if (arg == "--min_time" && hasValue)
+      options.minTime = std::stod(argv[++i]);
+    else if (arg == "--max_iterations" && hasValue)
+      options.maxIterations = std::stoul(argv[++i]);
+    else if (arg == "--seed" && hasValue)
+      options.seed = std::stoul(argv[++i]);
+    else if (arg == "--output" && hasValue)
+      options.output = argv[++i];
+    else if (arg == "--data_dir" && hasValue)
+      options.dataDir = argv[++i];
+    else
+    {
+      std::cerr << "Unknown or incomplete option '" << arg << "'." << std::endl;
+      PrintUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  const std::regex filter(options.filter);
+  const std::vector<std::pair<std::string, BenchmarkFunction>>& benchmarks =
+      Benchmarks();
+
+  if (options.list)
+  {
+    for (size_t i = 0; i < benchmarks.size(); ++i)
+      if (std::regex_search(benchmarks[i].first, filter))
+        std::cout << benchmarks[i].first << std::endl;
+    return 0;
+  }
+
+  util::PerfCounters counters;
+  if (options.hardwareCounters && !counters.Open())
+  {
+    std::cerr << "Hardware counters are not available; they will not be "
+        << "reported." << std::endl;
+    options.hardwareCounters = false;
+  }
+
+  std::cout << std::left << std::setw(48) << "Benchmark" << std::right
+      << std::setw(12) << "Iterations" << std::setw(16) << "Median (ms)"
+      << std::setw(16) << "Mean (ms)" << std::endl;
+  std::cout << std::string(92, '-') << std::endl;
+
+  std::vector<Result> results;
+  bool failed = false;
+  for (size_t i = 0; i < benchmarks.size(); ++i)
+  {
+    if (!std::regex_search(benchmarks[i].first, filter))
+      continue;
+
+    // Reseed before every benchmark, so that the generated data (and any other
+    // randomness) does not depend on which other benchmarks were run.
+    math::RandomSeed(options.seed);
+
+    BenchmarkState state(options.minTime, options.maxIterations,
+        options.dataDir, options.hardwareCounters ? &counters : NULL);
+
+    Result result;
+    result.name = benchmarks[i].first;
+    try
+    {
+      benchmarks[i].second(state);
+      result.skipped = state.Skipped();
+      result.message = state.SkipReason();
+    }
+    catch (std::exception& e)
+    {
+      result.skipped = true;
+      result.message = std::string("error: ") + e.what();
+      failed = true;
+    }
+
+    result.times = state.Times();
+    result.hasCounters = state.HasCounters();
+    for (size_t c = 0; c < util::PerfCounters::NumCounters; ++c)
+      result.counterTotals[c] = state.CounterTotals()[c];
+    result.values = state.UserCounters();
+    if (!result.skipped && result.times.empty())
+    {
+      result.skipped = true;
+      result.message = "no iterations were run";
+    }
+
+    std::cout << std::left << std::setw(48) << result.name << std::right;
+    if (result.skipped)
+    {
+      std::cout << "  skipped (" << result.message << ")" << std::endl;
+    }
+    else
+    {
+      const arma::vec times(result.times);
+      std::cout << std::setw(12) << times.n_elem << std::fixed
+          << std::setprecision(3) << std::setw(16)
+          << arma::median(times) / 1e6 << std::setw(16)
+          << arma::mean(times) / 1e6 << std::endl;
+    }
+
+    results.push_back(result);
+  }
+
+  if (!options.output.empty())
+  {
+    std::ofstream f(options.output);
+    if (!f.is_open())
+    {
+      std::cerr << "Could not open '" << options.output << "' for writing."
+          << std::endl;
+      return 1;
+    }
+
+    WriteJSON(f, options, results);
+  }
+
+  // A benchmark that throws is broken, so report that in the exit status.
+  return failed ? 1 : 0;
+}
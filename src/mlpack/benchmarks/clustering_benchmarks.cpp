@@ -0,0 +1,116 @@
+/**
+ * @file clustering_benchmarks.cpp
+ *
+ * Benchmarks for k-means clustering with each Lloyd step type, and for fitting
+ * Gaussian mixture models with EM.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "benchmark.hpp"
+#include "synthetic_data.hpp"
+
+#include <mlpack/methods/kmeans/kmeans.hpp>
+#include <mlpack/methods/kmeans/elkan_kmeans.hpp>
+#include <mlpack/methods/kmeans/hamerly_kmeans.hpp>
+#include <mlpack/methods/kmeans/pelleg_moore_kmeans.hpp>
+#include <mlpack/methods/kmeans/dual_tree_kmeans.hpp>
+#include <mlpack/methods/gmm/gmm.hpp>
+#include <mlpack/methods/gmm/diagonal_constraint.hpp>
+
+using namespace mlpack;
+using namespace mlpack::benchmark;
+using namespace mlpack::kmeans;
+using namespace mlpack::gmm;
+
+namespace {
+
+/**
+ * Time k-means clustering with the given Lloyd step type.  Every iteration
+ * starts from the same initial centroids, so every iteration does the same
+ * work and the step types can be compared directly.
+ */
+template<template<class, class> class LloydStepType>
+void RunKMeans(BenchmarkState& state,
+               const arma::mat& dataset,
+               const size_t clusters)
+{
+  arma::mat initialCentroids;
+  SampleInitialization::Cluster(dataset, clusters, initialCentroids);
+
+  KMeans<metric::EuclideanDistance, SampleInitialization, MaxVarianceNewCluster,
+      LloydStepType> kmeans(100);
+  arma::mat centroids;
+  while (state.KeepRunning())
+  {
+    centroids = initialCentroids;
+    kmeans.Cluster(dataset, clusters, centroids, true);
+  }
+
+  state.SetCounter("points", dataset.n_cols);
+  state.SetCounter("clusters", clusters);
+}
+
+/**
+ * Time fitting a GMM with the given fitter.
+ */
+template<typename FittingType>
+void RunEMFit(BenchmarkState& state,
+              const arma::mat& dataset,
+              const size_t gaussians)
+{
+  double logLikelihood = 0.0;
+  while (state.KeepRunning())
+  {
+    GMM gmm(gaussians, dataset.n_rows);
+    logLikelihood = gmm.Train<FittingType>(dataset, 1);
+  }
+
+  state.SetCounter("points", dataset.n_cols);
+  state.SetCounter("log_likelihood", logLikelihood);
+}
+
+//! Register the synthetic and real-data benchmarks for one step type.
+template<template<class, class> class LloydStepType>
+void RegisterKMeans(const std::string& name)
+{
+  RegisterBenchmark("KMeans/" + name, [](BenchmarkState& state)
+      {
+        const arma::mat dataset = GaussianBlobs(5, 20000, 8);
+        RunKMeans<LloydStepType>(state, dataset, 8);
+      });
+
+  RegisterBenchmark("KMeans/" + name + "/iris", [](BenchmarkState& state)
+      {
+        arma::mat dataset;
+        if (state.LoadDataset("iris.csv", dataset))
+          RunKMeans<LloydStepType>(state, dataset, 3);
+      });
+}
+
+BenchmarkRegistrar clusteringBenchmarks([]()
+{
+  // The names match the options of the kmeans program.
+  RegisterKMeans<NaiveKMeans>("naive");
+  RegisterKMeans<ElkanKMeans>("elkan");
+  RegisterKMeans<HamerlyKMeans>("hamerly");
+  RegisterKMeans<PellegMooreKMeans>("pelleg-moore");
+  RegisterKMeans<DefaultDualTreeKMeans>("dualtree");
+  RegisterKMeans<CoverTreeDualTreeKMeans>("dualtree-covertree");
+
+  RegisterBenchmark("GMM/EMFit", [](BenchmarkState& state)
+      {
+        const arma::mat dataset = GaussianBlobs(3, 5000, 4);
+        RunEMFit<EMFit<>>(state, dataset, 4);
+      });
+
+  RegisterBenchmark("GMM/EMFit/diagonal", [](BenchmarkState& state)
+      {
+        const arma::mat dataset = GaussianBlobs(3, 5000, 4);
+        RunEMFit<EMFit<KMeans<>, DiagonalConstraint>>(state, dataset, 4);
+      });
+});
+
+} // anonymous namespace
@@ -0,0 +1,133 @@
+/**
+ * @file decision_tree_benchmarks.cpp
+ *
+ * Benchmarks for training and classification with decision trees and random
+ * forests.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "benchmark.hpp"
+#include "synthetic_data.hpp"
+
+#include <mlpack/methods/decision_tree/decision_tree.hpp>
+#include <mlpack/methods/decision_tree/histogram_numeric_split.hpp>
+#include <mlpack/methods/random_forest/random_forest.hpp>
+
+using namespace mlpack;
+using namespace mlpack::benchmark;
+using namespace mlpack::tree;
+
+namespace {
+
+/**
+ * Time training a model of the given type.  ModelType must be constructible from
+ * the dataset, labels and number of classes.
+ */
+template<typename ModelType>
+void RunTrain(BenchmarkState& state,
+              const arma::mat& dataset,
+              const arma::Row<size_t>& labels,
+              const size_t numClasses)
+{
+  arma::Row<size_t> predictions;
+  while (state.KeepRunning())
+  {
+    ModelType model(dataset, labels, numClasses);
+
+    // Compute the training accuracy outside of the timed region.
+    state.PauseTiming();
+    model.Classify(dataset, predictions);
+    state.ResumeTiming();
+  }
+
+  state.SetCounter("points", dataset.n_cols);
+  state.SetCounter("training_accuracy",
+      double(arma::accu(predictions == labels)) / labels.n_elem);
+}
+
+/**
+ * Time batch classification of the dataset with a model of the given type.
+ */
+template<typename ModelType>
+void RunClassify(BenchmarkState& state,
+                 const arma::mat& dataset,
+                 const arma::Row<size_t>& labels,
+                 const size_t numClasses)
+{
+  ModelType model(dataset, labels, numClasses);
+  arma::Row<size_t> predictions;
+  while (state.KeepRunning())
+    model.Classify(dataset, predictions);
+
+  state.SetCounter("points", dataset.n_cols);
+}
+
+/**
+ * Generate the synthetic classification dataset: 4 overlapping Gaussians in 10
+ * dimensions.
+ */
+void SyntheticClassification(arma::mat& dataset, arma::Row<size_t>& labels)
+{
+  GaussianBlobs(10, 20000, 4, dataset, labels, 3.0);
+}
+
+BenchmarkRegistrar decisionTreeBenchmarks([]()
+{
+  RegisterBenchmark("DecisionTree/Train", [](BenchmarkState& state)
+      {
+        arma::mat dataset;
+        arma::Row<size_t> labels;
+        SyntheticClassification(dataset, labels);
+        RunTrain<DecisionTree<>>(state, dataset, labels, 4);
+      });
+
+  RegisterBenchmark("DecisionTree/Train/histogram", [](BenchmarkState& state)
+      {
+        arma::mat dataset;
+        arma::Row<size_t> labels;
+        SyntheticClassification(dataset, labels);
+        RunTrain<DecisionTree<GiniGain, Histogram256NumericSplit>>(state,
+            dataset, labels, 4);
+      });
+
+  RegisterBenchmark("DecisionTree/Train/vc2", [](BenchmarkState& state)
+      {
+        arma::mat dataset, labelsIn;
+        if (!state.LoadDataset("vc2.csv", dataset) ||
+            !state.LoadDataset("vc2_labels.txt", labelsIn))
+          return;
+
+        const arma::Row<size_t> labels =
+            arma::conv_to<arma::Row<size_t>>::from(labelsIn);
+        RunTrain<DecisionTree<>>(state, dataset, labels, arma::max(labels) + 1);
+      });
+
+  RegisterBenchmark("DecisionTree/Classify", [](BenchmarkState& state)
+      {
+        arma::mat dataset;
+        arma::Row<size_t> labels;
+        SyntheticClassification(dataset, labels);
+        RunClassify<DecisionTree<>>(state, dataset, labels, 4);
+      });
+
+  RegisterBenchmark("RandomForest/Train", [](BenchmarkState& state)
+      {
+        arma::mat dataset;
+        arma::Row<size_t> labels;
+        SyntheticClassification(dataset, labels);
+        RunTrain<RandomForest<>>(state, dataset, labels, 4);
+      });
+
+  RegisterBenchmark("RandomForest/Classify", [](BenchmarkState& state)
+      {
+        arma::mat dataset;
+        arma::Row<size_t> labels;
+        SyntheticClassification(dataset, labels);
+        RunClassify<RandomForest<>>(state, dataset, labels, 4);
+      });
+});
+
+} // anonymous namespace
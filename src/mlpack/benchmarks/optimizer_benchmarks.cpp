@@ -0,0 +1,71 @@
+/**
+ * @file optimizer_benchmarks.cpp
+ *
+ * Benchmarks for SGD and L-BFGS, optimizing the logistic regression objective.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "benchmark.hpp"
+#include "synthetic_data.hpp"
+
+#include <mlpack/core/optimizers/sgd/sgd.hpp>
+#include <mlpack/core/optimizers/lbfgs/lbfgs.hpp>
+#include <mlpack/methods/logistic_regression/logistic_regression_function.hpp>
+
+using namespace mlpack;
+using namespace mlpack::benchmark;
+using namespace mlpack::optimization;
+using namespace mlpack::regression;
+
+namespace {
+
+/**
+ * Time optimizing a regularized logistic regression objective on two
+ * overlapping Gaussians, starting from the function's initial point each time.
+ */
+template<typename OptimizerType>
+void RunLogisticRegression(BenchmarkState& state, OptimizerType& optimizer)
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  GaussianBlobs(10, 10000, 2, dataset, labels, 2.0);
+
+  LogisticRegressionFunction<> lrf(dataset, labels, 0.5);
+  arma::mat coordinates;
+  double objective = 0.0;
+  while (state.KeepRunning())
+  {
+    coordinates = lrf.InitialPoint();
+    objective = optimizer.Optimize(lrf, coordinates);
+  }
+
+  state.SetCounter("points", dataset.n_cols);
+  state.SetCounter("objective", objective);
+}
+
+BenchmarkRegistrar optimizerBenchmarks([]()
+{
+  RegisterBenchmark("Optimizer/SGD", [](BenchmarkState& state)
+      {
+        // Five passes over the data.
+        StandardSGD sgd(0.01, 5 * 10000, 1e-5, true);
+        RunLogisticRegression(state, sgd);
+      });
+
+  RegisterBenchmark("Optimizer/SGD/momentum", [](BenchmarkState& state)
+      {
+        MomentumSGD sgd(0.01, 5 * 10000, 1e-5, true);
+        RunLogisticRegression(state, sgd);
+      });
+
+  RegisterBenchmark("Optimizer/L-BFGS", [](BenchmarkState& state)
+      {
+        L_BFGS lbfgs;
+        RunLogisticRegression(state, lbfgs);
+      });
+});
+
+} // anonymous namespace
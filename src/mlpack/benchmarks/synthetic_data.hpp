@@ -0,0 +1,67 @@
+/**
+ * @file synthetic_data.hpp
+ *
+ * Generators for the synthetic datasets used by the benchmarks.  All of them
+ * use the global random number generator, which the benchmark program seeds
+ * before each benchmark, so the generated data is reproducible.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BENCHMARKS_SYNTHETIC_DATA_HPP
+#define MLPACK_BENCHMARKS_SYNTHETIC_DATA_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+namespace benchmark {
+
+/**
+ * Generate points from a mixture of spherical unit-variance Gaussians, whose
+ * centers are drawn uniformly from [0, spread]^d.  Points are assigned to the
+ * Gaussians in turn, so each one holds the same number of points (up to one).
+ *
+ * @param dimensionality Dimensionality of the points.
+ * @param points Number of points to generate.
+ * @param clusters Number of Gaussians.
+ * @param dataset Matrix to store the points in.
+ * @param labels Vector to store the index of the Gaussian of each point in.
+ * @param spread Side length of the cube the centers are drawn from.
+ */
+inline void GaussianBlobs(const size_t dimensionality,
+                          const size_t points,
+                          const size_t clusters,
+                          arma::mat& dataset,
+                          arma::Row<size_t>& labels,
+                          const double spread = 10.0)
+{
+  const arma::mat centers = spread * arma::randu<arma::mat>(dimensionality,
+      clusters);
+
+  dataset = arma::randn<arma::mat>(dimensionality, points);
+  labels.set_size(points);
+  for (size_t i = 0; i < points; ++i)
+  {
+    labels[i] = i % clusters;
+    dataset.col(i) += centers.col(labels[i]);
+  }
+}
+
+//! Generate points from a mixture of Gaussians, without labels.
+inline arma::mat GaussianBlobs(const size_t dimensionality,
+                               const size_t points,
+                               const size_t clusters,
+                               const double spread = 10.0)
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  GaussianBlobs(dimensionality, points, clusters, dataset, labels, spread);
+  return dataset;
+}
+
+} // namespace benchmark
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,150 @@
+/**
+ * @file tree_search_benchmarks.cpp
+ *
+ * Benchmarks for k-nearest-neighbor search and range search with each of the
+ * supported tree types.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "benchmark.hpp"
+
+#include <mlpack/methods/neighbor_search/ns_model.hpp>
+#include <mlpack/methods/range_search/rs_model.hpp>
+
+using namespace mlpack;
+using namespace mlpack::benchmark;
+using namespace mlpack::neighbor;
+using namespace mlpack::range;
+
+namespace {
+
+typedef NSModel<NearestNeighborSort> KNNModel;
+
+/**
+ * Time building a tree on the dataset and running monochromatic dual-tree
+ * k-nearest-neighbor search with it.
+ */
+void RunKNN(BenchmarkState& state,
+            const arma::mat& dataset,
+            const KNNModel::TreeTypes treeType)
+{
+  KNNModel model(treeType, false);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  while (state.KeepRunning())
+  {
+    // The model takes ownership of the reference set, so give it a copy.
+    state.PauseTiming();
+    arma::mat referenceSet(dataset);
+    state.ResumeTiming();
+
+    model.BuildModel(std::move(referenceSet), 20, DUAL_TREE_MODE);
+    model.Search(5, neighbors, distances);
+  }
+
+  state.SetCounter("points", dataset.n_cols);
+  state.SetCounter("mean_distance", arma::mean(arma::vectorise(distances)));
+}
+
+/**
+ * Time building a tree on the dataset and running monochromatic dual-tree
+ * range search with it.
+ */
+void RunRangeSearch(BenchmarkState& state,
+                    const arma::mat& dataset,
+                    const math::Range& range,
+                    const RSModel::TreeTypes treeType)
+{
+  RSModel model(treeType, false);
+  std::vector<std::vector<size_t>> neighbors;
+  std::vector<std::vector<double>> distances;
+  while (state.KeepRunning())
+  {
+    state.PauseTiming();
+    arma::mat referenceSet(dataset);
+    state.ResumeTiming();
+
+    model.BuildModel(std::move(referenceSet), 20, false, false);
+    model.Search(range, neighbors, distances);
+  }
+
+  size_t results = 0;
+  for (size_t i = 0; i < neighbors.size(); ++i)
+    results += neighbors[i].size();
+
+  state.SetCounter("points", dataset.n_cols);
+  state.SetCounter("results", results);
+}
+
+BenchmarkRegistrar treeSearchBenchmarks([]()
+{
+  // The names match the options of the knn and range_search programs.
+  const struct { KNNModel::TreeTypes type; const char* name; } knnTrees[] = {
+      { KNNModel::KD_TREE, "kd" },
+      { KNNModel::COVER_TREE, "cover" },
+      { KNNModel::R_TREE, "r" },
+      { KNNModel::R_STAR_TREE, "r-star" },
+      { KNNModel::BALL_TREE, "ball" },
+      { KNNModel::X_TREE, "x" },
+      { KNNModel::HILBERT_R_TREE, "hilbert-r" },
+      { KNNModel::R_PLUS_TREE, "r-plus" },
+      { KNNModel::R_PLUS_PLUS_TREE, "r-plus-plus" },
+      { KNNModel::VP_TREE, "vp" },
+      { KNNModel::RP_TREE, "rp" },
+      { KNNModel::MAX_RP_TREE, "max-rp" },
+      { KNNModel::SPILL_TREE, "spill" },
+      { KNNModel::UB_TREE, "ub" },
+      { KNNModel::OCTREE, "oct" } };
+
+  for (size_t i = 0; i < sizeof(knnTrees) / sizeof(knnTrees[0]); ++i)
+  {
+    const KNNModel::TreeTypes type = knnTrees[i].type;
+    RegisterBenchmark(std::string("NeighborSearch/KNN/") + knnTrees[i].name,
+        [type](BenchmarkState& state)
+        {
+          const arma::mat dataset(3, 10000, arma::fill::randu);
+          RunKNN(state, dataset, type);
+        });
+  }
+
+  RegisterBenchmark("NeighborSearch/KNN/kd/test_data_3_1000",
+      [](BenchmarkState& state)
+      {
+        arma::mat dataset;
+        if (state.LoadDataset("test_data_3_1000.csv", dataset))
+          RunKNN(state, dataset, KNNModel::KD_TREE);
+      });
+
+  const struct { RSModel::TreeTypes type; const char* name; } rsTrees[] = {
+      { RSModel::KD_TREE, "kd" },
+      { RSModel::COVER_TREE, "cover" },
+      { RSModel::R_TREE, "r" },
+      { RSModel::R_STAR_TREE, "r-star" },
+      { RSModel::BALL_TREE, "ball" },
+      { RSModel::X_TREE, "x" },
+      { RSModel::HILBERT_R_TREE, "hilbert-r" },
+      { RSModel::R_PLUS_TREE, "r-plus" },
+      { RSModel::R_PLUS_PLUS_TREE, "r-plus-plus" },
+      { RSModel::VP_TREE, "vp" },
+      { RSModel::RP_TREE, "rp" },
+      { RSModel::MAX_RP_TREE, "max-rp" },
+      { RSModel::UB_TREE, "ub" },
+      { RSModel::OCTREE, "oct" } };
+
+  for (size_t i = 0; i < sizeof(rsTrees) / sizeof(rsTrees[0]); ++i)
+  {
+    const RSModel::TreeTypes type = rsTrees[i].type;
+    RegisterBenchmark(std::string("RangeSearch/") + rsTrees[i].name,
+        [type](BenchmarkState& state)
+        {
+          // With this radius each point has a handful of neighbors.
+          const arma::mat dataset(3, 10000, arma::fill::randu);
+          RunRangeSearch(state, dataset, math::Range(0.0, 0.05), type);
+        });
+  }
+});
+
+} // anonymous namespace
@@ -9,6 +9,7 @@
 #define MLPACK_BINDINGS_CLI_END_PROGRAM_HPP
 
 #include <mlpack/core/util/cli.hpp>
+#include <fstream>
 
 namespace mlpack {
 namespace bindings {
@@ -23,6 +24,18 @@ inline void EndProgram()
   // Stop the CLI timers.
   CLI::StopTimers();
 
+  // Write the timers to a file, if the user asked for it.
+  if (CLI::HasParam("timers_file"))
+  {
+    const std::string filename = CLI::GetParam<std::string>("timers_file");
+    std::ofstream stream(filename.c_str());
+    if (stream.is_open())
+      Timer::ExportJSON(stream);
+    else
+      Log::Warn << "Could not open '" << filename << "' to write timers."
+          << std::endl;
+  }
+
   // Print any output.
   const std::map<std::string, util::ParamData>& parameters = CLI::Parameters();
   std::map<std::string, util::ParamData>::const_iterator it =
@@ -61,9 +74,10 @@ inline void EndProgram()
     }
 
     Log::Info << "Program timers:" << std::endl;
-    std::map<std::string, std::chrono::microseconds>::iterator it2;
-    for (it2 = CLI::GetSingleton().timer.GetAllTimers().begin();
-         it2 != CLI::GetSingleton().timer.GetAllTimers().end(); ++it2)
+    const std::map<std::string, std::chrono::microseconds> timers =
+        CLI::GetSingleton().timer.GetAllTimers();
+    std::map<std::string, std::chrono::microseconds>::const_iterator it2;
+    for (it2 = timers.begin(); it2 != timers.end(); ++it2)
     {
       std::string i = (*it2).first;
       Log::Info << "  " << i << ": ";
@@ -22,6 +22,11 @@ PARAM_STRING_IN("info", "Get help on a specific module or option.", "", "");
 PARAM_FLAG("verbose", "Display informational messages and the full list of "
     "parameters and timers at the end of execution.", "v");
 PARAM_FLAG("version", "Display the version of mlpack.", "V");
+PARAM_STRING_IN("timers_file", "If specified, write all timers to this file in"
+    " JSON format at the end of execution.", "", "");
+PARAM_FLAG("hardware_counters", "If set, record CPU cycles, cache misses and "
+    "branch misses for each scoped timer (Linux only); these are written to "
+    "the file given by --timers_file.", "");
 
 /**
  * Parse the command line, setting all of the options inside of the CLI object
@@ -169,6 +174,9 @@ void ParseCommandLine(int argc, char** argv)
     Log::Info.ignoreInput = false;
   }
 
+  if (CLI::HasParam("hardware_counters"))
+    Timer::EnableHardwareCounters();
+
   // Now, issue an error if we forgot any required options.
   for (std::map<std::string, util::ParamData>::const_iterator iter =
        parameters.begin(); iter != parameters.end(); ++iter)
@@ -8,21 +8,130 @@
 #define MLPACK_BINDINGS_PYTHON_GET_PARAM_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/cli.hpp>
+#include <memory>
 
 namespace mlpack {
 namespace bindings {
 namespace python {
 
 /**
- * All Python binding types are exactly what is held in the ParamData, so no
- * special handling is necessary.
+ * Return the value to hold in the ParamData for a parameter with the given
+ * default value.  All Python binding types except models are exactly what is
+ * held in the ParamData.
+ */
+template<typename T>
+boost::any MakeParamValue(
+    const T& defaultValue,
+    const typename boost::disable_if<data::HasSerialize<T>>::type* = 0)
+{
+  return boost::any(defaultValue);
+}
+
+/**
+ * Models are held by pointer, so that the model objects of the Python bindings
+ * can be used in place; no model is given by default.
+ */
+template<typename T>
+boost::any MakeParamValue(
+    const T& /* defaultValue */,
+    const typename boost::enable_if<data::HasSerialize<T>>::type* = 0)
+{
+  return boost::any((T*) NULL);
+}
+
+//! A model allocated by GetParam(), with the function that deletes it.
+typedef std::unique_ptr<void, void (*)(void*)> NewModel;
+
+/**
+ * The models that GetParam() allocated while a program ran on this thread, by
+ * parameter name.  They are owned here until the Python binding takes them
+ * with GetParamPtr() after the program has run, so that they are freed with
+ * DeleteNewModels() if the program throws.
+ */
+inline std::map<std::string, NewModel>& NewModels()
+{
+  static thread_local std::map<std::string, NewModel> newModels;
+  return newModels;
+}
+
+//! Delete a model allocated by GetParam().
+template<typename T>
+void DeleteNewModel(void* model)
+{
+  delete static_cast<T*>(model);
+}
+
+/**
+ * All Python binding types except models are exactly what is held in the
+ * ParamData, so no special handling is necessary.
+ */
+template<typename T>
+T* GetParam(
+    const util::ParamData& d,
+    const typename boost::disable_if<data::HasSerialize<T>>::type* = 0)
+{
+  return const_cast<T*>(boost::any_cast<T>(&d.value));
+}
+
+/**
+ * Models are held by pointer, and the Python binding owns them.  An input
+ * model must have been given with SetParamPtr().  An output model that was not
+ * given is the input model of the same type, if there is one: programs move
+ * their input model to their output model, so the model stays in the same
+ * object across calls.  Otherwise, a new model is allocated; it is held in
+ * NewModels() until the Python binding takes ownership of it after the program
+ * has run.
+ */
+template<typename T>
+T* GetParam(
+    const util::ParamData& d,
+    const typename boost::enable_if<data::HasSerialize<T>>::type* = 0)
+{
+  T*& model = *const_cast<T**>(boost::any_cast<T*>(&d.value));
+  if (model != NULL)
+    return model;
+
+  if (d.input)
+  {
+    Log::Fatal << "Model parameter '" << d.name << "' was not given!"
+        << std::endl;
+  }
+
+  typedef std::map<std::string, util::ParamData>::const_iterator ParamIter;
+  const std::map<std::string, util::ParamData>& parameters = CLI::Parameters();
+  for (ParamIter it = parameters.begin(); it != parameters.end(); ++it)
+  {
+    const util::ParamData& other = it->second;
+    if (other.input && other.wasPassed && other.tname == d.tname)
+    {
+      model = *boost::any_cast<T*>(&other.value);
+      return model;
+    }
+  }
+
+  NewModel newModel(new T(), &DeleteNewModel<T>);
+  T* newModelPtr = static_cast<T*>(newModel.get());
+  NewModels().erase(d.name);
+  NewModels().insert(std::make_pair(d.name, std::move(newModel)));
+
+  model = newModelPtr;
+  return model;
+}
+
+/**
+ * Get the parameter, and store a pointer to it in the output pointer.
+ *
+ * @param d Parameter data struct.
+ * @param input Unused parameter.
+ * @param output Pointer to a T* to store the parameter in.
  */
 template<typename T>
 void GetParam(const util::ParamData& d,
               const void* /* input */,
               void* output)
 {
-  *((T**) output) = const_cast<T*>(boost::any_cast<T>(&d.value));
+  *((T**) output) = GetParam<T>(d);
 }
 
 } // namespace python
@@ -3,9 +3,9 @@
 arma_numpy.pxd: Armadillo/numpy interface functionality.
 
 This file defines a number of functions useful for converting between Armadillo
-and numpy objects without actually copying memory.  Because Cython support for
-templates is primitive, we can't use templates here and instead overload for
-each type we might need.
+and numpy objects without actually copying memory (see arma_numpy.pyx for when
+a copy is needed).  Because Cython support for templates is primitive, we can't
+use templates here and instead overload for each type we might need.
 
 mlpack is free software; you may redistribute it and/or modify it under the
 terms of the 3-clause BSD license.  You should have received a copy of the
@@ -16,20 +16,26 @@ cimport cython
 cimport numpy
 import numpy
 
+from libcpp cimport bool
+
 numpy.import_array()
 
 cimport arma
 
 """
-Convert a numpy ndarray to a matrix.
+Convert a numpy ndarray to a matrix.  If takeOwnership is True, the matrix
+takes ownership of the memory of the ndarray; otherwise, it is an alias of it,
+unless the layout of the ndarray requires a copy.
 """
-cdef arma.Mat[double]* numpy_to_mat_d(numpy.ndarray[numpy.double_t, ndim=2] X) \
-    except +
-cdef arma.Mat[size_t]* numpy_to_mat_s(numpy.ndarray[numpy.npy_intp, ndim=2] X) \
-    except +
+cdef arma.Mat[double]* numpy_to_mat_d(numpy.ndarray[numpy.double_t, ndim=2] X,
+                                      bool takeOwnership) except +
+cdef arma.Mat[size_t]* numpy_to_mat_s(numpy.ndarray[numpy.npy_intp, ndim=2] X,
+                                      bool takeOwnership) except +
 
 """
-Convert an Armadillo object to a numpy ndarray of the given type.
+Convert an Armadillo object to a numpy ndarray of the given type.  The memory is
+handed over to the ndarray if the Armadillo object owns it, and copied
+otherwise.
 """
 cdef numpy.ndarray[numpy.double_t, ndim=2] mat_to_numpy_d(arma.Mat[double]& X) \
     except +
@@ -37,12 +43,13 @@ cdef numpy.ndarray[numpy.npy_intp, ndim=2] mat_to_numpy_s(arma.Mat[size_t]& X) \
     except +
 
 """
-Convert a numpy one-dimensional ndarray to a row of the given type.
+Convert a numpy one-dimensional ndarray to a row of the given type, in the same
+way as numpy_to_mat_d().
 """
-cdef arma.Row[double]* numpy_to_row_d(numpy.ndarray[numpy.double_t, ndim=1] X) \
-    except +
-cdef arma.Row[size_t]* numpy_to_row_s(numpy.ndarray[numpy.npy_intp, ndim=1] X) \
-    except +
+cdef arma.Row[double]* numpy_to_row_d(numpy.ndarray[numpy.double_t, ndim=1] X,
+                                      bool takeOwnership) except +
+cdef arma.Row[size_t]* numpy_to_row_s(numpy.ndarray[numpy.npy_intp, ndim=1] X,
+                                      bool takeOwnership) except +
 
 """
 Convert an Armadillo row vector to a one-dimensional numpy ndarray of the
@@ -54,12 +61,13 @@ cdef numpy.ndarray[numpy.npy_intp, ndim=1] row_to_numpy_s(arma.Row[size_t]& X) \
     except +
 
 """
-Convert a numpy one-dimensional ndarray to a column vector of the given type.
+Convert a numpy one-dimensional ndarray to a column vector of the given type, in
+the same way as numpy_to_mat_d().
 """
-cdef arma.Col[double]* numpy_to_col_d(numpy.ndarray[numpy.double_t, ndim=1] X) \
-    except +
-cdef arma.Col[size_t]* numpy_to_col_s(numpy.ndarray[numpy.npy_intp, ndim=1] X) \
-    except +
+cdef arma.Col[double]* numpy_to_col_d(numpy.ndarray[numpy.double_t, ndim=1] X,
+                                      bool takeOwnership) except +
+cdef arma.Col[size_t]* numpy_to_col_s(numpy.ndarray[numpy.npy_intp, ndim=1] X,
+                                      bool takeOwnership) except +
 
 """
 Convert an Armadillo column vector to a one-dimensional numpy ndarray of the
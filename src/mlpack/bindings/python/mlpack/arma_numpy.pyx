@@ -3,11 +3,14 @@
 arma_numpy.pyx: Armadillo/numpy interface functionality.
 
 This file defines a number of functions useful for converting between Armadillo
-and numpy objects without actually copying memory.  Note that if a numpy matrix
-is converted to an Armadillo object, then the Armadillo object will "own" the
-matrix and free the memory upon destruction (and the numpy object will no longer
-"own" the matrix).  Similarly, if an Armadillo object is converted to a numpy
-object, then the numpy object will "own" the matrix.
+and numpy objects without actually copying memory.  When a numpy matrix is
+converted to an Armadillo object, the Armadillo object is an alias of the numpy
+memory, unless the layout of the numpy matrix is not compatible (for instance,
+if it is Fortran-ordered or strided), in which case a copy is made.  If
+requested (and for any copy), the Armadillo object will "own" the memory and
+free it upon destruction, and the numpy object will no longer "own" the matrix.
+When an Armadillo object is converted to a numpy object, the numpy object will
+"own" the matrix, unless the Armadillo object didn't own it; then it is copied.
 
 Thus, know that if you convert a matrix type, remember that the resulting type
 is what "owns" the allocated memory.
@@ -21,6 +24,8 @@ cimport cython
 cimport numpy
 import numpy
 
+from libcpp cimport bool
+
 numpy.import_array()
 
 cimport arma
@@ -31,46 +36,70 @@ cdef extern from "numpy/arrayobject.h":
 
 cdef extern from "<mlpack/bindings/python/mlpack/arma_util.hpp>":
   void SetMemState[T](T& m, int state)
+  bool TakeOwnership[T](T& m)
+  bool CanGiveOwnership[T](const T& m)
 
-cdef arma.Mat[double]* numpy_to_mat_d(numpy.ndarray[numpy.double_t, ndim=2] X) \
-    except +:
+cdef arma.Mat[double]* numpy_to_mat_d(numpy.ndarray[numpy.double_t, ndim=2] X,
+                                      bool takeOwnership) except +:
   """
-  Convert a numpy ndarray to a matrix.
+  Convert a numpy ndarray to a matrix.  The memory of X is used directly if its
+  layout allows it; otherwise, it is copied.  If takeOwnership is True, the
+  Armadillo object takes ownership of the memory of X, which must then not be
+  used again.
   """
-  if not (X.flags.c_contiguous or X.flags.owndata):
-    # If needed, make a copy where we own the memory.
+  if not X.flags.c_contiguous:
+    # The layout is not compatible, so make a copy where we own the memory.
     X = X.copy(order="C")
+    takeOwnership = True
 
-  cdef arma.Mat[double]* m = new arma.Mat[double](<double*> X.data, X.shape[1], X.shape[0], False, True)
+  cdef arma.Mat[double]* m = new arma.Mat[double](<double*> X.data,
+      X.shape[1], X.shape[0], False, False)
 
-  # Transfer ownership to the Armadillo matrix.
-  PyArray_CLEARFLAGS(X, numpy.NPY_OWNDATA)
-  SetMemState[arma.Mat[double]](m[0], 0)
+  if takeOwnership:
+    if X.flags.owndata and TakeOwnership[arma.Mat[double]](m[0]):
+      # Transfer ownership to the Armadillo object.
+      PyArray_CLEARFLAGS(X, numpy.NPY_OWNDATA)
+    else:
+      # The memory can't be taken, so the Armadillo object gets its own copy.
+      del m
+      m = new arma.Mat[double](<double*> X.data, X.shape[1], X.shape[0], True,
+          False)
 
   return m
 
-cdef arma.Mat[size_t]* numpy_to_mat_s(numpy.ndarray[numpy.npy_intp, ndim=2] X) \
-    except +:
+cdef arma.Mat[size_t]* numpy_to_mat_s(numpy.ndarray[numpy.npy_intp, ndim=2] X,
+                                      bool takeOwnership) except +:
   """
-  Convert a numpy ndarray to a matrix.
+  Convert a numpy ndarray to a matrix.  The memory of X is used directly if its
+  layout allows it; otherwise, it is copied.  If takeOwnership is True, the
+  Armadillo object takes ownership of the memory of X, which must then not be
+  used again.
   """
-  if not (X.flags.c_contiguous or X.flags.owndata):
-    # If needed, make a copy where we own the memory.
+  if not X.flags.c_contiguous:
+    # The layout is not compatible, so make a copy where we own the memory.
     X = X.copy(order="C")
+    takeOwnership = True
 
-  cdef arma.Mat[size_t]* m = new arma.Mat[size_t](<size_t*> X.data, X.shape[1],
-      X.shape[0], False, True)
+  cdef arma.Mat[size_t]* m = new arma.Mat[size_t](<size_t*> X.data,
+      X.shape[1], X.shape[0], False, False)
 
-  # Transfer ownership to the Armadillo matrix.
-  PyArray_CLEARFLAGS(X, numpy.NPY_OWNDATA)
-  SetMemState[arma.Mat[size_t]](m[0], 0)
+  if takeOwnership:
+    if X.flags.owndata and TakeOwnership[arma.Mat[size_t]](m[0]):
+      # Transfer ownership to the Armadillo object.
+      PyArray_CLEARFLAGS(X, numpy.NPY_OWNDATA)
+    else:
+      # The memory can't be taken, so the Armadillo object gets its own copy.
+      del m
+      m = new arma.Mat[size_t](<size_t*> X.data, X.shape[1], X.shape[0], True,
+          False)
 
   return m
 
 cdef numpy.ndarray[numpy.double_t, ndim=2] mat_to_numpy_d(arma.Mat[double]& X) \
     except +:
   """
-  Convert an Armadillo object to a numpy ndarray.
+  Convert an Armadillo object to a numpy ndarray.  If X owns its memory, the
+  memory is handed over without a copy; otherwise, it is copied.
   """
   # Extract dimensions.
   cdef numpy.npy_intp dims[2]
@@ -79,16 +108,22 @@ cdef numpy.ndarray[numpy.double_t, ndim=2] mat_to_numpy_d(arma.Mat[double]& X) \
   cdef numpy.ndarray[numpy.double_t, ndim=2] output = \
       numpy.PyArray_SimpleNewFromData(2, &dims[0], numpy.NPY_DOUBLE, X.memptr())
 
-  # Transfer memory ownership.
-  SetMemState[arma.Mat[double]](X, 1)
-  PyArray_ENABLEFLAGS(output, numpy.NPY_OWNDATA)
+  if CanGiveOwnership[arma.Mat[double]](X):
+    # Transfer memory ownership.
+    SetMemState[arma.Mat[double]](X, 1)
+    PyArray_ENABLEFLAGS(output, numpy.NPY_OWNDATA)
+  else:
+    # The memory belongs to another object, or is stored inside X, so it must
+    # be copied.
+    output = output.copy()
 
   return output
 
 cdef numpy.ndarray[numpy.npy_intp, ndim=2] mat_to_numpy_s(arma.Mat[size_t]& X) \
     except +:
   """
-  Convert an Armadillo object to a numpy ndarray.
+  Convert an Armadillo object to a numpy ndarray.  If X owns its memory, the
+  memory is handed over without a copy; otherwise, it is copied.
   """
   # Extract dimensions.
   cdef numpy.npy_intp dims[2]
@@ -97,144 +132,211 @@ cdef numpy.ndarray[numpy.npy_intp, ndim=2] mat_to_numpy_s(arma.Mat[size_t]& X) \
   cdef numpy.ndarray[numpy.npy_intp, ndim=2] output = \
       numpy.PyArray_SimpleNewFromData(2, &dims[0], numpy.NPY_INTP, X.memptr())
 
-  # Transfer memory ownership.
-  SetMemState[arma.Mat[size_t]](X, 1)
-  PyArray_ENABLEFLAGS(output, numpy.NPY_OWNDATA)
+  if CanGiveOwnership[arma.Mat[size_t]](X):
+    # Transfer memory ownership.
+    SetMemState[arma.Mat[size_t]](X, 1)
+    PyArray_ENABLEFLAGS(output, numpy.NPY_OWNDATA)
+  else:
+    # The memory belongs to another object, or is stored inside X, so it must
+    # be copied.
+    output = output.copy()
 
   return output
 
-cdef arma.Row[double]* numpy_to_row_d(numpy.ndarray[numpy.double_t, ndim=1] X) \
-    except +:
+cdef arma.Row[double]* numpy_to_row_d(numpy.ndarray[numpy.double_t, ndim=1] X,
+                                      bool takeOwnership) except +:
   """
-  Convert a numpy one-dimensional ndarray to a row.
+  Convert a numpy one-dimensional ndarray to a row.  The memory of X is used
+  directly if its layout allows it; otherwise, it is copied.  If takeOwnership
+  is True, the Armadillo object takes ownership of the memory of X, which must
+  then not be used again.
   """
-  if not (X.flags.c_contiguous or X.flags.owndata):
-    # If needed, make a copy where we own the memory.
+  if not X.flags.c_contiguous:
+    # The layout is not compatible, so make a copy where we own the memory.
     X = X.copy(order="C")
+    takeOwnership = True
 
-  cdef arma.Row[double]* m = new arma.Row[double](<double*> X.data, X.shape[0],
-      False, True)
+  cdef arma.Row[double]* m = new arma.Row[double](<double*> X.data,
+      X.shape[0], False, False)
 
-  # Transfer ownership to the Armadillo matrix.
-  PyArray_CLEARFLAGS(X, numpy.NPY_OWNDATA)
-  SetMemState[arma.Row[double]](m[0], 0)
+  if takeOwnership:
+    if X.flags.owndata and TakeOwnership[arma.Row[double]](m[0]):
+      # Transfer ownership to the Armadillo object.
+      PyArray_CLEARFLAGS(X, numpy.NPY_OWNDATA)
+    else:
+      # The memory can't be taken, so the Armadillo object gets its own copy.
+      del m
+      m = new arma.Row[double](<double*> X.data, X.shape[0], True, False)
 
   return m
 
-cdef arma.Row[size_t]* numpy_to_row_s(numpy.ndarray[numpy.npy_intp, ndim=1] X) \
-    except +:
+cdef arma.Row[size_t]* numpy_to_row_s(numpy.ndarray[numpy.npy_intp, ndim=1] X,
+                                      bool takeOwnership) except +:
   """
-  Convert a numpy one-dimensional ndarray to a row.
+  Convert a numpy one-dimensional ndarray to a row.  The memory of X is used
+  directly if its layout allows it; otherwise, it is copied.  If takeOwnership
+  is True, the Armadillo object takes ownership of the memory of X, which must
+  then not be used again.
   """
-  if not (X.flags.c_contiguous or X.flags.owndata):
-    # If needed, make a copy where we own the memory.
+  if not X.flags.c_contiguous:
+    # The layout is not compatible, so make a copy where we own the memory.
     X = X.copy(order="C")
+    takeOwnership = True
 
-  cdef arma.Row[size_t]* m = new arma.Row[size_t](<size_t*> X.data, X.shape[0],
-      False, True)
+  cdef arma.Row[size_t]* m = new arma.Row[size_t](<size_t*> X.data,
+      X.shape[0], False, False)
 
-  # Transfer ownership to the Armadillo matrix.
-  PyArray_CLEARFLAGS(X, numpy.NPY_OWNDATA)
-  SetMemState[arma.Row[size_t]](m[0], 0)
+  if takeOwnership:
+    if X.flags.owndata and TakeOwnership[arma.Row[size_t]](m[0]):
+      # Transfer ownership to the Armadillo object.
+      PyArray_CLEARFLAGS(X, numpy.NPY_OWNDATA)
+    else:
+      # The memory can't be taken, so the Armadillo object gets its own copy.
+      del m
+      m = new arma.Row[size_t](<size_t*> X.data, X.shape[0], True, False)
 
   return m
 
 cdef numpy.ndarray[numpy.double_t, ndim=1] row_to_numpy_d(arma.Row[double]& X) \
     except +:
   """
-  Convert an Armadillo row vector to a one-dimensional numpy ndarray.
+  Convert an Armadillo row vector to a one-dimensional numpy ndarray.  If X owns
+  its memory, the memory is handed over without a copy; otherwise, it is copied.
   """
-  # Extract dimensions.
+  # Extract dimension.
   cdef numpy.npy_intp dim = <numpy.npy_intp> X.n_elem
   cdef numpy.ndarray[numpy.double_t, ndim=1] output = \
       numpy.PyArray_SimpleNewFromData(1, &dim, numpy.NPY_DOUBLE, X.memptr())
 
-  # Transfer memory ownership.
-  SetMemState[arma.Row[double]](X, 1)
-  PyArray_ENABLEFLAGS(output, numpy.NPY_OWNDATA)
+  if CanGiveOwnership[arma.Row[double]](X):
+    # Transfer memory ownership.
+    SetMemState[arma.Row[double]](X, 1)
+    PyArray_ENABLEFLAGS(output, numpy.NPY_OWNDATA)
+  else:
+    # The memory belongs to another object, or is stored inside X, so it must
+    # be copied.
+    output = output.copy()
 
   return output
 
 cdef numpy.ndarray[numpy.npy_intp, ndim=1] row_to_numpy_s(arma.Row[size_t]& X) \
     except +:
   """
-  Convert an Armadillo row vector to a one-dimensional numpy ndarray.
+  Convert an Armadillo row vector to a one-dimensional numpy ndarray.  If X owns
+  its memory, the memory is handed over without a copy; otherwise, it is copied.
   """
-  # Extract dimensions.
+  # Extract dimension.
   cdef numpy.npy_intp dim = <numpy.npy_intp> X.n_elem
   cdef numpy.ndarray[numpy.npy_intp, ndim=1] output = \
       numpy.PyArray_SimpleNewFromData(1, &dim, numpy.NPY_INTP, X.memptr())
 
-  # Transfer memory ownership.
-  SetMemState[arma.Row[size_t]](X, 1)
-  PyArray_ENABLEFLAGS(output, numpy.NPY_OWNDATA)
+  if CanGiveOwnership[arma.Row[size_t]](X):
+    # Transfer memory ownership.
+    SetMemState[arma.Row[size_t]](X, 1)
+    PyArray_ENABLEFLAGS(output, numpy.NPY_OWNDATA)
+  else:
+    # The memory belongs to another object, or is stored inside X, so it must
+    # be copied.
+    output = output.copy()
 
   return output
 
-cdef arma.Col[double]* numpy_to_col_d(numpy.ndarray[numpy.double_t, ndim=1] X) \
-    except +:
+cdef arma.Col[double]* numpy_to_col_d(numpy.ndarray[numpy.double_t, ndim=1] X,
+                                      bool takeOwnership) except +:
   """
-  Convert a numpy one-dimensional ndarray to a column vector.
+  Convert a numpy one-dimensional ndarray to a column vector.  The memory of X
+  is used directly if its layout allows it; otherwise, it is copied.  If
+  takeOwnership is True, the Armadillo object takes ownership of the memory of
+  X, which must then not be used again.
   """
-  if not (X.flags.c_contiguous or X.flags.owndata):
-    # If needed, make a copy where we own the memory.
+  if not X.flags.c_contiguous:
+    # The layout is not compatible, so make a copy where we own the memory.
     X = X.copy(order="C")
+    takeOwnership = True
 
-  cdef arma.Col[double]* m = new arma.Col[double](<double*> X.data, X.shape[0],
-      False, True)
+  cdef arma.Col[double]* m = new arma.Col[double](<double*> X.data,
+      X.shape[0], False, False)
 
-  # Transfer ownership to the Armadillo matrix.
-  PyArray_CLEARFLAGS(X, numpy.NPY_OWNDATA)
-  SetMemState[arma.Col[double]](m[0], 0)
+  if takeOwnership:
+    if X.flags.owndata and TakeOwnership[arma.Col[double]](m[0]):
+      # Transfer ownership to the Armadillo object.
+      PyArray_CLEARFLAGS(X, numpy.NPY_OWNDATA)
+    else:
+      # The memory can't be taken, so the Armadillo object gets its own copy.
+      del m
+      m = new arma.Col[double](<double*> X.data, X.shape[0], True, False)
 
   return m
 
-cdef arma.Col[size_t]* numpy_to_col_s(numpy.ndarray[numpy.npy_intp, ndim=1] X) \
-    except +:
+cdef arma.Col[size_t]* numpy_to_col_s(numpy.ndarray[numpy.npy_intp, ndim=1] X,
+                                      bool takeOwnership) except +:
   """
-  Convert a numpy one-dimensional ndarray to a column vector.
+  Convert a numpy one-dimensional ndarray to a column vector.  The memory of X
+  is used directly if its layout allows it; otherwise, it is copied.  If
+  takeOwnership is True, the Armadillo object takes ownership of the memory of
+  X, which must then not be used again.
   """
-  if not (X.flags.c_contiguous or X.flags.owndata):
-    # If needed, make a copy where we own the memory.
+  if not X.flags.c_contiguous:
+    # The layout is not compatible, so make a copy where we own the memory.
     X = X.copy(order="C")
+    takeOwnership = True
 
-  cdef arma.Col[size_t]* m = new arma.Col[size_t](<size_t*> X.data, X.shape[0],
-      False, True)
+  cdef arma.Col[size_t]* m = new arma.Col[size_t](<size_t*> X.data,
+      X.shape[0], False, False)
 
-  # Transfer ownership to the Armadillo matrix.
-  PyArray_CLEARFLAGS(X, numpy.NPY_OWNDATA)
-  SetMemState[arma.Col[size_t]](m[0], 0)
+  if takeOwnership:
+    if X.flags.owndata and TakeOwnership[arma.Col[size_t]](m[0]):
+      # Transfer ownership to the Armadillo object.
+      PyArray_CLEARFLAGS(X, numpy.NPY_OWNDATA)
+    else:
+      # The memory can't be taken, so the Armadillo object gets its own copy.
+      del m
+      m = new arma.Col[size_t](<size_t*> X.data, X.shape[0], True, False)
 
   return m
 
 cdef numpy.ndarray[numpy.double_t, ndim=1] col_to_numpy_d(arma.Col[double]& X) \
     except +:
   """
-  Convert an Armadillo column vector to a one-dimensional numpy ndarray.
+  Convert an Armadillo column vector to a one-dimensional numpy ndarray.  If X
+  owns its memory, the memory is handed over without a copy; otherwise, it is
+  copied.
   """
   # Extract dimension.
   cdef numpy.npy_intp dim = <numpy.npy_intp> X.n_elem
   cdef numpy.ndarray[numpy.double_t, ndim=1] output = \
       numpy.PyArray_SimpleNewFromData(1, &dim, numpy.NPY_DOUBLE, X.memptr())
 
-  # Transfer memory ownership.
-  SetMemState[arma.Col[double]](X, 1)
-  PyArray_ENABLEFLAGS(output, numpy.NPY_OWNDATA)
+  if CanGiveOwnership[arma.Col[double]](X):
+    # Transfer memory ownership.
+    SetMemState[arma.Col[double]](X, 1)
+    PyArray_ENABLEFLAGS(output, numpy.NPY_OWNDATA)
+  else:
+    # The memory belongs to another object, or is stored inside X, so it must
+    # be copied.
+    output = output.copy()
 
   return output
 
 cdef numpy.ndarray[numpy.npy_intp, ndim=1] col_to_numpy_s(arma.Col[size_t]& X) \
     except +:
   """
-  Convert an Armadillo column vector to a one-dimensional numpy ndarray.
+  Convert an Armadillo column vector to a one-dimensional numpy ndarray.  If X
+  owns its memory, the memory is handed over without a copy; otherwise, it is
+  copied.
   """
   # Extract dimension.
   cdef numpy.npy_intp dim = <numpy.npy_intp> X.n_elem
   cdef numpy.ndarray[numpy.npy_intp, ndim=1] output = \
       numpy.PyArray_SimpleNewFromData(1, &dim, numpy.NPY_INTP, X.memptr())
 
-  # Transfer memory ownership.
-  SetMemState[arma.Col[size_t]](X, 1)
-  PyArray_ENABLEFLAGS(output, numpy.NPY_OWNDATA)
+  if CanGiveOwnership[arma.Col[size_t]](X):
+    # Transfer memory ownership.
+    SetMemState[arma.Col[size_t]](X, 1)
+    PyArray_ENABLEFLAGS(output, numpy.NPY_OWNDATA)
+  else:
+    # The memory belongs to another object, or is stored inside X, so it must
+    # be copied.
+    output = output.copy()
 
   return output
@@ -2,7 +2,7 @@
  * @file arma_util.hpp
  * @author Ryan Curtin
  *
- * Utility function for Cython to set the memory state of an Armadillo object.
+ * Utility functions for Cython to manage the memory of Armadillo objects.
  *
  * mlpack is free software; you may redistribute it and/or modify it under the
  * terms of the 3-clause BSD license.  You should have received a copy of the
@@ -24,4 +24,35 @@ void SetMemState(T& t, int state)
   const_cast<arma::uhword&>(t.mem_state) = state;
 }
 
+/**
+ * Make the given Armadillo object, which uses auxiliary memory allocated by
+ * numpy, take ownership of that memory: it will be freed when the object is
+ * destroyed, and it can be moved to another object without a copy.  Small
+ * objects are expected to keep their elements inside the object, so nothing is
+ * done for them, and false is returned.
+ *
+ * @param t Armadillo object to take ownership of its memory.
+ * @return Whether or not the object now owns its memory.
+ */
+template<typename T>
+bool TakeOwnership(T& t)
+{
+  if (t.n_elem <= arma::arma_config::mat_prealloc)
+    return false;
+
+  const_cast<arma::uword&>(t.n_alloc) = t.n_elem;
+  const_cast<arma::uhword&>(t.mem_state) = 0;
+  return true;
+}
+
+/**
+ * Return whether the memory of the given Armadillo object can be handed to
+ * numpy: the object must own it, and it must not be stored inside the object.
+ */
+template<typename T>
+bool CanGiveOwnership(const T& t)
+{
+  return (t.mem_state == 0) && (t.n_alloc > arma::arma_config::mat_prealloc);
+}
+
 #endif
@@ -35,10 +35,17 @@ cdef extern from "<mlpack/core/util/cli.hpp>" namespace "mlpack" nogil:
     @staticmethod
     void ClearSettings() nogil except +
 
+cdef extern from "<mlpack/core/util/cli.hpp>" namespace "mlpack::util" nogil:
+  cdef cppclass CLIContext:
+    CLIContext() nogil
+
 cdef extern from "<mlpack/bindings/python/mlpack/cli_util.hpp>" \
     namespace "mlpack::util" nogil:
-  void SetParam[T](string, const T&) nogil except +
-  void SetParamWithInfo[T](string, const T&, const bool*) nogil except +
+  void SetParam[T](string, T&) nogil except +
+  void SetParamWithInfo[T](string, T&, const bool*) nogil except +
+  void SetParamPtr[T](string, T*) nogil except +
+  T* GetParamPtr[T](string) nogil except +
+  void DeleteNewModels() nogil except +
   (T&) GetParamWithInfo[T](string) nogil except +
   void EnableVerbose() nogil except +
   void DisableBacktrace() nogil except +
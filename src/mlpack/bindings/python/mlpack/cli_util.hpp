@@ -2,8 +2,8 @@
  * @file cli_util.hpp
  * @author Ryan Curtin
  *
- * Simple function to work around Cython's lack of support for lvalue
- * references.
+ * Simple functions to work around Cython's lack of support for lvalue
+ * references, and to pass models by pointer.
  *
  * mlpack is free software; you may redistribute it and/or modify it under the
  * terms of the 3-clause BSD license.  You should have received a copy of the
@@ -15,12 +15,15 @@
 
 #include <mlpack/core/util/cli.hpp>
 #include <mlpack/core/data/dataset_mapper.hpp>
+#include <mlpack/bindings/python/get_param.hpp>
 
 namespace mlpack {
 namespace util {
 
 /**
- * Set the parameter to the given value.
+ * Set the parameter to the given value.  The value is moved, so that matrices
+ * that are aliases of numpy memory are not copied; it should not be used
+ * afterwards.
  *
  * This function exists to work around Cython's lack of support for lvalue
  * references.
@@ -29,24 +32,26 @@ namespace util {
  * @param value Value to set parameter to.
  */
 template<typename T>
-inline void SetParam(const std::string& identifier, const T& value)
+inline void SetParam(const std::string& identifier, T& value)
 {
-  CLI::GetParam<T>(identifier) = value;
+  CLI::GetParam<T>(identifier) = std::move(value);
 }
 
 /**
  * Set the parameter (which is a matrix/DatasetInfo tuple) to the given value.
+ * Like SetParam(), the matrix is moved.
  */
 template<typename T>
 inline void SetParamWithInfo(const std::string& identifier,
-                             const T& matrix,
+                             T& value,
                              const bool* dims)
 {
   typedef typename std::tuple<data::DatasetInfo, T> TupleType;
   typedef typename T::elem_type eT;
 
   // The true type of the parameter is std::tuple<T, DatasetInfo>.
-  std::get<1>(CLI::GetParam<TupleType>(identifier)) = matrix;
+  T& matrix = std::get<1>(CLI::GetParam<TupleType>(identifier));
+  matrix = std::move(value);
   data::DatasetInfo& di = std::get<0>(CLI::GetParam<TupleType>(identifier));
   di = data::DatasetInfo(matrix.n_rows);
 
@@ -81,6 +86,51 @@ inline void SetParamWithInfo(const std::string& identifier,
   }
 }
 
+/**
+ * Set the model parameter to the given model.  The model is not copied or
+ * moved: the program uses it in place, and the caller keeps ownership of it.
+ *
+ * @param identifier Name of parameter.
+ * @param model Model to use.
+ */
+template<typename T>
+inline void SetParamPtr(const std::string& identifier, T* model)
+{
+  CLI::Parameters()[identifier].value = boost::any(model);
+}
+
+/**
+ * Return the model held by the given model parameter, or NULL if there is
+ * none.  If the model was allocated while the program ran, the caller takes
+ * ownership of it.
+ */
+template<typename T>
+T* GetParamPtr(const std::string& identifier)
+{
+  T* model = *boost::any_cast<T*>(&CLI::Parameters()[identifier].value);
+
+  std::map<std::string, bindings::python::NewModel>& newModels =
+      bindings::python::NewModels();
+  std::map<std::string, bindings::python::NewModel>::iterator it =
+      newModels.find(identifier);
+  if (it != newModels.end())
+  {
+    it->second.release();
+    newModels.erase(it);
+  }
+
+  return model;
+}
+
+/**
+ * Delete the models that were allocated while the program ran but not taken
+ * with GetParamPtr(); this is called if the program throws.
+ */
+inline void DeleteNewModels()
+{
+  bindings::python::NewModels().clear();
+}
+
 /**
  * Return the matrix part of a matrix + dataset info parameter.
  */
@@ -113,8 +163,7 @@ inline void DisableBacktrace()
  */
 inline void ResetTimers()
 {
-  // Just get a new object---removes all old timers.
-  CLI::GetSingleton().timer = Timers();
+  CLI::GetSingleton().timer.Reset();
 }
 
 } // namespace util
@@ -14,9 +14,11 @@ http://www.opensource.org/licenses/BSD-3-Clause for more information.
 import numpy as np
 import pandas as pd
 
-def to_matrix(x, dtype=np.double):
+def to_matrix(x, dtype=np.double, copy=False):
   """
-  Given some array-like X, return a numpy ndarray of the same type.
+  Given some array-like X, return a numpy ndarray of the same type.  If X is
+  already a C-contiguous ndarray of the given dtype, it is returned as-is
+  (unless copy is True); otherwise, a new ndarray is returned.
   """
   # Make sure it's array-like at all.
   if not hasattr(x, '__len__') and \
@@ -24,15 +26,17 @@ def to_matrix(x, dtype=np.double):
       not hasattr(x, '__array__'):
     raise TypeError("given argument is not array-like")
 
-  if (isinstance(x, np.ndarray) and x.dtype == dtype and x.flags.c_contiguous):
+  if (isinstance(x, np.ndarray) and x.dtype == dtype and x.flags.c_contiguous
+      and not copy):
     return x
   else:
     return np.array(x, copy=True, dtype=dtype, order='C')
 
-def to_matrix_with_info(x, dtype):
+def to_matrix_with_info(x, dtype, copy=False):
   """
   Given some array-like X (which should be either a numpy ndarray or a pandas
-  DataFrame, convert into a numpy matrix of the given dtype.
+  DataFrame, convert into a numpy matrix of the given dtype.  As with
+  to_matrix(), an ndarray is only copied if needed or if copy is True.
   """
   # Make sure it's array-like at all.
   if not hasattr(x, '__len__') and \
@@ -43,7 +47,7 @@ def to_matrix_with_info(x, dtype):
   if isinstance(x, np.ndarray):
     # It is already an ndarray, so the vector of info is all 0s (all numeric).
     d = np.zeros([x.shape[1]], dtype=np.bool)
-    return (x, d)
+    return (to_matrix(x, dtype, copy), d)
 
   if isinstance(x, pd.DataFrame) or isinstance(x, pd.Series):
     # It's a pandas dataframe.  So we need to see if any of the dtypes are
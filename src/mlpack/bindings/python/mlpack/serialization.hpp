@@ -0,0 +1,60 @@
+/**
+ * @file serialization.hpp
+ *
+ * Utility functions for Cython to serialize and deserialize models with
+ * boost::serialization binary archives; these are used to pickle the model
+ * objects of the Python bindings.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_PYTHON_CYTHON_SERIALIZATION_HPP
+#define MLPACK_BINDINGS_PYTHON_CYTHON_SERIALIZATION_HPP
+
+#include <mlpack/core.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <sstream>
+
+namespace mlpack {
+namespace util {
+
+/**
+ * Serialize the given model into a binary string.
+ *
+ * @param t Model to serialize.
+ * @param name Name of the model in the archive.
+ * @return Binary archive holding the model.
+ */
+template<typename T>
+std::string SerializeOut(T* t, const std::string& name)
+{
+  std::ostringstream oss;
+  {
+    boost::archive::binary_oarchive b(oss);
+    b << data::CreateNVP(*t, name);
+  }
+  return oss.str();
+}
+
+/**
+ * Deserialize the given model from a binary string created by SerializeOut().
+ *
+ * @param t Model to deserialize into.
+ * @param str Binary archive holding the model.
+ * @param name Name of the model in the archive.
+ */
+template<typename T>
+void SerializeIn(T* t, const std::string& str, const std::string& name)
+{
+  std::istringstream iss(str);
+  boost::archive::binary_iarchive b(iss);
+  b >> data::CreateNVP(*t, name);
+}
+
+} // namespace util
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,20 @@
+#!/usr/bin/env python
+"""
+serialization.pxd: Cython declarations for model serialization.
+
+This file imports the SerializeIn() and SerializeOut() functions, which are
+used to pickle the model objects of the bindings with binary archives.
+
+mlpack is free software; you may redistribute it and/or modify it under the
+terms of the 3-clause BSD license.  You should have received a copy of the
+3-clause BSD license along with mlpack.  If not, see
+http://www.opensource.org/licenses/BSD-3-Clause for more information.
+"""
+cimport cython
+
+from libcpp.string cimport string
+
+cdef extern from "<mlpack/bindings/python/mlpack/serialization.hpp>" \
+    namespace "mlpack::util" nogil:
+  string SerializeOut[T](T* t, string name) nogil except +
+  void SerializeIn[T](T* t, string str, string name) nogil except +
@@ -43,25 +43,51 @@ void PrintClassDefn(
    *
    * cdef class <ModelType>Type:
    *   cdef <ModelType>* modelptr
+   *   cdef list inputs
    *
    *   def __cinit__(self):
    *     self.modelptr = new <ModelType>()
+   *     self.inputs = []
    *
    *   def __dealloc__(self):
    *     del self.modelptr
+   *
+   *   def __getstate__(self):
+   *     return SerializeOut[<ModelType>](self.modelptr, '<ModelType>')
+   *
+   *   def __setstate__(self, state):
+   *     SerializeIn[<ModelType>](self.modelptr, state, '<ModelType>')
+   *
+   *   def __reduce_ex__(self, version):
+   *     return (self.__class__, (), self.__getstate__())
+   *
+   * The inputs member holds the numpy matrices whose memory the model may
+   * refer to without owning it, so that they live as long as the model.  The
+   * model is pickled with a binary archive.
    */
   std::cout << "cdef class " << strippedType << "Type:" << std::endl;
   std::cout << "  cdef " << printedType << "* modelptr" << std::endl;
+  std::cout << "  cdef list inputs" << std::endl;
   std::cout << std::endl;
   std::cout << "  def __cinit__(self):" << std::endl;
   std::cout << "    self.modelptr = new " << printedType << "()" << std::endl;
+  std::cout << "    self.inputs = []" << std::endl;
   std::cout << std::endl;
   std::cout << "  def __dealloc__(self):" << std::endl;
   std::cout << "    del self.modelptr" << std::endl;
   std::cout << std::endl;
-
-  // TODO: add some functions for loading models from and saving models to a
-  // filename.
+  std::cout << "  def __getstate__(self):" << std::endl;
+  std::cout << "    return SerializeOut[" << strippedType << "](self.modelptr, '"
+      << strippedType << "')" << std::endl;
+  std::cout << std::endl;
+  std::cout << "  def __setstate__(self, state):" << std::endl;
+  std::cout << "    SerializeIn[" << strippedType << "](self.modelptr, state, '"
+      << strippedType << "')" << std::endl;
+  std::cout << std::endl;
+  std::cout << "  def __reduce_ex__(self, version):" << std::endl;
+  std::cout << "    return (self.__class__, (), self.__getstate__())"
+      << std::endl;
+  std::cout << std::endl;
 }
 
 /**
@@ -90,38 +90,47 @@ void PrintInputProcessing(
    *
    * # Detect if the parameter was passed; set if so.
    * if param_name is not None:
-   *   param_name_mat = arma_numpy.numpy_to_mat_d(param_name)
+   *   param_name_array = to_matrix(param_name, dtype=np.double,
+   *       copy=copy_all_inputs)
+   *   if param_name_array is param_name:
+   *     inputs.append(param_name)
+   *   param_name_mat = arma_numpy.numpy_to_mat_d(param_name_array,
+   *       param_name_array is not param_name)
    *   SetParam[mat](<const string> 'param_name', dereference(param_name_mat))
+   *   del param_name_mat
    *   CLI.SetPassed(<const string> 'param_name')
+   *
+   * If to_matrix() did not have to copy the parameter, the matrix is an alias
+   * of its memory, so the parameter is kept in the list of inputs that output
+   * models hold on to.  Otherwise, the matrix owns the memory of the copy.
    */
   std::cout << prefix << "# Detect if the parameter was passed; set if so."
       << std::endl;
+  std::string extraPrefix = "";
   if (!d.required)
   {
     std::cout << prefix << "if " << d.name << " is not None:" << std::endl;
-
-    std::cout << prefix << "  " << d.name << "_mat = arma_numpy.numpy_to_"
-        << GetArmaType<T>() << "_" << GetNumpyTypeChar<T>() << "(to_matrix("
-        << d.name << ", " << "dtype=" << GetNumpyType<typename T::elem_type>()
-        << "))" << std::endl;
-    std::cout << prefix << "  SetParam[" << GetCythonType<T>(d) << "](<const "
-        << "string> '" << d.name << "', dereference(" << d.name << "_mat))"
-        << std::endl;
-    std::cout << prefix << "  CLI.SetPassed(<const string> '" << d.name << "')"
-        << std::endl;
-  }
-  else
-  {
-    std::cout << prefix << d.name << "_mat = arma_numpy.numpy_to_"
-        << GetArmaType<T>() << "_" << GetNumpyTypeChar<T>() << "(to_matrix("
-        << d.name << ", " << "dtype=" << GetNumpyType<typename T::elem_type>()
-        << "))" << std::endl;
-    std::cout << prefix << "SetParam[" << GetCythonType<T>(d) << "](<const "
-        << "string> '" << d.name << "', dereference(" << d.name << "_mat))"
-        << std::endl;
-    std::cout << prefix << "CLI.SetPassed(<const string> '" << d.name << "')"
-        << std::endl;
+    extraPrefix = "  ";
   }
+
+  std::cout << prefix << extraPrefix << d.name << "_array = to_matrix("
+      << d.name << ", dtype=" << GetNumpyType<typename T::elem_type>()
+      << ", copy=copy_all_inputs)" << std::endl;
+  std::cout << prefix << extraPrefix << "if " << d.name << "_array is "
+      << d.name << ":" << std::endl;
+  std::cout << prefix << extraPrefix << "  inputs.append(" << d.name << ")"
+      << std::endl;
+  std::cout << prefix << extraPrefix << d.name << "_mat = arma_numpy.numpy_to_"
+      << GetArmaType<T>() << "_" << GetNumpyTypeChar<T>() << "(" << d.name
+      << "_array, " << d.name << "_array is not " << d.name << ")"
+      << std::endl;
+  std::cout << prefix << extraPrefix << "SetParam[" << GetCythonType<T>(d)
+      << "](<const string> '" << d.name << "', dereference(" << d.name
+      << "_mat))" << std::endl;
+  std::cout << prefix << extraPrefix << "del " << d.name << "_mat"
+      << std::endl;
+  std::cout << prefix << extraPrefix << "CLI.SetPassed(<const string> '"
+      << d.name << "')" << std::endl;
   std::cout << std::endl;
 }
 
@@ -145,29 +154,33 @@ void PrintInputProcessing(
    *
    * # Detect if the parameter was passed; set if so.
    * if param_name is not None:
-   *   MoveFromPtr[Model](CLI.GetParam[Model]('param_name'),
-   *       (<ModelType?> param_name).modelptr)
+   *   SetParamPtr[Model]('param_name', (<ModelType?> param_name).modelptr)
+   *   input_models[<size_t> (<ModelType?> param_name).modelptr] = param_name
+   *   inputs.extend((<ModelType?> param_name).inputs)
    *   CLI.SetPassed(<const string> 'param_name')
+   *
+   * The program uses the model in place.  The model may refer to the memory of
+   * matrices it was built with, so those are passed on to any output model.
    */
   std::cout << prefix << "# Detect if the parameter was passed; set if so."
       << std::endl;
+  std::string extraPrefix = "";
   if (!d.required)
   {
     std::cout << prefix << "if " << d.name << " is not None:" << std::endl;
-    std::cout << prefix << "  MoveFromPtr[" << strippedType << "](CLI.GetParam["
-        << strippedType << "]('" << d.name << "'), (<" << strippedType
-        << "Type?> " << d.name << ").modelptr)" << std::endl;
-    std::cout << prefix << "  CLI.SetPassed(<const string> '" << d.name << "')"
-        << std::endl;
-  }
-  else
-  {
-    std::cout << prefix << "MoveFromPtr[" << strippedType << "](CLI.GetParam["
-        << strippedType << "]('" << d.name << "'), (<" << strippedType
-        << "Type?> " << d.name << ").modelptr)" << std::endl;
-    std::cout << prefix << "CLI.SetPassed(<const string> '" << d.name << "')"
-        << std::endl;
+    extraPrefix = "  ";
   }
+
+  std::cout << prefix << extraPrefix << "SetParamPtr[" << strippedType
+      << "]('" << d.name << "', (<" << strippedType << "Type?> " << d.name
+      << ").modelptr)" << std::endl;
+  std::cout << prefix << extraPrefix << "input_models[<size_t> (<"
+      << strippedType << "Type?> " << d.name << ").modelptr] = " << d.name
+      << std::endl;
+  std::cout << prefix << extraPrefix << "inputs.extend((<" << strippedType
+      << "Type?> " << d.name << ").inputs)" << std::endl;
+  std::cout << prefix << extraPrefix << "CLI.SetPassed(<const string> '"
+      << d.name << "')" << std::endl;
   std::cout << std::endl;
 }
 
@@ -187,44 +200,47 @@ void PrintInputProcessing(
   /** We want to generate code like the following:
    *
    * if param_name is not None:
-   *   param_name_tuple = to_matrix_with_info(param_name)
-   *   param_name_mat = arma_numpy.numpy_to_matrix_d(param_name_tuple[0])
+   *   param_name_tuple = to_matrix_with_info(param_name, dtype=np.double,
+   *       copy=copy_all_inputs)
+   *   if param_name_tuple[0] is param_name:
+   *     inputs.append(param_name)
+   *   param_name_mat = arma_numpy.numpy_to_mat_d(param_name_tuple[0],
+   *       param_name_tuple[0] is not param_name)
+   *   param_name_dims = param_name_tuple[1]
    *   SetParamWithInfo[mat](<const string> 'param_name',
-   *       dereference(param_name_mat), &param_name_tuple[1][0])
+   *       dereference(param_name_mat), <const bool*> param_name_dims.data)
+   *   del param_name_mat
    *   CLI.SetPassed(<const string> 'param_name')
    */
   std::cout << prefix << "cdef np.ndarray " << d.name << "_dims" << std::endl;
   std::cout << prefix << "# Detect if the parameter was passed; set if so."
       << std::endl;
+  std::string extraPrefix = "";
   if (!d.required)
   {
     std::cout << prefix << "if " << d.name << " is not None:" << std::endl;
-    std::cout << prefix << "  " << d.name << "_tuple = to_matrix_with_info("
-        << d.name << ", dtype=np.double)" << std::endl;
-    std::cout << prefix << "  " << d.name << "_mat = arma_numpy.numpy_to_mat_d("
-        << d.name << "_tuple[0])" << std::endl;
-    std::cout << prefix << "  " << d.name << "_dims = " << d.name << "_tuple[1]"
-        << std::endl;
-    std::cout << prefix << "  SetParamWithInfo[arma.Mat[double]](<const string>"
-        << " '" << d.name << "', dereference(" << d.name << "_mat), <const "
-        << "bool*> " << d.name << "_dims.data)" << std::endl;
-    std::cout << prefix << "  CLI.SetPassed(<const string> '" << d.name << "')"
-        << std::endl;
-  }
-  else
-  {
-    std::cout << prefix << d.name << "_tuple = to_matrix_with_info(" << d.name
-        << ", dtype=np.double)" << std::endl;
-    std::cout << prefix << d.name << "_mat = arma_numpy.numpy_to_mat_d("
-        << d.name << "_tuple[0])" << std::endl;
-    std::cout << prefix << d.name << "_dims = " << d.name << "_tuple[1]"
-        << std::endl;
-    std::cout << prefix << "SetParamWithInfo[arma.Mat[double]](<const string>"
-        << " '" << d.name << "', dereference(" << d.name << "_mat), <const "
-        << "bool*> " << d.name << "_dims.data)" << std::endl;
-    std::cout << prefix << "CLI.SetPassed(<const string> '" << d.name << "')"
-        << std::endl;
+    extraPrefix = "  ";
   }
+
+  std::cout << prefix << extraPrefix << d.name << "_tuple = "
+      << "to_matrix_with_info(" << d.name << ", dtype=np.double, "
+      << "copy=copy_all_inputs)" << std::endl;
+  std::cout << prefix << extraPrefix << "if " << d.name << "_tuple[0] is "
+      << d.name << ":" << std::endl;
+  std::cout << prefix << extraPrefix << "  inputs.append(" << d.name << ")"
+      << std::endl;
+  std::cout << prefix << extraPrefix << d.name << "_mat = "
+      << "arma_numpy.numpy_to_mat_d(" << d.name << "_tuple[0], " << d.name
+      << "_tuple[0] is not " << d.name << ")" << std::endl;
+  std::cout << prefix << extraPrefix << d.name << "_dims = " << d.name
+      << "_tuple[1]" << std::endl;
+  std::cout << prefix << extraPrefix << "SetParamWithInfo[arma.Mat[double]]"
+      << "(<const string> '" << d.name << "', dereference(" << d.name
+      << "_mat), <const bool*> " << d.name << "_dims.data)" << std::endl;
+  std::cout << prefix << extraPrefix << "del " << d.name << "_mat"
+      << std::endl;
+  std::cout << prefix << extraPrefix << "CLI.SetPassed(<const string> '"
+      << d.name << "')" << std::endl;
   std::cout << std::endl;
 }
 
@@ -154,36 +154,42 @@ void PrintOutputProcessing(
 
   const std::string prefix(indent, ' ');
 
-  if (onlyOutput)
-  {
-    /**
-     * This gives us code like:
-     *
-     * result = ModelType()
-     * MoveToPtr[Model]((<ModelType?> model).modelptr),
-     *     CLI.GetParam[Model]('name'))
-     */
-    std::cout << prefix << "result = " << strippedType << "Type()" << std::endl;
-    std::cout << prefix << "MoveToPtr[" << strippedType << "]((<"
-        << strippedType << "Type?> result).modelptr, CLI.GetParam["
-        << strippedType << "]('" << d.name << "'))" << std::endl;
-  }
-  else
-  {
-    /**
-     * This gives us code like:
-     *
-     * result['name'] = ModelType()
-     * MoveToPtr[Model*]((<ModelType?> result['name']).modelptr),
-     *     CLI.GetParam[Model]('name'))
-     */
-    std::cout << prefix << "result['" << d.name << "'] = " << strippedType
-        << "Type()" << std::endl;
-    std::cout << prefix << "MoveToPtr[" << strippedType << "]((<"
-        << strippedType << "Type?>" << " result['" << d.name
-        << "']).modelptr, CLI.GetParam[" << strippedType << "]('"
-        << d.name << "'))" << std::endl;
-  }
+  /**
+   * This gives us code like:
+   *
+   * name_ptr = GetParamPtr[Model]('name')
+   * if <size_t> name_ptr in input_models:
+   *   result['name'] = input_models[<size_t> name_ptr]
+   * else:
+   *   result['name'] = ModelType()
+   *   if name_ptr != NULL:
+   *     del (<ModelType?> result['name']).modelptr
+   *     (<ModelType?> result['name']).modelptr = name_ptr
+   * (<ModelType?> result['name']).inputs = inputs
+   *
+   * (or result instead of result['name'], if this is the only output).  If
+   * the program stored its output in an input model, that same object is
+   * returned; otherwise, the new object takes ownership of the model that was
+   * allocated for the program.
+   */
+  const std::string result = onlyOutput ? "result" :
+      "result['" + d.name + "']";
+  const std::string model = "(<" + strippedType + "Type?> " + result + ")";
+
+  std::cout << prefix << d.name << "_ptr = GetParamPtr[" << strippedType
+      << "]('" << d.name << "')" << std::endl;
+  std::cout << prefix << "if <size_t> " << d.name << "_ptr in input_models:"
+      << std::endl;
+  std::cout << prefix << "  " << result << " = input_models[<size_t> "
+      << d.name << "_ptr]" << std::endl;
+  std::cout << prefix << "else:" << std::endl;
+  std::cout << prefix << "  " << result << " = " << strippedType << "Type()"
+      << std::endl;
+  std::cout << prefix << "  if " << d.name << "_ptr != NULL:" << std::endl;
+  std::cout << prefix << "    del " << model << ".modelptr" << std::endl;
+  std::cout << prefix << "    " << model << ".modelptr = " << d.name << "_ptr"
+      << std::endl;
+  std::cout << prefix << model << ".inputs = inputs" << std::endl;
 }
 
 /**
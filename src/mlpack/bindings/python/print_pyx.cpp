@@ -70,11 +70,11 @@ void PrintPYX(const ProgramDoc& programInfo,
   // Now import all the necessary packages.
   cout << "cimport arma" << endl;
   cout << "cimport arma_numpy" << endl;
-  cout << "from cli cimport CLI" << endl;
+  cout << "from cli cimport CLI, CLIContext" << endl;
   cout << "from cli cimport SetParam, SetParamWithInfo" << endl;
-  cout << "from cli cimport EnableVerbose, DisableBacktrace, ResetTimers"
-      << endl;
-  cout << "from cli cimport MoveFromPtr, MoveToPtr" << endl;
+  cout << "from cli cimport EnableVerbose, DisableBacktrace" << endl;
+  cout << "from cli cimport SetParamPtr, GetParamPtr, DeleteNewModels" << endl;
+  cout << "from serialization cimport SerializeIn, SerializeOut" << endl;
   cout << "from matrix_utils import to_matrix, to_matrix_with_info" << endl;
   cout << endl;
   cout << "import numpy as np" << endl;
@@ -130,6 +130,11 @@ void PrintPYX(const ProgramDoc& programInfo,
     CLI::GetSingleton().functionMap[d.tname]["PrintDefn"](d, NULL, NULL);
   }
 
+  // Every binding can be asked to copy its input matrices.
+  if (inputOptions.size() > 0)
+    cout << "," << endl << std::string(indent, ' ');
+  cout << "copy_all_inputs=False";
+
   // Print closing brace for function definition.
   cout << "):" << endl;
 
@@ -151,6 +156,10 @@ void PrintPYX(const ProgramDoc& programInfo,
         NULL);
     cout << endl;
   }
+  cout << "   - " << HyphenateString("copy_all_inputs (bool): If True, all "
+      "input matrices are copied before the program is run.  Otherwise, they "
+      "are used without a copy whenever their layout allows it, so the program "
+      "may modify them.  Default value False.", 8) << endl;
   cout << endl;
   cout << "  Output parameters:" << endl;
   cout << endl;
@@ -169,14 +178,22 @@ void PrintPYX(const ProgramDoc& programInfo,
       << "returned." << endl;
   cout << "  \"\"\"" << endl;
 
-  // Reset any timers and disable backtraces.
-  cout << "  ResetTimers()" << endl;
+  // Each call gets its own parameters and timers, which are removed when the
+  // function returns, so that the binding can be called from several threads
+  // at once.
+  cout << "  cdef CLIContext context" << endl;
   cout << "  DisableBacktrace()" << endl;
 
   // Restore the parameters.
-  cout << "  CLI.RestoreSettings(\"" << programInfo.programName << "\")";
+  cout << "  CLI.RestoreSettings(\"" << programInfo.programName << "\")"
+      << endl;
 
-  // Do any input processing.
+  // Do any input processing.  The numpy matrices that are used without a copy
+  // are collected, so that output models can hold on to them; the input models
+  // are collected by address, so that an input model that the program stores
+  // its output in is returned as the same object.
+  cout << "  inputs = []" << endl;
+  cout << "  input_models = {}" << endl;
   for (size_t i = 0; i < inputOptions.size(); ++i)
   {
     const util::ParamData& d = parameters.at(inputOptions[i]);
@@ -194,9 +211,16 @@ void PrintPYX(const ProgramDoc& programInfo,
     cout << "  CLI.SetPassed(<const string> '" << d.name << "')" << endl;
   }
 
-  // Call the method.
+  // Call the method.  The GIL is released, so that other Python threads can
+  // run (and call mlpack) while the program runs.  If it throws, the models it
+  // allocated for its output are freed, since no Python object will own them.
   cout << "  # Call the mlpack program." << endl;
-  cout << "  mlpackMain()" << endl;
+  cout << "  try:" << endl;
+  cout << "    with nogil:" << endl;
+  cout << "      mlpackMain()" << endl;
+  cout << "  except:" << endl;
+  cout << "    DeleteNewModels()" << endl;
+  cout << "    raise" << endl;
 
   // Do any output processing and return.
   cout << "  # Initialize result dictionary." << endl;
@@ -212,11 +236,8 @@ void PrintPYX(const ProgramDoc& programInfo,
         (void*) &t, NULL);
   }
 
-  // Clear the parameters.
+  // The parameters are removed with the context.
   cout << endl;
-  cout << "  CLI.ClearSettings()" << endl;
-  cout << endl;
-
   cout << "  return result" << endl;
 }
 
@@ -63,8 +63,9 @@ class PyOption
       data.persistent = false;
     data.cppType = cppName;
 
-    // Every parameter we'll get from Python will have the correct type.
-    data.value = boost::any(defaultValue);
+    // Every parameter we'll get from Python will have the correct type (models
+    // are held by pointer; see get_param.hpp).
+    data.value = MakeParamValue<T>(defaultValue);
 
     // Restore the parameters for this program.
     CLI::RestoreSettings(programName, false);
@@ -7,6 +7,9 @@ Test that passing types to Python bindings works successfully.
 import unittest
 import pandas as pd
 import numpy as np
+import copy
+import pickle
+import threading
 
 from mlpack.test_python_binding import test_python_binding
 
@@ -94,6 +97,7 @@ class TestPythonBinding(unittest.TestCase):
     and the fifth forgotten.
     """
     x = np.random.rand(100, 5);
+    z = copy.deepcopy(x)
 
     output = test_python_binding(string_in='hello',
                                  int_in=12,
@@ -103,12 +107,76 @@ class TestPythonBinding(unittest.TestCase):
     self.assertEqual(output['matrix_out'].shape[0], 100)
     self.assertEqual(output['matrix_out'].shape[1], 4)
     self.assertEqual(output['matrix_out'].dtype, np.double)
+    for i in [0, 1, 3]:
+      for j in range(100):
+        self.assertEqual(z[j, i], output['matrix_out'][j, i])
+
+    for j in range(100):
+      self.assertEqual(2 * z[j, 2], output['matrix_out'][j, 2])
+
+  def testNumpyMatrixForceCopy(self):
+    """
+    The same test as testNumpyMatrix(), but with copy_all_inputs=True; the input
+    matrix should not be modified.
+    """
+    x = np.random.rand(100, 5);
+    z = copy.deepcopy(x)
+
+    output = test_python_binding(string_in='hello',
+                                 int_in=12,
+                                 double_in=4.0,
+                                 matrix_in=x,
+                                 copy_all_inputs=True)
+
+    self.assertEqual(output['matrix_out'].shape[0], 100)
+    self.assertEqual(output['matrix_out'].shape[1], 4)
     for i in [0, 1, 3]:
       for j in range(100):
         self.assertEqual(x[j, i], output['matrix_out'][j, i])
 
     for j in range(100):
       self.assertEqual(2 * x[j, 2], output['matrix_out'][j, 2])
+      self.assertEqual(x[j, 2], z[j, 2])
+
+  def testNumpyMatrixNoCopy(self):
+    """
+    A C-contiguous matrix should not be copied, so the binding (which modifies
+    its input) should modify our matrix.
+    """
+    x = np.random.rand(100, 5);
+    z = copy.deepcopy(x)
+
+    output = test_python_binding(string_in='hello',
+                                 int_in=12,
+                                 double_in=4.0,
+                                 matrix_in=x)
+
+    for j in range(100):
+      self.assertEqual(x[j, 2], 2 * z[j, 2])
+      self.assertEqual(output['matrix_out'][j, 2], 2 * z[j, 2])
+
+  def testFortranOrderMatrix(self):
+    """
+    A Fortran-ordered matrix has an incompatible layout, so it must be copied
+    (and not modified).
+    """
+    x = np.asfortranarray(np.random.rand(100, 5))
+    z = copy.deepcopy(x)
+
+    output = test_python_binding(string_in='hello',
+                                 int_in=12,
+                                 double_in=4.0,
+                                 matrix_in=x)
+
+    self.assertEqual(output['matrix_out'].shape[0], 100)
+    self.assertEqual(output['matrix_out'].shape[1], 4)
+    for i in [0, 1, 3]:
+      for j in range(100):
+        self.assertEqual(x[j, i], output['matrix_out'][j, i])
+
+    for j in range(100):
+      self.assertEqual(2 * x[j, 2], output['matrix_out'][j, 2])
+      self.assertEqual(x[j, 2], z[j, 2])
 
   def testArraylikeMatrix(self):
     """
@@ -144,6 +212,7 @@ class TestPythonBinding(unittest.TestCase):
     Same as testNumpyMatrix() but with an unsigned matrix.
     """
     x = np.random.randint(0, high=500, size=[100, 5])
+    z = copy.deepcopy(x)
 
     output = test_python_binding(string_in='hello',
                                  int_in=12,
@@ -155,10 +224,10 @@ class TestPythonBinding(unittest.TestCase):
     self.assertEqual(output['umatrix_out'].dtype, np.long)
     for i in [0, 1, 3]:
       for j in range(100):
-        self.assertEqual(x[j, i], output['umatrix_out'][j, i])
+        self.assertEqual(z[j, i], output['umatrix_out'][j, i])
 
     for j in range(100):
-      self.assertEqual(2 * x[j, 2], output['umatrix_out'][j, 2])
+      self.assertEqual(2 * z[j, 2], output['umatrix_out'][j, 2])
 
   def testArraylikeUmatrix(self):
     """
@@ -194,6 +263,7 @@ class TestPythonBinding(unittest.TestCase):
     Test a column vector input parameter.
     """
     x = np.random.rand(100)
+    z = copy.deepcopy(x)
 
     output = test_python_binding(string_in='hello',
                                  int_in=12,
@@ -204,13 +274,14 @@ class TestPythonBinding(unittest.TestCase):
     self.assertEqual(output['col_out'].dtype, np.double)
 
     for i in range(100):
-      self.assertEqual(output['col_out'][i], x[i] * 2)
+      self.assertEqual(output['col_out'][i], z[i] * 2)
 
   def testUcol(self):
     """
     Test an unsigned column vector input parameter.
     """
     x = np.random.randint(0, high=500, size=100)
+    z = copy.deepcopy(x)
 
     output = test_python_binding(string_in='hello',
                                  int_in=12,
@@ -220,13 +291,14 @@ class TestPythonBinding(unittest.TestCase):
     self.assertEqual(output['ucol_out'].shape[0], 100)
     self.assertEqual(output['ucol_out'].dtype, np.long)
     for i in range(100):
-      self.assertEqual(output['ucol_out'][i], x[i] * 2)
+      self.assertEqual(output['ucol_out'][i], z[i] * 2)
 
   def testRow(self):
     """
     Test a row vector input parameter.
     """
     x = np.random.rand(100)
+    z = copy.deepcopy(x)
 
     output = test_python_binding(string_in='hello',
                                  int_in=12,
@@ -237,13 +309,14 @@ class TestPythonBinding(unittest.TestCase):
     self.assertEqual(output['row_out'].dtype, np.double)
 
     for i in range(100):
-      self.assertEqual(output['row_out'][i], x[i] * 2)
+      self.assertEqual(output['row_out'][i], z[i] * 2)
 
   def testUrow(self):
     """
     Test an unsigned row vector input parameter.
     """
     x = np.random.randint(0, high=500, size=100)
+    z = copy.deepcopy(x)
 
     output = test_python_binding(string_in='hello',
                                  int_in=12,
@@ -254,13 +327,14 @@ class TestPythonBinding(unittest.TestCase):
     self.assertEqual(output['urow_out'].dtype, np.long)
 
     for i in range(100):
-      self.assertEqual(output['urow_out'][i], x[i] * 2)
+      self.assertEqual(output['urow_out'][i], z[i] * 2)
 
   def testMatrixAndInfoNumpy(self):
     """
     Test that we can pass a matrix with all numeric features.
     """
     x = np.random.rand(100, 10)
+    z = copy.deepcopy(x)
 
     output = test_python_binding(string_in='hello',
                                  int_in=12,
@@ -272,7 +346,7 @@ class TestPythonBinding(unittest.TestCase):
 
     for i in range(10):
       for j in range(100):
-        self.assertEqual(output['matrix_and_info_out'][j, i], x[j, i] * 2.0)
+        self.assertEqual(output['matrix_and_info_out'][j, i], z[j, i] * 2.0)
 
   def testMatrixAndInfoPandas(self):
     """
@@ -345,5 +419,73 @@ class TestPythonBinding(unittest.TestCase):
 
     self.assertEqual(output2['model_bw_out'], 20.0)
 
+  def testModelReuse(self):
+    """
+    Make sure that a model can be used for more than one call.
+    """
+    output = test_python_binding(string_in='hello',
+                                 int_in=12,
+                                 double_in=4.0,
+                                 build_model=True)
+
+    for i in range(3):
+      output2 = test_python_binding(string_in='hello',
+                                    int_in=12,
+                                    double_in=4.0,
+                                    model_in=output['model_out'])
+
+      self.assertEqual(output2['model_bw_out'], 20.0)
+
+  def testModelPickle(self):
+    """
+    Pickle a model and load it again, then make sure we get the right double
+    value.
+    """
+    output = test_python_binding(string_in='hello',
+                                 int_in=12,
+                                 double_in=4.0,
+                                 build_model=True)
+
+    model = pickle.loads(pickle.dumps(output['model_out']))
+
+    output2 = test_python_binding(string_in='hello',
+                                  int_in=12,
+                                  double_in=4.0,
+                                  model_in=model)
+
+    self.assertEqual(output2['model_bw_out'], 20.0)
+
+  def testConcurrentCalls(self):
+    """
+    Run the binding from several threads at once, with different inputs, and
+    make sure each call gets its own outputs.
+    """
+    results = [None] * 8
+
+    def run(i):
+      x = np.random.rand(100, 5) + i
+      output = test_python_binding(string_in='hello',
+                                   int_in=12,
+                                   double_in=4.0,
+                                   matrix_in=x,
+                                   copy_all_inputs=True)
+      results[i] = (x, output['matrix_out'])
+
+    threads = [threading.Thread(target=run, args=(i,)) for i in range(8)]
+    for t in threads:
+      t.start()
+    for t in threads:
+      t.join()
+
+    for i in range(8):
+      x, y = results[i]
+      self.assertEqual(y.shape[0], 100)
+      self.assertEqual(y.shape[1], 4)
+      for j in [0, 1, 3]:
+        for k in range(100):
+          self.assertEqual(y[k, j], x[k, j])
+      for k in range(100):
+        self.assertEqual(y[k, 2], x[k, 2] * 2)
+
 if __name__ == '__main__':
   unittest.main()
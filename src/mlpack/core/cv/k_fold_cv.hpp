@@ -153,7 +153,8 @@ class KFoldCV
           const WeightsType& weights);
 
   /**
-   * Run k-fold cross-validation.
+   * Run k-fold cross-validation.  The folds are trained and evaluated one after
+   * another, unless Parallel() is set.
    *
    * @param args Arguments for MLAlgorithm (in addition to the passed
    *     ones in the constructor).
@@ -164,6 +165,27 @@ class KFoldCV
   //! Access and modify a model from the last run of k-fold cross-validation.
   MLAlgorithm& Model();
 
+  //! Get the fraction of each training subset used for training.
+  double TrainingFraction() const { return trainingFraction; }
+  //! Modify the fraction of each training subset used for training (between
+  //! 0 and 1).  Only the first points of each training subset are used; the
+  //! validation subsets are unchanged.  This is used by budget-aware
+  //! hyper-parameter search, like SuccessiveHalving.
+  double& TrainingFraction() { return trainingFraction; }
+
+  //! Get whether the folds are trained and evaluated in parallel.
+  bool Parallel() const { return parallel; }
+  /**
+   * Modify whether the folds are trained and evaluated in parallel (with
+   * OpenMP).  Each fold gets its own seed, drawn from the global random number
+   * generators before the folds are run, so the results do not depend on the
+   * order the folds run in.  In parallel, each fold only seeds Armadillo's
+   * random number generator, which is local to each thread; so models that
+   * draw from math::Random() or math::RandInt() (like RandomForest) should not
+   * be cross-validated in parallel, since those share one generator.
+   */
+  bool& Parallel() { return parallel; }
+
  private:
   //! A short alias for CVBase.
   using Base = CVBase<MLAlgorithm, MatType, PredictionsType, WeightsType>;
@@ -187,6 +209,12 @@ class KFoldCV
   //! The size of each training subset in terms of data points.
   size_t trainingSubsetSize;
 
+  //! The fraction of each training subset used for training.
+  double trainingFraction;
+
+  //! Whether the folds are trained and evaluated in parallel.
+  bool parallel;
+
   //! A pointer to a model from the last run of k-fold cross-validation.
   std::unique_ptr<MLAlgorithm> modelPtr;
 
@@ -217,21 +245,37 @@ class KFoldCV
   void InitKFoldCVMat(const DataType& source, DataType& destination);
 
   /**
-   * Train and run evaluation in the case of non-weighted learning.
+   * Train and run evaluation on each fold, and return the mean of the
+   * evaluations.  The folds are run in parallel if Parallel() is set.
+   */
+  template<typename... MLAlgorithmArgs>
+  double TrainAndEvaluate(const MLAlgorithmArgs& ...mlAlgorithmArgs);
+
+  /**
+   * Train on the ith training subset in the case of non-weighted learning.
    */
   template<typename...MLAlgorithmArgs,
            bool Enabled = !Base::MIE::SupportsWeights,
            typename = typename std::enable_if<Enabled>::type>
-  double TrainAndEvaluate(const MLAlgorithmArgs& ...mlAlgorithmArgs);
+  MLAlgorithm TrainFold(const size_t i,
+                        const MLAlgorithmArgs& ...mlAlgorithmArgs);
 
   /**
-   * Train and run evaluation in the case of supporting weighted learning.
+   * Train on the ith training subset in the case of supporting weighted
+   * learning.
    */
   template<typename...MLAlgorithmArgs,
            bool Enabled = Base::MIE::SupportsWeights,
            typename = typename std::enable_if<Enabled>::type,
            typename = void>
-  double TrainAndEvaluate(const MLAlgorithmArgs& ...mlAlgorithmArgs);
+  MLAlgorithm TrainFold(const size_t i,
+                        const MLAlgorithmArgs& ...mlAlgorithmArgs);
+
+  /**
+   * Calculate the number of points of each training subset that are used for
+   * training, according to the training fraction.
+   */
+  inline size_t NumberOfTrainingPoints() const;
 
   /**
    * Calculate the index of the first column of the ith validation subset.
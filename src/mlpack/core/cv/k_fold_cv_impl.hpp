@@ -127,7 +127,7 @@ KFoldCV<MLAlgorithm,
                               const size_t k,
                               const MatType& xs,
                               const PredictionsType& ys) :
-  base(std::move(base)), k(k)
+  base(std::move(base)), k(k), trainingFraction(1.0), parallel(false)
 {
   if (k < 2)
     throw std::invalid_argument("KFoldCV: k should not be less than 2");
@@ -171,6 +171,10 @@ double KFoldCV<MLAlgorithm,
                PredictionsType,
                WeightsType>::Evaluate(const MLAlgorithmArgs&... args)
 {
+  if (trainingFraction <= 0.0 || trainingFraction > 1.0)
+    throw std::invalid_argument("KFoldCV::Evaluate(): the training fraction "
+        "should be more than 0 and not more than 1");
+
   return TrainAndEvaluate(args...);
 }
 
@@ -217,23 +221,55 @@ template<typename MLAlgorithm,
          typename MatType,
          typename PredictionsType,
          typename WeightsType>
-template<typename... MLAlgorithmArgs, bool Enabled, typename>
+template<typename... MLAlgorithmArgs>
 double KFoldCV<MLAlgorithm,
-                Metric,
-                MatType,
-                PredictionsType,
-                WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
+               Metric,
+               MatType,
+               PredictionsType,
+               WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
 {
   arma::vec evaluations(k);
 
+  // Each fold is seeded separately, so that it draws the same random numbers
+  // whether the folds are run in parallel or not.
+  std::vector<size_t> seeds(k);
   for (size_t i = 0; i < k; ++i)
+    seeds[i] = (size_t) math::RandInt(std::numeric_limits<int>::max());
+
+  // The folds are independent, and the training and validation subsets are
+  // aliases of the extended data, so the folds can be run in parallel without
+  // copying any data.  An exception can't leave the parallel region, so the
+  // exception of each fold is stored and the first one is rethrown afterwards.
+  std::vector<std::exception_ptr> exceptions(k);
+
+  #pragma omp parallel for schedule(dynamic) if(parallel)
+  for (omp_size_t i = 0; i < (omp_size_t) k; ++i)
   {
-    MLAlgorithm&& model  = base.Train(GetTrainingSubset(xs, i),
-        GetTrainingSubset(ys, i), args...);
-    evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
-        GetValidationSubset(ys, i));
-    if (i == k - 1)
-      modelPtr.reset(new MLAlgorithm(std::move(model)));
+    try
+    {
+      // Armadillo's random number generator is local to each thread, but the
+      // others are not, so in parallel only Armadillo's is seeded.
+      if (parallel)
+        arma::arma_rng::set_seed(seeds[i]);
+      else
+        math::RandomSeed(seeds[i]);
+
+      MLAlgorithm&& model = TrainFold(i, args...);
+      evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
+          GetValidationSubset(ys, i));
+      if ((size_t) i == k - 1)
+        modelPtr.reset(new MLAlgorithm(std::move(model)));
+    }
+    catch (...)
+    {
+      exceptions[i] = std::current_exception();
+    }
+  }
+
+  for (size_t i = 0; i < k; ++i)
+  {
+    if (exceptions[i])
+      std::rethrow_exception(exceptions[i]);
   }
 
   return arma::mean(evaluations);
@@ -244,29 +280,51 @@ template<typename MLAlgorithm,
          typename MatType,
          typename PredictionsType,
          typename WeightsType>
-template<typename... MLAlgorithmArgs, bool Enabled, typename, typename>
-double KFoldCV<MLAlgorithm,
-                Metric,
-                MatType,
-                PredictionsType,
-                WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
+template<typename... MLAlgorithmArgs, bool Enabled, typename>
+MLAlgorithm KFoldCV<MLAlgorithm,
+                    Metric,
+                    MatType,
+                    PredictionsType,
+                    WeightsType>::TrainFold(const size_t i,
+                                            const MLAlgorithmArgs&... args)
 {
-  arma::vec evaluations(k);
+  return base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
+      args...);
+}
 
-  for (size_t i = 0; i < k; ++i)
-  {
-    MLAlgorithm&& model = (weights.n_elem > 0) ?
-        base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
-            GetTrainingSubset(weights, i), args...) :
-        base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
-            args...);
-    evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
-        GetValidationSubset(ys, i));
-    if (i == k - 1)
-      modelPtr.reset(new MLAlgorithm(std::move(model)));
-  }
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... MLAlgorithmArgs, bool Enabled, typename, typename>
+MLAlgorithm KFoldCV<MLAlgorithm,
+                    Metric,
+                    MatType,
+                    PredictionsType,
+                    WeightsType>::TrainFold(const size_t i,
+                                            const MLAlgorithmArgs&... args)
+{
+  return (weights.n_elem > 0) ?
+      base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
+          GetTrainingSubset(weights, i), args...) :
+      base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
+          args...);
+}
 
-  return arma::mean(evaluations);
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+size_t KFoldCV<MLAlgorithm,
+               Metric,
+               MatType,
+               PredictionsType,
+               WeightsType>::NumberOfTrainingPoints() const
+{
+  return std::max((size_t) 1,
+      (size_t) std::round(trainingFraction * trainingSubsetSize));
 }
 
 template<typename MLAlgorithm,
@@ -298,7 +356,7 @@ arma::Mat<ElementType> KFoldCV<MLAlgorithm,
     const size_t i)
 {
   return arma::Mat<ElementType>(m.colptr(binSize * i), m.n_rows,
-      trainingSubsetSize, false, true);
+      NumberOfTrainingPoints(), false, true);
 }
 
 template<typename MLAlgorithm,
@@ -315,8 +373,8 @@ arma::Row<ElementType> KFoldCV<MLAlgorithm,
     arma::Row<ElementType>& r,
     const size_t i)
 {
-  return arma::Row<ElementType>(r.colptr(binSize * i), trainingSubsetSize,
-      false, true);
+  return arma::Row<ElementType>(r.colptr(binSize * i),
+      NumberOfTrainingPoints(), false, true);
 }
 
 template<typename MLAlgorithm,
@@ -211,6 +211,14 @@ class SimpleCV
   //! Access and modify the last trained model.
   MLAlgorithm& Model();
 
+  //! Get the fraction of the training set used for training.
+  double TrainingFraction() const { return trainingFraction; }
+  //! Modify the fraction of the training set used for training (between 0 and
+  //! 1).  Only the first points of the training set are used; the validation
+  //! set is unchanged.  This is used by budget-aware hyper-parameter search,
+  //! like SuccessiveHalving.
+  double& TrainingFraction() { return trainingFraction; }
+
  private:
   //! A short alias for CVBase.
   using Base = CVBase<MLAlgorithm, MatType, PredictionsType, WeightsType>;
@@ -237,6 +245,9 @@ class SimpleCV
   //! The validation predictions.
   PredictionsType validationYs;
 
+  //! The fraction of the training set used for training.
+  double trainingFraction;
+
   //! The pointer to the last trained model.
   std::unique_ptr<MLAlgorithm> modelPtr;
 
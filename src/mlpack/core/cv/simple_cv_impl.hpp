@@ -143,7 +143,8 @@ SimpleCV<MLAlgorithm,
                                 PIT&& ys) :
     base(std::move(base)),
     xs(std::forward<MIT>(xs)),
-    ys(std::forward<PIT>(ys))
+    ys(std::forward<PIT>(ys)),
+    trainingFraction(1.0)
 {
   Base::AssertDataConsistency(this->xs, this->ys);
 
@@ -194,6 +195,10 @@ double SimpleCV<MLAlgorithm,
                 PredictionsType,
                 WeightsType>::Evaluate(const MLAlgorithmArgs&... args)
 {
+  if (trainingFraction <= 0.0 || trainingFraction > 1.0)
+    throw std::invalid_argument("SimpleCV::Evaluate(): the training fraction "
+        "should be more than 0 and not more than 1");
+
   return TrainAndEvaluate(args...);
 }
 
@@ -293,7 +298,10 @@ double SimpleCV<MLAlgorithm,
                 PredictionsType,
                 WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
 {
-  modelPtr.reset(new MLAlgorithm(base.Train(trainingXs, trainingYs, args...)));
+  const size_t lastCol = std::max((size_t) 1,
+      (size_t) std::round(trainingFraction * trainingXs.n_cols)) - 1;
+  modelPtr.reset(new MLAlgorithm(base.Train(GetSubset(trainingXs, 0, lastCol),
+      GetSubset(trainingYs, 0, lastCol), args...)));
 
   return Metric::Evaluate(*modelPtr, validationXs, validationYs);
 }
@@ -310,12 +318,15 @@ double SimpleCV<MLAlgorithm,
                 PredictionsType,
                 WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
 {
+  const size_t lastCol = std::max((size_t) 1,
+      (size_t) std::round(trainingFraction * trainingXs.n_cols)) - 1;
   if (trainingWeights.n_elem > 0)
-    modelPtr.reset(new MLAlgorithm(
-        base.Train(trainingXs, trainingYs, trainingWeights, args...)));
+    modelPtr.reset(new MLAlgorithm(base.Train(GetSubset(trainingXs, 0, lastCol),
+        GetSubset(trainingYs, 0, lastCol),
+        GetSubset(trainingWeights, 0, lastCol), args...)));
   else
-    modelPtr.reset(new MLAlgorithm(
-        base.Train(trainingXs, trainingYs, args...)));
+    modelPtr.reset(new MLAlgorithm(base.Train(GetSubset(trainingXs, 0, lastCol),
+        GetSubset(trainingYs, 0, lastCol), args...)));
 
   return Metric::Evaluate(*modelPtr, validationXs, validationYs);
 }
@@ -18,6 +18,7 @@
 #include <mlpack/prereqs.hpp>
 #include <unordered_map>
 
+#include "hash_map.hpp"
 #include "map_policies/increment_policy.hpp"
 
 namespace mlpack {
@@ -140,14 +141,12 @@ class DatasetMapper
   size_t Dimensionality() const;
 
   /**
-   * Serialize the dataset information.
+   * Serialize the dataset information.  The mappings are serialized as
+   * std::unordered_maps, so that the format does not depend on the containers
+   * that hold them.
    */
   template<typename Archive>
-  void Serialize(Archive& ar, const unsigned int /* version */)
-  {
-    ar & data::CreateNVP(types, "types");
-    ar & data::CreateNVP(maps, "maps");
-  }
+  void Serialize(Archive& ar, const unsigned int /* version */);
 
   //! Return the policy of the mapper.
   const PolicyType& Policy() const;
@@ -161,20 +160,25 @@ class DatasetMapper
   //! Types of each dimension.
   std::vector<Datatype> types;
 
-  // Forward mapping type.
-  using ForwardMapType = typename std::unordered_map<InputType, typename
-      PolicyType::MappedType>;
+  // Forward mapping type.  The mappings are held in open-addressing hash
+  // maps, since each token of a dataset that is loaded is looked up.
+  using ForwardMapType = HashMap<InputType, typename PolicyType::MappedType>;
 
   // Reverse mapping type.  Multiple inputs may map to a single output, hence
   // the need for std::vector.
-  using ReverseMapType = std::unordered_map<typename PolicyType::MappedType,
+  using ReverseMapType = HashMap<typename PolicyType::MappedType,
       std::vector<InputType>>;
 
   // Mappings from strings to integers.
   // Map entries will only exist for dimensions that are categorical.
   // MapType = map<dimension, pair<bimap<string, MappedType>, numMappings>>
-  using MapType = std::unordered_map<size_t, std::pair<ForwardMapType,
-      ReverseMapType>>;
+  using MapType = HashMap<size_t, std::pair<ForwardMapType, ReverseMapType>>;
+
+  // The type the mappings are serialized as.
+  using SerializedMapType = std::unordered_map<size_t, std::pair<
+      std::unordered_map<InputType, typename PolicyType::MappedType>,
+      std::unordered_map<typename PolicyType::MappedType,
+          std::vector<InputType>>>>;
 
   //! maps object stores string and numerical pairs.
   MapType maps;
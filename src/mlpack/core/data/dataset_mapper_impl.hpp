@@ -222,6 +222,44 @@ inline size_t DatasetMapper<PolicyType, InputType>::Dimensionality() const
   return types.size();
 }
 
+template<typename PolicyType, typename InputType>
+template<typename Archive>
+void DatasetMapper<PolicyType, InputType>::Serialize(
+    Archive& ar,
+    const unsigned int /* version */)
+{
+  ar & data::CreateNVP(types, "types");
+
+  SerializedMapType serializedMaps;
+  if (!Archive::is_loading::value)
+  {
+    for (typename MapType::const_iterator it = maps.begin(); it != maps.end();
+        ++it)
+    {
+      serializedMaps[it->first].first.insert(it->second.first.begin(),
+          it->second.first.end());
+      serializedMaps[it->first].second.insert(it->second.second.begin(),
+          it->second.second.end());
+    }
+  }
+
+  ar & data::CreateNVP(serializedMaps, "maps");
+
+  if (Archive::is_loading::value)
+  {
+    maps.clear();
+    typename SerializedMapType::const_iterator it;
+    for (it = serializedMaps.begin(); it != serializedMaps.end(); ++it)
+    {
+      std::pair<ForwardMapType, ReverseMapType>& map = maps[it->first];
+      map.first.reserve(it->second.first.size());
+      map.first.insert(it->second.first.begin(), it->second.first.end());
+      map.second.reserve(it->second.second.size());
+      map.second.insert(it->second.second.begin(), it->second.second.end());
+    }
+  }
+}
+
 template<typename PolicyType, typename InputType>
 inline const PolicyType& DatasetMapper<PolicyType, InputType>::Policy() const
 {
@@ -0,0 +1,255 @@
+/**
+ * @file hash_map.hpp
+ *
+ * An open-addressing hash map that stores its elements contiguously, used by
+ * DatasetMapper to hold its mappings.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_HASH_MAP_HPP
+#define MLPACK_CORE_DATA_HASH_MAP_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A hash map with open addressing (linear probing).  The elements are stored
+ * in one contiguous array, in the order they were inserted, and the hash table
+ * only holds indices into that array, together with the hash of each element.
+ * Compared to std::unordered_map, this means there is no allocation for each
+ * element, a lookup costs one hash computation and (usually) one cache miss,
+ * and iteration order is deterministic.  Elements cannot be erased.
+ *
+ * The interface is the subset of the std::unordered_map interface that is
+ * needed by the map policies of DatasetMapper, so that HashMap can be used in
+ * its place.  Like for std::vector (and unlike for std::unordered_map),
+ * inserting an element invalidates iterators and references to other elements.
+ *
+ * @tparam KeyType Type of keys.
+ * @tparam ValueType Type of mapped values.
+ * @tparam HashType Hash function for keys.
+ */
+template<typename KeyType,
+         typename ValueType,
+         typename HashType = std::hash<KeyType>>
+class HashMap
+{
+ public:
+  //! The type of the keys.
+  typedef KeyType key_type;
+  //! The type of the mapped values.
+  typedef ValueType mapped_type;
+  //! The type of the elements.
+  typedef std::pair<KeyType, ValueType> value_type;
+  //! Iterator over the elements, in insertion order.
+  typedef typename std::vector<value_type>::iterator iterator;
+  //! Const iterator over the elements, in insertion order.
+  typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+  //! Create an empty map.
+  HashMap() : shift(8 * sizeof(uint64_t) - minLogSlots)
+  {
+    slots.resize(size_t(1) << minLogSlots, emptySlot);
+  }
+
+  //! Get the number of elements.
+  size_t size() const { return elements.size(); }
+  //! Return whether the map is empty.
+  bool empty() const { return elements.empty(); }
+
+  //! Remove all elements.
+  void clear()
+  {
+    elements.clear();
+    hashes.clear();
+    shift = 8 * sizeof(uint64_t) - minLogSlots;
+    slots.assign(size_t(1) << minLogSlots, emptySlot);
+  }
+
+  //! Make room for the given number of elements, so that inserting them does
+  //! not cause the table to be rebuilt.
+  void reserve(const size_t n)
+  {
+    elements.reserve(n);
+    hashes.reserve(n);
+    size_t logSlots = 8 * sizeof(uint64_t) - shift;
+    while ((size_t(1) << logSlots) * maxLoadNumerator <
+        n * maxLoadDenominator)
+      ++logSlots;
+    if (logSlots != 8 * sizeof(uint64_t) - shift)
+      Rehash(logSlots);
+  }
+
+  //! Get an iterator to the first element.
+  iterator begin() { return elements.begin(); }
+  //! Get an iterator to the end of the elements.
+  iterator end() { return elements.end(); }
+  //! Get a const iterator to the first element.
+  const_iterator begin() const { return elements.begin(); }
+  //! Get a const iterator to the end of the elements.
+  const_iterator end() const { return elements.end(); }
+
+  //! Find the element with the given key, or return end() if there is none.
+  iterator find(const KeyType& key)
+  {
+    const size_t index = Find(key, HashType()(key));
+    return (index == emptySlot) ? end() : elements.begin() + index;
+  }
+
+  //! Find the element with the given key, or return end() if there is none.
+  const_iterator find(const KeyType& key) const
+  {
+    const size_t index = Find(key, HashType()(key));
+    return (index == emptySlot) ? end() : elements.begin() + index;
+  }
+
+  //! Return the number of elements with the given key (0 or 1).
+  size_t count(const KeyType& key) const
+  {
+    return (Find(key, HashType()(key)) == emptySlot) ? 0 : 1;
+  }
+
+  //! Get the value mapped to the given key; std::out_of_range is thrown if
+  //! there is none.
+  ValueType& at(const KeyType& key)
+  {
+    const size_t index = Find(key, HashType()(key));
+    if (index == emptySlot)
+      throw std::out_of_range("HashMap::at(): key not found");
+    return elements[index].second;
+  }
+
+  //! Get the value mapped to the given key; std::out_of_range is thrown if
+  //! there is none.
+  const ValueType& at(const KeyType& key) const
+  {
+    const size_t index = Find(key, HashType()(key));
+    if (index == emptySlot)
+      throw std::out_of_range("HashMap::at(): key not found");
+    return elements[index].second;
+  }
+
+  //! Get the value mapped to the given key, inserting a default-constructed
+  //! value if there is none.
+  ValueType& operator[](const KeyType& key)
+  {
+    const size_t index = Find(key, HashType()(key));
+    if (index != emptySlot)
+      return elements[index].second;
+
+    return insert(value_type(key, ValueType())).first->second;
+  }
+
+  /**
+   * Insert the given element, if there is no element with the same key yet.
+   * Return an iterator to the element with that key, and whether the element
+   * was inserted.
+   *
+   * @param value Element to insert.
+   */
+  std::pair<iterator, bool> insert(value_type value)
+  {
+    const size_t hash = HashType()(value.first);
+    size_t slot = Slot(hash);
+    while (slots[slot] != emptySlot)
+    {
+      const size_t index = slots[slot];
+      if (hashes[index] == hash && elements[index].first == value.first)
+        return std::make_pair(elements.begin() + index, false);
+      slot = (slot + 1) & (slots.size() - 1);
+    }
+
+    slots[slot] = elements.size();
+    elements.push_back(std::move(value));
+    hashes.push_back(hash);
+
+    // Keep the table at most 3/4 full.
+    if (elements.size() * maxLoadDenominator >
+        slots.size() * maxLoadNumerator)
+      Rehash(8 * sizeof(uint64_t) - shift + 1);
+
+    return std::make_pair(elements.end() - 1, true);
+  }
+
+  //! Insert each element of the given range whose key is not in the map yet.
+  template<typename InputIterator>
+  void insert(InputIterator first, InputIterator last)
+  {
+    for (; first != last; ++first)
+      insert(value_type(*first));
+  }
+
+ private:
+  //! Marker for empty slots (and for keys that are not found).
+  static const size_t emptySlot = size_t(-1);
+  //! The base-2 logarithm of the initial number of slots.
+  static const size_t minLogSlots = 3;
+  //! The maximum load of the table is maxLoadNumerator / maxLoadDenominator.
+  static const size_t maxLoadNumerator = 3;
+  static const size_t maxLoadDenominator = 4;
+
+  //! Get the first slot to probe for the given hash.  The hash is scrambled
+  //! (Fibonacci hashing), since std::hash is the identity for integers.
+  size_t Slot(const size_t hash) const
+  {
+    return (size_t) ((uint64_t(hash) * 11400714819323198485ull) >> shift);
+  }
+
+  //! Get the index of the element with the given key and hash, or emptySlot.
+  size_t Find(const KeyType& key, const size_t hash) const
+  {
+    size_t slot = Slot(hash);
+    while (slots[slot] != emptySlot)
+    {
+      const size_t index = slots[slot];
+      if (hashes[index] == hash && elements[index].first == key)
+        return index;
+      slot = (slot + 1) & (slots.size() - 1);
+    }
+
+    return emptySlot;
+  }
+
+  //! Rebuild the table with 2^logSlots slots.
+  void Rehash(const size_t logSlots)
+  {
+    shift = 8 * sizeof(uint64_t) - logSlots;
+    slots.assign(size_t(1) << logSlots, emptySlot);
+    for (size_t i = 0; i < elements.size(); ++i)
+    {
+      size_t slot = Slot(hashes[i]);
+      while (slots[slot] != emptySlot)
+        slot = (slot + 1) & (slots.size() - 1);
+      slots[slot] = i;
+    }
+  }
+
+  //! The elements, in insertion order.
+  std::vector<value_type> elements;
+  //! The hash of each element.
+  std::vector<size_t> hashes;
+  //! The hash table: the index of an element, or emptySlot.
+  std::vector<size_t> slots;
+  //! 64 minus the base-2 logarithm of the number of slots.
+  size_t shift;
+};
+
+// Definitions of the constants, in case they are bound to references.
+template<typename KeyType, typename ValueType, typename HashType>
+const size_t HashMap<KeyType, ValueType, HashType>::emptySlot;
+template<typename KeyType, typename ValueType, typename HashType>
+const size_t HashMap<KeyType, ValueType, HashType>::minLogSlots;
+template<typename KeyType, typename ValueType, typename HashType>
+const size_t HashMap<KeyType, ValueType, HashType>::maxLoadNumerator;
+template<typename KeyType, typename ValueType, typename HashType>
+const size_t HashMap<KeyType, ValueType, HashType>::maxLoadDenominator;
+
+} // namespace data
+} // namespace mlpack
+
+#endif
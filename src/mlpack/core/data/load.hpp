@@ -255,6 +255,76 @@ extern template bool Load<double, IncrementPolicy>(
  * @endcond
  */
 
+/**
+ * Load a sparse matrix from file, guessing the filetype from the extension.
+ * This will transpose the matrix at load time (unless the transpose parameter
+ * is set to false), so that each row in the file becomes a column of the
+ * matrix.  The matrix is filled directly from its nonzero elements; no dense
+ * intermediate is ever formed.
+ *
+ * The supported types of files are:
+ *
+ *  - Coordinate list (coord_ascii), denoted by .coo, .txt, or .tsv; each line
+ *    holds the row index, column index, and value of one nonzero element
+ *    (indices start at 0)
+ *  - Armadillo sparse binary (arma_binary), denoted by .bin
+ *  - libsvm/svmlight, denoted by .svm, .libsvm, or .svmlight; the indices
+ *    start at 1, and the labels are discarded (use the overload below to keep
+ *    them)
+ *  - Matrix Market coordinate format, denoted by .mtx
+ *
+ * The libsvm and Matrix Market files are read in chunks that are parsed in
+ * parallel; see LoadLibSVM() and LoadMatrixMarket() for details.
+ *
+ * If the file extension is not one of those types, an error will be given.
+ *
+ * If the parameter 'fatal' is set to true, a std::runtime_error exception will
+ * be thrown if the matrix does not load successfully.
+ *
+ * @param filename Name of file to load.
+ * @param matrix Sparse matrix to load contents of file into.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @param transpose If true, transpose the matrix after loading.
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename eT>
+bool Load(const std::string& filename,
+          arma::SpMat<eT>& matrix,
+          const bool fatal = false,
+          const bool transpose = true);
+
+/**
+ * Load a sparse matrix and the labels of its points from a libsvm/svmlight
+ * file (denoted by .svm, .libsvm, or .svmlight).  Each line of the file becomes
+ * a column of the matrix (unless the transpose parameter is set to false) and
+ * an element of the labels.  The file is read in chunks that are parsed in
+ * parallel, and the matrix is filled directly from its nonzero elements.
+ *
+ * Labels that are not nonnegative integers (like the -1/+1 labels of many
+ * libsvm files) can only be loaded into a floating-point row vector; use
+ * NormalizeLabels() to map them to 0, 1, ....
+ *
+ * The indices in the file must start at 1, as in libsvm.  To load a file with
+ * indices that start at 0, or to fix the dimensionality of the points, call
+ * LoadLibSVM() directly.
+ *
+ * If the parameter 'fatal' is set to true, a std::runtime_error exception will
+ * be thrown if the matrix does not load successfully.
+ *
+ * @param filename Name of file to load.
+ * @param matrix Sparse matrix to load the points into.
+ * @param labels Row vector to load the labels into.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @param transpose If true, each point is a column of the matrix.
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename eT, typename LabelType>
+bool Load(const std::string& filename,
+          arma::SpMat<eT>& matrix,
+          arma::Row<LabelType>& labels,
+          const bool fatal = false,
+          const bool transpose = true);
+
 /**
  * Load a model from a file, guessing the filetype from the extension, or,
  * optionally, loading the specified format.  If automatic extension detection
@@ -294,5 +364,7 @@ bool Load(const std::string& filename,
 #include "load_model_impl.hpp"
 // Include implementation of Load() for vectors.
 #include "load_vec_impl.hpp"
+// Include implementation of Load() for sparse matrices.
+#include "load_sparse_impl.hpp"
 
 #endif
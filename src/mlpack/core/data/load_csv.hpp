@@ -121,13 +121,14 @@ class LoadCSV
       // same idea...
       if (MapPolicy::NeedsFirstPass)
       {
-        // In this case we must pass everything we parse to the MapPolicy.
+        // In this case we must pass everything we parse to the MapPolicy.  The
+        // token buffer is reused, so that no string is allocated per token.
         auto firstPassMap = [&](const iter_type& iter)
         {
-          std::string str(iter.begin(), iter.end());
-          boost::trim(str);
+          token.assign(iter.begin(), iter.end());
+          boost::trim(token);
 
-          info.template MapFirstPass<T>(std::move(str), rows - 1);
+          info.template MapFirstPass<T>(token, rows - 1);
         };
 
         // Now parse the line.
@@ -191,10 +192,10 @@ class LoadCSV
         // In this case we must pass everything we parse to the MapPolicy.
         auto firstPassMap = [&](const iter_type& iter)
         {
-          std::string str(iter.begin(), iter.end());
-          boost::trim(str);
+          token.assign(iter.begin(), iter.end());
+          boost::trim(token);
 
-          info.template MapFirstPass<T>(std::move(str), dim++);
+          info.template MapFirstPass<T>(token, dim++);
         };
 
         // Now parse the line.
@@ -241,14 +242,14 @@ class LoadCSV
 
     auto setCharClass = [&](iter_type const &iter)
     {
-      std::string str(iter.begin(), iter.end());
-      if (str == "\t")
+      token.assign(iter.begin(), iter.end());
+      if (token == "\t")
       {
-        str.clear();
+        token.clear();
       }
-      boost::trim(str);
+      boost::trim(token);
 
-      inout(row, col++) = infoSet.template MapString<T>(std::move(str), row);
+      inout(row, col++) = infoSet.template MapString<T>(token, row);
     };
 
     while (std::getline(inFile, line))
@@ -315,10 +316,10 @@ class LoadCSV
     auto parseString = [&](iter_type const &iter)
     {
       // All parsed values must be mapped.
-      std::string str(iter.begin(), iter.end());
-      boost::trim(str);
+      token.assign(iter.begin(), iter.end());
+      boost::trim(token);
 
-      inout(row, col) = infoSet.template MapString<T>(std::move(str), row);
+      inout(row, col) = infoSet.template MapString<T>(token, row);
       ++row;
     };
 
@@ -362,6 +363,9 @@ class LoadCSV
   //! Spirit rule for delimiters (i.e. ',' for CSVs).
   boost::spirit::qi::rule<std::string::iterator, iter_type()> delimiterRule;
 
+  //! Buffer for the token being mapped, reused for each token.
+  std::string token;
+
   //! Extension (type) of file.
   std::string extension;
   //! Name of file.
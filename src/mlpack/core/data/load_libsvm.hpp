@@ -0,0 +1,86 @@
+/**
+ * @file load_libsvm.hpp
+ *
+ * Load sparse datasets in the libsvm/svmlight and Matrix Market formats.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LOAD_LIBSVM_HPP
+#define MLPACK_CORE_DATA_LOAD_LIBSVM_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A utility function to load a dataset in the libsvm/svmlight format into a
+ * sparse matrix and a vector of labels.  Each line of the file holds one
+ * point:
+ *
+ * @code
+ * <label> <index>:<value> <index>:<value> ... # optional comment
+ * @endcode
+ *
+ * svmlight "qid:" tokens are skipped.  As in libsvm, the indices start at 1
+ * unless zeroBased is true.  The matrix is built directly from its nonzero
+ * elements, and the file is read in chunks of lines which are parsed in
+ * parallel, so no dense intermediate is formed and the whole file is never
+ * held in memory.
+ *
+ * The dimensionality of the points is taken from the largest index in the
+ * file, unless it is given.  Give it when loading, e.g., a test set that must
+ * have the same dimensionality as the training set, since the last features
+ * may not appear in every file.
+ *
+ * Because the labels in libsvm files are often -1 and +1, or regression
+ * targets, an exception is thrown if a negative or fractional label is loaded
+ * into an integer label type.  In that case, load the labels into an
+ * arma::rowvec and use NormalizeLabels().  An exception is also thrown if the
+ * file cannot be parsed, if it holds an index of 0 and zeroBased is false, or
+ * if it holds an index beyond the given dimensionality.
+ *
+ * @param filename Name of libsvm file to load.
+ * @param matrix Sparse matrix to load the points into.
+ * @param labels Row vector to load the labels into.
+ * @param transpose If true, each point is a column of the matrix; otherwise,
+ *     each point is a row.
+ * @param zeroBased If true, the indices in the file start at 0 instead of 1.
+ * @param dimensionality Dimensionality of the points, or 0 to take it from the
+ *     largest index in the file.
+ */
+template<typename eT, typename LabelType>
+void LoadLibSVM(const std::string& filename,
+                arma::SpMat<eT>& matrix,
+                arma::Row<LabelType>& labels,
+                const bool transpose = true,
+                const bool zeroBased = false,
+                const size_t dimensionality = 0);
+
+/**
+ * A utility function to load a sparse matrix in the Matrix Market coordinate
+ * format.  Real, integer and pattern fields are supported, with general,
+ * symmetric and skew-symmetric storage.  Like LoadLibSVM(), the entries are
+ * parsed in parallel chunks and the matrix is built directly from them.  An
+ * exception will be thrown upon failure.
+ *
+ * @param filename Name of Matrix Market file to load.
+ * @param matrix Sparse matrix to load data into.
+ * @param transpose If true, each row of the stored matrix becomes a column of
+ *     the loaded matrix.
+ */
+template<typename eT>
+void LoadMatrixMarket(const std::string& filename,
+                      arma::SpMat<eT>& matrix,
+                      const bool transpose = true);
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "load_libsvm_impl.hpp"
+
+#endif
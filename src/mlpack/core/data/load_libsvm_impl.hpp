@@ -0,0 +1,512 @@
+/**
+ * @file load_libsvm_impl.hpp
+ *
+ * Implementation of the libsvm/svmlight and Matrix Market loaders.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LOAD_LIBSVM_IMPL_HPP
+#define MLPACK_CORE_DATA_LOAD_LIBSVM_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "load_libsvm.hpp"
+
+namespace mlpack {
+namespace data {
+namespace details {
+
+//! The number of lines read from the file before they are parsed.
+const size_t sparseChunkLines = 65536;
+//! The number of lines parsed by each parallel task.
+const size_t sparseBlockLines = 1024;
+//! The number of parallel tasks for each chunk.
+const size_t sparseChunkBlocks = sparseChunkLines / sparseBlockLines;
+
+/**
+ * Read up to lines.size() lines from the stream into the given vector, reusing
+ * the memory of the strings.  Returns the number of lines that were read.
+ */
+inline size_t ReadLines(std::istream& stream, std::vector<std::string>& lines)
+{
+  size_t count = 0;
+  while (count < lines.size() && std::getline(stream, lines[count]))
+    ++count;
+
+  return count;
+}
+
+//! Skip spaces and tabs.
+inline const char* SkipWhitespace(const char* p, const char* end)
+{
+  while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+    ++p;
+
+  return p;
+}
+
+/**
+ * Parse one line of a libsvm file, appending the indices and values of its
+ * nonzero elements to the given vectors.  Returns false if the line holds no
+ * point (it is empty or a comment), or if it is malformed, in which case
+ * 'malformed' is set to true.
+ */
+template<typename eT>
+bool ParseLibSVMLine(const std::string& line,
+                     double& label,
+                     std::vector<size_t>& indices,
+                     std::vector<eT>& values,
+                     bool& malformed)
+{
+  const char* p = line.c_str();
+  const size_t comment = line.find('#');
+  const char* end = p + ((comment == std::string::npos) ? line.size() :
+      comment);
+
+  p = SkipWhitespace(p, end);
+  if (p == end)
+    return false;
+
+  char* next;
+  label = std::strtod(p, &next);
+  if (next == p)
+  {
+    malformed = true;
+    return false;
+  }
+
+  p = SkipWhitespace(next, end);
+  while (p < end)
+  {
+    // svmlight query ids are not features.
+    if (end - p > 4 && std::strncmp(p, "qid:", 4) == 0)
+    {
+      while (p < end && *p != ' ' && *p != '\t')
+        ++p;
+      p = SkipWhitespace(p, end);
+      continue;
+    }
+
+    if (*p < '0' || *p > '9')
+    {
+      malformed = true;
+      return false;
+    }
+
+    const size_t index = std::strtoull(p, &next, 10);
+    if (*next != ':')
+    {
+      malformed = true;
+      return false;
+    }
+
+    p = next + 1;
+    const double value = std::strtod(p, &next);
+    if (next == p)
+    {
+      malformed = true;
+      return false;
+    }
+
+    // Explicit zeros are allowed, but they are not stored.
+    if (value != 0.0)
+    {
+      indices.push_back(index);
+      values.push_back(eT(value));
+    }
+
+    p = SkipWhitespace(next, end);
+  }
+
+  return true;
+}
+
+/**
+ * Parse one entry line of a Matrix Market coordinate file, returning its
+ * 1-based row and column and its value.  Returns false if the line holds no
+ * entry, or if it is malformed, in which case 'malformed' is set to true.
+ */
+inline bool ParseMatrixMarketLine(const std::string& line,
+                                  const bool pattern,
+                                  size_t& row,
+                                  size_t& col,
+                                  double& value,
+                                  bool& malformed)
+{
+  const char* p = line.c_str();
+  const char* end = p + line.size();
+  p = SkipWhitespace(p, end);
+  if (p == end || *p == '%')
+    return false;
+
+  char* next;
+  row = std::strtoull(p, &next, 10);
+  if (next == p)
+  {
+    malformed = true;
+    return false;
+  }
+
+  p = next;
+  col = std::strtoull(p, &next, 10);
+  if (next == p)
+  {
+    malformed = true;
+    return false;
+  }
+
+  if (pattern)
+  {
+    value = 1.0;
+    return true;
+  }
+
+  p = next;
+  value = std::strtod(p, &next);
+  if (next == p)
+  {
+    malformed = true;
+    return false;
+  }
+
+  return true;
+}
+
+} // namespace details
+
+template<typename eT, typename LabelType>
+void LoadLibSVM(const std::string& filename,
+                arma::SpMat<eT>& matrix,
+                arma::Row<LabelType>& labels,
+                const bool transpose,
+                const bool zeroBased,
+                const size_t dimensionality)
+{
+  std::ifstream stream(filename);
+  if (!stream.is_open())
+    throw std::runtime_error("Cannot open file '" + filename + "'.");
+
+  // The nonzero elements of the matrix, as (dimension, point) pairs, and their
+  // values, along with the label of every point.
+  std::vector<arma::uword> locations;
+  std::vector<eT> values;
+  std::vector<double> allLabels;
+  size_t minIndex = std::numeric_limits<size_t>::max();
+  size_t maxIndex = 0;
+
+  // What each parallel task found in its block of lines: the label and the
+  // number of nonzero elements of each point, the indices and values of the
+  // nonzero elements, and the first malformed line (if any, plus one).
+  std::vector<std::string> lines(details::sparseChunkLines);
+  std::vector<std::vector<double>> blockLabels(details::sparseChunkBlocks);
+  std::vector<std::vector<size_t>> blockCounts(details::sparseChunkBlocks);
+  std::vector<std::vector<size_t>> blockIndices(details::sparseChunkBlocks);
+  std::vector<std::vector<eT>> blockValues(details::sparseChunkBlocks);
+  std::vector<size_t> blockErrors(details::sparseChunkBlocks);
+
+  size_t linesRead = 0;
+  size_t numLines;
+  while ((numLines = details::ReadLines(stream, lines)) > 0)
+  {
+    const size_t numBlocks = (numLines + details::sparseBlockLines - 1) /
+        details::sparseBlockLines;
+
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+    {
+      blockLabels[b].clear();
+      blockCounts[b].clear();
+      blockIndices[b].clear();
+      blockValues[b].clear();
+      blockErrors[b] = 0;
+
+      const size_t end = std::min(numLines, (b + 1) *
+          details::sparseBlockLines);
+      for (size_t i = b * details::sparseBlockLines; i < end; ++i)
+      {
+        const size_t nonzeros = blockIndices[b].size();
+        double label;
+        bool malformed = false;
+        if (details::ParseLibSVMLine(lines[i], label, blockIndices[b],
+            blockValues[b], malformed))
+        {
+          blockLabels[b].push_back(label);
+          blockCounts[b].push_back(blockIndices[b].size() - nonzeros);
+        }
+        else if (malformed)
+        {
+          blockErrors[b] = i + 1;
+          break;
+        }
+      }
+    }
+
+    // Now collect the points of each block, in order.
+    for (size_t b = 0; b < numBlocks; ++b)
+    {
+      if (blockErrors[b] != 0)
+      {
+        std::ostringstream oss;
+        oss << "Error parsing line " << (linesRead + blockErrors[b]) << " of '"
+            << filename << "'.";
+        throw std::runtime_error(oss.str());
+      }
+
+      size_t k = 0;
+      for (size_t i = 0; i < blockLabels[b].size(); ++i)
+      {
+        const size_t point = allLabels.size();
+        allLabels.push_back(blockLabels[b][i]);
+        for (size_t j = 0; j < blockCounts[b][i]; ++j, ++k)
+        {
+          const size_t index = blockIndices[b][k];
+          minIndex = std::min(minIndex, index);
+          maxIndex = std::max(maxIndex, index);
+
+          locations.push_back(index);
+          locations.push_back(point);
+          values.push_back(blockValues[b][k]);
+        }
+      }
+    }
+
+    linesRead += numLines;
+  }
+
+  const size_t indexOffset = zeroBased ? 0 : 1;
+  if (!values.empty() && minIndex < indexOffset)
+  {
+    throw std::runtime_error("'" + filename + "' holds a feature index of 0, "
+        "but libsvm indices start at 1; load it with zeroBased = true.");
+  }
+
+  const size_t fileDimensionality = values.empty() ? 0 :
+      maxIndex + 1 - indexOffset;
+  if (dimensionality != 0 && fileDimensionality > dimensionality)
+  {
+    std::ostringstream oss;
+    oss << "'" << filename << "' holds points of dimensionality "
+        << fileDimensionality << ", but the dimensionality was given as "
+        << dimensionality << ".";
+    throw std::runtime_error(oss.str());
+  }
+  const size_t numDimensions = (dimensionality != 0) ? dimensionality :
+      fileDimensionality;
+
+  for (size_t i = 0; i < locations.size(); i += 2)
+  {
+    locations[i] -= indexOffset;
+    if (!transpose)
+      std::swap(locations[i], locations[i + 1]);
+  }
+
+  // Build the matrix directly from the nonzero elements, without copying them.
+  const arma::umat locationMat(locations.data(), 2, values.size(), false,
+      true);
+  const arma::Col<eT> valueVec(values.data(), values.size(), false, true);
+  if (transpose)
+  {
+    matrix = arma::SpMat<eT>(locationMat, valueVec, numDimensions,
+        allLabels.size());
+  }
+  else
+  {
+    matrix = arma::SpMat<eT>(locationMat, valueVec, allLabels.size(),
+        numDimensions);
+  }
+
+  labels.set_size(allLabels.size());
+  for (size_t i = 0; i < allLabels.size(); ++i)
+  {
+    if (std::is_integral<LabelType>::value &&
+        ((allLabels[i] != std::floor(allLabels[i])) ||
+         (std::is_unsigned<LabelType>::value && allLabels[i] < 0.0)))
+    {
+      std::ostringstream oss;
+      oss << "Label " << allLabels[i] << " of point " << i << " in '"
+          << filename << "' cannot be represented by the label type; load the "
+          << "labels into an arma::rowvec instead.";
+      throw std::runtime_error(oss.str());
+    }
+
+    labels[i] = (LabelType) allLabels[i];
+  }
+}
+
+template<typename eT>
+void LoadMatrixMarket(const std::string& filename,
+                      arma::SpMat<eT>& matrix,
+                      const bool transpose)
+{
+  std::ifstream stream(filename);
+  if (!stream.is_open())
+    throw std::runtime_error("Cannot open file '" + filename + "'.");
+
+  // The banner is '%%MatrixMarket matrix coordinate <field> <symmetry>'.
+  std::string line;
+  std::getline(stream, line);
+  std::transform(line.begin(), line.end(), line.begin(), ::tolower);
+  std::istringstream banner(line);
+  std::string header, object, format, field, symmetry;
+  banner >> header >> object >> format >> field >> symmetry;
+  if (header != "%%matrixmarket" || object != "matrix")
+  {
+    throw std::runtime_error("'" + filename + "' is not a Matrix Market "
+        "file.");
+  }
+  if (format != "coordinate")
+  {
+    throw std::runtime_error("'" + filename + "' is not a sparse (coordinate) "
+        "Matrix Market file; load it into a dense matrix instead.");
+  }
+  if (field != "real" && field != "double" && field != "integer" &&
+      field != "pattern")
+  {
+    throw std::runtime_error("Matrix Market field type '" + field + "' of '" +
+        filename + "' is not supported.");
+  }
+  if (symmetry != "general" && symmetry != "symmetric" &&
+      symmetry != "skew-symmetric")
+  {
+    throw std::runtime_error("Matrix Market symmetry type '" + symmetry +
+        "' of '" + filename + "' is not supported.");
+  }
+
+  const bool pattern = (field == "pattern");
+  const bool symmetric = (symmetry != "general");
+  const double mirrorSign = (symmetry == "skew-symmetric") ? -1.0 : 1.0;
+
+  // Skip comments until the size line.
+  size_t linesRead = 1;
+  size_t nRows = 0, nCols = 0, nnz = 0;
+  while (std::getline(stream, line))
+  {
+    ++linesRead;
+    const size_t start = line.find_first_not_of(" \t\r");
+    if (start == std::string::npos || line[start] == '%')
+      continue;
+
+    std::istringstream sizes(line);
+    if (!(sizes >> nRows >> nCols >> nnz))
+    {
+      throw std::runtime_error("Error parsing the size line of '" + filename +
+          "'.");
+    }
+    break;
+  }
+
+  // The nonzero elements, as (row, column) pairs, and their values.
+  std::vector<arma::uword> locations;
+  std::vector<eT> values;
+  locations.reserve(2 * nnz);
+  values.reserve(nnz);
+  size_t entries = 0;
+
+  std::vector<std::string> lines(details::sparseChunkLines);
+  std::vector<std::vector<arma::uword>> blockLocations(
+      details::sparseChunkBlocks);
+  std::vector<std::vector<eT>> blockValues(details::sparseChunkBlocks);
+  std::vector<size_t> blockEntries(details::sparseChunkBlocks);
+  std::vector<size_t> blockErrors(details::sparseChunkBlocks);
+
+  size_t numLines;
+  while ((numLines = details::ReadLines(stream, lines)) > 0)
+  {
+    const size_t numBlocks = (numLines + details::sparseBlockLines - 1) /
+        details::sparseBlockLines;
+
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+    {
+      blockLocations[b].clear();
+      blockValues[b].clear();
+      blockEntries[b] = 0;
+      blockErrors[b] = 0;
+
+      const size_t end = std::min(numLines, (b + 1) *
+          details::sparseBlockLines);
+      for (size_t i = b * details::sparseBlockLines; i < end; ++i)
+      {
+        size_t row, col;
+        double value;
+        bool malformed = false;
+        if (details::ParseMatrixMarketLine(lines[i], pattern, row, col, value,
+            malformed))
+        {
+          if (row == 0 || row > nRows || col == 0 || col > nCols)
+          {
+            blockErrors[b] = i + 1;
+            break;
+          }
+
+          ++blockEntries[b];
+          if (value == 0.0)
+            continue;
+
+          blockLocations[b].push_back(row - 1);
+          blockLocations[b].push_back(col - 1);
+          blockValues[b].push_back(eT(value));
+
+          // Only one triangle of a symmetric matrix is stored.
+          if (symmetric && row != col)
+          {
+            blockLocations[b].push_back(col - 1);
+            blockLocations[b].push_back(row - 1);
+            blockValues[b].push_back(eT(mirrorSign * value));
+          }
+        }
+        else if (malformed)
+        {
+          blockErrors[b] = i + 1;
+          break;
+        }
+      }
+    }
+
+    for (size_t b = 0; b < numBlocks; ++b)
+    {
+      if (blockErrors[b] != 0)
+      {
+        std::ostringstream oss;
+        oss << "Error parsing line " << (linesRead + blockErrors[b]) << " of '"
+            << filename << "'.";
+        throw std::runtime_error(oss.str());
+      }
+
+      locations.insert(locations.end(), blockLocations[b].begin(),
+          blockLocations[b].end());
+      values.insert(values.end(), blockValues[b].begin(),
+          blockValues[b].end());
+      entries += blockEntries[b];
+    }
+
+    linesRead += numLines;
+  }
+
+  if (entries != nnz)
+  {
+    std::ostringstream oss;
+    oss << "'" << filename << "' should hold " << nnz << " entries, but "
+        << entries << " were found.";
+    throw std::runtime_error(oss.str());
+  }
+
+  if (transpose)
+  {
+    for (size_t i = 0; i < locations.size(); i += 2)
+      std::swap(locations[i], locations[i + 1]);
+  }
+
+  const arma::umat locationMat(locations.data(), 2, values.size(), false,
+      true);
+  const arma::Col<eT> valueVec(values.data(), values.size(), false, true);
+  matrix = arma::SpMat<eT>(locationMat, valueVec, transpose ? nCols : nRows,
+      transpose ? nRows : nCols);
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
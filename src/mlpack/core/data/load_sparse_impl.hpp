@@ -0,0 +1,201 @@
+/**
+ * @file load_sparse_impl.hpp
+ *
+ * Implementation of the Load() overload for sparse matrices.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LOAD_SPARSE_IMPL_HPP
+#define MLPACK_CORE_DATA_LOAD_SPARSE_IMPL_HPP
+
+// In case it hasn't already been included.
+#include "load.hpp"
+#include "extension.hpp"
+#include "load_libsvm.hpp"
+
+#include <mlpack/core/util/timers.hpp>
+
+namespace mlpack {
+namespace data {
+
+// Load sparse matrix.
+template<typename eT>
+bool Load(const std::string& filename,
+          arma::SpMat<eT>& matrix,
+          const bool fatal,
+          const bool transpose)
+{
+  Timer::Start("loading_data");
+
+  // Get the extension.
+  const std::string extension = Extension(filename);
+
+  // Catch nonexistent files by opening the stream ourselves.
+  std::fstream stream;
+#ifdef  _WIN32 // Always open in binary mode on Windows.
+  stream.open(filename.c_str(), std::fstream::in | std::fstream::binary);
+#else
+  stream.open(filename.c_str(), std::fstream::in);
+#endif
+  if (!stream.is_open())
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Cannot open file '" << filename << "'. " << std::endl;
+    else
+      Log::Warn << "Cannot open file '" << filename << "'; load failed."
+          << std::endl;
+
+    return false;
+  }
+
+  // The libsvm and Matrix Market formats have their own parsers.
+  if (extension == "svm" || extension == "libsvm" || extension == "svmlight" ||
+      extension == "mtx")
+  {
+    stream.close();
+
+    const bool libsvm = (extension != "mtx");
+    Log::Info << "Loading '" << filename << "' as "
+        << (libsvm ? "libsvm" : "Matrix Market") << " data.  " << std::flush;
+    try
+    {
+      if (libsvm)
+      {
+        // The labels are not needed here.
+        arma::rowvec labels;
+        LoadLibSVM(filename, matrix, labels, transpose);
+      }
+      else
+      {
+        LoadMatrixMarket(filename, matrix, transpose);
+      }
+    }
+    catch (std::exception& e)
+    {
+      Log::Info << std::endl;
+      Timer::Stop("loading_data");
+      if (fatal)
+        Log::Fatal << e.what() << std::endl;
+      else
+        Log::Warn << e.what() << std::endl;
+
+      return false;
+    }
+
+    Log::Info << "Size is " << matrix.n_rows << " x " << matrix.n_cols
+        << " with " << matrix.n_nonzero << " nonzero elements.\n";
+    Timer::Stop("loading_data");
+
+    return true;
+  }
+
+  arma::file_type loadType;
+  std::string stringType;
+  if (extension == "coo" || extension == "txt" || extension == "tsv")
+  {
+    loadType = arma::coord_ascii;
+    stringType = "coordinate list data";
+  }
+  else if (extension == "bin")
+  {
+    loadType = arma::arma_binary;
+    stringType = "Armadillo sparse binary formatted data";
+  }
+  else
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Unable to detect type of '" << filename << "'; "
+          << "incorrect extension?" << std::endl;
+    else
+      Log::Warn << "Unable to detect type of '" << filename << "'; load failed."
+          << " Incorrect extension?" << std::endl;
+
+    return false;
+  }
+
+  Log::Info << "Loading '" << filename << "' as " << stringType << ".  "
+      << std::flush;
+
+  const bool success = matrix.load(stream, loadType);
+  if (!success)
+  {
+    Log::Info << std::endl;
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Loading from '" << filename << "' failed." << std::endl;
+    else
+      Log::Warn << "Loading from '" << filename << "' failed." << std::endl;
+
+    return false;
+  }
+
+  Log::Info << "Size is " << (transpose ? matrix.n_cols : matrix.n_rows)
+      << " x " << (transpose ? matrix.n_rows : matrix.n_cols) << " with "
+      << matrix.n_nonzero << " nonzero elements.\n";
+
+  // Transposing a sparse matrix only touches its nonzero elements.
+  if (transpose)
+    matrix = arma::trans(matrix);
+
+  Timer::Stop("loading_data");
+
+  return true;
+}
+
+// Load sparse matrix and labels.
+template<typename eT, typename LabelType>
+bool Load(const std::string& filename,
+          arma::SpMat<eT>& matrix,
+          arma::Row<LabelType>& labels,
+          const bool fatal,
+          const bool transpose)
+{
+  Timer::Start("loading_data");
+
+  const std::string extension = Extension(filename);
+  if (extension != "svm" && extension != "libsvm" && extension != "svmlight")
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Unable to load labels from '" << filename << "'; only "
+          << "libsvm files hold labels.  Incorrect extension?" << std::endl;
+    else
+      Log::Warn << "Unable to load labels from '" << filename << "'; only "
+          << "libsvm files hold labels.  Incorrect extension?" << std::endl;
+
+    return false;
+  }
+
+  Log::Info << "Loading '" << filename << "' as libsvm data.  " << std::flush;
+  try
+  {
+    LoadLibSVM(filename, matrix, labels, transpose);
+  }
+  catch (std::exception& e)
+  {
+    Log::Info << std::endl;
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << e.what() << std::endl;
+    else
+      Log::Warn << e.what() << std::endl;
+
+    return false;
+  }
+
+  Log::Info << "Size is " << matrix.n_rows << " x " << matrix.n_cols
+      << " with " << matrix.n_nonzero << " nonzero elements.\n";
+  Timer::Stop("loading_data");
+
+  return true;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -72,7 +72,7 @@ class MissingPolicy
    * dimension. This function is used as a helper function for DatasetMapper
    * class.
    *
-   * @tparam MapType Type of unordered_map that contains mapped value pairs
+   * @tparam MapType Type of map (e.g. HashMap) that contains mapped value pairs
    * @param string String to find/create mapping for.
    * @param dimension Index of the dimension of the string.
    * @param maps Unordered map given by the DatasetMapper.
@@ -106,21 +106,15 @@ class MissingPolicy
     {
       // Everything is mapped to NaN.  However we must still keep track of
       // everything that we have mapped, so we add it to the maps if needed.
-      if (maps.count(dimension) == 0 ||
-          maps[dimension].first.count(string) == 0)
+      auto& dimensionMaps = maps[dimension];
+      if (dimensionMaps.first.count(string) == 0)
       {
         // This string does not exist yet.
         typedef std::pair<std::string, MappedType> PairType;
-        maps[dimension].first.insert(PairType(string, value));
+        dimensionMaps.first.insert(PairType(string, value));
 
         // Insert right mapping too.
-        if (maps[dimension].second.count(mapValue) == 0)
-        {
-          // Create new element in reverse map.
-          maps[dimension].second.insert(std::make_pair(mapValue,
-              std::vector<std::string>()));
-        }
-        maps[dimension].second[mapValue].push_back(string);
+        dimensionMaps.second[mapValue].push_back(string);
       }
 
       return value;
@@ -168,6 +168,60 @@ class DiscreteDistribution
     return log(Probability(observation));
   }
 
+  /**
+   * Calculate the probability of each observation (column) in the given
+   * matrix.  This is equivalent to calling Probability() on each column, but
+   * the dimension check is only performed once.
+   *
+   * @param x List of observations.
+   * @param probabilities Output probabilities for each input observation.
+   */
+  void Probability(const arma::mat& x, arma::vec& probabilities) const
+  {
+    // Ensure the observations have the same dimension with the probabilities.
+    if (x.n_rows != this->probabilities.size())
+    {
+      Log::Fatal << "DiscreteDistribution::Probability(): observations have "
+          << "incorrect dimension " << x.n_rows << " but should have "
+          << "dimension " << this->probabilities.size() << "!" << std::endl;
+    }
+
+    probabilities.ones(x.n_cols);
+    for (size_t i = 0; i < x.n_cols; ++i)
+    {
+      for (size_t dimension = 0; dimension < x.n_rows; ++dimension)
+      {
+        // Adding 0.5 helps ensure that we cast the floating point to a size_t
+        // correctly.
+        const size_t obs = size_t(x(dimension, i) + 0.5);
+
+        // Ensure that the observation is within the bounds.
+        if (obs >= this->probabilities[dimension].n_elem)
+        {
+          Log::Fatal << "DiscreteDistribution::Probability(): received "
+              << "observation " << obs << "; observation must be in [0, "
+              << this->probabilities[dimension].n_elem << "] for this "
+              << "distribution." << std::endl;
+        }
+        probabilities[i] *= this->probabilities[dimension][obs];
+      }
+    }
+  }
+
+  /**
+   * Calculate the log probability of each observation (column) in the given
+   * matrix.
+   *
+   * @param x List of observations.
+   * @param logProbabilities Output log probabilities for each input
+   *     observation.
+   */
+  void LogProbability(const arma::mat& x, arma::vec& logProbabilities) const
+  {
+    Probability(x, logProbabilities);
+    logProbabilities = arma::log(logProbabilities);
+  }
+
   /**
    * Return a randomly generated observation (one-dimensional vector; one
    * observation) according to the probability distribution defined by this
@@ -64,6 +64,20 @@ double RegressionDistribution::Probability(const arma::vec& observation) const
   return err.Probability(observation(0)-fitted.t());
 }
 
+/**
+ * Evaluate probability density function of each given observation.
+ *
+ * @param observations points to evaluate probability at
+ * @param probabilities output probabilities for each observation
+ */
+void RegressionDistribution::Probability(const arma::mat& observations,
+                                         arma::vec& probabilities) const
+{
+  arma::rowvec fitted;
+  rf.Predict(observations.rows(1, observations.n_rows - 1), fitted);
+  err.Probability(arma::mat(observations.row(0) - fitted), probabilities);
+}
+
 void RegressionDistribution::Predict(const arma::mat& points,
                                      arma::vec& predictions) const
 {
@@ -128,6 +128,17 @@ class RegressionDistribution
     return log(Probability(observation));
   }
 
+  /**
+   * Evaluate probability density function of each observation (column) in the
+   * given matrix.  The regression function is evaluated on all observations at
+   * once.
+   *
+   * @param observations points to evaluate probability at
+   * @param probabilities output probabilities for each observation
+   */
+  void Probability(const arma::mat& observations,
+                   arma::vec& probabilities) const;
+
   /**
    * Calculate y_i for each data point in points.
    *
@@ -69,6 +69,21 @@ class CVFunction
    */
   double Evaluate(const arma::mat& parameters);
 
+  /**
+   * Run cross-validation with the bound and passed parameters, training on the
+   * given fraction of the training data.  This is used by budget-aware
+   * optimizers like SuccessiveHalving, and requires the CVType class to
+   * provide a TrainingFraction() modifier (as SimpleCV and KFoldCV do).
+   *
+   * Objectives with different budgets are not comparable, so the best model
+   * is the best one among the models trained with the largest budget so far.
+   *
+   * @param parameters Arguments (rather than the bound arguments) that should
+   *     be passed into the Evaluate method of the CVType object.
+   * @param budget Fraction (between 0 and 1) of the training data to use.
+   */
+  double Evaluate(const arma::mat& parameters, const double budget);
+
   /**
    * Evaluate numerically the gradient of the CVFunction with the given
    * parameters.
@@ -112,6 +127,12 @@ class CVFunction
   //! The best model so far.
   MLAlgorithm bestModel;
 
+  //! The budget of the best model so far.
+  double bestBudget;
+
+  //! The budget of the current evaluation.
+  double budget;
+
   //! Relative increase of arguments for calculation of gradient.
   double relativeDelta;
 
@@ -52,6 +52,8 @@ CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::CVFunction(
     cv(cv),
     boundArgs(args...),
     bestObjective(std::numeric_limits<double>::max()),
+    bestBudget(0.0),
+    budget(1.0),
     relativeDelta(relativeDelta),
     minDelta(minDelta)
 { /* Nothing left to do. */ }
@@ -63,9 +65,39 @@ template<typename CVType,
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Evaluate(
     const arma::mat& parameters)
 {
+  budget = 1.0;
   return Evaluate<0, 0>(parameters);
 }
 
+template<typename CVType,
+         typename MLAlgorithm,
+         size_t TotalArgs,
+         typename... BoundArgs>
+double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Evaluate(
+    const arma::mat& parameters,
+    const double budget)
+{
+  const double oldFraction = cv.TrainingFraction();
+  cv.TrainingFraction() = budget;
+  this->budget = budget;
+
+  // The training fraction is restored even if the evaluation throws, so the
+  // cross-validation object is left as it was given to us.
+  double objective;
+  try
+  {
+    objective = Evaluate<0, 0>(parameters);
+  }
+  catch (...)
+  {
+    cv.TrainingFraction() = oldFraction;
+    throw;
+  }
+  cv.TrainingFraction() = oldFraction;
+
+  return objective;
+}
+
 template<typename CVType,
          typename MLAlgorithm,
          size_t TotalArgs,
@@ -117,12 +149,15 @@ double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Evaluate(
 {
   double objective = cv.Evaluate(args...);
 
-  // Change the best model if we have got a better score, or if we probably
-  // have not assigned any valid (trained) model yet.
-  if (bestObjective > objective ||
-      bestObjective == std::numeric_limits<double>::max())
+  // Change the best model if we have got a better score with the same budget,
+  // if we have trained with a larger budget, or if we probably have not
+  // assigned any valid (trained) model yet.
+  if (budget > bestBudget || (budget == bestBudget &&
+      (bestObjective > objective ||
+       bestObjective == std::numeric_limits<double>::max())))
   {
     bestObjective = objective;
+    bestBudget = budget;
     bestModel = std::move(cv.Model());
   }
 
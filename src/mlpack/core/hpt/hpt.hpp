@@ -15,6 +15,7 @@
 #include <mlpack/core/cv/meta_info_extractor.hpp>
 #include <mlpack/core/hpt/deduce_hp_types.hpp>
 #include <mlpack/core/optimizers/grid_search/grid_search.hpp>
+#include <mlpack/core/optimizers/successive_halving/successive_halving.hpp>
 
 namespace mlpack {
 namespace hpt {
@@ -67,12 +68,27 @@ namespace hpt {
  *     Fixed(useCholesky), lambda1Set, lambda2Set);
  * @endcode
  *
+ * Evaluating every set of hyper-parameters on all of the data can be too
+ * expensive for large models.  SuccessiveHalving evaluates the sets on small
+ * subsets of the training data first, and only trains the best ones on all of
+ * it; it takes the same arguments as GridSearch.  It requires a CV class that
+ * provides TrainingFraction(), like SimpleCV and KFoldCV.  The data should be
+ * shuffled, since the subsets are the first points of the training data.
+ *
+ * @code
+ * HyperParameterTuner<LARS, MSE, SimpleCV, SuccessiveHalving> hpt3(
+ *     validationSize, data, responses);
+ *
+ * std::tie(bestLambda1, bestLambda2) = hpt3.Optimize(Fixed(transposeData),
+ *     Fixed(useCholesky), lambda1Set, lambda2Set);
+ * @endcode
+ *
  * @tparam MLAlgorithm A machine learning algorithm.
  * @tparam Metric A metric to assess the quality of a trained model.
  * @tparam CV A cross-validation strategy used to assess a set of
  *     hyper-parameters.
- * @tparam OptimizerType An optimization strategy (GridSearch and
- *     GradientDescent are supported).
+ * @tparam OptimizerType An optimization strategy (GridSearch,
+ *     SuccessiveHalving and GradientDescent are supported).
  * @tparam MatType The type of data.
  * @tparam PredictionsType The type of predictions (should be passed when the
  *     predictions type is a template parameter in Train methods of the given
@@ -154,10 +170,12 @@ class HyperParameterTuner
   /**
    * Find the best hyper-parameters by using the given Optimizer. For each
    * hyper-parameter one of the following should be passed as an argument.
-   * 1. A set of values to choose from (when using GridSearch as an optimizer).
-   *   The set of values should be an STL-compatible container (it should
-   *   provide begin() and end() methods returning iterators).
-   * 2. A starting value (when using any other optimizer than GridSearch).
+   * 1. A set of values to choose from (when using GridSearch or
+   *   SuccessiveHalving as an optimizer). The set of values should be an
+   *   STL-compatible container (it should provide begin() and end() methods
+   *   returning iterators).
+   * 2. A starting value (when using any other optimizer than GridSearch or
+   *   SuccessiveHalving).
    * 3. A value fixed by using the function mlpack::hpt::Fixed. In this case the
    *   hyper-parameter will not be optimized.
    *
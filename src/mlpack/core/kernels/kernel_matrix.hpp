@@ -0,0 +1,198 @@
+/**
+ * @file kernel_matrix.hpp
+ *
+ * Blocked, parallel construction of kernel matrices.  The matrix is built in
+ * square tiles, which are computed in parallel with OpenMP.  For kernels that
+ * are functions of the dot product or the Euclidean distance (the linear,
+ * polynomial, hyperbolic tangent and Gaussian kernels), each tile is computed
+ * with one matrix multiplication and an elementwise transformation, instead of
+ * one call to Evaluate() for each pair of points.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_KERNEL_MATRIX_HPP
+#define MLPACK_CORE_KERNELS_KERNEL_MATRIX_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/gaussian_kernel.hpp>
+#include <mlpack/core/kernels/hyperbolic_tangent_kernel.hpp>
+#include <mlpack/core/kernels/linear_kernel.hpp>
+#include <mlpack/core/kernels/polynomial_kernel.hpp>
+
+namespace mlpack {
+namespace kernel {
+
+/**
+ * Compute one tile of a kernel matrix: tile(i, j) = K(a_i, b_j), where a_i and
+ * b_j are the columns of a and b.  By default, the kernel is evaluated for
+ * each pair of columns; KernelMatrixRule is specialized for kernels whose
+ * tiles can be computed with a matrix multiplication.  The tile is computed
+ * serially, so this can be called from several threads at once.
+ *
+ * @tparam KernelType Type of kernel.
+ */
+template<typename KernelType>
+class KernelMatrixRule
+{
+ public:
+  /**
+   * Compute the kernel between each column of a and each column of b.
+   *
+   * @param kernel Kernel to evaluate.
+   * @param a First set of points.
+   * @param b Second set of points.
+   * @param tile Matrix to store the kernel values in (a.n_cols x b.n_cols).
+   */
+  template<typename MatTypeA, typename MatTypeB>
+  static void Evaluate(KernelType& kernel,
+                       const MatTypeA& a,
+                       const MatTypeB& b,
+                       arma::mat& tile)
+  {
+    tile.set_size(a.n_cols, b.n_cols);
+    for (size_t j = 0; j < b.n_cols; ++j)
+      for (size_t i = 0; i < a.n_cols; ++i)
+        tile(i, j) = kernel.Evaluate(a.col(i), b.col(j));
+  }
+};
+
+//! The linear kernel tile is a matrix product.
+template<>
+class KernelMatrixRule<LinearKernel>
+{
+ public:
+  template<typename MatTypeA, typename MatTypeB>
+  static void Evaluate(LinearKernel& /* kernel */,
+                       const MatTypeA& a,
+                       const MatTypeB& b,
+                       arma::mat& tile)
+  {
+    tile = a.t() * b;
+  }
+};
+
+//! The polynomial kernel tile is an elementwise power of a matrix product.
+template<>
+class KernelMatrixRule<PolynomialKernel>
+{
+ public:
+  template<typename MatTypeA, typename MatTypeB>
+  static void Evaluate(PolynomialKernel& kernel,
+                       const MatTypeA& a,
+                       const MatTypeB& b,
+                       arma::mat& tile)
+  {
+    tile = arma::pow(a.t() * b + kernel.Offset(), kernel.Degree());
+  }
+};
+
+//! The hyperbolic tangent kernel tile is an elementwise tanh() of a matrix
+//! product.
+template<>
+class KernelMatrixRule<HyperbolicTangentKernel>
+{
+ public:
+  template<typename MatTypeA, typename MatTypeB>
+  static void Evaluate(HyperbolicTangentKernel& kernel,
+                       const MatTypeA& a,
+                       const MatTypeB& b,
+                       arma::mat& tile)
+  {
+    tile = arma::tanh(kernel.Scale() * (a.t() * b) + kernel.Offset());
+  }
+};
+
+//! The Gaussian kernel tile is computed from the squared distances
+//! ||a_i||^2 + ||b_j||^2 - 2 a_i^T b_j.
+template<>
+class KernelMatrixRule<GaussianKernel>
+{
+ public:
+  template<typename MatTypeA, typename MatTypeB>
+  static void Evaluate(GaussianKernel& kernel,
+                       const MatTypeA& a,
+                       const MatTypeB& b,
+                       arma::mat& tile)
+  {
+    tile = -2.0 * (a.t() * b);
+    tile.each_col() += arma::sum(arma::square(a), 0).t();
+    tile.each_row() += arma::sum(arma::square(b), 0);
+
+    // Rounding can make the squared distance of nearby points negative.
+    tile = arma::exp(kernel.Gamma() * arma::clamp(tile, 0.0, DBL_MAX));
+  }
+};
+
+/**
+ * Compute the symmetric kernel matrix of the given points, K(i, j) =
+ * K(x_i, x_j), in parallel tiles.  Only the tiles of the upper triangle are
+ * computed; each one is also copied to the lower triangle.
+ *
+ * @param data Points to compute the kernel matrix of (one per column).
+ * @param kernelMatrix Matrix to store the kernel matrix in.
+ * @param kernel Kernel to evaluate.
+ * @param tileSize Number of points in each dimension of a tile.
+ */
+template<typename KernelType, typename MatType>
+void KernelMatrix(const MatType& data,
+                  arma::mat& kernelMatrix,
+                  KernelType& kernel,
+                  const size_t tileSize = 256);
+
+/**
+ * Compute the kernel matrix between two sets of points, K(i, j) =
+ * K(a_i, b_j), in parallel tiles.
+ *
+ * @param a First set of points (one per column); one row of the kernel matrix
+ *     for each.
+ * @param b Second set of points (one per column); one column of the kernel
+ *     matrix for each.
+ * @param kernelMatrix Matrix to store the kernel matrix in.
+ * @param kernel Kernel to evaluate.
+ * @param tileSize Number of points in each dimension of a tile.
+ */
+template<typename KernelType, typename MatType>
+void KernelMatrix(const MatType& a,
+                  const MatType& b,
+                  arma::mat& kernelMatrix,
+                  KernelType& kernel,
+                  const size_t tileSize = 256);
+
+/**
+ * Compute the symmetric kernel matrix of the given points tile by tile, and
+ * hand each tile of the upper triangle to a callback instead of storing it.
+ * This can be used when the kernel matrix does not fit in memory (for
+ * instance, to write it to disk).  The callback has the signature
+ *
+ * @code
+ * void callback(const size_t rowBegin,
+ *               const size_t colBegin,
+ *               const arma::mat& tile);
+ * @endcode
+ *
+ * where tile(i, j) = K(x_{rowBegin + i}, x_{colBegin + j}) and rowBegin <=
+ * colBegin; the tiles of the lower triangle are their transposes.  The tiles
+ * are computed in parallel, so the callback can be called from several threads
+ * at once (but never twice for the same tile).
+ *
+ * @param data Points to compute the kernel matrix of (one per column).
+ * @param kernel Kernel to evaluate.
+ * @param callback Callback to hand each tile to.
+ * @param tileSize Number of points in each dimension of a tile.
+ */
+template<typename KernelType, typename MatType, typename CallbackType>
+void KernelMatrixTiles(const MatType& data,
+                       KernelType& kernel,
+                       CallbackType callback,
+                       const size_t tileSize = 256);
+
+} // namespace kernel
+} // namespace mlpack
+
+// Include implementation.
+#include "kernel_matrix_impl.hpp"
+
+#endif
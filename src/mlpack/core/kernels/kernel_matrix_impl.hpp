@@ -0,0 +1,117 @@
+/**
+ * @file kernel_matrix_impl.hpp
+ *
+ * Implementation of blocked, parallel kernel matrix construction.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_KERNEL_MATRIX_IMPL_HPP
+#define MLPACK_CORE_KERNELS_KERNEL_MATRIX_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "kernel_matrix.hpp"
+
+namespace mlpack {
+namespace kernel {
+
+template<typename KernelType, typename MatType, typename CallbackType>
+void KernelMatrixTiles(const MatType& data,
+                       KernelType& kernel,
+                       CallbackType callback,
+                       const size_t tileSize)
+{
+  if (tileSize == 0)
+    throw std::invalid_argument("KernelMatrixTiles(): tileSize must be "
+        "positive");
+
+  // List the tiles of the upper triangle, so that they can be handed out to
+  // the threads one by one.
+  const size_t n = data.n_cols;
+  const size_t numTiles = (n + tileSize - 1) / tileSize;
+  std::vector<std::pair<size_t, size_t>> tiles;
+  tiles.reserve(numTiles * (numTiles + 1) / 2);
+  for (size_t j = 0; j < numTiles; ++j)
+    for (size_t i = 0; i <= j; ++i)
+      tiles.push_back(std::make_pair(i * tileSize, j * tileSize));
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t t = 0; t < (omp_size_t) tiles.size(); ++t)
+  {
+    const size_t rowBegin = tiles[t].first;
+    const size_t colBegin = tiles[t].second;
+    const size_t rowEnd = std::min(rowBegin + tileSize, n) - 1;
+    const size_t colEnd = std::min(colBegin + tileSize, n) - 1;
+
+    arma::mat tile;
+    KernelMatrixRule<KernelType>::Evaluate(kernel,
+        data.cols(rowBegin, rowEnd), data.cols(colBegin, colEnd), tile);
+
+    // Make the tiles on the diagonal exactly symmetric.
+    if (rowBegin == colBegin)
+      tile = arma::symmatu(tile);
+
+    callback(rowBegin, colBegin, tile);
+  }
+}
+
+template<typename KernelType, typename MatType>
+void KernelMatrix(const MatType& data,
+                  arma::mat& kernelMatrix,
+                  KernelType& kernel,
+                  const size_t tileSize)
+{
+  kernelMatrix.set_size(data.n_cols, data.n_cols);
+
+  // Each tile is copied to a different part of the matrix, so no
+  // synchronization is needed.
+  KernelMatrixTiles(data, kernel, [&kernelMatrix](const size_t rowBegin,
+                                                  const size_t colBegin,
+                                                  const arma::mat& tile)
+  {
+    kernelMatrix.submat(rowBegin, colBegin, rowBegin + tile.n_rows - 1,
+        colBegin + tile.n_cols - 1) = tile;
+    if (rowBegin != colBegin)
+    {
+      kernelMatrix.submat(colBegin, rowBegin, colBegin + tile.n_cols - 1,
+          rowBegin + tile.n_rows - 1) = tile.t();
+    }
+  }, tileSize);
+}
+
+template<typename KernelType, typename MatType>
+void KernelMatrix(const MatType& a,
+                  const MatType& b,
+                  arma::mat& kernelMatrix,
+                  KernelType& kernel,
+                  const size_t tileSize)
+{
+  if (tileSize == 0)
+    throw std::invalid_argument("KernelMatrix(): tileSize must be positive");
+
+  kernelMatrix.set_size(a.n_cols, b.n_cols);
+
+  const size_t rowTiles = (a.n_cols + tileSize - 1) / tileSize;
+  const size_t colTiles = (b.n_cols + tileSize - 1) / tileSize;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t t = 0; t < (omp_size_t) (rowTiles * colTiles); ++t)
+  {
+    const size_t rowBegin = (t % rowTiles) * tileSize;
+    const size_t colBegin = (t / rowTiles) * tileSize;
+    const size_t rowEnd = std::min(rowBegin + tileSize, (size_t) a.n_cols) - 1;
+    const size_t colEnd = std::min(colBegin + tileSize, (size_t) b.n_cols) - 1;
+
+    arma::mat tile;
+    KernelMatrixRule<KernelType>::Evaluate(kernel, a.cols(rowBegin, rowEnd),
+        b.cols(colBegin, colEnd), tile);
+    kernelMatrix.submat(rowBegin, colBegin, rowEnd, colEnd) = tile;
+  }
+}
+
+} // namespace kernel
+} // namespace mlpack
+
+#endif
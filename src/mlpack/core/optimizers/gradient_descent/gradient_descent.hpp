@@ -13,6 +13,7 @@
 #define MLPACK_CORE_OPTIMIZERS_GRADIENT_DESCENT_GRADIENT_DESCENT_HPP
 
 #include <mlpack/core.hpp>
+#include <mlpack/core/optimizers/parallel_function/parallel_function.hpp>
 
 namespace mlpack {
 namespace optimization {
@@ -45,6 +46,10 @@ namespace optimization {
  *   double Evaluate(const arma::mat& coordinates);
  *   void Gradient(const arma::mat& coordinates,
  *                 arma::mat& gradient);
+ *
+ * If the function is separable and also implements the batch overloads of
+ * Evaluate() and Gradient() (see BatchEvaluate() and BatchGradient()), the
+ * objective and gradient are evaluated in parallel with ParallelFunction.
  */
 class GradientDescent
 {
@@ -21,8 +21,13 @@ namespace optimization {
 //! Optimize the function (minimize).
 template<typename FunctionType>
 double GradientDescent::Optimize(
-    FunctionType& function, arma::mat& iterate)
+    FunctionType& separableFunction, arma::mat& iterate)
 {
+  // Separable functions with batch overloads are evaluated in parallel shards;
+  // otherwise, this is just a reference to the function.
+  typename ParallelFunctionType<FunctionType>::type function(
+      separableFunction);
+
   // To keep track of where we are and how things are going.
   double overallObjective = function.Evaluate(iterate);
   double lastObjective = DBL_MAX;
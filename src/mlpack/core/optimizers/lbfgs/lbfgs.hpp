@@ -14,6 +14,7 @@
 #define MLPACK_CORE_OPTIMIZERS_LBFGS_LBFGS_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/optimizers/parallel_function/parallel_function.hpp>
 
 namespace mlpack {
 namespace optimization {
@@ -30,6 +31,10 @@ namespace optimization {
  *  - double Evaluate(const arma::mat& coordinates);
  *  - void Gradient(const arma::mat& coordinates, arma::mat& gradient);
  *  - arma::mat& GetInitialPoint();
+ *
+ * If the function is separable and also implements the batch overloads of
+ * Evaluate() and Gradient() (see BatchEvaluate() and BatchGradient()), the
+ * objective and gradient are evaluated in parallel with ParallelFunction.
  */
 class L_BFGS
 {
@@ -171,8 +171,13 @@ bool L_BFGS::LineSearch(FunctionType& function,
  * @param iterate Starting point (will be modified)
  */
 template<typename FunctionType>
-double L_BFGS::Optimize(FunctionType& function, arma::mat& iterate)
+double L_BFGS::Optimize(FunctionType& separableFunction, arma::mat& iterate)
 {
+  // Separable functions with batch overloads are evaluated in parallel shards;
+  // otherwise, this is just a reference to the function.
+  typename ParallelFunctionType<FunctionType>::type function(
+      separableFunction);
+
   // Ensure that the cubes holding past iterations' information are the right
   // size.  Also set the current best point value to the maximum.
   const size_t rows = iterate.n_rows;
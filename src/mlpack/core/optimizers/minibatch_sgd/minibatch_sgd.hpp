@@ -13,6 +13,7 @@
 #define MLPACK_CORE_OPTIMIZERS_MINIBATCH_SGD_MINIBATCH_SGD_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/optimizers/sgd/batch_function.hpp>
 #include <mlpack/core/optimizers/sgd/update_policies/vanilla_update.hpp>
 #include <mlpack/core/optimizers/minibatch_sgd/decay_policies/no_decay.hpp>
 
@@ -69,6 +70,23 @@ namespace optimization {
  * function on the first point in the dataset (presumably, the dataset is held
  * internally in the DecomposableFunctionType).
  *
+ * Each mini-batch is a contiguous range of functions, and when shuffling, the
+ * order of the mini-batches (not of the individual functions) is shuffled, so
+ * the points of each mini-batch are accessed sequentially.  If the
+ * DecomposableFunctionType also implements
+ *
+ *   double Evaluate(const arma::mat& coordinates,
+ *                   const size_t begin,
+ *                   const size_t batchSize);
+ *   void Gradient(const arma::mat& coordinates,
+ *                 const size_t begin,
+ *                 arma::mat& gradient,
+ *                 const size_t batchSize);
+ *
+ * which return the sum of the objectives (or gradients) of the functions begin,
+ * ..., begin + batchSize - 1, then these are used to process a whole mini-batch
+ * at once (see BatchEvaluate() and BatchGradient()).
+ *
  * @tparam DecomposableFunctionType Decomposable objective function type to be
  *     minimized.
  * @tparam update Update policy used during the iterative update process.
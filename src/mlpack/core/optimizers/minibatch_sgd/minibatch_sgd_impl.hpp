@@ -74,8 +74,7 @@ double MiniBatchSGDType<
   double lastObjective = DBL_MAX;
 
   // Calculate the first objective function.
-  for (size_t i = 0; i < numFunctions; ++i)
-    overallObjective += function.Evaluate(iterate, i);
+  overallObjective = FullEvaluate(function, iterate);
 
   // Initialize the update policy.
   if (resetPolicy)
@@ -116,53 +115,19 @@ double MiniBatchSGDType<
         visitationOrder = arma::shuffle(visitationOrder);
     }
 
-    // Evaluate the gradient for this mini-batch.
+    // Evaluate the gradient for this mini-batch.  The last batch may be
+    // smaller than the others.
     const size_t offset = batchSize * visitationOrder[currentBatch];
-    function.Gradient(iterate, offset, gradient);
-    if (visitationOrder[currentBatch] != numBatches - 1)
-    {
-      for (size_t j = 1; j < batchSize; ++j)
-      {
-        arma::mat funcGradient;
-        function.Gradient(iterate, offset + j, funcGradient);
-        gradient += funcGradient;
-      }
-
-      // Now update the iterate.
-      updatePolicy.Update(iterate, stepSize / batchSize, gradient);
-
-      // Add that to the overall objective function.
-      for (size_t j = 0; j < batchSize; ++j)
-        overallObjective += function.Evaluate(iterate, offset + j);
-    }
-    else
-    {
-      // Handle last batch differently: it's not a full-size batch.
-      const size_t lastBatchSize = numFunctions - offset - 1;
-      for (size_t j = 1; j < lastBatchSize; ++j)
-      {
-        arma::mat funcGradient;
-        function.Gradient(iterate, offset + j, funcGradient);
-        gradient += funcGradient;
-      }
+    const size_t effectiveBatchSize = std::min(batchSize,
+        numFunctions - offset);
+    BatchGradient(function, iterate, offset, gradient, effectiveBatchSize);
 
-      // Ensure the last batch size isn't zero, to avoid division by zero before
-      // updating.
-      if (lastBatchSize > 0)
-      {
-        // Now update the iterate.
-        updatePolicy.Update(iterate, stepSize / lastBatchSize, gradient);
-      }
-      else
-      {
-        // Now update the iterate.
-        updatePolicy.Update(iterate, stepSize, gradient);
-      }
+    // Now update the iterate.
+    updatePolicy.Update(iterate, stepSize / effectiveBatchSize, gradient);
 
-      // Add that to the overall objective function.
-      for (size_t j = 0; j < lastBatchSize; ++j)
-        overallObjective += function.Evaluate(iterate, offset + j);
-    }
+    // Add that to the overall objective function.
+    overallObjective += BatchEvaluate(function, iterate, offset,
+        effectiveBatchSize);
 
     // Now update the learning rate if requested by the user.
     decayPolicy.Update(iterate, stepSize, gradient);
@@ -172,9 +137,7 @@ double MiniBatchSGDType<
       << "reached; terminating optimization." << std::endl;
 
   // Calculate final objective.
-  overallObjective = 0;
-  for (size_t i = 0; i < numFunctions; ++i)
-    overallObjective += function.Evaluate(iterate, i);
+  overallObjective = FullEvaluate(function, iterate);
 
   return overallObjective;
 }
@@ -0,0 +1,136 @@
+/**
+ * @file parallel_function.hpp
+ *
+ * A wrapper around a separable function which evaluates the full objective and
+ * gradient in parallel, by splitting the separable functions into one
+ * contiguous shard per thread.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_OPTIMIZERS_PARALLEL_FUNCTION_PARALLEL_FUNCTION_HPP
+#define MLPACK_CORE_OPTIMIZERS_PARALLEL_FUNCTION_PARALLEL_FUNCTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/optimizers/sgd/batch_function.hpp>
+
+namespace mlpack {
+namespace optimization {
+
+/**
+ * ParallelFunction presents the Evaluate() and Gradient() interface used by
+ * full-batch optimizers such as L_BFGS and GradientDescent, but computes the
+ * objective and gradient of a separable function
+ *
+ * \f[
+ * f(A) = \sum_{i = 0}^{n - 1} f_i(A)
+ * \f]
+ *
+ * by splitting the n functions into contiguous shards, one per OpenMP thread.
+ * Each shard is evaluated with the batch Evaluate() and Gradient() overloads
+ * of the function (see BatchEvaluate() and BatchGradient()), and the per-shard
+ * results are summed in shard order, so for a fixed number of threads the
+ * result does not depend on the thread schedule.
+ *
+ * If OpenMP is not available, only one thread is available, or there are too
+ * few separable functions to give each thread at least minShardSize of them,
+ * the full Evaluate() and Gradient() of the function are called instead.
+ *
+ * The wrapped function must implement
+ *
+ * @code
+ * size_t NumFunctions();
+ * double Evaluate(const arma::mat& coordinates);
+ * void Gradient(const arma::mat& coordinates, arma::mat& gradient);
+ * double Evaluate(const arma::mat& coordinates, const size_t begin,
+ *                 const size_t batchSize);
+ * void Gradient(const arma::mat& coordinates, const size_t begin,
+ *               arma::mat& gradient, const size_t batchSize);
+ * @endcode
+ *
+ * and the batch overloads must be safe to call concurrently on disjoint
+ * ranges of functions; that is, they must not modify the function object.
+ *
+ * L_BFGS and GradientDescent wrap any function type which has batch overloads
+ * automatically (see ParallelFunctionType), so this class only needs to be used
+ * directly by other optimizers.
+ *
+ * @tparam FunctionType Type of the separable function to wrap.
+ */
+template<typename FunctionType>
+class ParallelFunction
+{
+ public:
+  /**
+   * Wrap the given separable function.  The function is held by reference, so
+   * it must outlive the ParallelFunction object.
+   *
+   * @param function Separable function to wrap.
+   * @param minShardSize Minimum number of separable functions in each shard.
+   */
+  ParallelFunction(FunctionType& function, const size_t minShardSize = 256);
+
+  /**
+   * Evaluate the full objective at the given coordinates, as the sum of the
+   * objectives of each shard.
+   *
+   * @param coordinates The coordinates to evaluate the objective at.
+   */
+  double Evaluate(const arma::mat& coordinates);
+
+  /**
+   * Evaluate the full gradient at the given coordinates, as the sum of the
+   * gradients of each shard.
+   *
+   * @param coordinates The coordinates to evaluate the gradient at.
+   * @param gradient Matrix to store the gradient in.
+   */
+  void Gradient(const arma::mat& coordinates, arma::mat& gradient);
+
+  //! Get the wrapped function.
+  const FunctionType& Function() const { return function; }
+  //! Modify the wrapped function.
+  FunctionType& Function() { return function; }
+
+  //! Get the minimum number of separable functions in each shard.
+  size_t MinShardSize() const { return minShardSize; }
+  //! Modify the minimum number of separable functions in each shard.
+  size_t& MinShardSize() { return minShardSize; }
+
+ private:
+  //! Return the number of shards to split the functions into (0 or 1 means
+  //! that the full objective should be evaluated serially).
+  size_t NumShards();
+
+  //! The wrapped function.
+  FunctionType& function;
+  //! The minimum number of separable functions in each shard.
+  size_t minShardSize;
+};
+
+/**
+ * The type that full-batch optimizers use to evaluate a function of type
+ * FunctionType.  If the function has batch Evaluate() and Gradient()
+ * overloads, this is ParallelFunction<FunctionType>; otherwise, it is a
+ * reference to the function itself.  In both cases an object of this type can
+ * be constructed from a FunctionType&.
+ */
+template<typename FunctionType>
+struct ParallelFunctionType
+{
+  typedef typename std::conditional<
+      HasBatchEvaluate<FunctionType>::value &&
+      HasBatchGradient<FunctionType>::value,
+      ParallelFunction<FunctionType>,
+      FunctionType&>::type type;
+};
+
+} // namespace optimization
+} // namespace mlpack
+
+// Include implementation.
+#include "parallel_function_impl.hpp"
+
+#endif
@@ -0,0 +1,99 @@
+/**
+ * @file parallel_function_impl.hpp
+ *
+ * Implementation of ParallelFunction, which evaluates a separable function in
+ * parallel shards.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_OPTIMIZERS_PARALLEL_FUNCTION_PARALLEL_FUNCTION_IMPL_HPP
+#define MLPACK_CORE_OPTIMIZERS_PARALLEL_FUNCTION_PARALLEL_FUNCTION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "parallel_function.hpp"
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+namespace optimization {
+
+template<typename FunctionType>
+ParallelFunction<FunctionType>::ParallelFunction(FunctionType& function,
+                                                 const size_t minShardSize) :
+    function(function),
+    minShardSize(std::max(minShardSize, (size_t) 1))
+{ /* Nothing to do. */ }
+
+template<typename FunctionType>
+size_t ParallelFunction<FunctionType>::NumShards()
+{
+  #ifdef HAS_OPENMP
+    // Don't start threads for shards that would be too small to be worth it.
+    return std::min((size_t) omp_get_max_threads(),
+        (size_t) function.NumFunctions() / minShardSize);
+  #else
+    return 1;
+  #endif
+}
+
+template<typename FunctionType>
+double ParallelFunction<FunctionType>::Evaluate(const arma::mat& coordinates)
+{
+  const size_t numShards = NumShards();
+  if (numShards < 2)
+    return function.Evaluate(coordinates);
+
+  const size_t numFunctions = function.NumFunctions();
+  arma::vec objectives(numShards);
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t shard = 0; shard < (omp_size_t) numShards; ++shard)
+  {
+    const size_t begin = shard * numFunctions / numShards;
+    const size_t end = (shard + 1) * numFunctions / numShards;
+    objectives[shard] = BatchEvaluate(function, coordinates, begin,
+        end - begin);
+  }
+
+  // Sum the shards in order, so that the result does not depend on which
+  // thread finished first.
+  return arma::accu(objectives);
+}
+
+template<typename FunctionType>
+void ParallelFunction<FunctionType>::Gradient(const arma::mat& coordinates,
+                                              arma::mat& gradient)
+{
+  const size_t numShards = NumShards();
+  if (numShards < 2)
+  {
+    function.Gradient(coordinates, gradient);
+    return;
+  }
+
+  const size_t numFunctions = function.NumFunctions();
+  std::vector<arma::mat> gradients(numShards);
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t shard = 0; shard < (omp_size_t) numShards; ++shard)
+  {
+    const size_t begin = shard * numFunctions / numShards;
+    const size_t end = (shard + 1) * numFunctions / numShards;
+    BatchGradient(function, coordinates, begin, gradients[shard],
+        end - begin);
+  }
+
+  gradient = std::move(gradients[0]);
+  for (size_t shard = 1; shard < numShards; ++shard)
+    gradient += gradients[shard];
+}
+
+} // namespace optimization
+} // namespace mlpack
+
+#endif
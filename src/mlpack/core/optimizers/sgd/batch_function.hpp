@@ -0,0 +1,175 @@
+/**
+ * @file batch_function.hpp
+ *
+ * Utilities for evaluating the objective and gradient of a decomposable
+ * function on a contiguous batch of its constituent functions.  If the function
+ * provides batch overloads of Evaluate() and Gradient(), those are used;
+ * otherwise, the single-function overloads are called for each function in the
+ * batch.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_OPTIMIZERS_SGD_BATCH_FUNCTION_HPP
+#define MLPACK_CORE_OPTIMIZERS_SGD_BATCH_FUNCTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/sfinae_utility.hpp>
+
+namespace mlpack {
+namespace optimization {
+
+HAS_MEM_FUNC(Evaluate, HasBatchEvaluateCheck);
+HAS_MEM_FUNC(Gradient, HasBatchGradientCheck);
+
+/**
+ * 'value' is true if the DecomposableFunctionType class has a member
+ * double Evaluate(const arma::mat& coordinates, const size_t begin,
+ * const size_t batchSize), which returns the sum of the objectives of the
+ * functions begin, ..., begin + batchSize - 1.
+ */
+template<typename DecomposableFunctionType>
+struct HasBatchEvaluate
+{
+  static const bool value =
+    // Non-const version.
+    HasBatchEvaluateCheck<DecomposableFunctionType,
+        double(DecomposableFunctionType::*)(const arma::mat&,
+                                            const size_t,
+                                            const size_t)>::value ||
+    // Const version.
+    HasBatchEvaluateCheck<DecomposableFunctionType,
+        double(DecomposableFunctionType::*)(const arma::mat&,
+                                            const size_t,
+                                            const size_t) const>::value;
+};
+
+/**
+ * 'value' is true if the DecomposableFunctionType class has a member
+ * void Gradient(const arma::mat& coordinates, const size_t begin,
+ * arma::mat& gradient, const size_t batchSize), which stores the sum of the
+ * gradients of the functions begin, ..., begin + batchSize - 1 in gradient.
+ */
+template<typename DecomposableFunctionType>
+struct HasBatchGradient
+{
+  static const bool value =
+    // Non-const version.
+    HasBatchGradientCheck<DecomposableFunctionType,
+        void(DecomposableFunctionType::*)(const arma::mat&,
+                                          const size_t,
+                                          arma::mat&,
+                                          const size_t)>::value ||
+    // Const version.
+    HasBatchGradientCheck<DecomposableFunctionType,
+        void(DecomposableFunctionType::*)(const arma::mat&,
+                                          const size_t,
+                                          arma::mat&,
+                                          const size_t) const>::value;
+};
+
+/**
+ * Return the sum of the objectives of the functions begin, ..., begin +
+ * batchSize - 1, using the batch Evaluate() overload of the function.
+ */
+template<typename DecomposableFunctionType>
+inline double BatchEvaluate(
+    DecomposableFunctionType& function,
+    const arma::mat& coordinates,
+    const size_t begin,
+    const size_t batchSize,
+    const typename std::enable_if_t<
+        HasBatchEvaluate<DecomposableFunctionType>::value>* = 0)
+{
+  return function.Evaluate(coordinates, begin, batchSize);
+}
+
+/**
+ * Return the sum of the objectives of the functions begin, ..., begin +
+ * batchSize - 1, evaluating each function separately.
+ */
+template<typename DecomposableFunctionType>
+inline double BatchEvaluate(
+    DecomposableFunctionType& function,
+    const arma::mat& coordinates,
+    const size_t begin,
+    const size_t batchSize,
+    const typename std::enable_if_t<
+        !HasBatchEvaluate<DecomposableFunctionType>::value>* = 0)
+{
+  double objective = 0.0;
+  for (size_t i = begin; i < begin + batchSize; ++i)
+    objective += function.Evaluate(coordinates, i);
+
+  return objective;
+}
+
+/**
+ * Compute the sum of the gradients of the functions begin, ..., begin +
+ * batchSize - 1, using the batch Gradient() overload of the function.
+ */
+template<typename DecomposableFunctionType>
+inline void BatchGradient(
+    DecomposableFunctionType& function,
+    const arma::mat& coordinates,
+    const size_t begin,
+    arma::mat& gradient,
+    const size_t batchSize,
+    const typename std::enable_if_t<
+        HasBatchGradient<DecomposableFunctionType>::value>* = 0)
+{
+  function.Gradient(coordinates, begin, gradient, batchSize);
+}
+
+/**
+ * Compute the sum of the gradients of the functions begin, ..., begin +
+ * batchSize - 1, computing the gradient of each function separately.
+ */
+template<typename DecomposableFunctionType>
+inline void BatchGradient(
+    DecomposableFunctionType& function,
+    const arma::mat& coordinates,
+    const size_t begin,
+    arma::mat& gradient,
+    const size_t batchSize,
+    const typename std::enable_if_t<
+        !HasBatchGradient<DecomposableFunctionType>::value>* = 0)
+{
+  function.Gradient(coordinates, begin, gradient);
+
+  arma::mat functionGradient;
+  for (size_t i = begin + 1; i < begin + batchSize; ++i)
+  {
+    function.Gradient(coordinates, i, functionGradient);
+    gradient += functionGradient;
+  }
+}
+
+/**
+ * Return the sum of the objectives of all of the functions, in batches of the
+ * given size.  This is how SGD-type optimizers compute the overall objective.
+ */
+template<typename DecomposableFunctionType>
+inline double FullEvaluate(DecomposableFunctionType& function,
+                           const arma::mat& coordinates,
+                           const size_t batchSize = 1024)
+{
+  const size_t numFunctions = function.NumFunctions();
+  double objective = 0.0;
+  for (size_t begin = 0; begin < numFunctions; begin += batchSize)
+  {
+    const size_t effectiveBatchSize = std::min(batchSize,
+        numFunctions - begin);
+    objective += BatchEvaluate(function, coordinates, begin,
+        effectiveBatchSize);
+  }
+
+  return objective;
+}
+
+} // namespace optimization
+} // namespace mlpack
+
+#endif
@@ -16,6 +16,7 @@
 
 #include <mlpack/methods/regularized_svd/regularized_svd_function.hpp>
 #include <mlpack/core/optimizers/sgd/update_policies/vanilla_update.hpp>
+#include <mlpack/core/optimizers/sgd/batch_function.hpp>
 
 // In case it hasn't been included yet.
 #include "sgd.hpp"
@@ -63,8 +64,7 @@ double SGD<UpdatePolicyType>::Optimize(
   double lastObjective = DBL_MAX;
 
   // Calculate the first objective function.
-  for (size_t i = 0; i < numFunctions; ++i)
-    overallObjective += function.Evaluate(iterate, i);
+  overallObjective = FullEvaluate(function, iterate);
 
   // Initialize the update policy.
   if (resetPolicy)
@@ -129,10 +129,7 @@ double SGD<UpdatePolicyType>::Optimize(
       << "terminating optimization." << std::endl;
 
   // Calculate final objective.
-  overallObjective = 0;
-  for (size_t i = 0; i < numFunctions; ++i)
-    overallObjective += function.Evaluate(iterate, i);
-  return overallObjective;
+  return FullEvaluate(function, iterate);
 }
 
 } // namespace optimization
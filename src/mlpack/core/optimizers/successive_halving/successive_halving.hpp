@@ -0,0 +1,118 @@
+/**
+ * @file successive_halving.hpp
+ *
+ * Successive halving: a budget-aware search over a multidimensional grid.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_OPTIMIZERS_SUCCESSIVE_HALVING_SUCCESSIVE_HALVING_HPP
+#define MLPACK_CORE_OPTIMIZERS_SUCCESSIVE_HALVING_SUCCESSIVE_HALVING_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+namespace optimization {
+
+/**
+ * An optimizer that finds the minimum of a given function over the points of a
+ * multidimensional grid, like GridSearch, but evaluates most of the points
+ * with only a fraction of the full budget.  All of the points (or a random
+ * sample of them) are first evaluated with a small budget; then only the best
+ * 1 / eta of them are evaluated again with eta times the budget, and so on,
+ * until the remaining points are evaluated with the full budget.  For more
+ * information, see the following paper:
+ *
+ * @code
+ * @inproceedings{jamieson2016non,
+ *   title={Non-stochastic Best Arm Identification and Hyperparameter
+ *       Optimization},
+ *   author={Jamieson, Kevin and Talwalkar, Ameet},
+ *   booktitle={Proceedings of the 19th International Conference on Artificial
+ *       Intelligence and Statistics (AISTATS)},
+ *   pages={240--248},
+ *   year={2016}
+ * }
+ * @endcode
+ *
+ * With the default minimum budget, each round costs about as much as one
+ * evaluation with the full budget, so searching over n points costs about
+ * log_eta(n) + 1 full evaluations instead of n.  Running the search several
+ * times with different minimum budgets gives the Hyperband algorithm.
+ *
+ * For SuccessiveHalving to work, a FunctionType template parameter is
+ * required.  This class must implement the following function:
+ *
+ *   double Evaluate(const arma::mat& coordinates, const double budget);
+ *
+ * where budget is the fraction (between 0 and 1) of the full cost to spend on
+ * the evaluation; for hyper-parameter tuning with CVFunction, it is the
+ * fraction of the training data to train on.
+ */
+class SuccessiveHalving
+{
+ public:
+  /**
+   * Create the SuccessiveHalving optimizer with the given parameters.
+   *
+   * @param eta Factor by which the number of points is divided (and the budget
+   *     is multiplied) in each round; it should be more than 1.
+   * @param minBudget Budget of the first round (between 0 and 1).  If 0, it is
+   *     chosen so that one point is left for the last round.
+   * @param numConfigurations Number of points of the grid to sample at random.
+   *     If 0, or more than the number of points of the grid, all of the points
+   *     are evaluated.
+   */
+  SuccessiveHalving(const double eta = 3.0,
+                    const double minBudget = 0.0,
+                    const size_t numConfigurations = 0);
+
+  /**
+   * Optimize (minimize) the given function over the combinations of values for
+   * the parameters specified in datasetInfo.
+   *
+   * @param function Function to optimize.
+   * @param bestParameters Variable for storing results.
+   * @param datasetInfo Type information for each dimension of the dataset. It
+   *     should store possible values for each parameter.
+   * @return Objective value of the final point, with the full budget.
+   */
+  template<typename FunctionType>
+  double Optimize(
+      FunctionType& function,
+      arma::mat& bestParameters,
+      data::DatasetMapper<data::IncrementPolicy, double>& datasetInfo);
+
+  //! Get the factor by which the number of points is divided in each round.
+  double Eta() const { return eta; }
+  //! Modify the factor by which the number of points is divided in each round.
+  double& Eta() { return eta; }
+
+  //! Get the budget of the first round (0 for automatic).
+  double MinBudget() const { return minBudget; }
+  //! Modify the budget of the first round (0 for automatic).
+  double& MinBudget() { return minBudget; }
+
+  //! Get the number of points to sample (0 for all).
+  size_t NumConfigurations() const { return numConfigurations; }
+  //! Modify the number of points to sample (0 for all).
+  size_t& NumConfigurations() { return numConfigurations; }
+
+ private:
+  //! The factor by which the number of points is divided in each round.
+  double eta;
+  //! The budget of the first round.
+  double minBudget;
+  //! The number of points to sample.
+  size_t numConfigurations;
+};
+
+} // namespace optimization
+} // namespace mlpack
+
+// Include implementation
+#include "successive_halving_impl.hpp"
+
+#endif
@@ -0,0 +1,127 @@
+/**
+ * @file successive_halving_impl.hpp
+ *
+ * Implementation of the SuccessiveHalving optimizer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_OPTIMIZERS_SUCCESSIVE_HALVING_SUCCESSIVE_HALVING_IMPL_HPP
+#define MLPACK_CORE_OPTIMIZERS_SUCCESSIVE_HALVING_SUCCESSIVE_HALVING_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "successive_halving.hpp"
+
+namespace mlpack {
+namespace optimization {
+
+inline SuccessiveHalving::SuccessiveHalving(const double eta,
+                                            const double minBudget,
+                                            const size_t numConfigurations) :
+    eta(eta),
+    minBudget(minBudget),
+    numConfigurations(numConfigurations)
+{ /* Nothing to do. */ }
+
+template<typename FunctionType>
+double SuccessiveHalving::Optimize(
+    FunctionType& function,
+    arma::mat& bestParameters,
+    data::DatasetMapper<data::IncrementPolicy, double>& datasetInfo)
+{
+  if (eta <= 1.0)
+    throw std::invalid_argument("SuccessiveHalving::Optimize(): eta should be "
+        "more than 1");
+
+  if (minBudget < 0.0 || minBudget > 1.0)
+    throw std::invalid_argument("SuccessiveHalving::Optimize(): the minimum "
+        "budget should be between 0 and 1");
+
+  size_t gridSize = 1;
+  for (size_t i = 0; i < datasetInfo.Dimensionality(); ++i)
+  {
+    if (datasetInfo.Type(i) != data::Datatype::categorical)
+    {
+      std::ostringstream oss;
+      oss << "SuccessiveHalving::Optimize(): the dimension " << i
+          << " is not categorical" << std::endl;
+      throw std::invalid_argument(oss.str());
+    }
+
+    gridSize *= datasetInfo.NumMappings(i);
+  }
+
+  // Choose the points of the grid to evaluate.
+  arma::uvec indices = arma::linspace<arma::uvec>(0, gridSize - 1, gridSize);
+  if (numConfigurations > 0 && numConfigurations < gridSize)
+  {
+    indices = arma::shuffle(indices);
+    indices.resize(numConfigurations);
+  }
+
+  arma::mat parameters(datasetInfo.Dimensionality(), indices.n_elem);
+  for (size_t j = 0; j < indices.n_elem; ++j)
+  {
+    size_t index = indices[j];
+    for (size_t i = 0; i < datasetInfo.Dimensionality(); ++i)
+    {
+      parameters(i, j) = datasetInfo.UnmapString(
+          index % datasetInfo.NumMappings(i), i);
+      index /= datasetInfo.NumMappings(i);
+    }
+  }
+
+  // By default, start with the budget that leaves one point for the last
+  // round.
+  double budget = minBudget;
+  if (budget == 0.0)
+  {
+    budget = 1.0;
+    for (double n = eta; n <= parameters.n_cols; n *= eta)
+      budget /= eta;
+  }
+
+  arma::vec objectives(parameters.n_cols);
+  arma::uvec survivors = arma::linspace<arma::uvec>(0, parameters.n_cols - 1,
+      parameters.n_cols);
+  while (true)
+  {
+    Log::Info << "SuccessiveHalving::Optimize(): evaluating "
+        << survivors.n_elem << " points with budget " << budget << "."
+        << std::endl;
+
+    arma::mat coordinates;
+    for (size_t j = 0; j < survivors.n_elem; ++j)
+    {
+      coordinates = parameters.col(survivors[j]);
+      objectives[survivors[j]] = function.Evaluate(coordinates, budget);
+    }
+
+    if (budget >= 1.0)
+      break;
+
+    // Keep the best 1 / eta of the points.  If only one point is left, it is
+    // evaluated with the full budget right away.
+    const size_t kept = std::max((size_t) 1,
+        (size_t) (survivors.n_elem / eta));
+    const arma::vec survivorObjectives = objectives.elem(survivors);
+    const arma::uvec order = arma::sort_index(survivorObjectives);
+    const arma::uvec nextSurvivors = survivors.elem(order.head(kept));
+    survivors = nextSurvivors;
+    budget = (kept == 1) ? 1.0 : std::min(1.0, budget * eta);
+  }
+
+  const arma::vec survivorObjectives = objectives.elem(survivors);
+  arma::uword best;
+  const double bestObjective = survivorObjectives.min(best);
+  bestParameters = parameters.col(survivors[best]);
+
+  return bestObjective;
+}
+
+} // namespace optimization
+} // namespace mlpack
+
+#endif
@@ -10,6 +10,7 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include <list>
+#include <mutex>
 #include <boost/program_options.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <iostream>
@@ -30,6 +31,28 @@ using namespace mlpack::util;
 // Fake ProgramDoc in case none is supplied.
 static ProgramDoc emptyProgramDoc = ProgramDoc("", []() { return ""; });
 
+// The CLI object of the calling thread's innermost CLIContext, if it has one.
+static thread_local CLI* currentContext = NULL;
+
+// Settings stored with StoreSettings(), which all threads share.  Options
+// store their settings during static initialization, so the map is created on
+// first use.
+typedef std::map<std::string, std::tuple<std::map<std::string, ParamData>,
+    std::map<char, std::string>, CLI::FunctionMapType>> StorageMapType;
+
+static StorageMapType& StorageMap()
+{
+  static StorageMapType storageMap;
+  return storageMap;
+}
+
+// Lock for the stored settings.
+static std::mutex& StorageMutex()
+{
+  static std::mutex storageMutex;
+  return storageMutex;
+}
+
 /* Constructors, Destructors, Copy */
 /* Make the constructor private, to preclude unauthorized instances */
 CLI::CLI() : didParse(false), doc(&emptyProgramDoc)
@@ -46,14 +69,7 @@ CLI::CLI(const CLI& /* other */) : didParse(false), doc(&emptyProgramDoc)
 void CLI::StopTimers()
 {
   // Terminate the program timers.
-  std::map<std::string, std::chrono::microseconds>::iterator it;
-  for (it = CLI::GetSingleton().timer.GetAllTimers().begin();
-       it != CLI::GetSingleton().timer.GetAllTimers().end(); ++it)
-  {
-    std::string i = (*it).first;
-    if (CLI::GetSingleton().timer.GetState(i) == 1)
-      Timer::Stop(i);
-  }
+  CLI::GetSingleton().timer.StopAllTimers();
 }
 
 /**
@@ -137,15 +153,27 @@ bool CLI::HasParam(const std::string& key)
   return (parameters.at(checkKey).wasPassed > 0);
 }
 
-// Returns the sole instance of this class.
+// Returns the sole instance of this class, or the object of the calling
+// thread's context.
 CLI& CLI::GetSingleton()
 {
+  if (currentContext != NULL)
+    return *currentContext;
+
   if (singleton == NULL)
     singleton = new CLI();
 
   return *singleton;
 }
 
+// Make the given object the current one for the calling thread.
+CLI* CLI::SetContext(CLI* context)
+{
+  CLI* previous = currentContext;
+  currentContext = context;
+  return previous;
+}
+
 /**
  * Registers a ProgramDoc object, which contains documentation about the
  * program.
@@ -194,9 +222,13 @@ void CLI::StoreSettings(const std::string& name)
 {
   // Take all of the parameters and put them in the map.  Clear anything old
   // first.
-  std::get<0>(GetSingleton().storageMap[name]) = GetSingleton().parameters;
-  std::get<1>(GetSingleton().storageMap[name]) = GetSingleton().aliases;
-  std::get<2>(GetSingleton().storageMap[name]) = GetSingleton().functionMap;
+  {
+    std::lock_guard<std::mutex> lock(StorageMutex());
+    StorageMapType& storageMap = StorageMap();
+    std::get<0>(storageMap[name]) = GetSingleton().parameters;
+    std::get<1>(storageMap[name]) = GetSingleton().aliases;
+    std::get<2>(storageMap[name]) = GetSingleton().functionMap;
+  }
 
   ClearSettings();
 }
@@ -204,19 +236,22 @@ void CLI::StoreSettings(const std::string& name)
 // Restore settings.
 void CLI::RestoreSettings(const std::string& name, const bool fatal)
 {
-  if (GetSingleton().storageMap.count(name) == 0 && fatal)
+  std::unique_lock<std::mutex> lock(StorageMutex());
+  StorageMapType& storageMap = StorageMap();
+  if (storageMap.count(name) == 0 && fatal)
     throw std::invalid_argument("no settings stored under the name '" + name
         + "'");
-  else if (GetSingleton().storageMap.count(name) == 0 && !fatal)
+  else if (storageMap.count(name) == 0 && !fatal)
   {
     // Nothing to do, just clear what's there.
+    lock.unlock();
     ClearSettings();
   }
   else
   {
-    GetSingleton().parameters = std::get<0>(GetSingleton().storageMap[name]);
-    GetSingleton().aliases = std::get<1>(GetSingleton().storageMap[name]);
-    GetSingleton().functionMap = std::get<2>(GetSingleton().storageMap[name]);
+    GetSingleton().parameters = std::get<0>(storageMap[name]);
+    GetSingleton().aliases = std::get<1>(storageMap[name]);
+    GetSingleton().functionMap = std::get<2>(storageMap[name]);
   }
 }
 
@@ -26,6 +26,7 @@
 #include "timers.hpp"
 #include "program_doc.hpp"
 #include "cli_deleter.hpp" // To make sure we can delete the singleton.
+#include "cli_context.hpp"
 #include "version.hpp"
 
 #include "param_data.hpp"
@@ -163,6 +164,14 @@ class ProgramDoc;
  * __LINE__ macro is used as an attempt to get a unique global identifier, but
  * collisions are still possible, and they produce bizarre error messages. See
  * https://github.com/mlpack/mlpack/issues/100 for more information.
+ *
+ * @section clicontext Running programs concurrently
+ *
+ * By default, there is one set of parameters for the whole process.  A thread
+ * that creates a util::CLIContext gets its own set of parameters and timers
+ * instead, for as long as the context exists; the settings stored with
+ * StoreSettings() are shared by all threads.  This allows several threads to
+ * run programs at the same time.
  */
 class CLI
 {
@@ -233,7 +242,8 @@ class CLI
    *
    * In this case, the singleton is used to store data for the static methods,
    * as there is no point in defining static methods only to have users call
-   * private instance methods.
+   * private instance methods.  If the calling thread has a util::CLIContext,
+   * the object of that context is returned instead.
    *
    * @return The singleton instance for use in the static methods.
    */
@@ -265,9 +275,9 @@ class CLI
 
   /**
    * Take all parameters and function mappings and store them, under the given
-   * name.  This can later be restored with RestoreSettings().  If settings have
-   * already been saved under the given name, they will be overwritten.  This
-   * also clears the current parameters and function map.
+   * name.  This can later be restored with RestoreSettings(), from any thread.
+   * If settings have already been saved under the given name, they will be
+   * overwritten.  This also clears the current parameters and function map.
    *
    * @param name Name of settings to save.
    */
@@ -302,15 +312,22 @@ class CLI
       void (*)(const util::ParamData&, const void*, void*)>> FunctionMapType;
   FunctionMapType functionMap;
 
- private:
-  //! Storage map for parameters.
-  std::map<std::string, std::tuple<std::map<std::string, util::ParamData>,
-      std::map<char, std::string>, FunctionMapType>> storageMap;
-
  private:
   //! The singleton itself.
   static CLI* singleton;
 
+  /**
+   * Make the given object the current one for the calling thread, or make the
+   * singleton the current one if NULL is given.
+   *
+   * @param context Object to make current.
+   * @return The object that was current before (NULL for the singleton).
+   */
+  static CLI* SetContext(CLI* context);
+
+  //! So that contexts can create CLI objects and make them current.
+  friend class util::CLIContext;
+
   //! True, if CLI was used to parse command line options.
  public:
   bool didParse;
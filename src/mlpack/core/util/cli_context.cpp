@@ -0,0 +1,33 @@
+/**
+ * @file cli_context.cpp
+ *
+ * Implementation of the CLIContext class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "cli_context.hpp"
+#include "cli.hpp"
+
+using namespace mlpack;
+using namespace mlpack::util;
+
+CLIContext::CLIContext() : cli(new CLI())
+{
+  // Keep the documentation of the program that is currently registered.
+  cli->doc = CLI::GetSingleton().doc;
+  previous = CLI::SetContext(cli);
+}
+
+CLIContext::CLIContext(const std::string& name) : CLIContext()
+{
+  CLI::RestoreSettings(name);
+}
+
+CLIContext::~CLIContext()
+{
+  CLI::SetContext(previous);
+  delete cli;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file cli_context.hpp
+ *
+ * Definition of the CLIContext class, which gives the calling thread its own
+ * set of CLI parameters.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_CLI_CONTEXT_HPP
+#define MLPACK_CORE_UTIL_CLI_CONTEXT_HPP
+
+#include <string>
+
+namespace mlpack {
+
+class CLI;
+
+namespace util {
+
+/**
+ * A CLIContext holds a separate set of parameters, aliases, function mappings
+ * and timers.  While it exists, all of the static CLI and Timer methods called
+ * from the thread that created it use the context instead of the process-wide
+ * CLI object, so that several threads can each run a program (e.g., the
+ * mlpackMain() function of a binding) at the same time:
+ *
+ * @code
+ * {
+ *   util::CLIContext context("K-Nearest-Neighbors Search");
+ *   CLI::GetParam<arma::mat>("reference") = std::move(referenceSet);
+ *   CLI::SetPassed("reference");
+ *   ...
+ *   mlpackMain();
+ * }
+ * @endcode
+ *
+ * The settings stored with CLI::StoreSettings() are shared by all threads, so
+ * a context can be filled with the parameters of any program.  Contexts may be
+ * nested, but they must be destroyed in the reverse order of their creation,
+ * and on the thread that created them.  Timers started on other threads (for
+ * instance, OpenMP worker threads) are recorded in the process-wide timers.
+ */
+class CLIContext
+{
+ public:
+  /**
+   * Create an empty context, and make it the current one for the calling
+   * thread.  The settings of a program can then be loaded into it with
+   * CLI::RestoreSettings().
+   */
+  CLIContext();
+
+  /**
+   * Create a context holding the settings stored under the given name, and
+   * make it the current one for the calling thread.  A std::invalid_argument
+   * exception is thrown if no settings are stored under that name.
+   *
+   * @param name Name of the settings to restore.
+   */
+  CLIContext(const std::string& name);
+
+  /**
+   * Destroy the context, making the context that was current before it was
+   * created the current one again.
+   */
+  ~CLIContext();
+
+ private:
+  // Non-copyable.
+  CLIContext(const CLIContext& other);
+  CLIContext& operator=(const CLIContext& other);
+
+  //! The parameters of this context.
+  CLI* cli;
+  //! The context that was current when this one was created (NULL if none).
+  CLI* previous;
+};
+
+} // namespace util
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,31 @@
+/**
+ * @file escape_json.cpp
+ *
+ * The implementation of EscapeJSON().
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "escape_json.hpp"
+
+#include <iomanip>
+#include <sstream>
+
+std::string mlpack::util::EscapeJSON(const std::string& str)
+{
+  std::ostringstream oss;
+  for (size_t i = 0; i < str.size(); ++i)
+  {
+    const char c = str[i];
+    if (c == '"' || c == '\\')
+      oss << '\\' << c;
+    else if ((unsigned char) c < 0x20)
+      oss << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+          << (int) c << std::dec;
+    else
+      oss << c;
+  }
+  return oss.str();
+}
@@ -0,0 +1,31 @@
+/**
+ * @file escape_json.hpp
+ *
+ * Escape a string for output in JSON.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_ESCAPE_JSON_HPP
+#define MLPACK_CORE_UTIL_ESCAPE_JSON_HPP
+
+#include <string>
+
+namespace mlpack {
+namespace util {
+
+/**
+ * Escape the given string so that it can be written between double quotes in
+ * JSON output: quotes and backslashes are escaped, and control characters are
+ * written as \\u escapes.
+ *
+ * @param str String to escape.
+ */
+std::string EscapeJSON(const std::string& str);
+
+} // namespace util
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,112 @@
+/**
+ * @file perf_counters.cpp
+ *
+ * Implementation of the perf_event wrapper.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "perf_counters.hpp"
+
+#if defined(__linux__)
+  #include <linux/perf_event.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+  #include <cstring>
+#endif
+
+using namespace mlpack;
+using namespace mlpack::util;
+
+PerfCounters::PerfCounters() : leader(-1)
+{
+  for (size_t i = 0; i < NumCounters; ++i)
+    fds[i] = -1;
+}
+
+PerfCounters::~PerfCounters()
+{
+#if defined(__linux__)
+  for (size_t i = 0; i < NumCounters; ++i)
+    if (fds[i] >= 0)
+      close(fds[i]);
+#endif
+}
+
+bool PerfCounters::Open()
+{
+#if defined(__linux__)
+  if (IsOpen())
+    return true;
+
+  const uint64_t configs[NumCounters] = { PERF_COUNT_HW_CPU_CYCLES,
+                                          PERF_COUNT_HW_CACHE_MISSES,
+                                          PERF_COUNT_HW_BRANCH_MISSES };
+
+  for (size_t i = 0; i < NumCounters; ++i)
+  {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = configs[i];
+    attr.read_format = PERF_FORMAT_GROUP;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    // Count for this thread only, on any CPU.
+    const long fd = syscall(__NR_perf_event_open, &attr, 0, -1,
+        (i == 0) ? -1 : fds[0], 0);
+    if (fd < 0)
+    {
+      // Give up and close anything we already opened.
+      for (size_t j = 0; j < i; ++j)
+      {
+        close(fds[j]);
+        fds[j] = -1;
+      }
+      return false;
+    }
+
+    fds[i] = (int) fd;
+  }
+
+  leader = fds[0];
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool PerfCounters::Read(uint64_t* values) const
+{
+  for (size_t i = 0; i < NumCounters; ++i)
+    values[i] = 0;
+
+#if defined(__linux__)
+  if (!IsOpen())
+    return false;
+
+  // With PERF_FORMAT_GROUP, the leader returns the number of counters followed
+  // by the value of each.
+  uint64_t buffer[NumCounters + 1];
+  const ssize_t bytes = read(leader, buffer, sizeof(buffer));
+  if (bytes != (ssize_t) sizeof(buffer) || buffer[0] != NumCounters)
+    return false;
+
+  for (size_t i = 0; i < NumCounters; ++i)
+    values[i] = buffer[i + 1];
+  return true;
+#else
+  return false;
+#endif
+}
+
+const char* PerfCounters::Name(const size_t counter)
+{
+  static const char* names[NumCounters] = { "cycles", "cache_misses",
+                                            "branch_misses" };
+  return (counter < NumCounters) ? names[counter] : "";
+}
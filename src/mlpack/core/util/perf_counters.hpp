@@ -0,0 +1,80 @@
+/**
+ * @file perf_counters.hpp
+ *
+ * A thin wrapper around the Linux perf_event interface, used to read hardware
+ * counters for the calling thread.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_PERF_COUNTERS_HPP
+#define MLPACK_CORE_UTIL_PERF_COUNTERS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mlpack {
+namespace util {
+
+/**
+ * PerfCounters reads a fixed set of hardware counters (CPU cycles, cache misses
+ * and branch misses) for the thread that opened them.  The counters are opened
+ * as one perf_event group, so all of them can be read with a single system
+ * call.
+ *
+ * On systems other than Linux, or when perf_event_open() is not permitted
+ * (e.g. because of /proc/sys/kernel/perf_event_paranoid or in a container),
+ * Open() returns false and the object does nothing.
+ *
+ * The counters must only be read from the thread that opened them.
+ */
+class PerfCounters
+{
+ public:
+  //! The number of counters that are read.
+  static const size_t NumCounters = 3;
+
+  //! Create the object, without opening any counters.
+  PerfCounters();
+
+  //! Close the counters, if they were opened.
+  ~PerfCounters();
+
+  /**
+   * Open the counters for the calling thread.  Returns false if the counters
+   * are not available.
+   */
+  bool Open();
+
+  //! Return whether the counters were successfully opened.
+  bool IsOpen() const { return leader >= 0; }
+
+  /**
+   * Read the current counter values into the given array, in the order CPU
+   * cycles, cache misses, branch misses.  If the counters are not open or
+   * cannot be read, the values are set to 0 and false is returned.
+   *
+   * @param values Array of NumCounters values to fill.
+   */
+  bool Read(uint64_t* values) const;
+
+  //! Get the name of the given counter, for output.
+  static const char* Name(const size_t counter);
+
+ private:
+  // Non-copyable, since we hold file descriptors.
+  PerfCounters(const PerfCounters& other);
+  PerfCounters& operator=(const PerfCounters& other);
+
+  //! File descriptor of the group leader (-1 if not open).
+  int leader;
+  //! File descriptors of all counters, including the leader.
+  int fds[NumCounters];
+};
+
+} // namespace util
+} // namespace mlpack
+
+#endif
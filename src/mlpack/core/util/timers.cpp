@@ -12,14 +12,210 @@
  */
 #include "timers.hpp"
 #include "cli.hpp"
+#include "escape_json.hpp"
 #include "log.hpp"
+#include "perf_counters.hpp"
 
+#include <atomic>
+#include <deque>
+#include <iomanip>
 #include <map>
+#include <memory>
+#include <set>
+#include <sstream>
 #include <string>
+#include <vector>
 
 using namespace mlpack;
 using namespace std::chrono;
 
+namespace {
+
+/**
+ * The accumulated values of one scoped timer.  These are only modified by the
+ * thread that owns them, but they may be read by other threads (when timers are
+ * exported), so they are atomic; since there is only ever one writer, relaxed
+ * loads and stores are sufficient.
+ */
+struct ScopedTimerEntry
+{
+  ScopedTimerEntry() : nanoseconds(0), calls(0), parent(SIZE_MAX)
+  {
+    for (size_t i = 0; i < util::PerfCounters::NumCounters; ++i)
+      counters[i] = 0;
+  }
+
+  std::atomic<int64_t> nanoseconds;
+  std::atomic<uint64_t> calls;
+  std::atomic<uint64_t> counters[util::PerfCounters::NumCounters];
+  //! The scoped timer that was active when this one was first entered inside
+  //! another one (SIZE_MAX if none).
+  std::atomic<size_t> parent;
+
+  //! Add to a value; only the owning thread may call this.
+  template<typename T, typename U>
+  static void Add(std::atomic<T>& value, const U delta)
+  {
+    value.store(value.load(std::memory_order_relaxed) + delta,
+        std::memory_order_relaxed);
+  }
+};
+
+//! A scoped timer that is currently running in a thread.
+struct ScopedTimerFrame
+{
+  size_t id;
+  steady_clock::time_point start;
+  //! Whether the hardware counters were read when the timer was entered; if
+  //! not (for instance, because they were enabled later), no counts are added
+  //! when it is left.
+  bool hasCounters;
+  uint64_t counters[util::PerfCounters::NumCounters];
+};
+
+//! The scoped timers of a single thread.
+struct ThreadTimerData
+{
+  ThreadTimerData() : countersTried(false) { }
+
+  //! The values of each scoped timer.  This is a deque so that it can grow
+  //! without moving the (non-movable) atomics.
+  std::deque<ScopedTimerEntry> entries;
+  //! The stack of scoped timers that are currently running.
+  std::vector<ScopedTimerFrame> stack;
+  //! Hardware counters for this thread.
+  util::PerfCounters counters;
+  //! Whether we have tried to open the counters yet.
+  bool countersTried;
+};
+
+/**
+ * The registry of scoped timer names and of the per-thread data of every
+ * thread.  This outlives all threads that use scoped timers, so it is kept
+ * outside of the CLI singleton (which can be destroyed and recreated).
+ */
+struct ScopedTimerRegistry
+{
+  ScopedTimerRegistry() : countersEnabled(false), countersUsed(false) { }
+
+  //! Lock for everything except the entries of each thread.
+  std::mutex mutex;
+  //! The name of each scoped timer.
+  std::vector<std::string> names;
+  //! Mapping from name to ID.
+  std::map<std::string, size_t> ids;
+  //! The data of every thread that is still running.
+  std::set<ThreadTimerData*> threads;
+  //! The accumulated values from threads that have exited.
+  std::deque<ScopedTimerEntry> retired;
+  //! Whether hardware counters should be opened by new threads.
+  std::atomic<bool> countersEnabled;
+  //! Whether any thread managed to open hardware counters.
+  std::atomic<bool> countersUsed;
+};
+
+ScopedTimerRegistry& Registry()
+{
+  static ScopedTimerRegistry registry;
+  return registry;
+}
+
+//! Add the values of one entry to another.  The registry lock must be held.
+void Accumulate(ScopedTimerEntry& to, const ScopedTimerEntry& from)
+{
+  ScopedTimerEntry::Add(to.nanoseconds,
+      from.nanoseconds.load(std::memory_order_relaxed));
+  ScopedTimerEntry::Add(to.calls, from.calls.load(std::memory_order_relaxed));
+  for (size_t i = 0; i < util::PerfCounters::NumCounters; ++i)
+  {
+    ScopedTimerEntry::Add(to.counters[i],
+        from.counters[i].load(std::memory_order_relaxed));
+  }
+
+  const size_t parent = from.parent.load(std::memory_order_relaxed);
+  if (to.parent.load(std::memory_order_relaxed) == SIZE_MAX)
+    to.parent.store(parent, std::memory_order_relaxed);
+}
+
+/**
+ * Holds the data of the current thread; when the thread exits, its values are
+ * moved to the registry.
+ */
+struct ThreadTimerDataHolder
+{
+  ~ThreadTimerDataHolder()
+  {
+    if (!data)
+      return;
+
+    ScopedTimerRegistry& registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    while (registry.retired.size() < data->entries.size())
+      registry.retired.emplace_back();
+    for (size_t i = 0; i < data->entries.size(); ++i)
+      Accumulate(registry.retired[i], data->entries[i]);
+    registry.threads.erase(data.get());
+  }
+
+  std::unique_ptr<ThreadTimerData> data;
+};
+
+ThreadTimerData& LocalTimerData()
+{
+  static thread_local ThreadTimerDataHolder holder;
+  if (!holder.data)
+  {
+    holder.data.reset(new ThreadTimerData());
+
+    ScopedTimerRegistry& registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.threads.insert(holder.data.get());
+  }
+
+  return *holder.data;
+}
+
+//! Write a scoped timer and its children as JSON.
+void ExportScopedTimer(std::ostream& stream,
+                       const size_t id,
+                       const std::vector<std::string>& names,
+                       const std::deque<ScopedTimerEntry>& totals,
+                       const std::vector<std::vector<size_t>>& children,
+                       const bool withCounters,
+                       const size_t indent)
+{
+  const std::string pad(indent, ' ');
+  const ScopedTimerEntry& e = totals[id];
+  stream << pad << "{" << std::endl;
+  stream << pad << "  \"name\": \"" << util::EscapeJSON(names[id]) << "\","
+      << std::endl;
+  stream << pad << "  \"calls\": " << e.calls.load() << "," << std::endl;
+  stream << pad << "  \"time\": " << std::fixed << std::setprecision(9)
+      << (e.nanoseconds.load() / 1e9) << "," << std::endl;
+  if (withCounters)
+  {
+    for (size_t i = 0; i < util::PerfCounters::NumCounters; ++i)
+    {
+      stream << pad << "  \"" << util::PerfCounters::Name(i) << "\": "
+          << e.counters[i].load() << "," << std::endl;
+    }
+  }
+
+  stream << pad << "  \"children\": [";
+  for (size_t i = 0; i < children[id].size(); ++i)
+  {
+    stream << ((i == 0) ? "" : ",") << std::endl;
+    ExportScopedTimer(stream, children[id][i], names, totals, children,
+        withCounters, indent + 4);
+  }
+  if (!children[id].empty())
+    stream << std::endl << pad << "  ";
+  stream << "]" << std::endl;
+  stream << pad << "}";
+}
+
+} // anonymous namespace
+
 /**
  * Start the given timer.
  */
@@ -44,24 +240,234 @@ microseconds Timer::Get(const std::string& name)
   return CLI::GetSingleton().timer.GetTimer(name);
 }
 
-std::map<std::string, microseconds>& Timers::GetAllTimers()
+/**
+ * Get the ID of a scoped timer.
+ */
+size_t Timer::GetID(const std::string& name)
 {
+  ScopedTimerRegistry& registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  std::map<std::string, size_t>::const_iterator it = registry.ids.find(name);
+  if (it != registry.ids.end())
+    return it->second;
+
+  const size_t id = registry.names.size();
+  registry.names.push_back(name);
+  registry.ids[name] = id;
+  return id;
+}
+
+/**
+ * Enter a scoped timer in the calling thread.
+ */
+void Timer::Enter(const size_t id)
+{
+  ThreadTimerData& data = LocalTimerData();
+
+  // Make room for this timer, if needed.  The lock is needed because another
+  // thread may be reading our entries.
+  if (id >= data.entries.size())
+  {
+    std::lock_guard<std::mutex> lock(Registry().mutex);
+    while (data.entries.size() <= id)
+      data.entries.emplace_back();
+  }
+
+  ScopedTimerEntry& entry = data.entries[id];
+  if (!data.stack.empty() &&
+      entry.parent.load(std::memory_order_relaxed) == SIZE_MAX)
+  {
+    entry.parent.store(data.stack.back().id, std::memory_order_relaxed);
+  }
+
+  // Open the hardware counters the first time we are asked to.
+  if (!data.countersTried && Registry().countersEnabled.load())
+  {
+    data.countersTried = true;
+    if (data.counters.Open())
+      Registry().countersUsed.store(true);
+  }
+
+  data.stack.push_back(ScopedTimerFrame());
+  ScopedTimerFrame& frame = data.stack.back();
+  frame.id = id;
+  frame.hasCounters = data.counters.Read(frame.counters);
+  frame.start = steady_clock::now();
+}
+
+/**
+ * Leave a scoped timer in the calling thread.
+ */
+void Timer::Leave(const size_t id)
+{
+  const steady_clock::time_point end = steady_clock::now();
+  ThreadTimerData& data = LocalTimerData();
+
+  // This can only happen if Enter() and Leave() are called by hand in the wrong
+  // order; we can't throw, since we are probably in a destructor.
+  if (data.stack.empty() || data.stack.back().id != id)
+    return;
+
+  const ScopedTimerFrame& frame = data.stack.back();
+  ScopedTimerEntry& entry = data.entries[id];
+  ScopedTimerEntry::Add(entry.nanoseconds,
+      duration_cast<nanoseconds>(end - frame.start).count());
+  ScopedTimerEntry::Add(entry.calls, 1);
+
+  if (frame.hasCounters)
+  {
+    uint64_t counters[util::PerfCounters::NumCounters];
+    if (data.counters.Read(counters))
+    {
+      for (size_t i = 0; i < util::PerfCounters::NumCounters; ++i)
+        ScopedTimerEntry::Add(entry.counters[i], counters[i] -
+            frame.counters[i]);
+    }
+  }
+
+  data.stack.pop_back();
+}
+
+/**
+ * Get the total time of a scoped timer.
+ */
+nanoseconds Timer::GetScoped(const size_t id)
+{
+  ScopedTimerRegistry& registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  int64_t total = 0;
+  if (id < registry.retired.size())
+    total += registry.retired[id].nanoseconds.load(std::memory_order_relaxed);
+
+  std::set<ThreadTimerData*>::const_iterator it;
+  for (it = registry.threads.begin(); it != registry.threads.end(); ++it)
+  {
+    if (id < (*it)->entries.size())
+    {
+      total += (*it)->entries[id].nanoseconds.load(
+          std::memory_order_relaxed);
+    }
+  }
+
+  return nanoseconds(total);
+}
+
+/**
+ * Enable or disable hardware counters.
+ */
+void Timer::EnableHardwareCounters(const bool enable)
+{
+  Registry().countersEnabled.store(enable);
+}
+
+/**
+ * Write all timers as JSON.
+ */
+void Timer::ExportJSON(std::ostream& stream)
+{
+  // Save the formatting of the stream, since we will change it.
+  const std::ios::fmtflags flags = stream.flags();
+  const std::streamsize precision = stream.precision();
+
+  stream << "{" << std::endl << "  \"timers\": {";
+  {
+    // Other threads may be starting or stopping timers, so take a copy.
+    const std::map<std::string, microseconds> named =
+        CLI::GetSingleton().timer.GetAllTimers();
+    std::map<std::string, microseconds>::const_iterator it;
+    for (it = named.begin(); it != named.end(); ++it)
+    {
+      stream << ((it == named.begin()) ? "" : ",") << std::endl;
+      stream << "    \"" << util::EscapeJSON(it->first) << "\": " << std::fixed
+          << std::setprecision(6) << (it->second.count() / 1e6);
+    }
+    if (!named.empty())
+      stream << std::endl << "  ";
+  }
+  stream << "}," << std::endl;
+
+  // Sum the scoped timers over all threads.
+  ScopedTimerRegistry& registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  const size_t numTimers = registry.names.size();
+  std::deque<ScopedTimerEntry> totals(numTimers);
+  for (size_t i = 0; i < std::min(numTimers, registry.retired.size()); ++i)
+    Accumulate(totals[i], registry.retired[i]);
+  std::set<ThreadTimerData*>::const_iterator it;
+  for (it = registry.threads.begin(); it != registry.threads.end(); ++it)
+  {
+    for (size_t i = 0; i < std::min(numTimers, (*it)->entries.size()); ++i)
+      Accumulate(totals[i], (*it)->entries[i]);
+  }
+
+  // Build the hierarchy.  Different threads may disagree on the parent of a
+  // timer, so we guard against cycles by only following parents that lead to a
+  // root.
+  std::vector<std::vector<size_t>> children(numTimers);
+  std::vector<size_t> roots;
+  for (size_t i = 0; i < numTimers; ++i)
+  {
+    size_t parent = totals[i].parent.load();
+    size_t steps = 0;
+    for (size_t p = parent; p != SIZE_MAX && steps <= numTimers; ++steps)
+      p = totals[p].parent.load();
+
+    if (parent == SIZE_MAX || steps > numTimers)
+      roots.push_back(i);
+    else
+      children[parent].push_back(i);
+  }
+
+  const bool withCounters = registry.countersUsed.load();
+  stream << "  \"scoped_timers\": [";
+  for (size_t i = 0; i < roots.size(); ++i)
+  {
+    stream << ((i == 0) ? "" : ",") << std::endl;
+    ExportScopedTimer(stream, roots[i], registry.names, totals, children,
+        withCounters, 4);
+  }
+  if (!roots.empty())
+    stream << std::endl << "  ";
+  stream << "]" << std::endl << "}" << std::endl;
+
+  stream.flags(flags);
+  stream.precision(precision);
+}
+
+std::map<std::string, microseconds> Timers::GetAllTimers()
+{
+  std::lock_guard<std::mutex> lock(timersMutex);
   return timers;
 }
 
 microseconds Timers::GetTimer(const std::string& timerName)
 {
+  std::lock_guard<std::mutex> lock(timersMutex);
   return timers[timerName];
 }
 
 bool Timers::GetState(std::string timerName)
 {
-  return timerState[timerName];
+  std::lock_guard<std::mutex> lock(timersMutex);
+  return timerStartTime[std::this_thread::get_id()].count(timerName) > 0;
 }
 
 void Timers::PrintTimer(const std::string& timerName)
 {
-  microseconds totalDuration = timers[timerName];
+  // Other threads may be starting or stopping timers, so read the value under
+  // the lock; a timer that doesn't exist is printed as zero.
+  microseconds totalDuration(0);
+  {
+    std::lock_guard<std::mutex> lock(timersMutex);
+    std::map<std::string, microseconds>::const_iterator it =
+        timers.find(timerName);
+    if (it != timers.end())
+      totalDuration = it->second;
+  }
+
   // Convert microseconds to seconds.
   seconds totalDurationSec = duration_cast<seconds>(totalDuration);
   microseconds totalDurationMicroSec =
@@ -126,7 +532,11 @@ high_resolution_clock::time_point Timers::GetTime()
 
 void Timers::StartTimer(const std::string& timerName)
 {
-  if ((timerState[timerName] == 1) && (timerName != "total_time"))
+  std::lock_guard<std::mutex> lock(timersMutex);
+  std::map<std::string, high_resolution_clock::time_point>& startTimes =
+      timerStartTime[std::this_thread::get_id()];
+
+  if ((startTimes.count(timerName) > 0) && (timerName != "total_time"))
   {
     std::ostringstream error;
     error << "Timer::Start(): timer '" << timerName
@@ -134,8 +544,6 @@ void Timers::StartTimer(const std::string& timerName)
     throw std::runtime_error(error.str());
   }
 
-  timerState[timerName] = true;
-
   high_resolution_clock::time_point currTime = GetTime();
 
   // If the timer is added first time
@@ -144,24 +552,56 @@ void Timers::StartTimer(const std::string& timerName)
     timers[timerName] = (microseconds) 0;
   }
 
-  timerStartTime[timerName] = currTime;
+  startTimes[timerName] = currTime;
 }
 
 void Timers::StopTimer(const std::string& timerName)
 {
-  if ((timerState[timerName] == 0) && (timerName != "total_time"))
+  high_resolution_clock::time_point currTime = GetTime();
+
+  std::lock_guard<std::mutex> lock(timersMutex);
+  std::map<std::string, high_resolution_clock::time_point>& startTimes =
+      timerStartTime[std::this_thread::get_id()];
+
+  std::map<std::string, high_resolution_clock::time_point>::iterator it =
+      startTimes.find(timerName);
+  if (it == startTimes.end())
   {
+    // Stopping "total_time" when it isn't running is allowed.
+    if (timerName == "total_time")
+      return;
+
     std::ostringstream error;
     error << "Timer::Stop(): timer '" << timerName
         << "' has already been stopped";
     throw std::runtime_error(error.str());
   }
 
-  timerState[timerName] = false;
+  // Calculate the delta time.
+  timers[timerName] += duration_cast<microseconds>(currTime - it->second);
+  startTimes.erase(it);
+}
 
+void Timers::StopAllTimers()
+{
   high_resolution_clock::time_point currTime = GetTime();
 
-  // Calculate the delta time.
-  timers[timerName] += duration_cast<microseconds>(currTime -
-      timerStartTime[timerName]);
+  std::lock_guard<std::mutex> lock(timersMutex);
+  std::map<std::thread::id, std::map<std::string,
+      high_resolution_clock::time_point>>::iterator it;
+  for (it = timerStartTime.begin(); it != timerStartTime.end(); ++it)
+  {
+    std::map<std::string, high_resolution_clock::time_point>::iterator it2;
+    for (it2 = it->second.begin(); it2 != it->second.end(); ++it2)
+      timers[it2->first] += duration_cast<microseconds>(currTime - it2->second);
+  }
+
+  timerStartTime.clear();
+}
+
+void Timers::Reset()
+{
+  std::lock_guard<std::mutex> lock(timersMutex);
+  timers.clear();
+  timerStartTime.clear();
 }
@@ -14,7 +14,10 @@
 #define MLPACK_CORE_UTILITIES_TIMERS_HPP
 
 #include <map>
+#include <mutex>
+#include <ostream>
 #include <string>
+#include <thread>
 #include <chrono> // chrono library for cross platform timer calculation
 
 #if defined(_WIN32)
@@ -32,8 +35,18 @@ namespace mlpack {
 
 /**
  * The timer class provides a way for mlpack methods to be timed.  The three
- * methods contained in this class allow a named timer to be started and
- * stopped, and its value to be obtained.
+ * methods Start(), Stop() and Get() allow a named timer to be started and
+ * stopped, and its value to be obtained.  Named timers may be used from any
+ * thread; each thread has its own running state for each timer, and the times
+ * of all threads are added together.
+ *
+ * Named timers cost a lookup (and a lock) each time they are started or
+ * stopped.  For code that is run very often, scoped timers are cheaper: get an
+ * ID for the timer once with GetID(), then use a ScopedTimer with that ID.
+ * Scoped timers are kept per thread without locking, and are hierarchical: a
+ * scoped timer entered while another is active is reported as its child.  If
+ * EnableHardwareCounters() has been called, scoped timers also record CPU
+ * cycles, cache misses and branch misses (on Linux, when permitted).
  */
 class Timer
 {
@@ -45,7 +58,7 @@ class Timer
    * run, and do not reset.
    *
    * @note A std::runtime_error exception will be thrown if a timer is started
-   * twice.
+   * twice in the same thread.
    *
    * @param name Name of timer to be started.
    */
@@ -67,6 +80,87 @@ class Timer
    * @param name Name of timer to return value of.
    */
   static std::chrono::microseconds Get(const std::string& name);
+
+  /**
+   * Get the ID of the scoped timer with the given name, registering the timer
+   * if it has not been seen before.  This takes a lock, so the ID should be
+   * obtained once (for instance, into a static local variable) and reused.
+   *
+   * @param name Name of scoped timer.
+   */
+  static size_t GetID(const std::string& name);
+
+  /**
+   * Enter the scoped timer with the given ID in the calling thread.  Use
+   * ScopedTimer instead of calling this directly.
+   *
+   * @param id ID of scoped timer, from GetID().
+   */
+  static void Enter(const size_t id);
+
+  /**
+   * Leave the scoped timer with the given ID in the calling thread; it must be
+   * the last scoped timer that was entered.  Use ScopedTimer instead of
+   * calling this directly.
+   *
+   * @param id ID of scoped timer, from GetID().
+   */
+  static void Leave(const size_t id);
+
+  /**
+   * Get the total time spent in the given scoped timer, over all threads.
+   *
+   * @param id ID of scoped timer, from GetID().
+   */
+  static std::chrono::nanoseconds GetScoped(const size_t id);
+
+  /**
+   * Enable or disable hardware counters for scoped timers.  Each thread opens
+   * its counters the first time it enters a scoped timer while they are
+   * enabled.  If the counters aren't available, only times are recorded.
+   *
+   * @param enable Whether or not to record hardware counters.
+   */
+  static void EnableHardwareCounters(const bool enable = true);
+
+  /**
+   * Write the values of all named timers and scoped timers to the given stream
+   * as a JSON object.  Times are given in seconds.  Scoped timers are nested
+   * under the timer they were first entered in.
+   *
+   * @param stream Stream to write to.
+   */
+  static void ExportJSON(std::ostream& stream);
+};
+
+/**
+ * A ScopedTimer enters the scoped timer with the given ID when it is
+ * constructed, and leaves it when it is destroyed.  For example:
+ *
+ * @code
+ * static const size_t timerID = Timer::GetID("tree_traversal");
+ * {
+ *   ScopedTimer t(timerID);
+ *   // ... code to time ...
+ * }
+ * @endcode
+ */
+class ScopedTimer
+{
+ public:
+  //! Enter the scoped timer with the given ID.
+  ScopedTimer(const size_t id) : id(id) { Timer::Enter(id); }
+
+  //! Leave the scoped timer.
+  ~ScopedTimer() { Timer::Leave(id); }
+
+ private:
+  // Non-copyable.
+  ScopedTimer(const ScopedTimer& other);
+  ScopedTimer& operator=(const ScopedTimer& other);
+
+  //! The ID of the scoped timer.
+  size_t id;
 };
 
 class Timers
@@ -76,9 +170,11 @@ class Timers
   Timers() { }
 
   /**
-   * Returns a copy of all the timers used via this interface.
+   * Returns a copy of all the timers used via this interface.  The copy is
+   * taken while holding the lock, so that it is safe to use while other
+   * threads start and stop timers.
    */
-  std::map<std::string, std::chrono::microseconds>& GetAllTimers();
+  std::map<std::string, std::chrono::microseconds> GetAllTimers();
 
   /**
    * Returns a copy of the timer specified.
@@ -114,20 +210,31 @@ class Timers
   void StopTimer(const std::string& timerName);
 
   /**
-   * Returns state of the given timer.
+   * Returns state of the given timer in the calling thread.
    *
    * @param timerName The name of the timer in question.
    */
   bool GetState(std::string timerName);
 
+  /**
+   * Stop every timer that is running, in any thread.
+   */
+  void StopAllTimers();
+
+  /**
+   * Remove all timers, including those that are running.
+   */
+  void Reset();
+
  private:
   //! A map of all the timers that are being tracked.
   std::map<std::string, std::chrono::microseconds> timers;
-  //! A map that contains whether or not each timer is currently running.
-  std::map<std::string, bool> timerState;
-  //! A map for the starting values of the timers.
-  std::map<std::string, std::chrono::high_resolution_clock::time_point>
-      timerStartTime;
+  //! For each thread, the starting values of the timers that are currently
+  //! running in that thread.
+  std::map<std::thread::id, std::map<std::string,
+      std::chrono::high_resolution_clock::time_point>> timerStartTime;
+  //! Lock for all of the maps.
+  std::mutex timersMutex;
 
   std::chrono::high_resolution_clock::time_point GetTime();
 };
@@ -15,7 +15,7 @@
 
 #include <mlpack/core.hpp>
 #include <mlpack/methods/range_search/range_search.hpp>
-#include <mlpack/methods/emst/union_find.hpp>
+#include <mlpack/methods/emst/concurrent_union_find.hpp>
 #include "random_point_selection.hpp"
 #include <boost/dynamic_bitset.hpp>
 
@@ -43,6 +43,20 @@ namespace dbscan {
  * range search technique used and the point selection strategy by means of
  * template parameters.
  *
+ * A point is a core point if at least minPoints points (including itself) lie
+ * within distance epsilon of it.  Core points within epsilon of each other are
+ * in the same cluster; a non-core point within epsilon of a core point is a
+ * border point, and is assigned to the cluster of its lowest-index core
+ * neighbor.  All other points are noise.
+ *
+ * The range searches are performed on blocks of points at a time, so the
+ * neighbor lists of the whole dataset are never held in memory at once.  When
+ * OpenMP is available, the range searches of each block are split between the
+ * threads, which all search the same reference tree (this requires the
+ * concurrent Search() overload of range::RangeSearch), and the neighbor lists
+ * are processed in parallel, merging clusters through a lock-free union-find
+ * structure.  The results do not depend on the number of threads.
+ *
  * @tparam RangeSearchType Class to use for range searching.
  * @tparam PointSelectionPolicy Strategy for selecting next point to cluster
  *      with.
@@ -60,7 +74,8 @@ class DBSCAN
    * could be slower but will use less memory.
    *
    * @param epsilon Size of range query.
-   * @param minPoints Minimum number of points for each cluster.
+   * @param minPoints Minimum number of points in the epsilon-neighborhood of a
+   *     point (including itself) for it to be a core point.
    * @param batchMode If true, all points are searched in batch.
    * @param rangeSearch Optional instantiated RangeSearch object.
    * @param pointSelector OptionL instantiated PointSelectionPolicy object.
@@ -119,7 +134,8 @@ class DBSCAN
   //! itself) for the point to be a core-point.
   size_t minPoints;
 
-  //! Whether or not to perform the search in batch mode.  If false, single
+  //! Whether or not to perform the search in batch mode.  If false, each point
+  //! is searched for individually.
   bool batchMode;
 
   //! Instantiated range search policy.
@@ -128,32 +144,61 @@ class DBSCAN
   //! Instantiated point selection policy.
   PointSelectionPolicy pointSelector;
 
+  //! Number of points whose neighbor lists are held in memory at once.
+  static constexpr size_t BlockSize = 4096;
+
   /**
-   * Performs DBSCAN clustering on the data, returning the number of clusters and
-   * also the list of cluster assignments.  This searches each point iteratively,
-   * and can save on RAM usage.  It may be slower than the batch search with a
-   * dual-tree algorithm.
+   * Find the epsilon-neighborhood of each point in the block [begin, end) by
+   * searching for each point individually.  This may be slower than the batch
+   * search with a dual-tree algorithm.  Several threads may call this at once
+   * for different blocks.
    *
    * @param data Dataset to cluster.
-   * @param assignments Assignments for each point.
-   * @param uf UnionFind structure that will be modified.
+   * @param begin Index of first point in the block.
+   * @param end Index one past the last point in the block.
+   * @param neighbors Neighbors of each point in the block.
    */
   template<typename MatType>
-  void PointwiseCluster(const MatType& data,
-                        emst::UnionFind& uf);
+  void PointwiseSearch(const MatType& data,
+                       const size_t begin,
+                       const size_t end,
+                       range::CSRResultSink& neighbors) const;
 
   /**
-   * Performs DBSCAN clustering on the data, returning number of clusters
-   * and also the list of cluster assignments.  This can perform search in batch,
-   * so it is well suited for dual-tree or naive search.
+   * Find the epsilon-neighborhood of each point in the block [begin, end) with
+   * a single range search, so that dual-tree algorithms can be used.  Several
+   * threads may call this at once for different blocks.
    *
    * @param data Dataset to cluster.
-   * @param assignments Assignments for each point.
-   * @param uf UnionFind structure that will be modified.
+   * @param begin Index of first point in the block.
+   * @param end Index one past the last point in the block.
+   * @param neighbors Neighbors of each point in the block.
    */
   template<typename MatType>
-  void BatchCluster(const MatType& data,
-                    emst::UnionFind& uf);
+  void BatchSearch(const MatType& data,
+                   const size_t begin,
+                   const size_t end,
+                   range::CSRResultSink& neighbors) const;
+
+  /**
+   * Given the neighbors of each point in the block [begin, end), mark the core
+   * points of the block and merge them with their core neighbors.  Each pair of
+   * neighbors is handled when the point with the larger index is processed, at
+   * which point the core status of both is known; so all of the points before
+   * 'begin' must already have been processed.
+   *
+   * @param begin Index of first point in the block.
+   * @param neighbors Neighbors of each point in the block.
+   * @param uf Union-find structure holding the clusters of core points.
+   * @param corePoints Core point status of each point.
+   * @param borderOwners For each border point, the lowest-index core point in
+   *     its neighborhood (SIZE_MAX if there is none yet).
+   */
+  void ProcessBlock(const size_t begin,
+                    const range::CSRResultSink& neighbors,
+                    emst::ConcurrentUnionFind& uf,
+                    boost::dynamic_bitset<>& corePoints,
+                    arma::Col<size_t>& borderOwners);
 };
 
 } // namespace dbscan
@@ -100,40 +100,103 @@ size_t DBSCAN<RangeSearchType, PointSelectionPolicy>::Cluster(
     const MatType& data,
     arma::Row<size_t>& assignments)
 {
-  // Initialize the UnionFind object.
-  emst::UnionFind uf(data.n_cols);
+  // Initialize the UnionFind object, which will hold the clusters of the core
+  // points.
+  emst::ConcurrentUnionFind uf(data.n_cols);
+  boost::dynamic_bitset<> corePoints(data.n_cols);
+  arma::Col<size_t> borderOwners(data.n_cols);
+  borderOwners.fill(SIZE_MAX);
+
   rangeSearch.Train(data);
 
-  if (batchMode)
-    BatchCluster(data, uf);
-  else
-    PointwiseCluster(data, uf);
+  // Process the points in blocks, so that we only ever need to hold the
+  // neighbors of a block of points in memory.  Each block is split into one
+  // sub-block per thread, and the sub-blocks are searched in parallel, against
+  // the reference tree built above.  The neighbors of each sub-block are stored
+  // in two flat arrays, which are reused for each block.  Single-tree search
+  // with a tree whose first point is the centroid of the node (such as the
+  // cover tree) stores distances in the reference tree, so then the sub-blocks
+  // are searched one at a time.
+  size_t numSubBlocks = 1;
+  #ifdef HAS_OPENMP
+    numSubBlocks = omp_get_max_threads();
+  #endif
+  const bool parallel = !tree::TreeTraits<
+      typename RangeSearchType::Tree>::FirstPointIsCentroid;
+  std::vector<range::CSRResultSink> neighbors(numSubBlocks,
+      range::CSRResultSink(false));
+  std::vector<std::exception_ptr> exceptions(numSubBlocks);
+  for (size_t begin = 0; begin < data.n_cols; begin += BlockSize)
+  {
+    const size_t end = (data.n_cols - begin > BlockSize) ? begin + BlockSize :
+        data.n_cols;
+    if (begin > 0)
+    {
+      Log::Info << "DBSCAN clustering on point " << begin << " of "
+          << data.n_cols << "..." << std::endl;
+    }
 
-  // Now set assignments.
-  assignments.set_size(data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
-    assignments[i] = uf.Find(i);
+    // Every sub-block holds at least one point.  An exception can't leave the
+    // parallel region, so the exception of each sub-block is stored and the
+    // first one is rethrown afterwards.
+    const size_t blockSubBlocks = std::min(numSubBlocks, end - begin);
+    #pragma omp parallel for schedule(static) if(parallel)
+    for (omp_size_t i = 0; i < (omp_size_t) blockSubBlocks; ++i)
+    {
+      const size_t subBegin = begin + i * (end - begin) / blockSubBlocks;
+      const size_t subEnd = begin + (i + 1) * (end - begin) / blockSubBlocks;
+      try
+      {
+        if (batchMode)
+          BatchSearch(data, subBegin, subEnd, neighbors[i]);
+        else
+          PointwiseSearch(data, subBegin, subEnd, neighbors[i]);
+      }
+      catch (...)
+      {
+        exceptions[i] = std::current_exception();
+      }
+    }
+
+    for (size_t i = 0; i < blockSubBlocks; ++i)
+    {
+      if (exceptions[i])
+        std::rethrow_exception(exceptions[i]);
+    }
 
-  // Get a count of all clusters.
-  const size_t numClusters = arma::max(assignments) + 1;
-  arma::Col<size_t> counts(numClusters, arma::fill::zeros);
-  for (size_t i = 0; i < assignments.n_elem; ++i)
-    counts[assignments[i]]++;
+    // The sub-blocks are processed in order, so that all of the points before
+    // each sub-block have been processed.
+    for (size_t i = 0; i < blockSubBlocks; ++i)
+    {
+      const size_t subBegin = begin + i * (end - begin) / blockSubBlocks;
+      ProcessBlock(subBegin, neighbors[i], uf, corePoints, borderOwners);
+    }
+  }
 
-  // Now assign clusters to new indices.
+  // Every component of core points is a cluster; assign cluster indices in
+  // order of the lowest-index core point of each cluster (which is also the
+  // representative of the component).
   size_t currentCluster = 0;
-  arma::Col<size_t> newAssignments(numClusters);
-  for (size_t i = 0; i < counts.n_elem; ++i)
+  arma::Col<size_t> newAssignments(data.n_cols);
+  newAssignments.fill(SIZE_MAX);
+  for (size_t i = 0; i < data.n_cols; ++i)
   {
-    if (counts[i] >= minPoints)
+    if (corePoints[i] && uf.Find(i) == i)
       newAssignments[i] = currentCluster++;
-    else
-      newAssignments[i] = SIZE_MAX;
   }
 
-  // Now reassign.
-  for (size_t i = 0; i < assignments.n_elem; ++i)
-    assignments[i] = newAssignments[assignments[i]];
+  // Now set assignments; border points take the cluster of their core
+  // neighbor, and anything else is noise.
+  assignments.set_size(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    if (corePoints[i])
+      assignments[i] = newAssignments[uf.Find(i)];
+    else if (borderOwners[i] != SIZE_MAX)
+      assignments[i] = newAssignments[uf.Find(borderOwners[i])];
+    else
+      assignments[i] = SIZE_MAX;
+  }
 
   Log::Info << currentCluster << " clusters found." << std::endl;
 
@@ -141,60 +204,139 @@ size_t DBSCAN<RangeSearchType, PointSelectionPolicy>::Cluster(
 }
 
 /**
- * Performs DBSCAN clustering on the data, returning the number of clusters and
- * also the list of cluster assignments.  This searches each point iteratively,
- * and can save on RAM usage.  It may be slower than the batch search with a
- * dual-tree algorithm.
+ * Find the epsilon-neighborhood of each point in the block by searching for
+ * each point individually.  This can save on RAM usage, but it may be slower
+ * than the batch search with a dual-tree algorithm.
  */
 template<typename RangeSearchType, typename PointSelectionPolicy>
 template<typename MatType>
-void DBSCAN<RangeSearchType, PointSelectionPolicy>::PointwiseCluster(
+void DBSCAN<RangeSearchType, PointSelectionPolicy>::PointwiseSearch(
     const MatType& data,
-    emst::UnionFind& uf)
+    const size_t begin,
+    const size_t end,
+    range::CSRResultSink& neighbors) const
 {
-  std::vector<std::vector<size_t>> neighbors;
-  std::vector<std::vector<double>> distances;
-
-  for (size_t i = 0; i < data.n_cols; ++i)
+  // The search doesn't modify rangeSearch, so that several threads can search
+  // at once; the base case and score counts aren't needed.
+  size_t baseCases = 0;
+  size_t scores = 0;
+  neighbors.Begin(end - begin);
+  std::vector<size_t> queryIndex(1);
+  for (size_t i = begin; i < end; ++i)
   {
-    if (i % 10000 == 0 && i > 0)
-      Log::Info << "DBSCAN clustering on point " << i << "..." << std::endl;
-
-    // Do the range search for only this point.
-    rangeSearch.Search(data.col(i), math::Range(0.0, epsilon), neighbors,
-        distances);
-
-    // Union to all neighbors.
-    for (size_t j = 0; j < neighbors[0].size(); ++j)
-      uf.Union(i, neighbors[0][j]);
+    // Do the range search for only this point, and store its neighbors as
+    // those of point i - begin of the block.
+    queryIndex[0] = i - begin;
+    range::MappedResultSink<range::CSRResultSink> pointNeighbors(neighbors,
+        &queryIndex, NULL);
+    rangeSearch.Search(data.col(i), math::Range(0.0, epsilon), pointNeighbors,
+        baseCases, scores);
   }
+  neighbors.End();
 }
 
 /**
- * Performs DBSCAN clustering on the data, returning number of clusters
- * and also the list of cluster assignments.  This can perform search in batch,
- * naive search).
+ * Find the epsilon-neighborhood of each point in the block with one range
+ * search.  This is well suited for dual-tree or naive search.
  */
 template<typename RangeSearchType, typename PointSelectionPolicy>
 template<typename MatType>
-void DBSCAN<RangeSearchType, PointSelectionPolicy>::BatchCluster(
+void DBSCAN<RangeSearchType, PointSelectionPolicy>::BatchSearch(
     const MatType& data,
-    emst::UnionFind& uf)
+    const size_t begin,
+    const size_t end,
+    range::CSRResultSink& neighbors) const
 {
-  // For each point, find the points in epsilon-nighborhood and their distances.
-  std::vector<std::vector<size_t>> neighbors;
-  std::vector<std::vector<double>> distances;
-  Log::Info << "Performing range search." << std::endl;
-  rangeSearch.Train(data);
-  rangeSearch.Search(data, math::Range(0.0, epsilon), neighbors, distances);
-  Log::Info << "Range search complete." << std::endl;
+  typedef typename MatType::elem_type ElemType;
 
-  // Now loop over all points.
-  for (size_t i = 0; i < data.n_cols; ++i)
+  // For each point, find the points in epsilon-neighborhood.  The distances
+  // aren't stored.  The columns of the block are contiguous, so alias them
+  // instead of copying them.
+  const MatType block(const_cast<ElemType*>(data.colptr(begin)), data.n_rows,
+      end - begin, false, true);
+
+  // The search doesn't modify rangeSearch, so that several threads can search
+  // at once; the base case and score counts aren't needed.
+  size_t baseCases = 0;
+  size_t scores = 0;
+  rangeSearch.Search(block, math::Range(0.0, epsilon), neighbors, baseCases,
+      scores);
+}
+
+/**
+ * Mark the core points of the block and merge them with their neighbors.
+ */
+template<typename RangeSearchType, typename PointSelectionPolicy>
+void DBSCAN<RangeSearchType, PointSelectionPolicy>::ProcessBlock(
+    const size_t begin,
+    const range::CSRResultSink& neighbors,
+    emst::ConcurrentUnionFind& uf,
+    boost::dynamic_bitset<>& corePoints,
+    arma::Col<size_t>& borderOwners)
+{
+  const std::vector<size_t>& offsets = neighbors.Offsets();
+  const std::vector<size_t>& allNeighbors = neighbors.Neighbors();
+
+  // Marking the core points is cheap and writes to a bitset, so it is done
+  // before the parallel section.
+  for (size_t i = 0; i < neighbors.NumQueries(); ++i)
+  {
+    if (neighbors.NumNeighbors(i) >= minPoints)
+      corePoints[begin + i] = true;
+  }
+
+  // Now handle every pair (p, q) with q < p: the core status of q is known
+  // because it is either in this block or in an earlier one.  Pairs with q > p
+  // will be handled when q is processed.
+  #pragma omp parallel
   {
-    // Union to all neighbors.
-    for (size_t j = 0; j < neighbors[i].size(); ++j)
-      uf.Union(i, neighbors[i][j]);
+    // A core point can't set the owner of an earlier border point directly,
+    // because another thread may be updating the same border point, so these
+    // are collected and applied after the loop.
+    std::vector<std::pair<size_t, size_t>> borderPairs;
+
+    #pragma omp for schedule(dynamic, 64)
+    for (omp_size_t i = 0; i < (omp_size_t) neighbors.NumQueries(); ++i)
+    {
+      const size_t p = begin + i;
+      if (corePoints[p])
+      {
+        for (size_t j = offsets[i]; j < offsets[i + 1]; ++j)
+        {
+          const size_t q = allNeighbors[j];
+          if (q >= p)
+            continue;
+
+          if (corePoints[q])
+            uf.Union(p, q);
+          else
+            borderPairs.push_back(std::make_pair(q, p));
+        }
+      }
+      else
+      {
+        // This point can only be a border point; take the lowest-index core
+        // point in the neighborhood as the owner.
+        for (size_t j = offsets[i]; j < offsets[i + 1]; ++j)
+        {
+          const size_t q = allNeighbors[j];
+          if (q < p && corePoints[q] && q < borderOwners[p])
+            borderOwners[p] = q;
+        }
+      }
+    }
+
+    // The implicit barrier at the end of the loop means no thread is still
+    // modifying borderOwners.
+    #pragma omp critical(DBSCANBorderOwners)
+    {
+      for (size_t i = 0; i < borderPairs.size(); ++i)
+      {
+        const size_t q = borderPairs[i].first;
+        if (borderPairs[i].second < borderOwners[q])
+          borderOwners[q] = borderPairs[i].second;
+      }
+    }
   }
 }
 
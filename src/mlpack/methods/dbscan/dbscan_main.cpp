@@ -32,8 +32,11 @@ PROGRAM_INFO("DBSCAN clustering",
     "The input dataset to be clustered may be specified with the " +
     PRINT_PARAM_STRING("input") + " parameter; the radius of each range "
     "search may be specified with the " + PRINT_PARAM_STRING("epsilon") +
-    " parameters, and the minimum number of points in a cluster may be "
-    "specified with the " + PRINT_PARAM_STRING("min_size") + " parameter."
+    " parameters, and the minimum number of points in the neighborhood of a "
+    "core point (including itself) may be specified with the " +
+    PRINT_PARAM_STRING("min_size") + " parameter.  Points that are not core "
+    "points but are within the radius of a core point are assigned to that "
+    "core point's cluster; all other points are noise."
     "\n\n"
     "The " + PRINT_PARAM_STRING("assignments") + " and " +
     PRINT_PARAM_STRING("centroids") + " output parameters may be "
@@ -54,8 +57,8 @@ PROGRAM_INFO("DBSCAN clustering",
     PRINT_PARAM_STRING("naive") + " will force brute-force range search."
     "\n\n"
     "An example usage to run DBSCAN on the dataset in " +
-    PRINT_DATASET("input") + " with a radius of 0.5 and a minimum cluster size"
-    " of 5 is given below:"
+    PRINT_DATASET("input") + " with a radius of 0.5 and a minimum neighborhood"
+    " size of 5 is given below:"
     "\n\n" +
     PRINT_CALL("dbscan", "input", "input", "epsilon", 0.5, "min_size", 5));
 
@@ -65,7 +68,8 @@ PARAM_UMATRIX_OUT("assignments", "Output matrix for assignments of each "
 PARAM_MATRIX_OUT("centroids", "Matrix to save output centroids to.", "C");
 
 PARAM_DOUBLE_IN("epsilon", "Radius of each range search.", "e", 1.0);
-PARAM_INT_IN("min_size", "Minimum number of points for a cluster.", "m", 5);
+PARAM_INT_IN("min_size", "Minimum number of points in the neighborhood of a "
+    "core point.", "m", 5);
 
 PARAM_STRING_IN("tree_type", "If using single-tree or dual-tree search, the "
     "type of tree to use ('kd', 'r', 'r-star', 'x', 'hilbert-r', 'r-plus', "
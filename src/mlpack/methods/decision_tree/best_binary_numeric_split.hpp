@@ -13,6 +13,7 @@
 #define MLPACK_METHODS_DECISION_TREE_BEST_BINARY_NUMERIC_SPLIT_HPP
 
 #include <mlpack/prereqs.hpp>
+#include "numeric_split_traits.hpp"
 
 namespace mlpack {
 namespace tree {
@@ -85,6 +86,15 @@ class BestBinaryNumericSplit
       const AuxiliarySplitInfo<ElemType>& /* aux */);
 };
 
+//! BestBinaryNumericSplit splits on a single threshold.
+template<typename FitnessFunction>
+class NumericSplitTraits<BestBinaryNumericSplit<FitnessFunction>>
+{
+ public:
+  static const bool PreBinned = false;
+  static const bool ThresholdSplit = true;
+};
+
 } // namespace tree
 } // namespace mlpack
 
@@ -18,8 +18,17 @@
 #include "best_binary_numeric_split.hpp"
 #include "all_categorical_split.hpp"
 #include "all_dimension_select.hpp"
+#include "numeric_split_traits.hpp"
 #include <type_traits>
 
+// Training is parallelized with OpenMP tasks, which were introduced in OpenMP
+// 3.0.  With older OpenMP implementations (or without OpenMP), trees are
+// trained serially.
+#if defined(HAS_OPENMP) && (_OPENMP >= 200805)
+  #include <omp.h>
+  #define MLPACK_DECISION_TREE_OMP_TASKS
+#endif
+
 namespace mlpack {
 namespace tree {
 
@@ -319,7 +328,8 @@ class DecisionTree :
 
   //! Get the child of the given index.
   const DecisionTree& Child(const size_t i) const { return *children[i]; }
-  //! Modify the child of the given index (be careful!).
+  //! Modify the child of the given index (be careful!).  The flattened layout
+  //! that the root uses for classification is not updated.
   DecisionTree& Child(const size_t i) { return *children[i]; }
 
   /**
@@ -338,6 +348,13 @@ class DecisionTree :
   size_t NumClasses() const;
 
  private:
+  //! Nodes with at least this many points evaluate their candidate dimensions
+  //! in parallel.
+  static constexpr size_t ParallelSplitSize = 2048;
+  //! Children with at least this many points are trained in their own task;
+  //! training on fewer points does not start a parallel region at all.
+  static constexpr size_t ParallelTaskSize = 512;
+
   //! The vector of children.
   std::vector<DecisionTree*> children;
   //! The dimension this node splits on.
@@ -354,6 +371,25 @@ class DecisionTree :
    */
   arma::vec classProbabilities;
 
+  /**
+   * After training, the root lays the tree out for classification: the nodes
+   * are stored in breadth-first order, so that the children of each node are
+   * contiguous, and each of the following vectors holds one element per node.
+   * Other nodes leave these empty, and are classified by walking the children.
+   */
+  //! The split dimension of each node.
+  std::vector<size_t> flatDimensions;
+  //! The threshold of each node that splits on a single threshold.
+  std::vector<double> flatThresholds;
+  //! The index of the first child of each node (0 for leaves).
+  std::vector<size_t> flatChildren;
+  //! Each node, for leaves and for splits that aren't a single threshold (NULL
+  //! otherwise).
+  std::vector<const DecisionTree*> flatNodes;
+  //! Whether this node is being loaded as the child of another node (and so
+  //! should not be laid out for classification).
+  bool loadingChild;
+
   //! Note that this class will also hold the members of the NumericSplit and
   //! CategoricalSplit AuxiliarySplitInfo classes, since it inherits from them.
   //! We'll define some convenience typedefs here.
@@ -370,6 +406,115 @@ class DecisionTree :
                                    const size_t numClasses,
                                    const WeightsRowType& weights);
 
+  /**
+   * Lay the tree out for classification (see flatDimensions).  This is called
+   * on the root after training, copying, or loading.
+   */
+  void Flatten();
+
+  //! Discard the layout for classification.
+  void ClearFlattened();
+
+  /**
+   * Find the leaf that the given point falls into, using the flattened layout
+   * if there is one.
+   *
+   * @param point Point to find the leaf of.
+   */
+  template<typename VecType>
+  const DecisionTree* FindLeaf(const VecType& point) const;
+
+  /**
+   * Train the tree on purely numeric data, starting from the root.  If the
+   * numeric split type supports pre-binned training (see NumericSplitTraits),
+   * the data is binned once and TrainBinned() is used; otherwise, the
+   * recursive Train() is used.
+   *
+   * @param data Dataset to train on.
+   * @param labels Labels for each training point.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights of all the points (only used if UseWeights).
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   */
+  template<bool UseWeights, typename MatType>
+  void TrainNumeric(MatType& data,
+                    arma::Row<size_t>& labels,
+                    const size_t numClasses,
+                    arma::rowvec& weights,
+                    const size_t minimumLeafSize);
+
+  //! Train on numeric data with the recursive Train().
+  template<bool UseWeights, typename MatType>
+  void TrainNumeric(MatType& data,
+                    arma::Row<size_t>& labels,
+                    const size_t numClasses,
+                    arma::rowvec& weights,
+                    const size_t minimumLeafSize,
+                    const std::false_type& /* preBinned */);
+
+  //! Bin the numeric data, then train with TrainBinned().
+  template<bool UseWeights, typename MatType>
+  void TrainNumeric(MatType& data,
+                    arma::Row<size_t>& labels,
+                    const size_t numClasses,
+                    arma::rowvec& weights,
+                    const size_t minimumLeafSize,
+                    const std::true_type& /* preBinned */);
+
+  /**
+   * Train a node on pre-binned numeric data.  The histogram of the node holds,
+   * for each dimension, one column per bin with the (weighted) number of
+   * points of each class in the bin followed by the number of points in the
+   * bin.  To split the node, only the histogram of the smaller child is built
+   * from the bin codes; the histogram of the larger child is the histogram of
+   * this node minus that one.  When the node is done, its histogram is
+   * released to the pool, so that it can be reused by other nodes.
+   *
+   * @param codes Bin code of each value of the dataset.
+   * @param thresholds Upper boundary of each bin (but the last) of each
+   *      dimension.
+   * @param labels Labels for each training point.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights of all the points (only used if UseWeights).
+   * @param indices Indices of the points in this node; these are reordered.
+   * @param count Number of points in this node.
+   * @param histogram Histogram of the points in this node.
+   * @param pool Histograms that are not in use.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   */
+  template<bool UseWeights, typename BinType, typename ThresholdType>
+  void TrainBinned(const arma::Mat<BinType>& codes,
+                   const std::vector<arma::Col<ThresholdType>>& thresholds,
+                   const arma::Row<size_t>& labels,
+                   const size_t numClasses,
+                   const arma::rowvec& weights,
+                   size_t* indices,
+                   const size_t count,
+                   arma::mat& histogram,
+                   std::vector<arma::mat>& pool,
+                   const size_t minimumLeafSize);
+
+  /**
+   * Add the given points to a histogram of pre-binned numeric data (see
+   * TrainBinned()).
+   *
+   * @param codes Bin code of each value of the dataset.
+   * @param labels Labels for each training point.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights of all the points (only used if UseWeights).
+   * @param indices Indices of the points to add.
+   * @param count Number of points to add.
+   * @param histogram Histogram to add the points to.
+   */
+  template<bool UseWeights, typename BinType>
+  static void BuildHistogram(const arma::Mat<BinType>& codes,
+                             const arma::Row<size_t>& labels,
+                             const size_t numClasses,
+                             const arma::rowvec& weights,
+                             const size_t* indices,
+                             const size_t count,
+                             arma::mat& histogram);
+
   /**
    * Corresponding to the public Train() method, this method is designed for
    * avoiding unnecessary copies during training.  This function is called to
@@ -32,7 +32,8 @@ DecisionTree<FitnessFunction,
                                         const data::DatasetInfo& datasetInfo,
                                         LabelsType&& labels,
                                         const size_t numClasses,
-                                        const size_t minimumLeafSize)
+                                        const size_t minimumLeafSize) :
+    loadingChild(false)
 {
   using TrueMatType = typename std::decay<MatType>::type;
   using TrueLabelsType = typename std::decay<LabelsType>::type;
@@ -45,6 +46,9 @@ DecisionTree<FitnessFunction,
   arma::rowvec weights; // Fake weights, not used.
   Train<false>(tmpData, 0, tmpData.n_cols, datasetInfo, tmpLabels, numClasses,
       weights, minimumLeafSize);
+
+  // Lay out the tree for classification.
+  Flatten();
 }
 
 //! Construct and train.
@@ -63,7 +67,8 @@ DecisionTree<FitnessFunction,
              NoRecursion>::DecisionTree(MatType&& data,
                                         LabelsType&& labels,
                                         const size_t numClasses,
-                                        const size_t minimumLeafSize)
+                                        const size_t minimumLeafSize) :
+    loadingChild(false)
 {
   using TrueMatType = typename std::decay<MatType>::type;
   using TrueLabelsType = typename std::decay<LabelsType>::type;
@@ -74,8 +79,10 @@ DecisionTree<FitnessFunction,
 
   // Pass off work to the Train() method.
   arma::rowvec weights; // Fake weights, not used.
-  Train<false>(tmpData, 0, tmpData.n_cols, tmpLabels, numClasses, weights,
-      minimumLeafSize);
+  TrainNumeric<false>(tmpData, tmpLabels, numClasses, weights, minimumLeafSize);
+
+  // Lay out the tree for classification.
+  Flatten();
 }
 
 //! Construct and train with weights.
@@ -100,7 +107,8 @@ DecisionTree<FitnessFunction,
                                         const std::enable_if_t<
                                             arma::is_arma_type<
                                             typename std::remove_reference<
-                                            WeightsType>::type>::value>*)
+                                            WeightsType>::type>::value>*) :
+    loadingChild(false)
 {
   using TrueMatType = typename std::decay<MatType>::type;
   using TrueLabelsType = typename std::decay<LabelsType>::type;
@@ -114,6 +122,9 @@ DecisionTree<FitnessFunction,
   // Pass off work to the weighted Train() method.
   Train<true>(tmpData, 0, tmpData.n_cols, datasetInfo, tmpLabels, numClasses,
       tmpWeights, minimumLeafSize);
+
+  // Lay out the tree for classification.
+  Flatten();
 }
 
 //! Construct and train with weights.
@@ -137,7 +148,8 @@ DecisionTree<FitnessFunction,
                                         const std::enable_if_t<
                                             arma::is_arma_type<
                                             typename std::remove_reference<
-                                            WeightsType>::type>::value>*)
+                                            WeightsType>::type>::value>*) :
+    loadingChild(false)
 {
   using TrueMatType = typename std::decay<MatType>::type;
   using TrueLabelsType = typename std::decay<LabelsType>::type;
@@ -149,8 +161,11 @@ DecisionTree<FitnessFunction,
   TrueWeightsType tmpWeights(std::forward<WeightsType>(weights));
 
   // Pass off work to the weighted Train() method.
-  Train<true>(tmpData, 0, tmpData.n_cols, tmpLabels, numClasses, tmpWeights,
+  TrainNumeric<true>(tmpData, tmpLabels, numClasses, tmpWeights,
       minimumLeafSize);
+
+  // Lay out the tree for classification.
+  Flatten();
 }
 
 //! Construct, don't train.
@@ -168,7 +183,8 @@ DecisionTree<FitnessFunction,
              NoRecursion>::DecisionTree(const size_t numClasses) :
     splitDimension(0),
     dimensionTypeOrMajorityClass(0),
-    classProbabilities(numClasses)
+    classProbabilities(numClasses),
+    loadingChild(false)
 {
   // Initialize utility vector.
   classProbabilities.fill(1.0 / (double) numClasses);
@@ -191,11 +207,16 @@ DecisionTree<FitnessFunction,
     CategoricalAuxiliarySplitInfo(other),
     splitDimension(other.splitDimension),
     dimensionTypeOrMajorityClass(other.dimensionTypeOrMajorityClass),
-    classProbabilities(other.classProbabilities)
+    classProbabilities(other.classProbabilities),
+    loadingChild(false)
 {
   // Copy each child.
   for (size_t i = 0; i < other.children.size(); ++i)
     children.push_back(new DecisionTree(*other.children[i]));
+
+  // Only the root of a tree is laid out for classification.
+  if (!other.flatChildren.empty())
+    Flatten();
 }
 
 //! Take ownership of another tree.
@@ -216,10 +237,18 @@ DecisionTree<FitnessFunction,
     children(std::move(other.children)),
     splitDimension(other.splitDimension),
     dimensionTypeOrMajorityClass(other.dimensionTypeOrMajorityClass),
-    classProbabilities(std::move(other.classProbabilities))
+    classProbabilities(std::move(other.classProbabilities)),
+    loadingChild(false)
 {
   // Reset the other object.
   other.classProbabilities.ones(1); // One class, P(1) = 1.
+
+  // The layout refers to the root, so it has to be rebuilt.
+  if (!other.flatChildren.empty())
+  {
+    other.ClearFlattened();
+    Flatten();
+  }
 }
 
 //! Copy another tree.
@@ -263,6 +292,12 @@ DecisionTree<FitnessFunction,
   NumericAuxiliarySplitInfo::operator=(other);
   CategoricalAuxiliarySplitInfo::operator=(other);
 
+  // Only the root of a tree is laid out for classification.
+  if (!other.flatChildren.empty())
+    Flatten();
+  else
+    ClearFlattened();
+
   return *this;
 }
 
@@ -307,6 +342,17 @@ DecisionTree<FitnessFunction,
   NumericAuxiliarySplitInfo::operator=(std::move(other));
   CategoricalAuxiliarySplitInfo::operator=(std::move(other));
 
+  // The layout refers to the root, so it has to be rebuilt.
+  if (!other.flatChildren.empty())
+  {
+    other.ClearFlattened();
+    Flatten();
+  }
+  else
+  {
+    ClearFlattened();
+  }
+
   return *this;
 }
 
@@ -368,6 +414,9 @@ void DecisionTree<FitnessFunction,
   arma::rowvec weights; // Fake weights, not used.
   Train<false>(tmpData, 0, tmpData.n_cols, datasetInfo, tmpLabels, numClasses,
       weights, minimumLeafSize);
+
+  // Lay out the tree for classification.
+  Flatten();
 }
 
 //! Train on the given data, assuming all dimensions are numeric.
@@ -407,8 +456,10 @@ void DecisionTree<FitnessFunction,
 
   // Pass off work to the Train() method.
   arma::rowvec weights; // Fake weights, not used.
-  Train<false>(tmpData, 0, tmpData.n_cols, tmpLabels, numClasses, weights,
-      minimumLeafSize);
+  TrainNumeric<false>(tmpData, tmpLabels, numClasses, weights, minimumLeafSize);
+
+  // Lay out the tree for classification.
+  Flatten();
 }
 
 //! Train on the given weighted data.
@@ -456,6 +507,9 @@ void DecisionTree<FitnessFunction,
   // Pass off work to the Train() method.
   Train<true>(tmpData, 0, tmpData.n_cols, datasetInfo, tmpLabels, numClasses,
       tmpWeights, minimumLeafSize);
+
+  // Lay out the tree for classification.
+  Flatten();
 }
 
 //! Train on the given weighted data.
@@ -500,8 +554,11 @@ void DecisionTree<FitnessFunction,
   TrueWeightsType tmpWeights(std::forward<WeightsType>(weights));
 
   // Pass off work to the Train() method.
-  Train<true>(tmpData, 0, tmpData.n_cols, tmpLabels, numClasses, tmpWeights,
+  TrainNumeric<true>(tmpData, tmpLabels, numClasses, tmpWeights,
       minimumLeafSize);
+
+  // Lay out the tree for classification.
+  Flatten();
 }
 
 //! Train on the given data.
@@ -526,6 +583,24 @@ void DecisionTree<FitnessFunction,
                                       arma::rowvec& weights,
                                       const size_t minimumLeafSize)
 {
+  #ifdef MLPACK_DECISION_TREE_OMP_TASKS
+  // Training creates tasks, which need a team of threads.  If we are not
+  // already inside of a parallel region (for instance, in RandomForest), start
+  // one here and let a single thread begin the recursion.  With fewer than
+  // ParallelTaskSize points no task would ever be deferred, so the team is
+  // only started for larger datasets.
+  if (omp_get_level() == 0)
+  {
+    #pragma omp parallel if(count >= ParallelTaskSize)
+    {
+      #pragma omp single
+      Train<UseWeights>(data, begin, count, datasetInfo, labels, numClasses,
+          weights, minimumLeafSize);
+    }
+    return;
+  }
+  #endif
+
   // Clear children if needed.
   for (size_t i = 0; i < children.size(); ++i)
     delete children[i];
@@ -541,45 +616,139 @@ void DecisionTree<FitnessFunction,
       numClasses,
       UseWeights ? weights.subvec(begin, begin + count - 1) : weights);
   size_t bestDim = datasetInfo.Dimensionality(); // This means "no split".
-  DimensionSelectionType dimensions(datasetInfo.Dimensionality());
-  for (size_t i = dimensions.Begin(); i != dimensions.End();
-       i = dimensions.Next())
+
+  // Collect the candidate dimensions.  The dimension selection policy may use
+  // the (global) random number generator, so guard its construction in case
+  // sibling nodes are being trained concurrently.
+  std::vector<size_t> candidates;
+  #pragma omp critical(DecisionTreeDimensionSelect)
   {
-    double dimGain = -DBL_MAX;
-    if (datasetInfo.Type(i) == data::Datatype::categorical)
+    DimensionSelectionType dimensions(datasetInfo.Dimensionality());
+    for (size_t i = dimensions.Begin(); i != dimensions.End();
+         i = dimensions.Next())
+      candidates.push_back(i);
+  }
+
+  if (candidates.size() > 1 && count >= ParallelSplitSize)
+  {
+    // This is a large node, so evaluate every candidate dimension in its own
+    // task.  Each task gets its own split information, and afterwards we pick
+    // the best dimension in the same order that the serial search would.
+    const double baseGain = bestGain;
+    std::vector<double> gains(candidates.size(), baseGain);
+    std::vector<arma::vec> dimProbabilities(candidates.size());
+    std::vector<NumericAuxiliarySplitInfo> numericAux(candidates.size());
+    std::vector<CategoricalAuxiliarySplitInfo> categoricalAux(
+        candidates.size());
+    for (size_t c = 0; c < candidates.size(); ++c)
     {
-      dimGain = CategoricalSplit::template SplitIfBetter<UseWeights>(bestGain,
-          data.cols(begin, begin + count - 1).row(i),
-          datasetInfo.NumMappings(i),
-          labels.subvec(begin, begin + count - 1),
-          numClasses,
-          UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
-          minimumLeafSize,
-          classProbabilities,
-          *this);
+      #ifdef MLPACK_DECISION_TREE_OMP_TASKS
+      #pragma omp task default(shared) firstprivate(c)
+      #endif
+      {
+        const size_t i = candidates[c];
+        if (datasetInfo.Type(i) == data::Datatype::categorical)
+        {
+          gains[c] = CategoricalSplit::template SplitIfBetter<UseWeights>(
+              baseGain,
+              data.cols(begin, begin + count - 1).row(i),
+              datasetInfo.NumMappings(i),
+              labels.subvec(begin, begin + count - 1),
+              numClasses,
+              UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
+              minimumLeafSize,
+              dimProbabilities[c],
+              categoricalAux[c]);
+        }
+        else if (datasetInfo.Type(i) == data::Datatype::numeric)
+        {
+          gains[c] = NumericSplit::template SplitIfBetter<UseWeights>(baseGain,
+              data.cols(begin, begin + count - 1).row(i),
+              labels.subvec(begin, begin + count - 1),
+              numClasses,
+              UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
+              minimumLeafSize,
+              dimProbabilities[c],
+              numericAux[c]);
+        }
+      }
     }
-    else if (datasetInfo.Type(i) == data::Datatype::numeric)
+    #ifdef MLPACK_DECISION_TREE_OMP_TASKS
+    #pragma omp taskwait
+    #endif
+
+    size_t bestCandidate = candidates.size();
+    for (size_t c = 0; c < candidates.size(); ++c)
     {
-      dimGain = NumericSplit::template SplitIfBetter<UseWeights>(bestGain,
-          data.cols(begin, begin + count - 1).row(i),
-          labels.subvec(begin, begin + count - 1),
-          numClasses,
-          UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
-          minimumLeafSize,
-          classProbabilities,
-          *this);
+      if (gains[c] > bestGain)
+      {
+        bestCandidate = c;
+        bestGain = gains[c];
+      }
+
+      // If the gain is the best possible, no need to keep looking.
+      if (bestGain >= 0.0)
+        break;
     }
 
-    // Was there an improvement?  If so mark that it's the new best dimension.
-    if (dimGain > bestGain)
+    if (bestCandidate != candidates.size())
     {
-      bestDim = i;
-      bestGain = dimGain;
+      bestDim = candidates[bestCandidate];
+      classProbabilities = std::move(dimProbabilities[bestCandidate]);
+      if (datasetInfo.Type(bestDim) == data::Datatype::categorical)
+      {
+        CategoricalAuxiliarySplitInfo::operator=(
+            categoricalAux[bestCandidate]);
+      }
+      else
+      {
+        NumericAuxiliarySplitInfo::operator=(numericAux[bestCandidate]);
+      }
     }
+  }
+  else
+  {
+    for (size_t c = 0; c < candidates.size(); ++c)
+    {
+      const size_t i = candidates[c];
+      double dimGain = -DBL_MAX;
+      if (datasetInfo.Type(i) == data::Datatype::categorical)
+      {
+        dimGain = CategoricalSplit::template SplitIfBetter<UseWeights>(
+            bestGain,
+            data.cols(begin, begin + count - 1).row(i),
+            datasetInfo.NumMappings(i),
+            labels.subvec(begin, begin + count - 1),
+            numClasses,
+            UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
+            minimumLeafSize,
+            classProbabilities,
+            *this);
+      }
+      else if (datasetInfo.Type(i) == data::Datatype::numeric)
+      {
+        dimGain = NumericSplit::template SplitIfBetter<UseWeights>(bestGain,
+            data.cols(begin, begin + count - 1).row(i),
+            labels.subvec(begin, begin + count - 1),
+            numClasses,
+            UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
+            minimumLeafSize,
+            classProbabilities,
+            *this);
+      }
+
+      // Was there an improvement?  If so mark that it's the new best
+      // dimension.
+      if (dimGain > bestGain)
+      {
+        bestDim = i;
+        bestGain = dimGain;
+      }
 
-    // If the gain is the best possible, no need to keep looking.
-    if (bestGain >= 0.0)
-      break;
+      // If the gain is the best possible, no need to keep looking.
+      if (bestGain >= 0.0)
+        break;
+    }
   }
 
   // Did we split or not?  If so, then split the data and create the children.
@@ -612,17 +781,15 @@ void DecisionTree<FitnessFunction,
       }
     }
 
-    // Figure out counts of children.
-    arma::Row<size_t> childCounts(numClasses, arma::fill::zeros);
-    for (size_t i = begin; i < begin + count; ++i)
-      childCounts[childAssignments[i - begin]]++;
-
-    // Split into children.
+    // Split into children.  First reorder the points so that the points of
+    // each child are contiguous.
+    std::vector<size_t> childBegins(numChildren);
+    std::vector<size_t> childSizes(numChildren);
     size_t currentCol = begin;
     for (size_t i = 0; i < numChildren; ++i)
     {
-      size_t currentChildBegin = currentCol;
-      for (size_t j = currentChildBegin; j < begin + count; ++j)
+      childBegins[i] = currentCol;
+      for (size_t j = childBegins[i]; j < begin + count; ++j)
       {
         if (childAssignments[j - begin] == i)
         {
@@ -634,23 +801,35 @@ void DecisionTree<FitnessFunction,
           ++currentCol;
         }
       }
+      childSizes[i] = currentCol - childBegins[i];
 
-      // Now build the child recursively.
-      DecisionTree* child = new DecisionTree();
-      if (NoRecursion)
-      {
-        child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, datasetInfo, labels, numClasses,
-            weights, currentCol - currentChildBegin);
-      }
-      else
+      children.push_back(new DecisionTree());
+    }
+
+    // Now build the children recursively.  Each child only touches its own
+    // columns of the data, so large children can be built in parallel tasks.
+    for (size_t i = 0; i < numChildren; ++i)
+    {
+      #ifdef MLPACK_DECISION_TREE_OMP_TASKS
+      #pragma omp task default(shared) firstprivate(i) \
+          if(childSizes[i] >= ParallelTaskSize)
+      #endif
       {
-        child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, datasetInfo, labels, numClasses,
-            weights, minimumLeafSize);
+        if (NoRecursion)
+        {
+          children[i]->Train<UseWeights>(data, childBegins[i], childSizes[i],
+              datasetInfo, labels, numClasses, weights, childSizes[i]);
+        }
+        else
+        {
+          children[i]->Train<UseWeights>(data, childBegins[i], childSizes[i],
+              datasetInfo, labels, numClasses, weights, minimumLeafSize);
+        }
       }
-      children.push_back(child);
     }
+    #ifdef MLPACK_DECISION_TREE_OMP_TASKS
+    #pragma omp taskwait
+    #endif
   }
   else
   {
@@ -687,6 +866,24 @@ void DecisionTree<FitnessFunction,
                                       arma::rowvec& weights,
                                       const size_t minimumLeafSize)
 {
+  #ifdef MLPACK_DECISION_TREE_OMP_TASKS
+  // Training creates tasks, which need a team of threads.  If we are not
+  // already inside of a parallel region (for instance, in RandomForest), start
+  // one here and let a single thread begin the recursion.  With fewer than
+  // ParallelTaskSize points no task would ever be deferred, so the team is
+  // only started for larger datasets.
+  if (omp_get_level() == 0)
+  {
+    #pragma omp parallel if(count >= ParallelTaskSize)
+    {
+      #pragma omp single
+      Train<UseWeights>(data, begin, count, labels, numClasses, weights,
+          minimumLeafSize);
+    }
+    return;
+  }
+  #endif
+
   // Clear children if needed.
   for (size_t i = 0; i < children.size(); ++i)
     delete children[i];
@@ -705,29 +902,80 @@ void DecisionTree<FitnessFunction,
       numClasses,
       UseWeights ? weights.subvec(begin, begin + count - 1) : weights);
   size_t bestDim = data.n_rows; // This means "no split".
-  for (size_t i = 0; i < data.n_rows; ++i)
+  if (data.n_rows > 1 && count >= ParallelSplitSize)
   {
-    const double dimGain = NumericSplitType<FitnessFunction>::template
-        SplitIfBetter<UseWeights>(bestGain,
-                                  data.cols(begin, begin + count - 1).row(i),
-                                  labels.cols(begin, begin + count - 1),
-                                  numClasses,
-                                  UseWeights ?
-                                      weights.cols(begin, begin + count - 1) :
-                                      weights,
-                                  minimumLeafSize,
-                                  classProbabilities,
-                                  *this);
-
-    if (dimGain > bestGain)
+    // This is a large node, so evaluate every dimension in its own task.  Each
+    // task gets its own split information, and afterwards we pick the best
+    // dimension in the same order that the serial search would.
+    const double baseGain = bestGain;
+    std::vector<double> gains(data.n_rows, baseGain);
+    std::vector<arma::vec> dimProbabilities(data.n_rows);
+    std::vector<NumericAuxiliarySplitInfo> numericAux(data.n_rows);
+    for (size_t i = 0; i < data.n_rows; ++i)
     {
-      bestDim = i;
-      bestGain = dimGain;
+      #ifdef MLPACK_DECISION_TREE_OMP_TASKS
+      #pragma omp task default(shared) firstprivate(i)
+      #endif
+      {
+        gains[i] = NumericSplit::template SplitIfBetter<UseWeights>(baseGain,
+            data.cols(begin, begin + count - 1).row(i),
+            labels.cols(begin, begin + count - 1),
+            numClasses,
+            UseWeights ? weights.cols(begin, begin + count - 1) : weights,
+            minimumLeafSize,
+            dimProbabilities[i],
+            numericAux[i]);
+      }
+    }
+    #ifdef MLPACK_DECISION_TREE_OMP_TASKS
+    #pragma omp taskwait
+    #endif
+
+    for (size_t i = 0; i < data.n_rows; ++i)
+    {
+      if (gains[i] > bestGain)
+      {
+        bestDim = i;
+        bestGain = gains[i];
+      }
+
+      // If the gain is the best possible, no need to keep looking.
+      if (bestGain >= 0.0)
+        break;
     }
 
-    // If the gain is the best possible, no need to keep looking.
-    if (bestGain >= 0.0)
-      break;
+    if (bestDim != data.n_rows)
+    {
+      classProbabilities = std::move(dimProbabilities[bestDim]);
+      NumericAuxiliarySplitInfo::operator=(numericAux[bestDim]);
+    }
+  }
+  else
+  {
+    for (size_t i = 0; i < data.n_rows; ++i)
+    {
+      const double dimGain = NumericSplitType<FitnessFunction>::template
+          SplitIfBetter<UseWeights>(bestGain,
+                                    data.cols(begin, begin + count - 1).row(i),
+                                    labels.cols(begin, begin + count - 1),
+                                    numClasses,
+                                    UseWeights ?
+                                        weights.cols(begin, begin + count - 1) :
+                                        weights,
+                                    minimumLeafSize,
+                                    classProbabilities,
+                                    *this);
+
+      if (dimGain > bestGain)
+      {
+        bestDim = i;
+        bestGain = dimGain;
+      }
+
+      // If the gain is the best possible, no need to keep looking.
+      if (bestGain >= 0.0)
+        break;
+    }
   }
 
   // Did we split or not?  If so, then split the data and create the children.
@@ -747,17 +995,15 @@ void DecisionTree<FitnessFunction,
           data(bestDim, j), classProbabilities, *this);
     }
 
-    // Calculate counts of children in each node.
-    arma::Row<size_t> childCounts(numChildren);
-    childCounts.zeros();
-    for (size_t j = begin; j < begin + count; ++j)
-      childCounts[childAssignments[j - begin]]++;
-
+    // Split into children.  First reorder the points so that the points of
+    // each child are contiguous.
+    std::vector<size_t> childBegins(numChildren);
+    std::vector<size_t> childSizes(numChildren);
     size_t currentCol = begin;
     for (size_t i = 0; i < numChildren; ++i)
     {
-      size_t currentChildBegin = currentCol;
-      for (size_t j = currentChildBegin; j < begin + count; ++j)
+      childBegins[i] = currentCol;
+      for (size_t j = childBegins[i]; j < begin + count; ++j)
       {
         if (childAssignments[j - begin] == i)
         {
@@ -769,23 +1015,35 @@ void DecisionTree<FitnessFunction,
           ++currentCol;
         }
       }
+      childSizes[i] = currentCol - childBegins[i];
 
-      // Now build the child recursively.
-      DecisionTree* child = new DecisionTree();
-      if (NoRecursion)
-      {
-        child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, labels, numClasses, weights,
-            currentCol - currentChildBegin);
-      }
-      else
+      children.push_back(new DecisionTree());
+    }
+
+    // Now build the children recursively.  Each child only touches its own
+    // columns of the data, so large children can be built in parallel tasks.
+    for (size_t i = 0; i < numChildren; ++i)
+    {
+      #ifdef MLPACK_DECISION_TREE_OMP_TASKS
+      #pragma omp task default(shared) firstprivate(i) \
+          if(childSizes[i] >= ParallelTaskSize)
+      #endif
       {
-        child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, labels, numClasses, weights,
-            minimumLeafSize);
+        if (NoRecursion)
+        {
+          children[i]->Train<UseWeights>(data, childBegins[i], childSizes[i],
+              labels, numClasses, weights, childSizes[i]);
+        }
+        else
+        {
+          children[i]->Train<UseWeights>(data, childBegins[i], childSizes[i],
+              labels, numClasses, weights, minimumLeafSize);
+        }
       }
-      children.push_back(child);
     }
+    #ifdef MLPACK_DECISION_TREE_OMP_TASKS
+    #pragma omp taskwait
+    #endif
   }
   else
   {
@@ -800,6 +1058,321 @@ void DecisionTree<FitnessFunction,
   }
 }
 
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+template<bool UseWeights, typename MatType>
+void DecisionTree<FitnessFunction,
+                  NumericSplitType,
+                  CategoricalSplitType,
+                  DimensionSelectionType,
+                  ElemType,
+                  NoRecursion>::TrainNumeric(MatType& data,
+                                             arma::Row<size_t>& labels,
+                                             const size_t numClasses,
+                                             arma::rowvec& weights,
+                                             const size_t minimumLeafSize)
+{
+  TrainNumeric<UseWeights>(data, labels, numClasses, weights, minimumLeafSize,
+      std::integral_constant<bool,
+          NumericSplitTraits<NumericSplit>::PreBinned>());
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+template<bool UseWeights, typename MatType>
+void DecisionTree<FitnessFunction,
+                  NumericSplitType,
+                  CategoricalSplitType,
+                  DimensionSelectionType,
+                  ElemType,
+                  NoRecursion>::TrainNumeric(MatType& data,
+                                             arma::Row<size_t>& labels,
+                                             const size_t numClasses,
+                                             arma::rowvec& weights,
+                                             const size_t minimumLeafSize,
+                                             const std::false_type&)
+{
+  Train<UseWeights>(data, 0, data.n_cols, labels, numClasses, weights,
+      minimumLeafSize);
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+template<bool UseWeights, typename MatType>
+void DecisionTree<FitnessFunction,
+                  NumericSplitType,
+                  CategoricalSplitType,
+                  DimensionSelectionType,
+                  ElemType,
+                  NoRecursion>::TrainNumeric(MatType& data,
+                                             arma::Row<size_t>& labels,
+                                             const size_t numClasses,
+                                             arma::rowvec& weights,
+                                             const size_t minimumLeafSize,
+                                             const std::true_type&)
+{
+  typedef typename NumericSplit::BinType BinType;
+  typedef typename MatType::elem_type DataElemType;
+
+  // Bin every dimension once; from here on, only the codes are used.
+  arma::Mat<BinType> codes;
+  std::vector<arma::Col<DataElemType>> thresholds;
+  NumericSplit::Bin(data, codes, thresholds);
+
+  // Give every dimension the same number of columns in the histograms, so
+  // that a histogram is a single matrix.
+  size_t numBins = 1;
+  for (size_t d = 0; d < thresholds.size(); ++d)
+    numBins = std::max(numBins, (size_t) thresholds[d].n_elem + 1);
+
+  std::vector<size_t> indices(data.n_cols);
+  for (size_t i = 0; i < indices.size(); ++i)
+    indices[i] = i;
+
+  arma::mat histogram(numClasses + 1, numBins * data.n_rows,
+      arma::fill::zeros);
+  std::vector<arma::mat> pool;
+
+  #ifdef MLPACK_DECISION_TREE_OMP_TASKS
+  // Training creates tasks, which need a team of threads.  If we are not
+  // already inside of a parallel region (for instance, in RandomForest), start
+  // one here and let a single thread begin the recursion.  With fewer than
+  // ParallelTaskSize points no task would ever be deferred, so the team is
+  // only started for larger datasets.
+  if (omp_get_level() == 0)
+  {
+    #pragma omp parallel if(data.n_cols >= ParallelTaskSize)
+    {
+      #pragma omp single
+      {
+        BuildHistogram<UseWeights>(codes, labels, numClasses, weights,
+            indices.data(), indices.size(), histogram);
+        TrainBinned<UseWeights>(codes, thresholds, labels, numClasses, weights,
+            indices.data(), indices.size(), histogram, pool, minimumLeafSize);
+      }
+    }
+    return;
+  }
+  #endif
+
+  BuildHistogram<UseWeights>(codes, labels, numClasses, weights,
+      indices.data(), indices.size(), histogram);
+  TrainBinned<UseWeights>(codes, thresholds, labels, numClasses, weights,
+      indices.data(), indices.size(), histogram, pool, minimumLeafSize);
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+template<bool UseWeights, typename BinType, typename ThresholdType>
+void DecisionTree<FitnessFunction,
+                  NumericSplitType,
+                  CategoricalSplitType,
+                  DimensionSelectionType,
+                  ElemType,
+                  NoRecursion>::TrainBinned(
+    const arma::Mat<BinType>& codes,
+    const std::vector<arma::Col<ThresholdType>>& thresholds,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const arma::rowvec& weights,
+    size_t* indices,
+    const size_t count,
+    arma::mat& histogram,
+    std::vector<arma::mat>& pool,
+    const size_t minimumLeafSize)
+{
+  // Clear children if needed.
+  for (size_t i = 0; i < children.size(); ++i)
+    delete children[i];
+  children.clear();
+
+  // We won't be using these members, so reset them.
+  NumericAuxiliarySplitInfo::operator=(NumericAuxiliarySplitInfo());
+  CategoricalAuxiliarySplitInfo::operator=(CategoricalAuxiliarySplitInfo());
+
+  // Every dimension holds every point, so the class counts of the node are the
+  // sums over the bins of the first dimension.
+  const size_t numBins = histogram.n_cols / codes.n_rows;
+  const arma::vec totalCounts = arma::sum(
+      histogram.submat(0, 0, numClasses - 1, numBins - 1), 1);
+
+  double bestGain = FitnessFunction::EvaluatePtr(totalCounts.memptr(),
+      numClasses, arma::accu(totalCounts));
+  size_t bestDim = codes.n_rows; // This means "no split".
+  size_t bestLeftBin = numBins;
+  if (count >= 2 && count >= 2 * minimumLeafSize)
+  {
+    for (size_t d = 0; d < codes.n_rows; ++d)
+    {
+      // Alias the histogram of this dimension.
+      const arma::mat dimHistogram(histogram.colptr(d * numBins),
+          numClasses + 1, numBins, false, true);
+
+      size_t leftBin, rightBin;
+      const double dimGain = NumericSplit::BestBoundary(bestGain, dimHistogram,
+          totalCounts, minimumLeafSize, leftBin, rightBin);
+      if (leftBin != numBins)
+      {
+        bestDim = d;
+        bestGain = dimGain;
+        bestLeftBin = leftBin;
+      }
+
+      // If the gain is the best possible, no need to keep looking.
+      if (bestGain >= 0.0)
+        break;
+    }
+  }
+
+  // Did we split or not?  If so, then split the points and create the
+  // children.
+  if (bestDim != codes.n_rows)
+  {
+    splitDimension = bestDim;
+    dimensionTypeOrMajorityClass = (size_t) data::Datatype::numeric;
+    classProbabilities.set_size(1);
+    classProbabilities[0] = thresholds[bestDim][bestLeftBin];
+
+    // Move the points of the left child to the front.
+    size_t leftCount = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (codes(bestDim, indices[i]) <= bestLeftBin)
+        std::swap(indices[i], indices[leftCount++]);
+    }
+    const size_t childBegins[2] = { 0, leftCount };
+    const size_t childSizes[2] = { childBegins[1], count - childBegins[1] };
+
+    // Build the histogram of the smaller child from the codes, in a buffer
+    // taken from the pool; the histogram of the larger child is then this
+    // node's histogram minus that one, so it can be computed in place.
+    const size_t smaller = (childSizes[0] <= childSizes[1]) ? 0 : 1;
+    arma::mat smallerHistogram;
+    #pragma omp critical(DecisionTreeHistogramPool)
+    {
+      if (!pool.empty())
+      {
+        smallerHistogram.swap(pool.back());
+        pool.pop_back();
+      }
+    }
+    smallerHistogram.zeros(histogram.n_rows, histogram.n_cols);
+    BuildHistogram<UseWeights>(codes, labels, numClasses, weights,
+        indices + childBegins[smaller], childSizes[smaller], smallerHistogram);
+    histogram -= smallerHistogram;
+
+    children.push_back(new DecisionTree());
+    children.push_back(new DecisionTree());
+
+    // Now build the children recursively.  Each child only touches its own
+    // indices and its own histogram, so large children can be built in
+    // parallel tasks.
+    for (size_t i = 0; i < 2; ++i)
+    {
+      #ifdef MLPACK_DECISION_TREE_OMP_TASKS
+      #pragma omp task default(shared) firstprivate(i) \
+          if(childSizes[i] >= ParallelTaskSize)
+      #endif
+      {
+        arma::mat& childHistogram = (i == smaller) ? smallerHistogram :
+            histogram;
+        if (NoRecursion)
+        {
+          children[i]->TrainBinned<UseWeights>(codes, thresholds, labels,
+              numClasses, weights, indices + childBegins[i], childSizes[i],
+              childHistogram, pool, childSizes[i]);
+        }
+        else
+        {
+          children[i]->TrainBinned<UseWeights>(codes, thresholds, labels,
+              numClasses, weights, indices + childBegins[i], childSizes[i],
+              childHistogram, pool, minimumLeafSize);
+        }
+      }
+    }
+    #ifdef MLPACK_DECISION_TREE_OMP_TASKS
+    #pragma omp taskwait
+    #endif
+  }
+  else
+  {
+    // Calculate class probabilities because we are a leaf.
+    classProbabilities = totalCounts / arma::accu(totalCounts);
+    arma::uword maxIndex = 0;
+    classProbabilities.max(maxIndex);
+    dimensionTypeOrMajorityClass = (size_t) maxIndex;
+
+    // The histogram is not needed anymore, so give it back to the pool.
+    #pragma omp critical(DecisionTreeHistogramPool)
+    {
+      pool.push_back(arma::mat());
+      pool.back().swap(histogram);
+    }
+  }
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+template<bool UseWeights, typename BinType>
+void DecisionTree<FitnessFunction,
+                  NumericSplitType,
+                  CategoricalSplitType,
+                  DimensionSelectionType,
+                  ElemType,
+                  NoRecursion>::BuildHistogram(
+    const arma::Mat<BinType>& codes,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const arma::rowvec& weights,
+    const size_t* indices,
+    const size_t count,
+    arma::mat& histogram)
+{
+  // Each dimension has its own columns of the histogram, so for large nodes
+  // the dimensions can be filled in parallel tasks.
+  const size_t numBins = histogram.n_cols / codes.n_rows;
+  for (size_t d = 0; d < codes.n_rows; ++d)
+  {
+    #ifdef MLPACK_DECISION_TREE_OMP_TASKS
+    #pragma omp task default(shared) firstprivate(d) \
+        if(count >= ParallelSplitSize)
+    #endif
+    {
+      double* dimHistogram = histogram.colptr(d * numBins);
+      for (size_t i = 0; i < count; ++i)
+      {
+        const size_t index = indices[i];
+        double* bin = dimHistogram + (numClasses + 1) * codes(d, index);
+        bin[labels[index]] += UseWeights ? weights[index] : 1.0;
+        bin[numClasses] += 1.0;
+      }
+    }
+  }
+  #ifdef MLPACK_DECISION_TREE_OMP_TASKS
+  #pragma omp taskwait
+  #endif
+}
+
 //! Return the class.
 template<typename FitnessFunction,
          template<typename> class NumericSplitType,
@@ -815,13 +1388,8 @@ size_t DecisionTree<FitnessFunction,
                     ElemType,
                     NoRecursion>::Classify(const VecType& point) const
 {
-  if (children.size() == 0)
-  {
-    // Return cached max of probabilities.
-    return dimensionTypeOrMajorityClass;
-  }
-
-  return children[CalculateDirection(point)]->Classify(point);
+  // Return cached max of probabilities.
+  return FindLeaf(point)->dimensionTypeOrMajorityClass;
 }
 
 //! Return class probabilities for a given point.
@@ -841,15 +1409,9 @@ void DecisionTree<FitnessFunction,
                                          size_t& prediction,
                                          arma::vec& probabilities) const
 {
-  if (children.size() == 0)
-  {
-    prediction = dimensionTypeOrMajorityClass;
-    probabilities = classProbabilities;
-    return;
-  }
-
-  children[CalculateDirection(point)]->Classify(point, prediction,
-      probabilities);
+  const DecisionTree* leaf = FindLeaf(point);
+  prediction = leaf->dimensionTypeOrMajorityClass;
+  probabilities = leaf->classProbabilities;
 }
 
 //! Return the class for a set of points.
@@ -875,9 +1437,8 @@ void DecisionTree<FitnessFunction,
     return;
   }
 
-  // Loop over each point.
   for (size_t i = 0; i < data.n_cols; ++i)
-    predictions[i] = Classify(data.col(i));
+    predictions[i] = FindLeaf(data.col(i))->dimensionTypeOrMajorityClass;
 }
 
 //! Return the class probabilities for a set of points.
@@ -907,15 +1468,13 @@ void DecisionTree<FitnessFunction,
 
   // Otherwise we have to find the right size to set the predictions matrix to
   // be.
-  DecisionTree* node = children[0];
-  while (node->NumChildren() != 0)
-    node = &node->Child(0);
-  probabilities.set_size(node->classProbabilities.n_elem, data.n_cols);
+  probabilities.set_size(NumClasses(), data.n_cols);
 
   for (size_t i = 0; i < data.n_cols; ++i)
   {
-    arma::vec v = probabilities.unsafe_col(i); // Alias of column.
-    Classify(data.col(i), predictions[i], v);
+    const DecisionTree* leaf = FindLeaf(data.col(i));
+    predictions[i] = leaf->dimensionTypeOrMajorityClass;
+    probabilities.col(i) = leaf->classProbabilities;
   }
 }
 
@@ -959,13 +1518,21 @@ void DecisionTree<FitnessFunction,
   {
     std::ostringstream name;
     name << "child" << i;
+    // Only the root is laid out, so the children don't need to be.
+    children[i]->loadingChild = true;
     ar & CreateNVP(*children[i], name.str());
+    children[i]->loadingChild = false;
   }
 
   // Now serialize the rest of the object.
   ar & CreateNVP(splitDimension, "splitDimension");
   ar & CreateNVP(dimensionTypeOrMajorityClass, "dimensionTypeOrMajorityClass");
   ar & CreateNVP(classProbabilities, "classProbabilities");
+
+  // The layout for classification isn't serialized, so the root rebuilds it
+  // once the whole tree is loaded.
+  if (Archive::is_loading::value && !loadingChild)
+    Flatten();
 }
 
 template<typename FitnessFunction,
@@ -991,6 +1558,116 @@ size_t DecisionTree<FitnessFunction,
         classProbabilities, *this);
 }
 
+//! Lay the tree out for classification.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+void DecisionTree<FitnessFunction,
+                  NumericSplitType,
+                  CategoricalSplitType,
+                  DimensionSelectionType,
+                  ElemType,
+                  NoRecursion>::Flatten()
+{
+  ClearFlattened();
+
+  // Visit the nodes in breadth-first order, appending the children of each
+  // node as it is visited, so that siblings are contiguous.  Only the root
+  // keeps a layout, so those of the other nodes are discarded.
+  std::vector<DecisionTree*> nodes(1, this);
+  for (size_t i = 0; i < nodes.size(); ++i)
+  {
+    DecisionTree* node = nodes[i];
+    if (i > 0)
+      node->ClearFlattened();
+
+    if (node->children.size() == 0)
+    {
+      flatDimensions.push_back(0);
+      flatThresholds.push_back(0.0);
+      flatChildren.push_back(0);
+      flatNodes.push_back(node);
+      continue;
+    }
+
+    const bool threshold = NumericSplitTraits<NumericSplit>::ThresholdSplit &&
+        ((data::Datatype) node->dimensionTypeOrMajorityClass ==
+        data::Datatype::numeric);
+    flatDimensions.push_back(node->splitDimension);
+    flatThresholds.push_back(threshold ? node->classProbabilities[0] : 0.0);
+    flatChildren.push_back(nodes.size());
+    flatNodes.push_back(threshold ? NULL : node);
+    nodes.insert(nodes.end(), node->children.begin(), node->children.end());
+  }
+}
+
+//! Discard the layout for classification.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+void DecisionTree<FitnessFunction,
+                  NumericSplitType,
+                  CategoricalSplitType,
+                  DimensionSelectionType,
+                  ElemType,
+                  NoRecursion>::ClearFlattened()
+{
+  // Release the memory too.
+  std::vector<size_t>().swap(flatDimensions);
+  std::vector<double>().swap(flatThresholds);
+  std::vector<size_t>().swap(flatChildren);
+  std::vector<const DecisionTree*>().swap(flatNodes);
+}
+
+//! Find the leaf that a point falls into.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+template<typename VecType>
+const DecisionTree<FitnessFunction,
+                   NumericSplitType,
+                   CategoricalSplitType,
+                   DimensionSelectionType,
+                   ElemType,
+                   NoRecursion>*
+DecisionTree<FitnessFunction,
+             NumericSplitType,
+             CategoricalSplitType,
+             DimensionSelectionType,
+             ElemType,
+             NoRecursion>::FindLeaf(const VecType& point) const
+{
+  // Without a layout (for instance, if this node is not the root), walk down
+  // the children.
+  if (flatChildren.empty())
+  {
+    const DecisionTree* node = this;
+    while (node->children.size() != 0)
+      node = node->children[node->CalculateDirection(point)];
+    return node;
+  }
+
+  size_t node = 0;
+  while (flatChildren[node] != 0)
+  {
+    const size_t direction = (flatNodes[node] == NULL) ?
+        ((point[flatDimensions[node]] <= flatThresholds[node]) ? 0 : 1) :
+        flatNodes[node]->CalculateDirection(point);
+    node = flatChildren[node] + direction;
+  }
+
+  return flatNodes[node];
+}
+
 // Get the number of classes in the tree.
 template<typename FitnessFunction,
          template<typename> class NumericSplitType,
@@ -175,6 +175,33 @@ class GiniGain
     return -impurity;
   }
 
+  /**
+   * Evaluate the Gini impurity given a vector of (possibly weighted) class
+   * counts, instead of the labels themselves.  This is useful for split types
+   * that already have class histograms available.
+   *
+   * @param counts Pointer to the count of each class (numClasses elements).
+   * @param numClasses Number of classes in the dataset.
+   * @param totalCount Sum of all elements in counts.
+   */
+  static double EvaluatePtr(const double* counts,
+                            const size_t numClasses,
+                            const double totalCount)
+  {
+    // Corner case: if there are no elements, the impurity is zero.
+    if (totalCount == 0.0)
+      return 0.0;
+
+    double impurity = 0.0;
+    for (size_t i = 0; i < numClasses; ++i)
+    {
+      const double f = counts[i] / totalCount;
+      impurity += f * (1.0 - f);
+    }
+
+    return -impurity;
+  }
+
   /**
    * Return the range of the Gini impurity for the given number of classes.
    * (That is, the difference between the maximum possible value and the minimum
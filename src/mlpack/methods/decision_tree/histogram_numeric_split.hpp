@@ -0,0 +1,185 @@
+/**
+ * @file histogram_numeric_split.hpp
+ *
+ * A tree splitter that finds the best binary numeric split among a fixed number
+ * of histogram bins.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_HISTOGRAM_NUMERIC_SPLIT_HPP
+#define MLPACK_METHODS_DECISION_TREE_HISTOGRAM_NUMERIC_SPLIT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "numeric_split_traits.hpp"
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The HistogramNumericSplit is a splitting function for decision trees that
+ * approximates the best binary split of a numeric dimension.  Instead of
+ * sorting the points in the node (which is O(n log n) per dimension per node,
+ * as in BestBinaryNumericSplit), the values are placed into at most NumBins
+ * bins, and the gain of each boundary between non-empty bins is computed from
+ * cumulative per-class histograms in O(NumBins * numClasses) time.
+ *
+ * When a DecisionTree is trained on purely numeric data with this split type,
+ * every dimension is binned only once, before training, into quantile bins
+ * whose codes are stored as one byte per value (two for more than 256 bins);
+ * see Bin().  The tree then builds the per-class histograms of a node from the
+ * bin codes, only for the smaller child of each split: the histograms of the
+ * larger child are those of the parent minus those of the smaller child.
+ *
+ * When the tree is trained with categorical dimensions as well, the node's
+ * values are instead binned for each node into equal-width bins over the range
+ * of the node, through SplitIfBetter().  The split value is then placed halfway
+ * between the largest value of the bin to the left of the boundary and the
+ * smallest value of the bin to the right, so that the partition used to
+ * evaluate the gain is exactly the partition that CalculateDirection() will
+ * produce.
+ *
+ * The FitnessFunction must provide a static EvaluatePtr() function that
+ * computes the gain from a vector of class counts; GiniGain and InformationGain
+ * both do.
+ *
+ * @tparam FitnessFunction Fitness function to use to calculate gain.
+ * @tparam NumBins Number of histogram bins to use for each dimension.
+ */
+template<typename FitnessFunction, size_t NumBins>
+class HistogramNumericSplit
+{
+ public:
+  // No extra info needed for split.
+  template<typename ElemType>
+  class AuxiliarySplitInfo { };
+
+  //! The type of the bin codes: one byte if there are at most 256 bins.
+  typedef typename std::conditional<(NumBins <= 256), uint8_t,
+      uint16_t>::type BinType;
+
+  /**
+   * Check if we can split a node.  If we can split a node in a way that
+   * improves on 'bestGain', then we return the improved gain.  Otherwise we
+   * return the value 'bestGain'.  If a split is made, then classProbabilities
+   * and aux may be modified.
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param data The dimension of data points to check for a split in.
+   * @param labels Labels for each point.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights for each point (only used if UseWeights is true).
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param classProbabilities Class probabilities vector, which may be filled
+   *      with split information a successful split.
+   * @param aux Auxiliary split information, which may be modified on a
+   *      successful split.
+   */
+  template<bool UseWeights, typename VecType, typename WeightVecType>
+  static double SplitIfBetter(
+      const double bestGain,
+      const VecType& data,
+      const arma::Row<size_t>& labels,
+      const size_t numClasses,
+      const WeightVecType& weights,
+      const size_t minimumLeafSize,
+      arma::Col<typename VecType::elem_type>& classProbabilities,
+      AuxiliarySplitInfo<typename VecType::elem_type>& aux);
+
+  /**
+   * Bin every dimension of the given dataset into at most NumBins bins, whose
+   * boundaries are (approximately) quantiles of the values in the dimension;
+   * if a dimension has at most NumBins distinct values, each gets its own bin.
+   * A value x in dimension d gets the code b such that
+   * thresholds[d][b - 1] < x <= thresholds[d][b] (where the missing thresholds
+   * of the first and last bins are -inf and inf).
+   *
+   * @param data Dataset to bin.
+   * @param codes Matrix to store the bin code of each value in.
+   * @param thresholds Vector to store the boundaries of the bins of each
+   *      dimension in.
+   */
+  template<typename MatType>
+  static void Bin(const MatType& data,
+                  arma::Mat<BinType>& codes,
+                  std::vector<arma::Col<typename MatType::elem_type>>&
+                      thresholds);
+
+  /**
+   * Find the best boundary between two non-empty bins, given the histogram of
+   * a dimension.  Each column of the histogram corresponds to a bin; its first
+   * numClasses elements hold the (weighted) number of points of each class in
+   * the bin, and the last element holds the number of points in the bin.  If
+   * a split with gain better than bestGain is found, its gain is returned and
+   * the bins on each side of the boundary are stored in leftBin and rightBin;
+   * otherwise, bestGain is returned and leftBin and rightBin are set to the
+   * number of bins.
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param histogram Histogram of the dimension ((numClasses + 1) x bins).
+   * @param totalCounts (Weighted) number of points of each class.
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param leftBin Set to the last non-empty bin left of the boundary.
+   * @param rightBin Set to the first non-empty bin right of the boundary.
+   */
+  static double BestBoundary(const double bestGain,
+                             const arma::mat& histogram,
+                             const arma::vec& totalCounts,
+                             const size_t minimumLeafSize,
+                             size_t& leftBin,
+                             size_t& rightBin);
+
+  /**
+   * Returns 2, since the binary split always has two children.
+   */
+  template<typename ElemType>
+  static size_t NumChildren(const arma::Col<ElemType>& /* classProbabilities */,
+                            const AuxiliarySplitInfo<ElemType>& /* aux */)
+  {
+    return 2;
+  }
+
+  /**
+   * Given a point, calculate which child it should go to (left or right).
+   *
+   * @param point Point to calculate direction of.
+   * @param classProbabilities Auxiliary information for the split.
+   * @param aux (Unused) auxiliary information for the split.
+   */
+  template<typename ElemType>
+  static size_t CalculateDirection(
+      const ElemType& point,
+      const arma::Col<ElemType>& classProbabilities,
+      const AuxiliarySplitInfo<ElemType>& /* aux */);
+};
+
+//! HistogramNumericSplit supports pre-binned training, and splits on a single
+//! threshold.
+template<typename FitnessFunction, size_t NumBins>
+class NumericSplitTraits<HistogramNumericSplit<FitnessFunction, NumBins>>
+{
+ public:
+  static const bool PreBinned = true;
+  static const bool ThresholdSplit = true;
+};
+
+/**
+ * Convenience typedef for a histogram split with 256 bins, suitable for use as
+ * the NumericSplitType of DecisionTree or RandomForest.
+ */
+template<typename FitnessFunction>
+using Histogram256NumericSplit = HistogramNumericSplit<FitnessFunction, 256>;
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "histogram_numeric_split_impl.hpp"
+
+#endif
@@ -0,0 +1,247 @@
+/**
+ * @file histogram_numeric_split_impl.hpp
+ *
+ * Implementation of strategy that finds the best binary numeric split among
+ * histogram bins.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_HISTOGRAM_NUMERIC_SPLIT_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_HISTOGRAM_NUMERIC_SPLIT_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "histogram_numeric_split.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename FitnessFunction, size_t NumBins>
+template<bool UseWeights, typename VecType, typename WeightVecType>
+double HistogramNumericSplit<FitnessFunction, NumBins>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    arma::Col<typename VecType::elem_type>& classProbabilities,
+    AuxiliarySplitInfo<typename VecType::elem_type>& /* aux */)
+{
+  typedef typename VecType::elem_type ElemType;
+
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2) || data.n_elem < 2)
+    return bestGain;
+
+  // Find the range of the data in this node.
+  ElemType minValue = data[0];
+  ElemType maxValue = data[0];
+  for (size_t i = 1; i < data.n_elem; ++i)
+  {
+    if (data[i] < minValue)
+      minValue = data[i];
+    else if (data[i] > maxValue)
+      maxValue = data[i];
+  }
+
+  // If every value is the same, there is nothing to split.
+  if (minValue == maxValue)
+    return bestGain;
+
+  // Now build the histogram.  Each column holds the (weighted) number of
+  // points of each class in the bin, followed by the number of points in the
+  // bin; we also keep the smallest and largest value in each bin.
+  const double binScale = double(NumBins) /
+      (double(maxValue) - double(minValue));
+  arma::mat histogram(numClasses + 1, NumBins, arma::fill::zeros);
+  arma::Col<ElemType> binMin(NumBins);
+  arma::Col<ElemType> binMax(NumBins);
+  binMin.fill(maxValue);
+  binMax.fill(minValue);
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    size_t bin = (size_t) ((double(data[i]) - double(minValue)) * binScale);
+    if (bin >= NumBins)
+      bin = NumBins - 1;
+
+    histogram(labels[i], bin) += UseWeights ? weights[i] : 1.0;
+    histogram(numClasses, bin) += 1.0;
+    if (data[i] < binMin[bin])
+      binMin[bin] = data[i];
+    if (data[i] > binMax[bin])
+      binMax[bin] = data[i];
+  }
+
+  const arma::vec totalCounts = arma::sum(histogram.head_rows(numClasses), 1);
+
+  size_t leftBin, rightBin;
+  const double gain = BestBoundary(bestGain, histogram, totalCounts,
+      minimumLeafSize, leftBin, rightBin);
+  if (leftBin == NumBins)
+    return bestGain;
+
+  classProbabilities.set_size(1);
+  classProbabilities[0] = (binMax[leftBin] + binMin[rightBin]) / 2.0;
+  return gain;
+}
+
+template<typename FitnessFunction, size_t NumBins>
+template<typename MatType>
+void HistogramNumericSplit<FitnessFunction, NumBins>::Bin(
+    const MatType& data,
+    arma::Mat<BinType>& codes,
+    std::vector<arma::Col<typename MatType::elem_type>>& thresholds)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  codes.set_size(data.n_rows, data.n_cols);
+  thresholds.resize(data.n_rows);
+
+  // First find the boundaries of the bins of each dimension.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t d = 0; d < (omp_size_t) data.n_rows; ++d)
+  {
+    arma::Col<ElemType> sorted = arma::sort(arma::Col<ElemType>(
+        arma::trans(data.row(d))));
+
+    // Place a boundary between two consecutive distinct values whenever the
+    // current bin holds at least its share of the points (or whenever the
+    // value changes, if there are few distinct values).
+    const size_t numDistinct = (sorted.n_elem == 0) ? 0 : 1 +
+        arma::accu(sorted.tail(sorted.n_elem - 1) !=
+        sorted.head(sorted.n_elem - 1));
+    const double binShare = (numDistinct <= NumBins) ? 0.0 :
+        double(sorted.n_elem) / NumBins;
+
+    std::vector<ElemType> boundaries;
+    size_t binStart = 0;
+    for (size_t i = 1; i < sorted.n_elem; ++i)
+    {
+      if (sorted[i] != sorted[i - 1] && double(i - binStart) >= binShare &&
+          boundaries.size() < NumBins - 1)
+      {
+        boundaries.push_back(sorted[i - 1] + (sorted[i] - sorted[i - 1]) / 2);
+        binStart = i;
+      }
+    }
+    thresholds[d] = arma::Col<ElemType>(boundaries);
+  }
+
+  // Now find the code of each value: the first bin whose upper boundary is not
+  // less than the value.  This is done point by point, so that each thread
+  // writes its own columns of the codes.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+  {
+    for (size_t d = 0; d < data.n_rows; ++d)
+    {
+      const ElemType* begin = thresholds[d].memptr();
+      const ElemType* end = begin + thresholds[d].n_elem;
+      codes(d, i) = (BinType) (std::lower_bound(begin, end, data(d, i)) -
+          begin);
+    }
+  }
+}
+
+template<typename FitnessFunction, size_t NumBins>
+double HistogramNumericSplit<FitnessFunction, NumBins>::BestBoundary(
+    const double bestGain,
+    const arma::mat& histogram,
+    const arma::vec& totalCounts,
+    const size_t minimumLeafSize,
+    size_t& leftBin,
+    size_t& rightBin)
+{
+  // This means "no better split found".
+  leftBin = histogram.n_cols;
+  rightBin = histogram.n_cols;
+
+  const size_t numClasses = totalCounts.n_elem;
+  const double totalWeight = arma::accu(totalCounts);
+  const double totalSize = arma::accu(histogram.row(numClasses));
+  if (totalWeight <= 0.0)
+    return bestGain;
+
+  // Loop through all the boundaries between non-empty bins, choosing the best
+  // one.  Also, force a minimum leaf size of 1 (empty children don't make
+  // sense).
+  double bestFoundGain = bestGain;
+  const double minimum = (double) std::max(minimumLeafSize, (size_t) 1);
+  arma::vec leftCounts(numClasses, arma::fill::zeros);
+  arma::vec rightCounts(numClasses);
+  double leftSize = 0.0;
+  size_t lastBin = histogram.n_cols; // This means "no non-empty bin seen yet".
+  for (size_t bin = 0; bin < histogram.n_cols; ++bin)
+  {
+    const double binSize = histogram(numClasses, bin);
+    if (binSize == 0.0)
+      continue;
+
+    // Consider splitting between the last non-empty bin and this one.
+    if (lastBin != histogram.n_cols && leftSize >= minimum)
+    {
+      rightCounts = totalCounts - leftCounts;
+      const double leftWeight = arma::accu(leftCounts);
+      const double rightWeight = totalWeight - leftWeight;
+
+      // Calculate the gain for the left and right child.
+      const double leftGain = FitnessFunction::EvaluatePtr(
+          leftCounts.memptr(), numClasses, leftWeight);
+      const double rightGain = FitnessFunction::EvaluatePtr(
+          rightCounts.memptr(), numClasses, rightWeight);
+
+      // Calculate the gain at this split point.
+      const double gain = (leftWeight / totalWeight) * leftGain +
+          (rightWeight / totalWeight) * rightGain;
+
+      // Corner case: is this the best possible split?
+      if (gain >= 0.0)
+      {
+        // We can take a shortcut: no split will be better than this, so just
+        // take this one.
+        leftBin = lastBin;
+        rightBin = bin;
+        return gain;
+      }
+      else if (gain > bestFoundGain)
+      {
+        // We still have a better split.
+        bestFoundGain = gain;
+        leftBin = lastBin;
+        rightBin = bin;
+      }
+    }
+
+    // Move this bin to the left side.
+    leftCounts += histogram.unsafe_col(bin).head(numClasses);
+    leftSize += binSize;
+    lastBin = bin;
+
+    // If the right side is now too small, no further split is possible.
+    if (totalSize - leftSize < minimum)
+      break;
+  }
+
+  return bestFoundGain;
+}
+
+template<typename FitnessFunction, size_t NumBins>
+template<typename ElemType>
+size_t HistogramNumericSplit<FitnessFunction, NumBins>::CalculateDirection(
+    const ElemType& point,
+    const arma::Col<ElemType>& classProbabilities,
+    const AuxiliarySplitInfo<ElemType>& /* aux */)
+{
+  if (point <= classProbabilities[0])
+    return 0; // Go left.
+  else
+    return 1; // Go right.
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
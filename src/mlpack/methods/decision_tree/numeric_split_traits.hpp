@@ -0,0 +1,47 @@
+/**
+ * @file numeric_split_traits.hpp
+ *
+ * Traits of the numeric split types of decision trees.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_NUMERIC_SPLIT_TRAITS_HPP
+#define MLPACK_METHODS_DECISION_TREE_NUMERIC_SPLIT_TRAITS_HPP
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The NumericSplitTraits class specifies properties of a numeric split type
+ * that DecisionTree can take advantage of.
+ *
+ * If PreBinned is true, the split type provides a BinType, and static Bin()
+ * and BestBoundary() functions (see HistogramNumericSplit); DecisionTree then
+ * bins the data once before training on numeric data, and computes the
+ * per-class histograms of each node from the bin codes.
+ *
+ * If ThresholdSplit is true, every split made by the split type sends the
+ * points whose value is at most classProbabilities[0] to the first child and
+ * the other points to the second child; DecisionTree then stores the threshold
+ * in its flattened layout and classifies without calling CalculateDirection().
+ *
+ * By default, split types have neither property; specialize this class to
+ * change that.
+ */
+template<typename NumericSplitType>
+class NumericSplitTraits
+{
+ public:
+  //! Whether or not the split type supports pre-binned training.
+  static const bool PreBinned = false;
+  //! Whether or not every split is a single threshold.
+  static const bool ThresholdSplit = false;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
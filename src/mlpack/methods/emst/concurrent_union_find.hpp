@@ -0,0 +1,113 @@
+/**
+ * @file concurrent_union_find.hpp
+ *
+ * Implements a lock-free union-find data structure that can be used by many
+ * threads at once.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_EMST_CONCURRENT_UNION_FIND_HPP
+#define MLPACK_METHODS_EMST_CONCURRENT_UNION_FIND_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <atomic>
+
+namespace mlpack {
+namespace emst {
+
+/**
+ * A union-find data structure whose Union() and Find() operations may be called
+ * concurrently from multiple threads without any locking.  Each parent pointer
+ * is an atomic, and a union links the root with the larger index below the
+ * root with the smaller index using a compare-and-swap.  Because parent
+ * pointers only ever point to smaller indices, no cycles can form, and Find()
+ * can safely perform path halving while other threads are linking roots.
+ *
+ * A consequence of linking by index is that the representative of every
+ * component is the smallest index in that component, so the result of Find()
+ * does not depend on the order in which unions were performed.
+ *
+ * This is slightly slower than UnionFind when only one thread is used, since
+ * there is no union by rank.
+ */
+class ConcurrentUnionFind
+{
+ private:
+  std::vector<std::atomic<size_t>> parent;
+
+ public:
+  //! Construct the object with the given size.
+  ConcurrentUnionFind(const size_t size) : parent(size)
+  {
+    for (size_t i = 0; i < size; ++i)
+      parent[i].store(i, std::memory_order_relaxed);
+  }
+
+  /**
+   * Returns the component containing an element.  This is safe to call while
+   * other threads call Union(), but the result may be out of date as soon as it
+   * is returned if other threads are still merging components.
+   *
+   * @param x The element to find the component of.
+   * @return The index of the component containing x.
+   */
+  size_t Find(size_t x)
+  {
+    size_t p = parent[x].load();
+    while (p != x)
+    {
+      // Path halving: point x at its grandparent.  If this fails, another
+      // thread has already moved x closer to the root, which is fine.
+      size_t gp = parent[p].load();
+      if (gp != p)
+      {
+        size_t expected = p;
+        parent[x].compare_exchange_weak(expected, gp);
+      }
+
+      x = gp;
+      p = parent[x].load();
+    }
+
+    return x;
+  }
+
+  /**
+   * Union the components containing x and y.  If several threads try to union
+   * the same two components at once, exactly one of them returns true.
+   *
+   * @param x One element.
+   * @param y Another element.
+   * @return true if x and y were in different components before the call.
+   */
+  bool Union(const size_t x, const size_t y)
+  {
+    size_t xRoot = x;
+    size_t yRoot = y;
+    while (true)
+    {
+      xRoot = Find(xRoot);
+      yRoot = Find(yRoot);
+      if (xRoot == yRoot)
+        return false;
+
+      // Always link the larger root below the smaller one.
+      if (xRoot < yRoot)
+        std::swap(xRoot, yRoot);
+
+      // This only succeeds if xRoot is still a root.  Otherwise, some other
+      // thread has linked it in the meantime, and we have to try again.
+      size_t expected = xRoot;
+      if (parent[xRoot].compare_exchange_strong(expected, yRoot))
+        return true;
+    }
+  }
+}; // class ConcurrentUnionFind
+
+} // namespace emst
+} // namespace mlpack
+
+#endif
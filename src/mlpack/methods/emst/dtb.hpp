@@ -27,6 +27,7 @@
 
 #include "dtb_stat.hpp"
 #include "edge_pair.hpp"
+#include "concurrent_union_find.hpp"
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/metrics/lmetric.hpp>
@@ -68,6 +69,11 @@ namespace emst /** Euclidean Minimum Spanning Trees. */ {
  * More advanced usage of the class can use different types of trees, pass in an
  * already-built tree, or compute the MST using the O(n^2) naive algorithm.
  *
+ * If OpenMP is available, each Boruvka round is parallelized: the query tree is
+ * split into a set of disjoint subtrees, each of which is traversed against the
+ * whole reference tree by one thread, and the components found in the round
+ * are merged concurrently with a ConcurrentUnionFind.
+ *
  * @tparam MetricType The metric to use.
  * @tparam MatType The type of data matrix to use.
  * @tparam TreeType Type of tree to use.  This should follow the TreeType policy
@@ -103,7 +109,18 @@ class DualTreeBoruvka
   std::vector<EdgePair> edges; // We must use vector with non-numerical types.
 
   //! Connections.
-  UnionFind connections;
+  ConcurrentUnionFind connections;
+  //! The component of each point, flattened from connections once per round
+  //! so that the traversal doesn't need to use the union-find structure.
+  arma::Col<size_t> components;
+
+  //! The distance to the best candidate edge of each component found so far in
+  //! this round, shared between all threads.
+  std::vector<std::atomic<double>> componentDistances;
+  //! The distance to the best candidate edge of each point in this round.
+  arma::vec pointDistances;
+  //! The other endpoint of the best candidate edge of each point in this round.
+  arma::Col<size_t> pointNeighbors;
 
   //! List of edge nodes.
   arma::Col<size_t> neighborsInComponent;
@@ -112,6 +129,12 @@ class DualTreeBoruvka
   //! List of edge distances.
   arma::vec neighborsDistances;
 
+  //! Disjoint query subtrees which cover the whole tree, each of which is
+  //! traversed by one thread.
+  std::vector<Tree*> queryFrontier;
+  //! The nodes above the query frontier, in the order they were expanded.
+  std::vector<Tree*> frontierAncestors;
+
   //! Total distance of the tree.
   double totalDist;
 
@@ -187,6 +210,12 @@ class DualTreeBoruvka
    */
   void AddAllEdges();
 
+  /**
+   * Split the tree into the disjoint query subtrees that the threads traverse,
+   * with a few subtrees for each thread so that the work can be balanced.
+   */
+  void BuildQueryFrontier();
+
   /**
    * Unpermute the edge list and output it to results.
    */
@@ -198,6 +227,12 @@ class DualTreeBoruvka
    */
   void CleanupHelper(Tree* tree);
 
+  /**
+   * Reset the values of a single node and check if it is fully connected,
+   * assuming that its children have already been cleaned up.
+   */
+  void CleanupNode(Tree* tree);
+
   /**
    * The values stored in the tree must be reset on each iteration.
    */
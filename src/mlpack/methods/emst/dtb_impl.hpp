@@ -14,6 +14,10 @@
 
 #include "dtb_rules.hpp"
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace emst {
 
@@ -58,6 +62,7 @@ DualTreeBoruvka<MetricType, MatType, TreeType>::DualTreeBoruvka(
     ownTree(!naive),
     naive(naive),
     connections(dataset.n_cols),
+    componentDistances(dataset.n_cols),
     totalDist(0.0),
     metric(metric)
 {
@@ -67,6 +72,18 @@ DualTreeBoruvka<MetricType, MatType, TreeType>::DualTreeBoruvka(
   neighborsOutComponent.set_size(data.n_cols);
   neighborsDistances.set_size(data.n_cols);
   neighborsDistances.fill(DBL_MAX);
+
+  // At the start, every point is its own component.
+  components.set_size(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    components[i] = i;
+    componentDistances[i].store(DBL_MAX);
+  }
+
+  pointDistances.set_size(data.n_cols);
+  pointDistances.fill(DBL_MAX);
+  pointNeighbors.set_size(data.n_cols);
 }
 
 template<
@@ -83,6 +100,7 @@ DualTreeBoruvka<MetricType, MatType, TreeType>::DualTreeBoruvka(
     ownTree(false),
     naive(false),
     connections(data.n_cols),
+    componentDistances(data.n_cols),
     totalDist(0.0),
     metric(metric)
 {
@@ -92,6 +110,18 @@ DualTreeBoruvka<MetricType, MatType, TreeType>::DualTreeBoruvka(
   neighborsOutComponent.set_size(data.n_cols);
   neighborsDistances.set_size(data.n_cols);
   neighborsDistances.fill(DBL_MAX);
+
+  // At the start, every point is its own component.
+  components.set_size(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    components[i] = i;
+    componentDistances[i].store(DBL_MAX);
+  }
+
+  pointDistances.set_size(data.n_cols);
+  pointDistances.fill(DBL_MAX);
+  pointNeighbors.set_size(data.n_cols);
 }
 
 template<
@@ -123,22 +153,41 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
 
   totalDist = 0; // Reset distance.
 
+  if (!naive)
+    BuildQueryFrontier();
+
   typedef DTBRules<MetricType, Tree> RuleType;
-  RuleType rules(data, connections, neighborsDistances, neighborsInComponent,
-                 neighborsOutComponent, metric);
+  size_t baseCases = 0;
+  size_t scores = 0;
   while (edges.size() < (data.n_cols - 1))
   {
     if (naive)
     {
-      // Full O(N^2) traversal.
-      for (size_t i = 0; i < data.n_cols; ++i)
+      // Full O(N^2) traversal.  Each query point is handled by one thread.
+      #pragma omp parallel for schedule(dynamic)
+      for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+      {
+        RuleType rules(data, components, componentDistances, pointDistances,
+            pointNeighbors, metric);
         for (size_t j = 0; j < data.n_cols; ++j)
           rules.BaseCase(i, j);
+      }
     }
     else
     {
-      typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
-      traverser.Traverse(*tree, *tree);
+      // Each query subtree is traversed against the whole reference tree by
+      // one thread.
+      #pragma omp parallel for schedule(dynamic) reduction(+:baseCases, scores)
+      for (omp_size_t i = 0; i < (omp_size_t) queryFrontier.size(); ++i)
+      {
+        RuleType rules(data, components, componentDistances, pointDistances,
+            pointNeighbors, metric);
+        typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+        traverser.Traverse(*queryFrontier[i], *tree);
+
+        baseCases += rules.BaseCases();
+        scores += rules.Scores();
+      }
     }
 
     AddAllEdges();
@@ -148,8 +197,8 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
     Log::Info << edges.size() << " edges found so far." << std::endl;
     if (!naive)
     {
-      Log::Info << rules.BaseCases() << " cumulative base cases." << std::endl;
-      Log::Info << rules.Scores() << " cumulative node combinations scored."
+      Log::Info << baseCases << " cumulative base cases." << std::endl;
+      Log::Info << scores << " cumulative node combinations scored."
           << std::endl;
     }
   }
@@ -195,20 +244,101 @@ template<
              typename TreeMatType> class TreeType>
 void DualTreeBoruvka<MetricType, MatType, TreeType>::AddAllEdges()
 {
+  // Find the best candidate edge of each component from the candidates of its
+  // points.  Points are visited in order, so ties go to the smallest index.
+  std::vector<size_t> candidateComponents;
   for (size_t i = 0; i < data.n_cols; i++)
   {
-    size_t component = connections.Find(i);
-    size_t inEdge = neighborsInComponent[component];
-    size_t outEdge = neighborsOutComponent[component];
-    if (connections.Find(inEdge) != connections.Find(outEdge))
+    const size_t component = components[i];
+    if (pointDistances[i] < neighborsDistances[component])
     {
-      // totalDist = totalDist + dist;
-      // changed to make this agree with the cover tree code
-      totalDist += neighborsDistances[component];
-      AddEdge(inEdge, outEdge, neighborsDistances[component]);
-      connections.Union(inEdge, outEdge);
+      if (neighborsDistances[component] == DBL_MAX)
+        candidateComponents.push_back(component);
+
+      neighborsDistances[component] = pointDistances[i];
+      neighborsInComponent[component] = i;
+      neighborsOutComponent[component] = pointNeighbors[i];
     }
   }
+
+  // Merge the components along their candidate edges concurrently.  If two
+  // components chose the same edge, only one of the unions succeeds, so every
+  // merge adds exactly one edge and no cycles are formed.
+  std::vector<char> merged(candidateComponents.size());
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) candidateComponents.size(); ++i)
+  {
+    const size_t component = candidateComponents[i];
+    merged[i] = connections.Union(neighborsInComponent[component],
+                                  neighborsOutComponent[component]);
+  }
+
+  for (size_t i = 0; i < candidateComponents.size(); ++i)
+  {
+    if (!merged[i])
+      continue;
+
+    // totalDist = totalDist + dist;
+    // changed to make this agree with the cover tree code
+    const size_t component = candidateComponents[i];
+    totalDist += neighborsDistances[component];
+    AddEdge(neighborsInComponent[component], neighborsOutComponent[component],
+        neighborsDistances[component]);
+  }
+
+  // Flatten the components for the next round.
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+    components[i] = connections.Find(i);
+}
+
+/**
+ * Split the tree into disjoint query subtrees for the threads.
+ */
+template<
+    typename MetricType,
+    typename MatType,
+    template<typename TreeMetricType,
+             typename TreeStatType,
+             typename TreeMatType> class TreeType>
+void DualTreeBoruvka<MetricType, MatType, TreeType>::BuildQueryFrontier()
+{
+  queryFrontier.clear();
+  frontierAncestors.clear();
+
+  // With one thread, the whole tree is traversed at once, as it would be
+  // without OpenMP.
+  size_t minFrontierSize = 1;
+  #ifdef HAS_OPENMP
+    if (omp_get_max_threads() > 1)
+      minFrontierSize = 4 * omp_get_max_threads();
+  #endif
+
+  // Expand the frontier one level at a time until it is large enough.
+  queryFrontier.push_back(tree);
+  while (queryFrontier.size() < minFrontierSize)
+  {
+    std::vector<Tree*> nextFrontier;
+    for (size_t i = 0; i < queryFrontier.size(); ++i)
+    {
+      Tree* node = queryFrontier[i];
+      if (node->NumChildren() == 0)
+      {
+        nextFrontier.push_back(node);
+        continue;
+      }
+
+      frontierAncestors.push_back(node);
+      for (size_t j = 0; j < node->NumChildren(); ++j)
+        nextFrontier.push_back(&node->Child(j));
+    }
+
+    // Stop if every subtree is already a leaf.
+    if (nextFrontier.size() == queryFrontier.size())
+      break;
+
+    queryFrontier.swap(nextFrontier);
+  }
 }
 
 /**
@@ -277,21 +407,35 @@ template<
              typename TreeStatType,
              typename TreeMatType> class TreeType>
 void DualTreeBoruvka<MetricType, MatType, TreeType>::CleanupHelper(Tree* tree)
+{
+  // Recurse into all children.
+  for (size_t i = 0; i < tree->NumChildren(); ++i)
+    CleanupHelper(&tree->Child(i));
+
+  CleanupNode(tree);
+}
+
+/**
+ * Reset the values of one node, after its children have been cleaned up.
+ */
+template<
+    typename MetricType,
+    typename MatType,
+    template<typename TreeMetricType,
+             typename TreeStatType,
+             typename TreeMatType> class TreeType>
+void DualTreeBoruvka<MetricType, MatType, TreeType>::CleanupNode(Tree* tree)
 {
   // Reset the statistic information.
   tree->Stat().MaxNeighborDistance() = DBL_MAX;
   tree->Stat().MinNeighborDistance() = DBL_MAX;
   tree->Stat().Bound() = DBL_MAX;
 
-  // Recurse into all children.
-  for (size_t i = 0; i < tree->NumChildren(); ++i)
-    CleanupHelper(&tree->Child(i));
-
   // Get the component of the first child or point.  Then we will check to see
   // if all other components of children and points are the same.
   const int component = (tree->NumChildren() != 0) ?
       tree->Child(0).Stat().ComponentMembership() :
-      connections.Find(tree->Point(0));
+      components[tree->Point(0)];
 
   // Check components of children.
   for (size_t i = 0; i < tree->NumChildren(); ++i)
@@ -300,7 +444,7 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::CleanupHelper(Tree* tree)
 
   // Check components of points.
   for (size_t i = 0; i < tree->NumPoints(); ++i)
-    if (connections.Find(tree->Point(i)) != size_t(component))
+    if (components[tree->Point(i)] != size_t(component))
       return;
 
   // If we made it this far, all components are the same.
@@ -318,11 +462,25 @@ template<
              typename TreeMatType> class TreeType>
 void DualTreeBoruvka<MetricType, MatType, TreeType>::Cleanup()
 {
-  for (size_t i = 0; i < data.n_cols; i++)
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; i++)
+  {
+    componentDistances[i].store(DBL_MAX, std::memory_order_relaxed);
+    pointDistances[i] = DBL_MAX;
     neighborsDistances[i] = DBL_MAX;
+  }
 
   if (!naive)
-    CleanupHelper(tree);
+  {
+    // Each query subtree can be cleaned up independently; then the nodes above
+    // them are cleaned up, deepest first.
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) queryFrontier.size(); ++i)
+      CleanupHelper(queryFrontier[i]);
+
+    for (size_t i = frontierAncestors.size(); i > 0; --i)
+      CleanupNode(frontierAncestors[i - 1]);
+  }
 }
 
 } // namespace emst
@@ -13,21 +13,44 @@
 #define MLPACK_METHODS_EMST_DTB_RULES_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <atomic>
 
 #include <mlpack/core/tree/traversal_info.hpp>
 
 namespace mlpack {
 namespace emst {
 
+/**
+ * The rules for one Boruvka round of the DualTreeBoruvka algorithm.  Several
+ * DTBRules objects may be used at once by different threads, as long as each
+ * one traverses a disjoint set of query nodes.  The candidate neighbor of each
+ * query point is stored separately (and each query point is only visited by
+ * one thread), and the only shared state that is written is the distance to
+ * the best candidate of each component, which is updated with an atomic
+ * compare-and-swap and only ever decreases.
+ */
 template<typename MetricType, typename TreeType>
 class DTBRules
 {
  public:
+  /**
+   * Construct the rules.
+   *
+   * @param dataSet The data points.
+   * @param components The component of each point in this round.
+   * @param componentDistances The distance to the best candidate neighbor found
+   *     so far for each component, shared between threads.
+   * @param pointDistances The distance to the best candidate neighbor found so
+   *     far for each query point.
+   * @param pointNeighbors The best candidate neighbor found so far for each
+   *     query point.
+   * @param metric The instantiated metric.
+   */
   DTBRules(const arma::mat& dataSet,
-           UnionFind& connections,
-           arma::vec& neighborsDistances,
-           arma::Col<size_t>& neighborsInComponent,
-           arma::Col<size_t>& neighborsOutComponent,
+           const arma::Col<size_t>& components,
+           std::vector<std::atomic<double>>& componentDistances,
+           arma::vec& pointDistances,
+           arma::Col<size_t>& pointNeighbors,
            MetricType& metric);
 
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
@@ -101,23 +124,28 @@ class DTBRules
   //! The data points.
   const arma::mat& dataSet;
 
-  //! Stores the tree structure so far
-  UnionFind& connections;
+  //! The component of each point; this does not change during a round.
+  const arma::Col<size_t>& components;
 
   //! The distance to the candidate nearest neighbor for each component.
-  arma::vec& neighborsDistances;
+  std::vector<std::atomic<double>>& componentDistances;
 
-  //! The index of the point in the component that is an endpoint of the
-  //! candidate edge.
-  arma::Col<size_t>& neighborsInComponent;
+  //! The distance to the candidate nearest neighbor of each query point.
+  arma::vec& pointDistances;
 
-  //! The index of the point outside of the component that is an endpoint
-  //! of the candidate edge.
-  arma::Col<size_t>& neighborsOutComponent;
+  //! The candidate nearest neighbor (outside of its component) of each query
+  //! point.
+  arma::Col<size_t>& pointNeighbors;
 
   //! The instantiated metric.
   MetricType& metric;
 
+  //! Return the distance to the candidate nearest neighbor of a component.
+  double ComponentDistance(const size_t component) const
+  {
+    return componentDistances[component].load(std::memory_order_relaxed);
+  }
+
   /**
    * Update the bound for the given query node.
    */
@@ -18,17 +18,17 @@ namespace emst {
 template<typename MetricType, typename TreeType>
 DTBRules<MetricType, TreeType>::
 DTBRules(const arma::mat& dataSet,
-         UnionFind& connections,
-         arma::vec& neighborsDistances,
-         arma::Col<size_t>& neighborsInComponent,
-         arma::Col<size_t>& neighborsOutComponent,
+         const arma::Col<size_t>& components,
+         std::vector<std::atomic<double>>& componentDistances,
+         arma::vec& pointDistances,
+         arma::Col<size_t>& pointNeighbors,
          MetricType& metric)
 :
   dataSet(dataSet),
-  connections(connections),
-  neighborsDistances(neighborsDistances),
-  neighborsInComponent(neighborsInComponent),
-  neighborsOutComponent(neighborsOutComponent),
+  components(components),
+  componentDistances(componentDistances),
+  pointDistances(pointDistances),
+  pointNeighbors(pointNeighbors),
   metric(metric),
   baseCases(0),
   scores(0)
@@ -44,12 +44,8 @@ double DTBRules<MetricType, TreeType>::BaseCase(const size_t queryIndex,
   // Check if the points are in the same component at this iteration.
   // If not, return the distance between them.  Also, store a better result as
   // the current neighbor, if necessary.
-  double newUpperBound = -1.0;
-
-  // Find the index of the component the query is in.
-  size_t queryComponentIndex = connections.Find(queryIndex);
-
-  size_t referenceComponentIndex = connections.Find(referenceIndex);
+  const size_t queryComponentIndex = components[queryIndex];
+  const size_t referenceComponentIndex = components[referenceIndex];
 
   if (queryComponentIndex != referenceComponentIndex)
   {
@@ -57,19 +53,27 @@ double DTBRules<MetricType, TreeType>::BaseCase(const size_t queryIndex,
     double distance = metric.Evaluate(dataSet.col(queryIndex),
                                       dataSet.col(referenceIndex));
 
-    if (distance < neighborsDistances[queryComponentIndex])
+    // A candidate that isn't better than the best candidate of the whole
+    // component can't give the shortest edge out of it, so there is no need to
+    // store it.
+    double componentDistance = ComponentDistance(queryComponentIndex);
+    if (distance < componentDistance)
     {
       Log::Assert(queryIndex != referenceIndex);
 
-      neighborsDistances[queryComponentIndex] = distance;
-      neighborsInComponent[queryComponentIndex] = queryIndex;
-      neighborsOutComponent[queryComponentIndex] = referenceIndex;
+      // Only this thread visits this query point.
+      pointDistances[queryIndex] = distance;
+      pointNeighbors[queryIndex] = referenceIndex;
+
+      // Lower the distance for the component, unless another thread has
+      // already found something better.
+      while (distance < componentDistance &&
+          !componentDistances[queryComponentIndex].compare_exchange_weak(
+          componentDistance, distance, std::memory_order_relaxed)) { }
     }
   }
 
-  if (newUpperBound < neighborsDistances[queryComponentIndex])
-    newUpperBound = neighborsDistances[queryComponentIndex];
-
+  const double newUpperBound = ComponentDistance(queryComponentIndex);
   Log::Assert(newUpperBound >= 0.0);
 
   return newUpperBound;
@@ -79,7 +83,7 @@ template<typename MetricType, typename TreeType>
 double DTBRules<MetricType, TreeType>::Score(const size_t queryIndex,
                                              TreeType& referenceNode)
 {
-  size_t queryComponentIndex = connections.Find(queryIndex);
+  const size_t queryComponentIndex = components[queryIndex];
 
   // If the query belongs to the same component as all of the references,
   // then prune.  The cast is to stop a warning about comparing unsigned to
@@ -93,7 +97,7 @@ double DTBRules<MetricType, TreeType>::Score(const size_t queryIndex,
 
   // If all the points in the reference node are farther than the candidate
   // nearest neighbor for the query's component, we prune.
-  return neighborsDistances[queryComponentIndex] < distance
+  return ComponentDistance(queryComponentIndex) < distance
       ? DBL_MAX : distance;
 }
 
@@ -104,7 +108,7 @@ double DTBRules<MetricType, TreeType>::Rescore(const size_t queryIndex,
 {
   // We don't need to check component membership again, because it can't
   // change inside a single iteration.
-  return (oldScore > neighborsDistances[connections.Find(queryIndex)])
+  return (oldScore > ComponentDistance(components[queryIndex]))
       ? DBL_MAX : oldScore;
 }
 
@@ -152,8 +156,7 @@ inline double DTBRules<MetricType, TreeType>::CalculateBound(
   // Now, find the best and worst point bounds.
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
-    const size_t pointComponent = connections.Find(queryNode.Point(i));
-    const double bound = neighborsDistances[pointComponent];
+    const double bound = ComponentDistance(components[queryNode.Point(i)]);
 
     if (bound > worstPointBound)
       worstPointBound = bound;
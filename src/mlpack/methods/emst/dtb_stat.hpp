@@ -36,7 +36,7 @@ class DTBStat
   double bound;
 
   //! The index of the component that all points in this node belong to.  This
-  //! is the same index returned by UnionFind for all points in this node.  If
+  //! is the same component index that every point in this node has.  If
   //! points in this node are in different components, this value will be
   //! negative.
   int componentMembership;
@@ -304,33 +304,7 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Naive implementation.
   if (naive)
   {
-    // Simple double loop.  Stupid, slow, but a good benchmark.
-    for (size_t q = 0; q < querySet.n_cols; ++q)
-    {
-      const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
-      std::vector<Candidate> cList(k, def);
-      CandidateList pqueue(CandidateCmp(), std::move(cList));
-
-      for (size_t r = 0; r < referenceSet->n_cols; ++r)
-      {
-        const double eval = metric.Kernel().Evaluate(querySet.col(q),
-                                                     referenceSet->col(r));
-
-        if (eval > pqueue.top().first)
-        {
-          Candidate c = std::make_pair(eval, r);
-          pqueue.pop();
-          pqueue.push(c);
-        }
-      }
-
-      for (size_t j = 1; j <= k; j++)
-      {
-        indices(k - j, q) = pqueue.top().second;
-        kernels(k - j, q) = pqueue.top().first;
-        pqueue.pop();
-      }
-    }
+    NaiveSearch(querySet, k, indices, kernels, false);
 
     Timer::Stop("computing_products");
 
@@ -433,36 +407,7 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Naive implementation.
   if (naive)
   {
-    // Simple double loop.  Stupid, slow, but a good benchmark.
-    for (size_t q = 0; q < referenceSet->n_cols; ++q)
-    {
-      const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
-      std::vector<Candidate> cList(k, def);
-      CandidateList pqueue(CandidateCmp(), std::move(cList));
-
-      for (size_t r = 0; r < referenceSet->n_cols; ++r)
-      {
-        if (q == r)
-          continue; // Don't return the point as its own candidate.
-
-        const double eval = metric.Kernel().Evaluate(referenceSet->col(q),
-                                                     referenceSet->col(r));
-
-        if (eval > pqueue.top().first)
-        {
-          Candidate c = std::make_pair(eval, r);
-          pqueue.pop();
-          pqueue.push(c);
-        }
-      }
-
-      for (size_t j = 1; j <= k; j++)
-      {
-        indices(k - j, q) = pqueue.top().second;
-        kernels(k - j, q) = pqueue.top().first;
-        pqueue.pop();
-      }
-    }
+    NaiveSearch(*referenceSet, k, indices, kernels, true);
 
     Timer::Stop("computing_products");
 
@@ -559,6 +504,78 @@ void FastMKS<KernelType, MatType, TreeType>::Serialize(
   }
 }
 
+template<typename KernelType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void FastMKS<KernelType, MatType, TreeType>::NaiveSearch(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& indices,
+    arma::mat& kernels,
+    const bool sameSet)
+{
+  const size_t tileSize = 256;
+  const size_t numQueryTiles = (querySet.n_cols + tileSize - 1) / tileSize;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t t = 0; t < (omp_size_t) numQueryTiles; ++t)
+  {
+    const size_t queryBegin = t * tileSize;
+    const size_t queryEnd = std::min(queryBegin + tileSize,
+        (size_t) querySet.n_cols) - 1;
+
+    const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
+    std::vector<CandidateList> pqueues;
+    pqueues.reserve(queryEnd - queryBegin + 1);
+    for (size_t q = queryBegin; q <= queryEnd; ++q)
+      pqueues.push_back(CandidateList(CandidateCmp(),
+          std::vector<Candidate>(k, def)));
+
+    // Each column of a tile holds the kernel values of one query point, for a
+    // range of reference points.
+    arma::mat tile;
+    for (size_t referenceBegin = 0; referenceBegin < referenceSet->n_cols;
+         referenceBegin += tileSize)
+    {
+      const size_t referenceEnd = std::min(referenceBegin + tileSize,
+          (size_t) referenceSet->n_cols) - 1;
+      kernel::KernelMatrixRule<KernelType>::Evaluate(metric.Kernel(),
+          referenceSet->cols(referenceBegin, referenceEnd),
+          querySet.cols(queryBegin, queryEnd), tile);
+
+      for (size_t q = 0; q < tile.n_cols; ++q)
+      {
+        CandidateList& pqueue = pqueues[q];
+        for (size_t r = 0; r < tile.n_rows; ++r)
+        {
+          // Don't return the point as its own candidate.
+          if (sameSet && queryBegin + q == referenceBegin + r)
+            continue;
+
+          if (tile(r, q) > pqueue.top().first)
+          {
+            Candidate c = std::make_pair(tile(r, q), referenceBegin + r);
+            pqueue.pop();
+            pqueue.push(c);
+          }
+        }
+      }
+    }
+
+    for (size_t q = 0; q < pqueues.size(); ++q)
+    {
+      for (size_t j = 1; j <= k; j++)
+      {
+        indices(k - j, queryBegin + q) = pqueues[q].top().second;
+        kernels(k - j, queryBegin + q) = pqueues[q].top().first;
+        pqueues[q].pop();
+      }
+    }
+  }
+}
+
 } // namespace fastmks
 } // namespace mlpack
 
@@ -76,6 +76,24 @@ double GMM::Probability(const arma::vec& observation,
   return weights[component] * dists[component].Probability(observation);
 }
 
+/**
+ * Return the probability of each of the given observations being from this
+ * distribution.
+ */
+void GMM::Probability(const arma::mat& observations,
+                      arma::vec& probabilities) const
+{
+  // Evaluate each Gaussian on all of the observations at once, and accumulate
+  // the weighted sum.
+  probabilities.zeros(observations.n_cols);
+  arma::vec componentProbabilities;
+  for (size_t i = 0; i < gaussians; i++)
+  {
+    dists[i].Probability(observations, componentProbabilities);
+    probabilities += weights[i] * componentProbabilities;
+  }
+}
+
 /**
  * Return a randomly generated observation according to the probability
  * distribution defined by this object.
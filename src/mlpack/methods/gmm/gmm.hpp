@@ -175,6 +175,16 @@ class GMM
   double Probability(const arma::vec& observation,
                      const size_t component) const;
 
+  /**
+   * Calculate the probability that each observation (column) in the given
+   * matrix came from this distribution.
+   *
+   * @param observations Observations to evaluate the probability of.
+   * @param probabilities Output probabilities for each observation.
+   */
+  void Probability(const arma::mat& observations,
+                   arma::vec& probabilities) const;
+
   /**
    * Return a randomly generated observation according to the probability
    * distribution defined by this object.
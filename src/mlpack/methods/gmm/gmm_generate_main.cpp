@@ -56,7 +56,7 @@ void mlpackMain()
   if (CLI::GetParam<int>("samples") < 0)
     Log::Fatal << "Parameter to --samples must be greater than 0!" << endl;
 
-  GMM gmm = std::move(CLI::GetParam<GMM>("input_model"));
+  GMM& gmm = CLI::GetParam<GMM>("input_model");
 
   size_t length = (size_t) CLI::GetParam<int>("samples");
   Log::Info << "Generating " << length << " samples..." << endl;
@@ -47,7 +47,7 @@ void mlpackMain()
         << "saved!" << endl;
 
   // Get the GMM and the points.
-  GMM gmm = std::move(CLI::GetParam<GMM>("input_model"));
+  GMM& gmm = CLI::GetParam<GMM>("input_model");
 
   arma::mat dataset = std::move(CLI::GetParam<arma::mat>("input"));
 
@@ -259,6 +259,34 @@ class HMM
   double Predict(const arma::mat& dataSeq,
                  arma::Row<size_t>& stateSeq) const;
 
+  /**
+   * Compute the most probable hidden state sequence for each of the given data
+   * sequences, using the Viterbi algorithm.  The sequences are processed in
+   * parallel if OpenMP is available.  The log-likelihood of the most probable
+   * state sequence for each data sequence is stored in logLikelihoods.
+   *
+   * @param dataSeq Vector of observation sequences.
+   * @param stateSeq Vector in which the most probable state sequence for each
+   *    observation sequence will be stored.
+   * @param logLikelihoods Vector in which the log-likelihood of each most
+   *    probable state sequence will be stored.
+   */
+  void Predict(const std::vector<arma::mat>& dataSeq,
+               std::vector<arma::Row<size_t> >& stateSeq,
+               arma::vec& logLikelihoods) const;
+
+  /**
+   * Compute the most probable hidden state sequence for each of the given data
+   * sequences, using the Viterbi algorithm.  The sequences are processed in
+   * parallel if OpenMP is available.
+   *
+   * @param dataSeq Vector of observation sequences.
+   * @param stateSeq Vector in which the most probable state sequence for each
+   *    observation sequence will be stored.
+   */
+  void Predict(const std::vector<arma::mat>& dataSeq,
+               std::vector<arma::Row<size_t> >& stateSeq) const;
+
   /**
    * Compute the log-likelihood of the given data sequence.
    *
@@ -359,6 +387,58 @@ class HMM
                 const arma::vec& scales,
                 arma::mat& backwardProb) const;
 
+  /**
+   * Compute the emission probability of every observation in the given data
+   * sequence for every hidden state.  Each emission distribution is evaluated
+   * on the whole sequence at once.  The returned matrix has rows equal to the
+   * number of hidden states and columns equal to the number of observations.
+   *
+   * @param dataSeq Data sequence to compute emission probabilities for.
+   * @param emissionProb Matrix in which emission probabilities will be saved.
+   */
+  void EmissionProbability(const arma::mat& dataSeq,
+                           arma::mat& emissionProb) const;
+
+  /**
+   * The Forward algorithm, using precomputed emission probabilities (as
+   * returned by EmissionProbability()).
+   *
+   * @param emissionProb Emission probabilities of each state for each
+   *    observation.
+   * @param scales Vector in which scaling factors will be saved.
+   * @param forwardProb Matrix in which forward probabilities will be saved.
+   */
+  void ForwardFromEmission(const arma::mat& emissionProb,
+                           arma::vec& scales,
+                           arma::mat& forwardProb) const;
+
+  /**
+   * The Backward algorithm, using precomputed emission probabilities (as
+   * returned by EmissionProbability()) and the scaling factors found by
+   * ForwardFromEmission().
+   *
+   * @param emissionProb Emission probabilities of each state for each
+   *    observation.
+   * @param scales Vector of scaling factors.
+   * @param backwardProb Matrix in which backward probabilities will be saved.
+   */
+  void BackwardFromEmission(const arma::mat& emissionProb,
+                            const arma::vec& scales,
+                            arma::mat& backwardProb) const;
+
+  /**
+   * The Viterbi algorithm, using precomputed emission probabilities (as
+   * returned by EmissionProbability()).  All computation is done in log-space.
+   *
+   * @param emissionProb Emission probabilities of each state for each
+   *    observation.
+   * @param stateSeq Vector in which the most probable state sequence will be
+   *    stored.
+   * @return Log-likelihood of most probable state sequence.
+   */
+  double Viterbi(const arma::mat& emissionProb,
+                 arma::Row<size_t>& stateSeq) const;
+
   //! Set of emission probability distributions; one for each state.
   std::vector<Distribution> emission;
 
@@ -102,8 +102,8 @@ void mlpackMain()
   else
     RandomSeed((size_t) time(NULL));
 
-  // Load model, and perform the generation.
-  HMMModel hmm;
-  hmm = std::move(CLI::GetParam<HMMModel>("model"));
+  // Load model, and perform the generation.  The model is used in place, so
+  // that it is not consumed.
+  HMMModel& hmm = CLI::GetParam<HMMModel>("model");
   hmm.PerformAction<Generate, void>(NULL); // No extra data required.
 }
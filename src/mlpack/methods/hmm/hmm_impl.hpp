@@ -104,10 +104,25 @@ void HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
   }
 
   // These are used later for training of each distribution.  We initialize it
-  // all now so we don't have to do any allocation later on.
+  // all now so we don't have to do any allocation later on.  The observations
+  // themselves do not change between iterations, so the emission list only
+  // needs to be filled once; each sequence occupies a contiguous block of it,
+  // starting at seqOffsets[seq].
   std::vector<arma::vec> emissionProb(transition.n_cols,
       arma::vec(totalLength));
   arma::mat emissionList(dimensionality, totalLength);
+  std::vector<size_t> seqOffsets(dataSeq.size());
+  size_t sumTime = 0;
+  for (size_t seq = 0; seq < dataSeq.size(); seq++)
+  {
+    seqOffsets[seq] = sumTime;
+    if (dataSeq[seq].n_cols > 0)
+    {
+      emissionList.cols(sumTime, sumTime + dataSeq[seq].n_cols - 1) =
+          dataSeq[seq];
+    }
+    sumTime += dataSeq[seq].n_cols;
+  }
 
   // This should be the Baum-Welch algorithm (EM for HMM estimation). This
   // follows the procedure outlined in Elliot, Aggoun, and Moore's book "Hidden
@@ -123,52 +138,96 @@ void HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
     // Reset log likelihood.
     loglik = 0;
 
-    // Sum over time.
-    size_t sumTime = 0;
+    // The E-step is independent for each sequence, so the sequences are
+    // processed in parallel.  Each thread accumulates its own expected counts,
+    // and these are reduced at the end.  The state probabilities for each
+    // sequence are written to disjoint parts of emissionProb, so no
+    // synchronization is necessary there.  An exception (for instance, from an
+    // invalid observation) can't leave the parallel region, so the exception of
+    // each sequence is stored and the first one is rethrown afterwards.
+    std::vector<std::exception_ptr> exceptions(dataSeq.size());
 
-    // Loop over each sequence.
-    for (size_t seq = 0; seq < dataSeq.size(); seq++)
+    #pragma omp parallel
     {
-      arma::mat stateProb;
-      arma::mat forward;
-      arma::mat backward;
-      arma::vec scales;
-
-      // Add the log-likelihood of this sequence.  This is the E-step.
-      loglik += Estimate(dataSeq[seq], stateProb, forward, backward, scales);
-
-      // Add to estimate of initial probability for state j.
-      for (size_t j = 0; j < transition.n_cols; ++j)
-        newInitial[j] += stateProb(j, 0);
-
-      // Now re-estimate the parameters.  This is the M-step.
-      //   pi_i = sum_d ((1 / P(seq[d])) sum_t (f(i, 0) b(i, 0))
-      //   T_ij = sum_d ((1 / P(seq[d])) sum_t (f(i, t) T_ij E_i(seq[d][t]) b(i,
-      //           t + 1)))
-      //   E_ij = sum_d ((1 / P(seq[d])) sum_{t | seq[d][t] = j} f(i, t) b(i, t)
-      // We store the new estimates in a different matrix.
-      for (size_t t = 0; t < dataSeq[seq].n_cols; ++t)
+      arma::vec threadInitial(transition.n_rows, arma::fill::zeros);
+      arma::mat threadTransition(transition.n_rows, transition.n_cols,
+          arma::fill::zeros);
+      double threadLoglik = 0.0;
+
+      #pragma omp for schedule(dynamic)
+      for (omp_size_t seq = 0; seq < (omp_size_t) dataSeq.size(); seq++)
       {
-        for (size_t j = 0; j < transition.n_cols; ++j)
+        const size_t seqLength = dataSeq[seq].n_cols;
+        if (seqLength == 0)
+          continue;
+
+        try
         {
-          if (t < dataSeq[seq].n_cols - 1)
+          arma::mat seqEmissionProb;
+          arma::mat stateProb;
+          arma::mat forward;
+          arma::mat backward;
+          arma::vec scales;
+
+          // Compute the emission probabilities of the whole sequence at once,
+          // then run the forward-backward algorithm.  This is the E-step.
+          EmissionProbability(dataSeq[seq], seqEmissionProb);
+          ForwardFromEmission(seqEmissionProb, scales, forward);
+          BackwardFromEmission(seqEmissionProb, scales, backward);
+          stateProb = forward % backward;
+
+          // Add the log-likelihood of this sequence.
+          threadLoglik += accu(log(scales));
+
+          // Add to estimate of initial probability for state j.
+          threadInitial += stateProb.col(0);
+
+          // Now re-estimate the parameters.  This is the M-step.
+          //   pi_i = sum_d ((1 / P(seq[d])) sum_t (f(i, 0) b(i, 0))
+          //   T_ij = sum_d ((1 / P(seq[d])) sum_t (f(i, t) T_ij E_i(seq[d][t])
+          //           b(i, t + 1)))
+          //   E_ij = sum_d ((1 / P(seq[d])) sum_{t | seq[d][t] = j} f(i, t)
+          //           b(i, t)
+          // We store the new estimates in a different matrix.  The sum over
+          // time for the estimate of T_ij (probability of transition from state
+          // j to state i) is computed as a single matrix product.  We postpone
+          // multiplication of the old T_ij until later.
+          if (seqLength > 1)
           {
-            // Estimate of T_ij (probability of transition from state j to state
-            // i).  We postpone multiplication of the old T_ij until later.
-            for (size_t i = 0; i < transition.n_rows; i++)
-              newTransition(i, j) += forward(j, t) * backward(i, t + 1) *
-                  emission[i].Probability(dataSeq[seq].unsafe_col(t + 1)) /
-                  scales[t + 1];
+            arma::mat weightedBackward = backward.cols(1, seqLength - 1) %
+                seqEmissionProb.cols(1, seqLength - 1);
+            weightedBackward.each_row() /= scales.subvec(1, seqLength - 1).t();
+            threadTransition += weightedBackward *
+                trans(forward.cols(0, seqLength - 2));
           }
 
-          // Add to list of emission observations, for Distribution::Train().
-          emissionList.col(sumTime) = dataSeq[seq].col(t);
-          emissionProb[j][sumTime] = stateProb(j, t);
+          // Add to list of emission weights, for Distribution::Train().
+          for (size_t j = 0; j < transition.n_cols; ++j)
+          {
+            emissionProb[j].subvec(seqOffsets[seq],
+                seqOffsets[seq] + seqLength - 1) = trans(stateProb.row(j));
+          }
+        }
+        catch (...)
+        {
+          exceptions[seq] = std::current_exception();
         }
-        sumTime++;
+      }
+
+      #pragma omp critical(HMMTrainReduce)
+      {
+        newInitial += threadInitial;
+        newTransition += threadTransition;
+        loglik += threadLoglik;
       }
     }
 
+    for (size_t seq = 0; seq < dataSeq.size(); ++seq)
+    {
+      if (exceptions[seq])
+        std::rethrow_exception(exceptions[seq]);
+    }
+
     // Normalize the new initial probabilities.
     if (dataSeq.size() > 1)
       initial = newInitial / dataSeq.size();
@@ -314,9 +373,12 @@ double HMM<Distribution>::Estimate(const arma::mat& dataSeq,
                                    arma::mat& backwardProb,
                                    arma::vec& scales) const
 {
-  // First run the forward-backward algorithm.
-  Forward(dataSeq, scales, forwardProb);
-  Backward(dataSeq, scales, backwardProb);
+  // First run the forward-backward algorithm.  The emission probabilities are
+  // shared by both passes, so we only compute them once.
+  arma::mat emissionProb;
+  EmissionProbability(dataSeq, emissionProb);
+  ForwardFromEmission(emissionProb, scales, forwardProb);
+  BackwardFromEmission(emissionProb, scales, backwardProb);
 
   // Now assemble the state probability matrix based on the forward and backward
   // probabilities.
@@ -399,53 +461,61 @@ template<typename Distribution>
 double HMM<Distribution>::Predict(const arma::mat& dataSeq,
                                   arma::Row<size_t>& stateSeq) const
 {
-  // This is an implementation of the Viterbi algorithm for finding the most
-  // probable sequence of states to produce the observed data sequence.  We
-  // don't use log-likelihoods to save that little bit of time, but we'll
-  // calculate the log-likelihood at the end of it all.
-  stateSeq.set_size(dataSeq.n_cols);
-  arma::mat logStateProb(transition.n_rows, dataSeq.n_cols);
-  arma::mat stateSeqBack(transition.n_rows, dataSeq.n_cols);
+  arma::mat emissionProb;
+  EmissionProbability(dataSeq, emissionProb);
 
-  // Store the logs of the transposed transition matrix.  This is because we
-  // will be using the rows of the transition matrix.
-  arma::mat logTrans(log(trans(transition)));
+  return Viterbi(emissionProb, stateSeq);
+}
 
-  // The calculation of the first state is slightly different; the probability
-  // of the first state being state j is the maximum probability that the state
-  // came to be j from another state.
-  logStateProb.col(0).zeros();
-  for (size_t state = 0; state < transition.n_rows; state++)
-  {
-    logStateProb(state, 0) = log(initial[state] *
-        emission[state].Probability(dataSeq.unsafe_col(0)));
-    stateSeqBack(state, 0) = state;
-  }
+/**
+ * Compute the most probable hidden state sequence for each of the given
+ * observation sequences, in parallel.
+ */
+template<typename Distribution>
+void HMM<Distribution>::Predict(const std::vector<arma::mat>& dataSeq,
+                                std::vector<arma::Row<size_t> >& stateSeq,
+                                arma::vec& logLikelihoods) const
+{
+  stateSeq.resize(dataSeq.size());
+  logLikelihoods.set_size(dataSeq.size());
 
-  // Store the best first state.
-  arma::uword index;
-  for (size_t t = 1; t < dataSeq.n_cols; t++)
+  // Each sequence is independent, but sequence lengths may vary a lot, so use
+  // dynamic scheduling.  An exception can't leave the parallel region, so the
+  // exception of each sequence is stored and the first one is rethrown
+  // afterwards.
+  std::vector<std::exception_ptr> exceptions(dataSeq.size());
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) dataSeq.size(); ++i)
   {
-    // Assemble the state probability for this element.
-    // Given that we are in state j, we use state with the highest probability
-    // of being the previous state.
-    for (size_t j = 0; j < transition.n_rows; j++)
+    try
+    {
+      logLikelihoods[i] = Predict(dataSeq[i], stateSeq[i]);
+    }
+    catch (...)
     {
-      arma::vec prob = logStateProb.col(t - 1) + logTrans.col(j);
-      logStateProb(j, t) = prob.max(index) +
-          log(emission[j].Probability(dataSeq.unsafe_col(t)));
-        stateSeqBack(j, t) = index;
+      exceptions[i] = std::current_exception();
     }
   }
 
-  // Backtrack to find the most probable state sequence.
-  logStateProb.unsafe_col(dataSeq.n_cols - 1).max(index);
-  stateSeq[dataSeq.n_cols - 1] = index;
-  for (size_t t = 2; t <= dataSeq.n_cols; t++)
-    stateSeq[dataSeq.n_cols - t] =
-        stateSeqBack(stateSeq[dataSeq.n_cols - t + 1], dataSeq.n_cols - t + 1);
+  for (size_t i = 0; i < dataSeq.size(); ++i)
+  {
+    if (exceptions[i])
+      std::rethrow_exception(exceptions[i]);
+  }
+}
 
-  return logStateProb(stateSeq(dataSeq.n_cols - 1), dataSeq.n_cols - 1);
+/**
+ * Compute the most probable hidden state sequence for each of the given
+ * observation sequences, in parallel.
+ */
+template<typename Distribution>
+void HMM<Distribution>::Predict(const std::vector<arma::mat>& dataSeq,
+                                std::vector<arma::Row<size_t> >& stateSeq)
+    const
+{
+  arma::vec logLikelihoods;
+  Predict(dataSeq, stateSeq, logLikelihoods);
 }
 
 /**
@@ -512,20 +582,60 @@ template<typename Distribution>
 void HMM<Distribution>::Forward(const arma::mat& dataSeq,
                                 arma::vec& scales,
                                 arma::mat& forwardProb) const
+{
+  arma::mat emissionProb;
+  EmissionProbability(dataSeq, emissionProb);
+  ForwardFromEmission(emissionProb, scales, forwardProb);
+}
+
+/**
+ * The Backward procedure (part of the Forward-Backward algorithm).
+ */
+template<typename Distribution>
+void HMM<Distribution>::Backward(const arma::mat& dataSeq,
+                                 const arma::vec& scales,
+                                 arma::mat& backwardProb) const
+{
+  arma::mat emissionProb;
+  EmissionProbability(dataSeq, emissionProb);
+  BackwardFromEmission(emissionProb, scales, backwardProb);
+}
+
+/**
+ * Compute the emission probabilities of each observation for each state.
+ */
+template<typename Distribution>
+void HMM<Distribution>::EmissionProbability(const arma::mat& dataSeq,
+                                            arma::mat& emissionProb) const
+{
+  emissionProb.set_size(transition.n_rows, dataSeq.n_cols);
+
+  // Evaluate each distribution on the entire sequence at once; this is much
+  // cheaper than calling Probability() for each observation separately.
+  arma::vec probabilities;
+  for (size_t state = 0; state < transition.n_rows; state++)
+  {
+    emission[state].Probability(dataSeq, probabilities);
+    emissionProb.row(state) = trans(probabilities);
+  }
+}
+
+template<typename Distribution>
+void HMM<Distribution>::ForwardFromEmission(const arma::mat& emissionProb,
+                                            arma::vec& scales,
+                                            arma::mat& forwardProb) const
 {
   // Our goal is to calculate the forward probabilities:
   //  P(X_k | o_{1:k}) for all possible states X_k, for each time point k.
-  forwardProb.zeros(transition.n_rows, dataSeq.n_cols);
-  scales.zeros(dataSeq.n_cols);
+  forwardProb.zeros(transition.n_rows, emissionProb.n_cols);
+  scales.zeros(emissionProb.n_cols);
 
   // The first entry in the forward algorithm uses the initial state
   // probabilities.  Note that MATLAB assumes that the starting state (at
   // t = -1) is state 0; this is not our assumption here.  To force that
   // behavior, you could append a single starting state to every single data
   // sequence and that should produce results in line with MATLAB.
-  for (size_t state = 0; state < transition.n_rows; state++)
-    forwardProb(state, 0) = initial(state) *
-        emission[state].Probability(dataSeq.unsafe_col(0));
+  forwardProb.col(0) = initial % emissionProb.col(0);
 
   // Then normalize the column.
   scales[0] = accu(forwardProb.col(0));
@@ -533,17 +643,13 @@ void HMM<Distribution>::Forward(const arma::mat& dataSeq,
     forwardProb.col(0) /= scales[0];
 
   // Now compute the probabilities for each successive observation.
-  for (size_t t = 1; t < dataSeq.n_cols; t++)
+  for (size_t t = 1; t < emissionProb.n_cols; t++)
   {
-    for (size_t j = 0; j < transition.n_rows; j++)
-    {
-      // The forward probability of state j at time t is the sum over all states
-      // of the probability of the previous state transitioning to the current
-      // state and emitting the given observation.
-      forwardProb(j, t) = accu(forwardProb.col(t - 1) %
-          trans(transition.row(j))) *
-          emission[j].Probability(dataSeq.unsafe_col(t));
-    }
+    // The forward probability of state j at time t is the sum over all states
+    // of the probability of the previous state transitioning to the current
+    // state and emitting the given observation.
+    forwardProb.col(t) = (transition * forwardProb.col(t - 1)) %
+        emissionProb.col(t);
 
     // Normalize probability.
     scales[t] = accu(forwardProb.col(t));
@@ -553,35 +659,85 @@ void HMM<Distribution>::Forward(const arma::mat& dataSeq,
 }
 
 template<typename Distribution>
-void HMM<Distribution>::Backward(const arma::mat& dataSeq,
-                                 const arma::vec& scales,
-                                 arma::mat& backwardProb) const
+void HMM<Distribution>::BackwardFromEmission(const arma::mat& emissionProb,
+                                             const arma::vec& scales,
+                                             arma::mat& backwardProb) const
 {
   // Our goal is to calculate the backward probabilities:
   //  P(X_k | o_{k + 1:T}) for all possible states X_k, for each time point k.
-  backwardProb.zeros(transition.n_rows, dataSeq.n_cols);
+  backwardProb.zeros(transition.n_rows, emissionProb.n_cols);
 
   // The last element probability is 1.
-  backwardProb.col(dataSeq.n_cols - 1).fill(1);
+  backwardProb.col(emissionProb.n_cols - 1).fill(1);
 
   // Now step backwards through all other observations.
-  for (size_t t = dataSeq.n_cols - 2; t + 1 > 0; t--)
+  for (size_t t = emissionProb.n_cols - 2; t + 1 > 0; t--)
+  {
+    // The backward probability of state j at time t is the sum over all state
+    // of the probability of the next state having been a transition from the
+    // current state multiplied by the probability of each of those states
+    // emitting the given observation.
+    backwardProb.col(t) = trans(transition) * (backwardProb.col(t + 1) %
+        emissionProb.col(t + 1));
+
+    // Normalize by the weights from the forward algorithm.
+    if (scales[t + 1] > 0.0)
+      backwardProb.col(t) /= scales[t + 1];
+  }
+}
+
+/**
+ * The Viterbi algorithm, given precomputed emission probabilities.
+ */
+template<typename Distribution>
+double HMM<Distribution>::Viterbi(const arma::mat& emissionProb,
+                                  arma::Row<size_t>& stateSeq) const
+{
+  // This is an implementation of the Viterbi algorithm for finding the most
+  // probable sequence of states to produce the observed data sequence.  All
+  // work is done in log-space, so the emission probabilities are converted
+  // once up front.
+  const size_t length = emissionProb.n_cols;
+  stateSeq.set_size(length);
+  arma::mat logStateProb(transition.n_rows, length);
+  arma::Mat<size_t> stateSeqBack(transition.n_rows, length);
+  const arma::mat logEmissionProb = log(emissionProb);
+
+  // Store the logs of the transposed transition matrix.  This is because we
+  // will be using the rows of the transition matrix.
+  const arma::mat logTrans(log(trans(transition)));
+
+  // The calculation of the first state is slightly different; the probability
+  // of the first state being state j is the maximum probability that the state
+  // came to be j from another state.
+  logStateProb.col(0) = log(initial) + logEmissionProb.col(0);
+  for (size_t state = 0; state < transition.n_rows; state++)
+    stateSeqBack(state, 0) = state;
+
+  // Store the best first state.
+  arma::uword index;
+  arma::vec prob(transition.n_rows);
+  for (size_t t = 1; t < length; t++)
   {
+    // Assemble the state probability for this element.
+    // Given that we are in state j, we use state with the highest probability
+    // of being the previous state.
     for (size_t j = 0; j < transition.n_rows; j++)
     {
-      // The backward probability of state j at time t is the sum over all state
-      // of the probability of the next state having been a transition from the
-      // current state multiplied by the probability of each of those states
-      // emitting the given observation.
-      for (size_t state = 0; state < transition.n_rows; state++)
-        backwardProb(j, t) += transition(state, j) * backwardProb(state, t + 1)
-            * emission[state].Probability(dataSeq.unsafe_col(t + 1));
-
-      // Normalize by the weights from the forward algorithm.
-      if (scales[t + 1] > 0.0)
-        backwardProb(j, t) /= scales[t + 1];
+      prob = logStateProb.col(t - 1) + logTrans.col(j);
+      logStateProb(j, t) = prob.max(index) + logEmissionProb(j, t);
+      stateSeqBack(j, t) = index;
     }
   }
+
+  // Backtrack to find the most probable state sequence.
+  logStateProb.unsafe_col(length - 1).max(index);
+  stateSeq[length - 1] = index;
+  for (size_t t = 2; t <= length; t++)
+    stateSeq[length - t] = stateSeqBack(stateSeq[length - t + 1],
+        length - t + 1);
+
+  return logStateProb(stateSeq(length - 1), length - 1);
 }
 
 //! Serialize the HMM.
@@ -85,10 +85,10 @@ void HoeffdingNumericSplit<FitnessFunction, ObservationType>::Train(
     // Now, add all of the points we've seen to the sufficient statistics.
     for (size_t i = 0; i < observationsBeforeBinning - 1; ++i)
     {
-      // What bin does the point fall into?
-      size_t bin = 0;
-      while (bin < bins - 1 && observations[i] > splitPoints[bin])
-        ++bin;
+      // What bin does the point fall into?  The split points are sorted, so
+      // this is the number of split points less than the observation.
+      const size_t bin = std::lower_bound(splitPoints.begin(),
+          splitPoints.end(), observations[i]) - splitPoints.begin();
 
       sufficientStatistics(labels[i], bin)++;
     }
@@ -96,9 +96,8 @@ void HoeffdingNumericSplit<FitnessFunction, ObservationType>::Train(
 
   // If we've gotten to here, then we need to add the point to the sufficient
   // statistics.  What bin does the point fall into?
-  size_t bin = 0;
-  while (bin < bins - 1 && value > splitPoints[bin])
-    ++bin;
+  const size_t bin = std::lower_bound(splitPoints.begin(), splitPoints.end(),
+      value) - splitPoints.begin();
 
   sufficientStatistics(label, bin)++;
 }
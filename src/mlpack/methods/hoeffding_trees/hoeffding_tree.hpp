@@ -150,7 +150,10 @@ class HoeffdingTree
 
   /**
    * Train on a set of points, either in streaming mode or in batch mode, with
-   * the given labels.
+   * the given labels.  In either mode, the points are routed to the leaves of
+   * the tree together, and the leaves are then trained in parallel; the
+   * resulting tree is the same as if Train() had been called on each point in
+   * turn.
    *
    * @param data Data points to train on.
    * @param label Labels of data points.
@@ -292,6 +295,35 @@ class HoeffdingTree
   void Serialize(Archive& ar, const unsigned int /* version */);
 
  private:
+  /**
+   * Pass each of the given points down from this node to the leaf it falls
+   * into, then train every leaf that received points (in parallel).  The
+   * points each leaf receives are kept in their original order.
+   *
+   * @param data Dataset containing the points.
+   * @param labels Labels of the dataset.
+   * @param points Indices of the points to train on, in training order.
+   */
+  template<typename MatType>
+  void TrainLeaves(const MatType& data,
+                   const arma::Row<size_t>& labels,
+                   const std::vector<size_t>& points);
+
+  /**
+   * Train this leaf on the given points in streaming mode.  All of the points
+   * between two split checks are given to the split objects at once, one
+   * dimension at a time; if the node splits, the rest of the points are passed
+   * on to the new children.
+   *
+   * @param data Dataset containing the points.
+   * @param labels Labels of the dataset.
+   * @param points Indices of the points to train on, in training order.
+   */
+  template<typename MatType>
+  void TrainLeaf(const MatType& data,
+                 const arma::Row<size_t>& labels,
+                 const std::vector<size_t>& points);
+
   // We need to keep some information for before we have split.
 
   //! Information for splitting of numeric features (used before split).
@@ -213,8 +213,10 @@ void HoeffdingTree<
     // Don't split if there are fewer than five points.
     size_t oldMaxSamples = maxSamples;
     maxSamples = std::max(size_t(data.n_cols - 1), size_t(5));
+    std::vector<size_t> points(data.n_cols);
     for (size_t i = 0; i < data.n_cols; ++i)
-      Train(data.col(i), labels[i]);
+      points[i] = i;
+    TrainLeaves(data, labels, points);
     maxSamples = oldMaxSamples;
 
     // Now, if we did split, find out which points go to which child, and
@@ -265,9 +267,131 @@ void HoeffdingTree<
   }
   else
   {
-    // We aren't training in batch mode; loop through the points.
+    // We aren't training in batch mode, so each point is only seen once.
+    std::vector<size_t> points(data.n_cols);
     for (size_t i = 0; i < data.n_cols; ++i)
-      Train(data.col(i), labels[i]);
+      points[i] = i;
+    TrainLeaves(data, labels, points);
+  }
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename MatType>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::TrainLeaves(const MatType& data,
+               const arma::Row<size_t>& labels,
+               const std::vector<size_t>& points)
+{
+  // Find the leaf that each point falls into.
+  std::vector<HoeffdingTree*> leaves;
+  std::vector<std::vector<size_t>> leafPoints;
+  std::unordered_map<HoeffdingTree*, size_t> leafIndices;
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    HoeffdingTree* node = this;
+    while (node->splitDimension != size_t(-1))
+      node = node->children[node->CalculateDirection(data.col(points[i]))];
+
+    typename std::unordered_map<HoeffdingTree*, size_t>::const_iterator it =
+        leafIndices.find(node);
+    if (it == leafIndices.end())
+    {
+      leafIndices[node] = leaves.size();
+      leaves.push_back(node);
+      leafPoints.push_back(std::vector<size_t>(1, points[i]));
+    }
+    else
+    {
+      leafPoints[it->second].push_back(points[i]);
+    }
+  }
+
+  // Each leaf only touches its own statistics, so the leaves can be trained
+  // independently.  If there is only one leaf, the parallelism is instead used
+  // inside of TrainLeaf().
+  #pragma omp parallel for schedule(dynamic) if (leaves.size() > 1)
+  for (omp_size_t i = 0; i < (omp_size_t) leaves.size(); ++i)
+    leaves[i]->TrainLeaf(data, labels, leafPoints[i]);
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename MatType>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::TrainLeaf(const MatType& data,
+             const arma::Row<size_t>& labels,
+             const std::vector<size_t>& points)
+{
+  size_t begin = 0;
+  while (begin < points.size())
+  {
+    // Take all of the points up to the next split check.
+    const size_t end = std::min(points.size(),
+        begin + checkInterval - (numSamples % checkInterval));
+
+    // The split objects for different dimensions are independent, so we can
+    // train each dimension separately on every point in the batch.
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t d = 0; d < (omp_size_t) data.n_rows; ++d)
+    {
+      const size_t index = dimensionMappings->at(d).second;
+      if (datasetInfo->Type(d) == data::Datatype::categorical)
+      {
+        for (size_t i = begin; i < end; ++i)
+        {
+          categoricalSplits[index].Train(data(d, points[i]),
+              labels[points[i]]);
+        }
+      }
+      else if (datasetInfo->Type(d) == data::Datatype::numeric)
+      {
+        for (size_t i = begin; i < end; ++i)
+          numericSplits[index].Train(data(d, points[i]), labels[points[i]]);
+      }
+    }
+    numSamples += (end - begin);
+
+    // Grab majority class from splits.
+    if (categoricalSplits.size() > 0)
+    {
+      majorityClass = categoricalSplits[0].MajorityClass();
+      majorityProbability = categoricalSplits[0].MajorityProbability();
+    }
+    else
+    {
+      majorityClass = numericSplits[0].MajorityClass();
+      majorityProbability = numericSplits[0].MajorityProbability();
+    }
+
+    // Check for a split, if we should.
+    if (numSamples % checkInterval == 0)
+    {
+      const size_t numChildren = SplitCheck();
+      if (numChildren > 0)
+      {
+        children.clear();
+        CreateChildren();
+
+        // The rest of the points go to the new children.
+        if (end < points.size())
+        {
+          TrainLeaves(data, labels,
+              std::vector<size_t>(points.begin() + end, points.end()));
+        }
+        return;
+      }
+    }
+
+    begin = end;
   }
 }
 
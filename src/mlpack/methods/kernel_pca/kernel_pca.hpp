@@ -32,6 +32,12 @@ namespace kpca {
  * There are numerous available kernels in the mlpack::kernel namespace (see
  * files in mlpack/core/kernels/) and it is easy to write your own; see other
  * implementations for examples.
+ *
+ * The kernel rule determines how the kernel principal components are found:
+ * NaiveKernelRule uses the exact kernel matrix, NystroemKernelRule uses the
+ * Nystroem approximation of it, and RandomFourierFeaturesRule uses random
+ * Fourier features, which scales to large datasets and can transform new points
+ * with Transform().
  */
 template <
   typename KernelType,
@@ -48,9 +54,11 @@ class KernelPCA
    *
    * @param kernel Kernel to be used for computation.
    * @param centerTransformedData Center transformed data.
+   * @param rule Instantiated kernel rule (for rules with parameters).
    */
   KernelPCA(const KernelType kernel = KernelType(),
-            const bool centerTransformedData = false);
+            const bool centerTransformedData = false,
+            const KernelRule rule = KernelRule());
 
   /**
    * Apply Kernel Principal Components Analysis to the provided data set.
@@ -106,6 +114,16 @@ class KernelPCA
    */
   void Apply(arma::mat& data, const size_t newDimension);
 
+  /**
+   * Transform new points onto the kernel principal components found by the
+   * last call to Apply().  This is only available for kernel rules that keep
+   * what they need to transform points, like RandomFourierFeaturesRule.
+   *
+   * @param points Points to transform.
+   * @param transformedPoints Matrix to store the transformed points in.
+   */
+  void Transform(const arma::mat& points, arma::mat& transformedPoints) const;
+
   //! Get the kernel.
   const KernelType& Kernel() const { return kernel; }
   //! Modify the kernel.
@@ -116,12 +134,19 @@ class KernelPCA
   //! Return whether or not the transformed data is centered.
   bool& CenterTransformedData() { return centerTransformedData; }
 
+  //! Get the kernel rule.
+  const KernelRule& Rule() const { return rule; }
+  //! Modify the kernel rule.
+  KernelRule& Rule() { return rule; }
+
  private:
   //! The instantiated kernel.
   KernelType kernel;
   //! If true, the data will be scaled (by standard deviation) when Apply() is
   //! run.
   bool centerTransformedData;
+  //! The instantiated kernel rule.
+  KernelRule rule;
 }; // class KernelPCA
 
 } // namespace kpca
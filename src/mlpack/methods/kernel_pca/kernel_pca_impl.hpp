@@ -22,9 +22,11 @@ namespace kpca {
 
 template <typename KernelType, typename KernelRule>
 KernelPCA<KernelType, KernelRule>::KernelPCA(const KernelType kernel,
-                                 const bool centerTransformedData) :
+                                 const bool centerTransformedData,
+                                 const KernelRule rule) :
       kernel(kernel),
-      centerTransformedData(centerTransformedData)
+      centerTransformedData(centerTransformedData),
+      rule(rule)
 { }
 
 //! Apply Kernel Principal Component Analysis to the provided data set.
@@ -35,8 +37,8 @@ void KernelPCA<KernelType, KernelRule>::Apply(const arma::mat& data,
                                   arma::mat& eigvec,
                                   const size_t newDimension)
 {
-  KernelRule::ApplyKernelMatrix(data, transformedData, eigval,
-                                eigvec, newDimension, kernel);
+  rule.ApplyKernelMatrix(data, transformedData, eigval, eigvec, newDimension,
+      kernel);
 
   // Center the transformed data, if the user asked for it.
   if (centerTransformedData)
@@ -77,10 +79,19 @@ void KernelPCA<KernelType, KernelRule>::Apply(arma::mat& data,
 
   Apply(data, data, eigVal, coeffs, newDimension);
 
-  if (newDimension < coeffs.n_rows && newDimension > 0)
+  if (newDimension < data.n_rows && newDimension > 0)
     data.shed_rows(newDimension, data.n_rows - 1);
 }
 
+//! Transform new points onto the kernel principal components.
+template <typename KernelType, typename KernelRule>
+void KernelPCA<KernelType, KernelRule>::Transform(
+    const arma::mat& points,
+    arma::mat& transformedPoints) const
+{
+  rule.Transform(points, transformedPoints);
+}
+
 } // namespace kpca
 } // namespace mlpack
 
@@ -30,6 +30,7 @@
 #include <mlpack/methods/nystroem_method/kmeans_selection.hpp>
 #include <mlpack/methods/nystroem_method/nystroem_method.hpp>
 #include <mlpack/methods/kernel_pca/kernel_rules/nystroem_method.hpp>
+#include <mlpack/methods/kernel_pca/kernel_rules/random_features_method.hpp>
 
 #include "kernel_pca.hpp"
 
@@ -92,7 +93,29 @@ PROGRAM_INFO("Kernel Principal Components Analysis",
     "the kernel matrix; to specify the sampling scheme, the " +
     PRINT_PARAM_STRING("sampling") + " parameter is used.  The "
     "sampling scheme for the Nystr\u00F6m method can be chosen from the "
-    "following list: 'kmeans', 'random', 'ordered'.");
+    "following list: 'kmeans', 'random', 'ordered'."
+    "\n\n"
+    "For large datasets with the 'gaussian' or 'laplacian' kernel, random "
+    "Fourier features (\"Random Features for Large-Scale Kernel Machines\", "
+    "2007) can be used instead by specifying the " +
+    PRINT_PARAM_STRING("random_features") + " parameter.  The kernel is then "
+    "approximated with " + PRINT_PARAM_STRING("num_features") + " features, "
+    "and neither the kernel matrix nor the features of all points are held in "
+    "memory.  If " + PRINT_PARAM_STRING("randomized_svd") + " is also "
+    "specified, the components are found with the randomized SVD of the "
+    "features; this is faster when " +
+    PRINT_PARAM_STRING("new_dimensionality") + " is much smaller than " +
+    PRINT_PARAM_STRING("num_features") + ", but the features of all points are "
+    "held in memory."
+    "\n\n"
+    "For example, the following command will reduce the dataset " +
+    PRINT_DATASET("input") + " to 10 dimensions with the Gaussian kernel "
+    "approximated by 1000 random features, saving the result to " +
+    PRINT_DATASET("transformed") + ":"
+    "\n\n" +
+    PRINT_CALL("kernel_pca", "input", "input", "kernel", "gaussian",
+        "random_features", true, "num_features", 1000, "new_dimensionality",
+        10, "output", "transformed"));
 
 PARAM_MATRIX_IN_REQ("input", "Input dataset to perform KPCA on.", "i");
 PARAM_MATRIX_OUT("output", "Matrix to save modified dataset to.", "o");
@@ -111,6 +134,12 @@ PARAM_FLAG("nystroem_method", "If set, the nystroem method will be used.", "n");
 PARAM_STRING_IN("sampling", "Sampling scheme to use for the nystroem method: "
     "'kmeans', 'random', 'ordered'", "s", "kmeans");
 
+PARAM_FLAG("random_features", "If set, random Fourier features will be used "
+    "(only for the 'gaussian' and 'laplacian' kernels).", "R");
+PARAM_INT_IN("num_features", "Number of random Fourier features.", "m", 256);
+PARAM_FLAG("randomized_svd", "If set, the components will be found with the "
+    "randomized SVD of the random Fourier features.", "r");
+
 PARAM_DOUBLE_IN("kernel_scale", "Scale, for 'hyptan' kernel.", "S", 1.0);
 PARAM_DOUBLE_IN("offset", "Offset, for 'hyptan' and 'polynomial' kernels.", "O",
     0.0);
@@ -163,6 +192,22 @@ void RunKPCA(arma::mat& dataset,
   }
 }
 
+//! Run KernelPCA with random Fourier features on the specified dataset, for
+//! the given shift-invariant kernel type.
+template<typename KernelType>
+void RunRandomFeaturesKPCA(arma::mat& dataset,
+                           const bool centerTransformedData,
+                           const size_t newDim,
+                           const size_t numFeatures,
+                           const bool randomizedSVD,
+                           KernelType& kernel)
+{
+  KernelPCA<KernelType, RandomFourierFeaturesRule<KernelType>> kpca(kernel,
+      centerTransformedData, RandomFourierFeaturesRule<KernelType>(numFeatures,
+      randomizedSVD));
+  kpca.Apply(dataset, newDim);
+}
+
 void mlpackMain()
 {
   if (!CLI::HasParam("output"))
@@ -192,6 +237,35 @@ void mlpackMain()
   const bool centerTransformedData = CLI::HasParam("center");
   const bool nystroem = CLI::HasParam("nystroem_method");
   const string sampling = CLI::GetParam<string>("sampling");
+  const bool randomFeatures = CLI::HasParam("random_features");
+  const bool randomizedSVD = CLI::HasParam("randomized_svd");
+
+  if (randomFeatures)
+  {
+    if (nystroem)
+    {
+      Log::Fatal << "Cannot specify both --nystroem_method and "
+          << "--random_features!" << endl;
+    }
+
+    if (kernelType != "gaussian" && kernelType != "laplacian")
+    {
+      Log::Fatal << "Random features can only be used with the 'gaussian' and "
+          << "'laplacian' kernels!" << endl;
+    }
+
+    if (CLI::GetParam<int>("num_features") <= 0)
+    {
+      Log::Fatal << "Number of features (" << CLI::GetParam<int>("num_features")
+          << ") must be positive!" << endl;
+    }
+  }
+  else if (randomizedSVD)
+  {
+    Log::Warn << "--randomized_svd ignored because --random_features is not "
+        << "specified." << endl;
+  }
+  const size_t numFeatures = (size_t) CLI::GetParam<int>("num_features");
 
   if (kernelType == "linear")
   {
@@ -204,8 +278,16 @@ void mlpackMain()
     const double bandwidth = CLI::GetParam<double>("bandwidth");
 
     GaussianKernel kernel(bandwidth);
-    RunKPCA<GaussianKernel>(dataset, centerTransformedData, nystroem, newDim,
-        sampling, kernel);
+    if (randomFeatures)
+    {
+      RunRandomFeaturesKPCA<GaussianKernel>(dataset, centerTransformedData,
+          newDim, numFeatures, randomizedSVD, kernel);
+    }
+    else
+    {
+      RunKPCA<GaussianKernel>(dataset, centerTransformedData, nystroem, newDim,
+          sampling, kernel);
+    }
   }
   else if (kernelType == "polynomial")
   {
@@ -230,8 +312,16 @@ void mlpackMain()
     const double bandwidth = CLI::GetParam<double>("bandwidth");
 
     LaplacianKernel kernel(bandwidth);
-    RunKPCA<LaplacianKernel>(dataset, centerTransformedData, nystroem, newDim,
-        sampling, kernel);
+    if (randomFeatures)
+    {
+      RunRandomFeaturesKPCA<LaplacianKernel>(dataset, centerTransformedData,
+          newDim, numFeatures, randomizedSVD, kernel);
+    }
+    else
+    {
+      RunKPCA<LaplacianKernel>(dataset, centerTransformedData, nystroem, newDim,
+          sampling, kernel);
+    }
   }
   else if (kernelType == "epanechnikov")
   {
@@ -0,0 +1,301 @@
+/**
+ * @file random_features_method.hpp
+ *
+ * Use random Fourier features to approximate the kernel matrix of a
+ * shift-invariant kernel.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef MLPACK_METHODS_KERNEL_PCA_RANDOM_FEATURES_METHOD_HPP
+#define MLPACK_METHODS_KERNEL_PCA_RANDOM_FEATURES_METHOD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/gaussian_kernel.hpp>
+#include <mlpack/core/kernels/laplacian_kernel.hpp>
+#include <mlpack/methods/randomized_svd/randomized_svd.hpp>
+
+namespace mlpack {
+namespace kpca {
+
+/**
+ * Approximate kernel PCA with random Fourier features, for shift-invariant
+ * kernels.  The kernel is approximated by K(x, y) ~ z(x)^T z(y), with the
+ * m-dimensional feature map
+ *
+ *   z(x) = sqrt(2 / m) cos(W^T x + b),
+ *
+ * where the columns of W are sampled from the Fourier transform of the kernel
+ * and the elements of b are uniform on [0, 2 pi].  Kernel PCA then reduces to
+ * PCA of the features.  By default, the covariance of the features (m x m) is
+ * accumulated over blocks of points in parallel and eigendecomposed, so neither
+ * the kernel matrix nor the features of all the points are held in memory:
+ * this takes O(n m (d + m) + m^3) time and O(m (d + m)) memory.  Alternatively,
+ * the components can be found with the randomized SVD of the features, which
+ * takes O(n m (d + k)) time for k components but holds the features of all the
+ * points in memory.
+ *
+ * The feature map and the components are kept, so new points can be
+ * transformed with Transform() in O(m (d + k)) time each, without the training
+ * points.  The GaussianKernel and the LaplacianKernel are supported.
+ *
+ * For more information, see the following paper.
+ *
+ * @code
+ * @inproceedings{rahimi2007random,
+ *   title={Random Features for Large-Scale Kernel Machines},
+ *   author={Rahimi, Ali and Recht, Benjamin},
+ *   booktitle={Advances in Neural Information Processing Systems},
+ *   pages={1177--1184},
+ *   year={2007}
+ * }
+ * @endcode
+ */
+template<typename KernelType>
+class RandomFourierFeaturesRule
+{
+ public:
+  /**
+   * Create the rule.
+   *
+   * @param numFeatures Number of random features (m).
+   * @param randomizedSVD If true, find the components with the randomized SVD
+   *     of the features instead of the eigendecomposition of their covariance.
+   * @param blockSize Number of points to compute the features of at once.
+   */
+  RandomFourierFeaturesRule(const size_t numFeatures = 256,
+                            const bool randomizedSVD = false,
+                            const size_t blockSize = 4096) :
+      numFeatures(numFeatures),
+      randomizedSVD(randomizedSVD),
+      blockSize(blockSize)
+  {
+    /* Nothing to do here */
+  }
+
+  /**
+   * Sample the feature map and find the kernel principal components of the
+   * given data.  The eigenvalues are those of the centered approximate kernel
+   * matrix, like for the NaiveKernelRule; the eigenvectors are the components
+   * in the feature space (m x rank).
+   *
+   * @param data Input data points.
+   * @param transformedData Matrix to output results into.
+   * @param eigval KPCA eigenvalues will be written to this vector.
+   * @param eigvec KPCA eigenvectors will be written to this matrix.
+   * @param rank Number of components to find (at most the number of features).
+   * @param kernel Kernel to be used for computation.
+   */
+  void ApplyKernelMatrix(const arma::mat& data,
+                         arma::mat& transformedData,
+                         arma::vec& eigval,
+                         arma::mat& eigvec,
+                         const size_t rank,
+                         KernelType kernel = KernelType())
+  {
+    if (numFeatures == 0)
+    {
+      throw std::invalid_argument("RandomFourierFeaturesRule: the number of "
+          "features must be positive");
+    }
+    if (blockSize == 0)
+    {
+      throw std::invalid_argument("RandomFourierFeaturesRule: the block size "
+          "must be positive");
+    }
+
+    // Sample the feature map.
+    SampleFrequencies(kernel, data.n_rows);
+    offsets = 2.0 * M_PI * arma::randu<arma::vec>(numFeatures);
+
+    size_t k = (rank == 0) ? numFeatures : std::min(rank, numFeatures);
+
+    if (randomizedSVD)
+    {
+      arma::mat features;
+      Features(data, features);
+      featureMean = arma::sum(features, 1) / features.n_cols;
+
+      // The randomized SVD centers the features itself.  It returns a few more
+      // singular vectors than asked for.
+      arma::mat v;
+      svd::RandomizedSVD rsvd;
+      rsvd.Apply(features, components, eigval, v, k);
+
+      k = std::min(k, (size_t) components.n_cols);
+      components = components.head_cols(k);
+      eigval = arma::square(eigval.head(k));
+
+      features.each_col() -= featureMean;
+      transformedData = components.t() * features;
+    }
+    else
+    {
+      // Accumulate the sum of the features and of their outer products, in
+      // blocks of points.
+      arma::vec featureSum(numFeatures, arma::fill::zeros);
+      arma::mat covariance(numFeatures, numFeatures, arma::fill::zeros);
+      const size_t numBlocks = (data.n_cols + blockSize - 1) / blockSize;
+
+      #pragma omp parallel
+      {
+        arma::vec localSum(numFeatures, arma::fill::zeros);
+        arma::mat localCovariance(numFeatures, numFeatures, arma::fill::zeros);
+
+        #pragma omp for schedule(dynamic)
+        for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+        {
+          const size_t begin = b * blockSize;
+          const size_t end = std::min(begin + blockSize,
+              (size_t) data.n_cols) - 1;
+
+          arma::mat features;
+          Features(data.cols(begin, end), features);
+          localSum += arma::sum(features, 1);
+          localCovariance += features * features.t();
+        }
+
+        #pragma omp critical
+        {
+          featureSum += localSum;
+          covariance += localCovariance;
+        }
+      }
+
+      // Center the covariance: sum (z - mu) (z - mu)^T = sum z z^T - n mu mu^T.
+      featureMean = featureSum / data.n_cols;
+      covariance -= data.n_cols * (featureMean * featureMean.t());
+
+      // Eigendecompose the centered covariance; the eigenvalues are in
+      // ascending order, so take the last k in reverse.
+      arma::vec allEigval;
+      arma::mat allEigvec;
+      arma::eig_sym(allEigval, allEigvec, arma::symmatu(covariance));
+
+      eigval = arma::flipud(allEigval.tail(k));
+      components = arma::fliplr(allEigvec.tail_cols(k));
+
+      Transform(data, transformedData);
+    }
+
+    eigvec = components;
+  }
+
+  /**
+   * Transform the given points onto the components found by the last call to
+   * ApplyKernelMatrix().  The training points are not needed.
+   *
+   * @param points Points to transform.
+   * @param transformedPoints Matrix to store the transformed points in.
+   */
+  void Transform(const arma::mat& points, arma::mat& transformedPoints) const
+  {
+    if (points.n_rows != frequencies.n_rows)
+    {
+      std::ostringstream oss;
+      oss << "RandomFourierFeaturesRule::Transform(): dimensionality of points "
+          << "(" << points.n_rows << ") does not match the dimensionality of "
+          << "the training points (" << frequencies.n_rows << ")";
+      throw std::invalid_argument(oss.str());
+    }
+
+    // Transform into a separate matrix, in case the points and the transformed
+    // points are the same matrix.
+    arma::mat result(components.n_cols, points.n_cols);
+    const size_t numBlocks = (points.n_cols + blockSize - 1) / blockSize;
+
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+    {
+      const size_t begin = b * blockSize;
+      const size_t end = std::min(begin + blockSize,
+          (size_t) points.n_cols) - 1;
+
+      arma::mat features;
+      Features(points.cols(begin, end), features);
+      features.each_col() -= featureMean;
+      result.cols(begin, end) = components.t() * features;
+    }
+
+    transformedPoints = std::move(result);
+  }
+
+  //! Get the number of random features.
+  size_t NumFeatures() const { return numFeatures; }
+  //! Modify the number of random features.
+  size_t& NumFeatures() { return numFeatures; }
+
+  //! Get whether the randomized SVD is used to find the components.
+  bool RandomizedSVD() const { return randomizedSVD; }
+  //! Modify whether the randomized SVD is used to find the components.
+  bool& RandomizedSVD() { return randomizedSVD; }
+
+  //! Get the number of points to compute the features of at once.
+  size_t BlockSize() const { return blockSize; }
+  //! Modify the number of points to compute the features of at once.
+  size_t& BlockSize() { return blockSize; }
+
+  //! Get the sampled frequencies (one feature per column).
+  const arma::mat& Frequencies() const { return frequencies; }
+  //! Get the sampled offsets.
+  const arma::vec& Offsets() const { return offsets; }
+  //! Get the mean of the features of the training points.
+  const arma::vec& FeatureMean() const { return featureMean; }
+  //! Get the components in the feature space (one per column).
+  const arma::mat& Components() const { return components; }
+
+ private:
+  //! Compute the features of the given points (one column per point).
+  template<typename MatType>
+  void Features(const MatType& points, arma::mat& features) const
+  {
+    features = frequencies.t() * points;
+    features.each_col() += offsets;
+    features = std::sqrt(2.0 / frequencies.n_cols) * arma::cos(features);
+  }
+
+  //! The Fourier transform of the Gaussian kernel is a Gaussian distribution
+  //! with standard deviation 1 / bandwidth.
+  void SampleFrequencies(const kernel::GaussianKernel& kernel,
+                         const size_t dimensionality)
+  {
+    frequencies = arma::randn<arma::mat>(dimensionality, numFeatures) /
+        kernel.Bandwidth();
+  }
+
+  //! The Fourier transform of the Laplacian kernel is a multivariate Cauchy
+  //! distribution with scale 1 / bandwidth; a sample is a Gaussian sample
+  //! divided by the absolute value of a standard normal sample.
+  void SampleFrequencies(const kernel::LaplacianKernel& kernel,
+                         const size_t dimensionality)
+  {
+    frequencies = arma::randn<arma::mat>(dimensionality, numFeatures) /
+        kernel.Bandwidth();
+    frequencies.each_row() /=
+        arma::abs(arma::randn<arma::rowvec>(numFeatures));
+  }
+
+  //! The number of random features.
+  size_t numFeatures;
+  //! Whether the randomized SVD is used to find the components.
+  bool randomizedSVD;
+  //! The number of points to compute the features of at once.
+  size_t blockSize;
+
+  //! The sampled frequencies (dimensionality x numFeatures).
+  arma::mat frequencies;
+  //! The sampled offsets.
+  arma::vec offsets;
+  //! The mean of the features of the training points.
+  arma::vec featureMean;
+  //! The components in the feature space.
+  arma::mat components;
+};
+
+} // namespace kpca
+} // namespace mlpack
+
+#endif
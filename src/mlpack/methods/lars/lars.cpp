@@ -21,12 +21,14 @@ LARS::LARS(const bool useCholesky,
            const double lambda2,
            const double tolerance) :
     matGram(&matGramInternal),
+    cholSize(0),
     useCholesky(useCholesky),
     lasso((lambda1 != 0)),
     lambda1(lambda1),
     elasticNet((lambda1 != 0) && (lambda2 != 0)),
     lambda2(lambda2),
-    tolerance(tolerance)
+    tolerance(tolerance),
+    quiet(false)
 { /* Nothing left to do. */ }
 
 LARS::LARS(const bool useCholesky,
@@ -35,12 +37,14 @@ LARS::LARS(const bool useCholesky,
            const double lambda2,
            const double tolerance) :
     matGram(&gramMatrix),
+    cholSize(0),
     useCholesky(useCholesky),
     lasso((lambda1 != 0)),
     lambda1(lambda1),
     elasticNet((lambda1 != 0) && (lambda2 != 0)),
     lambda2(lambda2),
-    tolerance(tolerance)
+    tolerance(tolerance),
+    quiet(false)
 { /* Nothing left to do */ }
 
 LARS::LARS(const arma::mat& data,
@@ -51,12 +55,14 @@ LARS::LARS(const arma::mat& data,
            const double lambda2,
            const double tolerance) :
     matGram(&matGramInternal),
+    cholSize(0),
     useCholesky(useCholesky),
     lasso((lambda1 != 0)),
     lambda1(lambda1),
     elasticNet((lambda1 != 0) && (lambda2 != 0)),
     lambda2(lambda2),
-    tolerance(tolerance)
+    tolerance(tolerance),
+    quiet(false)
 {
   arma::rowvec rowResponses = responses.t();
   Train(data, rowResponses, transposeData);
@@ -71,12 +77,14 @@ LARS::LARS(const arma::mat& data,
            const double lambda2,
            const double tolerance) :
     matGram(&gramMatrix),
+    cholSize(0),
     useCholesky(useCholesky),
     lasso((lambda1 != 0)),
     lambda1(lambda1),
     elasticNet((lambda1 != 0) && (lambda2 != 0)),
     lambda2(lambda2),
-    tolerance(tolerance)
+    tolerance(tolerance),
+    quiet(false)
 {
   arma::rowvec rowResponses = responses.t();
   Train(data, rowResponses, transposeData);
@@ -130,7 +138,28 @@ void LARS::Train(const arma::mat& matX,
                  arma::vec& beta,
                  const bool transposeData)
 {
-  Timer::Start("lars_regression");
+  TrainImpl(matX, y, beta, transposeData);
+}
+
+void LARS::Train(const arma::sp_mat& matX,
+                 const arma::rowvec& y,
+                 arma::vec& beta,
+                 const bool transposeData)
+{
+  TrainImpl(matX, y, beta, transposeData);
+}
+
+template<typename MatType>
+void LARS::TrainImpl(const MatType& matX,
+                     const arma::rowvec& y,
+                     arma::vec& beta,
+                     const bool transposeData)
+{
+  // When LARS is run for many problems (as by SparseCoding), the caller may
+  // make it quiet; then it is not timed, and warnings are left to the caller,
+  // which can check IgnoreSet().
+  if (!quiet)
+    Timer::Start("lars_regression");
 
   // Clear any previous solution information.
   betaPath.clear();
@@ -139,12 +168,14 @@ void LARS::Train(const arma::mat& matX,
   isActive.clear();
   ignoreSet.clear();
   isIgnored.clear();
-  matUtriCholFactor.reset();
+
+  // Empty the cholesky factor, but keep its storage.
+  cholSize = 0;
 
   // This matrix may end up holding the transpose -- if necessary.
-  arma::mat dataTrans;
+  MatType dataTrans;
   // dataRef is row-major.
-  const arma::mat& dataRef = (transposeData ? dataTrans : matX);
+  const MatType& dataRef = (transposeData ? dataTrans : matX);
   if (transposeData)
     dataTrans = trans(matX);
 
@@ -185,13 +216,18 @@ void LARS::Train(const arma::mat& matX,
   if (maxCorr < lambda1)
   {
     lambdaPath[0] = lambda1;
-    Timer::Stop("lars_regression");
+    if (!quiet)
+      Timer::Stop("lars_regression");
     return;
   }
 
   // Compute the Gram matrix.  If this is the elastic net problem, we will add
-  // lambda2 * I_n to the matrix.
-  if (matGram->n_elem != dataRef.n_cols * dataRef.n_cols)
+  // lambda2 * I_n to the matrix.  The Gram matrix is dense even when the data
+  // is sparse, so for sparse data we instead compute the entries we need from
+  // the columns of the data, as variables enter the active set.
+  const bool sparseGram = arma::is_SpMat<MatType>::value &&
+      (matGram->n_elem != dataRef.n_cols * dataRef.n_cols);
+  if (!sparseGram && (matGram->n_elem != dataRef.n_cols * dataRef.n_cols))
   {
     // In this case, matGram should reference matGramInternal.
     matGramInternal = trans(dataRef) * dataRef;
@@ -217,7 +253,19 @@ void LARS::Train(const arma::mat& matX,
 
     if (!lassocond)
     {
-      if (useCholesky)
+      if (useCholesky && sparseGram)
+      {
+        arma::vec newGramCol(activeSet.size());
+        for (size_t i = 0; i < activeSet.size(); i++)
+        {
+          newGramCol[i] = dot(dataRef.col(activeSet[i]),
+                              dataRef.col(changeInd));
+        }
+
+        CholeskyInsert(dot(dataRef.col(changeInd), dataRef.col(changeInd)),
+            newGramCol);
+      }
+      else if (useCholesky)
       {
         // vec newGramCol = vec(activeSet.size());
         // for (size_t i = 0; i < activeSet.size(); i++)
@@ -249,8 +297,10 @@ void LARS::Train(const arma::mat& matX,
     if (useCholesky)
     {
       // Check for singularity.
-      const double lastUtriElement = matUtriCholFactor(
-          matUtriCholFactor.n_cols - 1, matUtriCholFactor.n_rows - 1);
+      const arma::mat matUtriCholFactor(cholFactorBuffer.memptr(), cholSize,
+          cholSize, false, true);
+      const double lastUtriElement = matUtriCholFactor(cholSize - 1,
+          cholSize - 1);
       if (std::abs(lastUtriElement) > tolerance)
       {
         // Ok, no singularity.
@@ -275,21 +325,42 @@ void LARS::Train(const arma::mat& matX,
       {
         // Singularity, so remove variable from active set, add to ignores set,
         // and look for new variable to add.
-        Log::Warn << "Encountered singularity when adding variable "
-            << changeInd << " to active set; permanently removing."
-            << std::endl;
+        if (!quiet)
+        {
+          Log::Warn << "Encountered singularity when adding variable "
+              << changeInd << " to active set; permanently removing."
+              << std::endl;
+        }
         Deactivate(activeSet.size() - 1);
         Ignore(changeInd);
-        CholeskyDelete(matUtriCholFactor.n_rows - 1);
+        CholeskyDelete(cholSize - 1);
         continue;
       }
     }
     else
     {
       arma::mat matGramActive = arma::mat(activeSet.size(), activeSet.size());
-      for (size_t i = 0; i < activeSet.size(); i++)
-        for (size_t j = 0; j < activeSet.size(); j++)
-          matGramActive(i, j) = (*matGram)(activeSet[i], activeSet[j]);
+      if (sparseGram)
+      {
+        for (size_t i = 0; i < activeSet.size(); i++)
+        {
+          for (size_t j = i; j < activeSet.size(); j++)
+          {
+            matGramActive(i, j) = dot(dataRef.col(activeSet[i]),
+                                      dataRef.col(activeSet[j]));
+            matGramActive(j, i) = matGramActive(i, j);
+          }
+
+          if (elasticNet)
+            matGramActive(i, i) += lambda2;
+        }
+      }
+      else
+      {
+        for (size_t i = 0; i < activeSet.size(); i++)
+          for (size_t j = 0; j < activeSet.size(); j++)
+            matGramActive(i, j) = (*matGram)(activeSet[i], activeSet[j]);
+      }
 
       // Check for singularity.
       arma::mat matS = s * arma::ones<arma::mat>(1, activeSet.size());
@@ -308,9 +379,12 @@ void LARS::Train(const arma::mat& matX,
         // and look for new variable to add.
         Deactivate(activeSet.size() - 1);
         Ignore(changeInd);
-        Log::Warn << "Encountered singularity when adding variable "
-            << changeInd << " to active set; permanently removing."
-            << std::endl;
+        if (!quiet)
+        {
+          Log::Warn << "Encountered singularity when adding variable "
+              << changeInd << " to active set; permanently removing."
+              << std::endl;
+        }
         continue;
       }
     }
@@ -417,7 +491,8 @@ void LARS::Train(const arma::mat& matX,
   // Unfortunate copy...
   beta = betaPath.back();
 
-  Timer::Stop("lars_regression");
+  if (!quiet)
+    Timer::Stop("lars_regression");
 }
 
 void LARS::Train(const arma::mat& data,
@@ -428,6 +503,14 @@ void LARS::Train(const arma::mat& data,
   Train(data, responses, beta, transposeData);
 }
 
+void LARS::Train(const arma::sp_mat& data,
+                 const arma::rowvec& responses,
+                 const bool transposeData)
+{
+  arma::vec beta;
+  Train(data, responses, beta, transposeData);
+}
+
 void LARS::Predict(const arma::mat& points,
                    arma::vec& predictions,
                    const bool rowMajor) const
@@ -448,6 +531,16 @@ void LARS::Predict(const arma::mat& points,
     predictions = betaPath.back().t() * points;
 }
 
+void LARS::Predict(const arma::sp_mat& points,
+                   arma::rowvec& predictions,
+                   const bool rowMajor) const
+{
+  if (rowMajor)
+    predictions = trans(points * betaPath.back());
+  else
+    predictions = betaPath.back().t() * points;
+}
+
 // Private functions.
 void LARS::Deactivate(const size_t activeVarInd)
 {
@@ -467,7 +560,8 @@ void LARS::Ignore(const size_t varInd)
   ignoreSet.push_back(varInd);
 }
 
-void LARS::ComputeYHatDirection(const arma::mat& matX,
+template<typename MatType>
+void LARS::ComputeYHatDirection(const MatType& matX,
                                 const arma::vec& betaDirection,
                                 arma::vec& yHatDirection)
 {
@@ -494,14 +588,9 @@ void LARS::InterpolateBeta()
 
 void LARS::CholeskyInsert(const arma::vec& newX, const arma::mat& X)
 {
-  if (matUtriCholFactor.n_rows == 0)
+  if (cholSize == 0)
   {
-    matUtriCholFactor = arma::mat(1, 1);
-
-    if (elasticNet)
-      matUtriCholFactor(0, 0) = sqrt(dot(newX, newX) + lambda2);
-    else
-      matUtriCholFactor(0, 0) = norm(newX, 2);
+    CholeskyInsert(dot(newX, newX), arma::vec());
   }
   else
   {
@@ -512,35 +601,48 @@ void LARS::CholeskyInsert(const arma::vec& newX, const arma::mat& X)
 
 void LARS::CholeskyInsert(double sqNormNewX, const arma::vec& newGramCol)
 {
-  int n = matUtriCholFactor.n_rows;
+  const size_t n = cholSize;
 
-  if (n == 0)
+  if (elasticNet)
+    sqNormNewX += lambda2;
+
+  // Make sure there is room for the larger factor.  The storage at least
+  // doubles when it grows, so it is rarely reallocated.
+  if (cholFactorBuffer.n_elem < (n + 1) * (n + 1))
   {
-    matUtriCholFactor = arma::mat(1, 1);
+    cholFactorBuffer.resize(std::max((size_t) (2 * cholFactorBuffer.n_elem),
+        (n + 1) * (n + 1)));
+  }
 
-    if (elasticNet)
-      matUtriCholFactor(0, 0) = sqrt(sqNormNewX + lambda2);
-    else
-      matUtriCholFactor(0, 0) = sqrt(sqNormNewX);
+  double* factor = cholFactorBuffer.memptr();
+  if (n == 0)
+  {
+    factor[0] = sqrt(sqNormNewX);
   }
   else
   {
-    arma::mat matNewR = arma::mat(n + 1, n + 1);
-
-    if (elasticNet)
-      sqNormNewX += lambda2;
-
+    const arma::mat matUtriCholFactor(factor, n, n, false, true);
     arma::vec matUtriCholFactork = solve(trimatl(trans(matUtriCholFactor)),
         newGramCol);
 
-    matNewR(arma::span(0, n - 1), arma::span(0, n - 1)) = matUtriCholFactor;
+    // Spread the columns of the factor out to make room for the new row, and
+    // zero it.  Each column moves further than the one before it, so they are
+    // moved from last to first.
+    for (size_t c = n - 1; c > 0; --c)
+    {
+      std::copy_backward(factor + c * n, factor + (c + 1) * n,
+          factor + c * (n + 1) + n);
+      factor[c * (n + 1) + n] = 0.0;
+    }
+    factor[n] = 0.0;
+
+    arma::mat matNewR(factor, n + 1, n + 1, false, true);
     matNewR(arma::span(0, n - 1), n) = matUtriCholFactork;
-    matNewR(n, arma::span(0, n - 1)).fill(0.0);
     matNewR(n, n) = sqrt(sqNormNewX - dot(matUtriCholFactork,
                                           matUtriCholFactork));
-
-    matUtriCholFactor = matNewR;
   }
+
+  cholSize = n + 1;
 }
 
 void LARS::GivensRotate(const arma::vec::fixed<2>& x,
@@ -573,33 +675,36 @@ void LARS::GivensRotate(const arma::vec::fixed<2>& x,
 
 void LARS::CholeskyDelete(const size_t colToKill)
 {
-  size_t n = matUtriCholFactor.n_rows;
+  size_t n = cholSize;
+  double* factor = cholFactorBuffer.memptr();
+  arma::mat matUtriCholFactor(factor, n, n, false, true);
 
-  if (colToKill == (n - 1))
-  {
-    matUtriCholFactor = matUtriCholFactor(arma::span(0, n - 2),
-                                          arma::span(0, n - 2));
-  }
-  else
-  {
-    matUtriCholFactor.shed_col(colToKill); // remove column colToKill
-    n--;
+  // Remove column colToKill by moving the later columns left.
+  for (size_t c = colToKill; c < n - 1; c++)
+    matUtriCholFactor.col(c) = matUtriCholFactor.col(c + 1);
+  n--;
 
-    for (size_t k = colToKill; k < n; k++)
+  // Restore the upper triangular form of the first n columns.
+  for (size_t k = colToKill; k < n; k++)
+  {
+    arma::mat matG;
+    arma::vec::fixed<2> rotatedVec;
+    GivensRotate(matUtriCholFactor(arma::span(k, k + 1), k), rotatedVec,
+        matG);
+    matUtriCholFactor(arma::span(k, k + 1), k) = rotatedVec;
+    if (k < n - 1)
     {
-      arma::mat matG;
-      arma::vec::fixed<2> rotatedVec;
-      GivensRotate(matUtriCholFactor(arma::span(k, k + 1), k), rotatedVec,
-          matG);
-      matUtriCholFactor(arma::span(k, k + 1), k) = rotatedVec;
-      if (k < n - 1)
-      {
-        matUtriCholFactor(arma::span(k, k + 1), arma::span(k + 1, n - 1)) =
-            matG * matUtriCholFactor(arma::span(k, k + 1),
-            arma::span(k + 1, n - 1));
-      }
+      matUtriCholFactor(arma::span(k, k + 1), arma::span(k + 1, n - 1)) =
+          matG * matUtriCholFactor(arma::span(k, k + 1),
+          arma::span(k + 1, n - 1));
     }
-
-    matUtriCholFactor.shed_row(n);
   }
+
+  // Now the last row is zero, so drop it by packing the first n rows of each
+  // column together.  The columns move towards the start of the storage, so
+  // they are moved from first to last.
+  for (size_t c = 1; c < n; c++)
+    std::copy(factor + c * (n + 1), factor + c * (n + 1) + n, factor + c * n);
+
+  cholSize = n;
 }
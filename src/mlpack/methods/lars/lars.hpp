@@ -290,6 +290,37 @@ class LARS
              const arma::rowvec& responses,
              const bool transposeData = true);
 
+  /**
+   * Run LARS on sparse data.  The correlations and the equiangular direction
+   * only touch the nonzero elements of the data, so this is much faster than
+   * densifying the data first.  Unless a Gram matrix was given to the
+   * constructor, the full (dense) Gram matrix is never formed: the entries for
+   * the active set are computed from products of the sparse columns as
+   * variables enter it.  The parameters are the same as for the dense overload.
+   *
+   * @param data Column-major input data (or row-major input data if rowMajor =
+   *     true).
+   * @param responses A vector of targets.
+   * @param beta Vector to store the solution (the coefficients) in.
+   * @param transposeData Set to false if the data is row-major.
+   */
+  void Train(const arma::sp_mat& data,
+             const arma::rowvec& responses,
+             arma::vec& beta,
+             const bool transposeData = true);
+
+  /**
+   * Run LARS on sparse data.
+   *
+   * @param data Input data.
+   * @param responses A vector of targets.
+   * @param transposeData Should be true if the input data is column-major and
+   *     false otherwise.
+   */
+  void Train(const arma::sp_mat& data,
+             const arma::rowvec& responses,
+             const bool transposeData = true);
+
   /**
    * Predict y_i for each data point in the given data matrix, using the
    * currently-trained LARS model (so make sure you run Regress() first).  If
@@ -316,6 +347,19 @@ class LARS
                arma::rowvec& predictions,
                const bool rowMajor = false) const;
 
+  /**
+   * Predict y_i for each data point in the given sparse data matrix using the
+   * currently-trained LARS model.
+   *
+   * @param points The data points to regress on.
+   * @param predictions y, which will contained calculated values on completion.
+   * @param rowMajor Should be true if the data points matrix is row-major and
+   *     false otherwise.
+   */
+  void Predict(const arma::sp_mat& points,
+               arma::rowvec& predictions,
+               const bool rowMajor = false) const;
+
   //! Access the set of active dimensions.
   const std::vector<size_t>& ActiveSet() const { return activeSet; }
 
@@ -330,8 +374,22 @@ class LARS
   //! the last element.
   const std::vector<double>& LambdaPath() const { return lambdaPath; }
 
-  //! Access the upper triangular cholesky factor.
-  const arma::mat& MatUtriCholFactor() const { return matUtriCholFactor; }
+  //! Get a copy of the upper triangular cholesky factor.
+  arma::mat MatUtriCholFactor() const
+  {
+    return arma::mat(cholFactorBuffer.memptr(), cholSize, cholSize);
+  }
+
+  //! Access the set of variables that were permanently removed from the active
+  //! set because they made it singular.
+  const std::vector<size_t>& IgnoreSet() const { return ignoreSet; }
+
+  //! Get whether Train() is quiet (neither timed nor printing warnings).
+  bool Quiet() const { return quiet; }
+  //! Modify whether Train() is quiet (neither timed nor printing warnings).
+  //! This is useful when many problems are solved, possibly in parallel; the
+  //! caller can check IgnoreSet() for singularities instead.
+  bool& Quiet() { return quiet; }
 
   /**
    * Serialize the LARS model.
@@ -346,8 +404,13 @@ class LARS
   //! Pointer to the Gram matrix we will use.
   const arma::mat* matGram;
 
-  //! Upper triangular cholesky factor; initially 0x0 matrix.
-  arma::mat matUtriCholFactor;
+  //! Storage for the upper triangular cholesky factor, which is held
+  //! column-major in its first cholSize * cholSize elements.  The storage only
+  //! grows, so it is reused by later calls to Train().
+  arma::vec cholFactorBuffer;
+
+  //! Number of rows (and columns) of the cholesky factor; initially 0.
+  size_t cholSize;
 
   //! Whether or not to use Cholesky decomposition when solving linear system.
   bool useCholesky;
@@ -365,6 +428,9 @@ class LARS
   //! Tolerance for main loop.
   double tolerance;
 
+  //! If true, Train() is neither timed nor prints warnings.
+  bool quiet;
+
   //! Solution path.
   std::vector<arma::vec> betaPath;
 
@@ -385,6 +451,15 @@ class LARS
   //! Membership indicator for set of ignored variables.
   std::vector<bool> isIgnored;
 
+  /**
+   * Run LARS on dense or sparse data; this is the implementation of Train().
+   */
+  template<typename MatType>
+  void TrainImpl(const MatType& data,
+                 const arma::rowvec& responses,
+                 arma::vec& beta,
+                 const bool transposeData);
+
   /**
    * Remove activeVarInd'th element from active set.
    *
@@ -407,7 +482,8 @@ class LARS
   void Ignore(const size_t varInd);
 
   // compute "equiangular" direction in output space
-  void ComputeYHatDirection(const arma::mat& matX,
+  template<typename MatType>
+  void ComputeYHatDirection(const MatType& matX,
                             const arma::vec& betaDirection,
                             arma::vec& yHatDirection);
 
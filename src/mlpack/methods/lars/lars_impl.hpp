@@ -37,7 +37,17 @@ void LARS::Serialize(Archive& ar, const unsigned int /* version */)
     ar & CreateNVP(const_cast<arma::mat&>(*matGram), "matGramInternal");
   }
 
+  // Only the cholesky factor itself is saved, not its storage.
+  arma::mat matUtriCholFactor;
+  if (Archive::is_saving::value)
+    matUtriCholFactor = MatUtriCholFactor();
   ar & CreateNVP(matUtriCholFactor, "matUtriCholFactor");
+  if (Archive::is_loading::value)
+  {
+    cholSize = matUtriCholFactor.n_rows;
+    cholFactorBuffer = arma::vectorise(matUtriCholFactor);
+  }
+
   ar & CreateNVP(useCholesky, "useCholesky");
   ar & CreateNVP(lasso, "lasso");
   ar & CreateNVP(lambda1, "lambda1");
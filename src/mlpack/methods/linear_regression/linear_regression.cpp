@@ -37,7 +37,29 @@ LinearRegression::LinearRegression(const arma::mat& predictors,
                                    const double lambda,
                                    const bool intercept) :
     lambda(lambda),
-    intercept(intercept)
+    intercept(intercept),
+    maxIterations(0),
+    tolerance(1e-10)
+{
+  Train(predictors, responses, weights, intercept);
+}
+
+LinearRegression::LinearRegression(const arma::sp_mat& predictors,
+                                   const arma::rowvec& responses,
+                                   const double lambda,
+                                   const bool intercept) :
+    LinearRegression(predictors, responses, arma::rowvec(), lambda, intercept)
+{}
+
+LinearRegression::LinearRegression(const arma::sp_mat& predictors,
+                                   const arma::rowvec& responses,
+                                   const arma::rowvec& weights,
+                                   const double lambda,
+                                   const bool intercept) :
+    lambda(lambda),
+    intercept(intercept),
+    maxIterations(0),
+    tolerance(1e-10)
 {
   Train(predictors, responses, weights, intercept);
 }
@@ -122,6 +144,107 @@ void LinearRegression::Train(const arma::mat& predictors,
   }
 }
 
+void LinearRegression::Train(const arma::sp_mat& predictors,
+                             const arma::rowvec& responses,
+                             const bool intercept)
+{
+  Train(predictors, responses, arma::rowvec(), intercept);
+}
+
+void LinearRegression::Train(const arma::sp_mat& predictors,
+                             const arma::rowvec& responses,
+                             const arma::rowvec& weights,
+                             const bool intercept)
+{
+  this->intercept = intercept;
+
+  /*
+   * Adding the row of ones for the intercept and taking the QR decomposition
+   * would fill in the sparse predictors, so instead we solve the normal
+   * equations
+   *   (X W X^T + lambda I) B = X W y
+   * with the conjugate gradient method.  Only products with X and X^T are
+   * needed, and X is never modified.  As in the dense case, the intercept (if
+   * any) is the first parameter and it is not penalized.
+   */
+  const size_t offset = intercept ? 1 : 0;
+  const size_t nParams = predictors.n_rows + offset;
+
+  // Compute X^T B: the prediction for each point.
+  auto predict = [&](const arma::vec& b)
+  {
+    arma::rowvec result = arma::trans(b.subvec(offset, nParams - 1)) *
+        predictors;
+    if (intercept)
+      result += b(0);
+    return result;
+  };
+
+  // Compute X u for a vector u with one element per point.
+  auto project = [&](const arma::rowvec& u)
+  {
+    arma::vec result(nParams);
+    if (intercept)
+      result(0) = arma::accu(u);
+    result.subvec(offset, nParams - 1) = predictors * arma::trans(u);
+    return result;
+  };
+
+  // Compute (X W X^T + lambda I) b.
+  auto normal = [&](const arma::vec& b)
+  {
+    arma::rowvec u = predict(b);
+    if (weights.n_elem > 0)
+      u %= weights;
+    arma::vec result = project(u);
+    if (lambda != 0.0)
+    {
+      result.subvec(offset, nParams - 1) += lambda *
+          b.subvec(offset, nParams - 1);
+    }
+    return result;
+  };
+
+  arma::vec residual = (weights.n_elem > 0) ? project(weights % responses) :
+      project(responses);
+  const double rhsNorm = arma::norm(residual);
+  const double absoluteTolerance = tolerance * rhsNorm;
+  arma::vec direction = residual;
+  double residualNorm = arma::dot(residual, residual);
+
+  // In exact arithmetic, conjugate gradient converges in at most nParams
+  // iterations; by default, leave some slack for roundoff.
+  parameters.zeros(nParams);
+  const size_t iterations = (maxIterations == 0) ? 2 * nParams + 10 :
+      maxIterations;
+  for (size_t i = 0; i < iterations &&
+       std::sqrt(residualNorm) > absoluteTolerance; ++i)
+  {
+    const arma::vec q = normal(direction);
+    const double curvature = arma::dot(direction, q);
+    if (curvature <= 0.0)
+      break; // The system is singular in this direction.
+
+    const double alpha = residualNorm / curvature;
+    parameters += alpha * direction;
+    residual -= alpha * q;
+
+    const double newResidualNorm = arma::dot(residual, residual);
+    direction = residual + (newResidualNorm / residualNorm) * direction;
+    residualNorm = newResidualNorm;
+  }
+
+  // The normal equations square the condition number of the predictors, so on
+  // ill-conditioned data the solution may not have converged, and it may then
+  // differ from the one found for the same data in dense form.
+  if (std::sqrt(residualNorm) > absoluteTolerance)
+  {
+    Log::Warn << "LinearRegression::Train(): conjugate gradient did not "
+        << "converge; the relative residual of the normal equations is "
+        << std::sqrt(residualNorm) / rhsNorm << "." << std::endl;
+  }
+}
+
 void LinearRegression::Predict(const arma::mat& points, arma::vec& predictions)
     const
 {
@@ -130,7 +253,8 @@ void LinearRegression::Predict(const arma::mat& points, arma::vec& predictions)
   predictions = arma::trans(rowPredictions);
 }
 
-void LinearRegression::Predict(const arma::mat& points,
+template<typename MatType>
+void LinearRegression::PredictImpl(const MatType& points,
     arma::rowvec& predictions) const
 {
   if (intercept)
@@ -154,6 +278,18 @@ void LinearRegression::Predict(const arma::mat& points,
   }
 }
 
+void LinearRegression::Predict(const arma::mat& points,
+    arma::rowvec& predictions) const
+{
+  PredictImpl(points, predictions);
+}
+
+void LinearRegression::Predict(const arma::sp_mat& points,
+    arma::rowvec& predictions) const
+{
+  PredictImpl(points, predictions);
+}
+
 //! Compute the L2 squared error on the given predictors and responses.
 double LinearRegression::ComputeError(const arma::mat& predictors,
                                       const arma::vec& responses) const
@@ -164,6 +300,19 @@ double LinearRegression::ComputeError(const arma::mat& predictors,
 
 double LinearRegression::ComputeError(const arma::mat& predictors,
                                       const arma::rowvec& responses) const
+{
+  return ComputeErrorImpl(predictors, responses);
+}
+
+double LinearRegression::ComputeError(const arma::sp_mat& predictors,
+                                      const arma::rowvec& responses) const
+{
+  return ComputeErrorImpl(predictors, responses);
+}
+
+template<typename MatType>
+double LinearRegression::ComputeErrorImpl(const MatType& predictors,
+                                          const arma::rowvec& responses) const
 {
   // Get the number of columns and rows of the dataset.
   const size_t nCols = predictors.n_cols;
@@ -69,12 +69,47 @@ class LinearRegression
                    const double lambda = 0,
                    const bool intercept = true);
 
+  /**
+   * Creates the model from sparse data.  See the sparse overload of Train()
+   * for details.
+   *
+   * @param predictors X, sparse matrix of data points.
+   * @param responses y, the measured data for each point in X.
+   * @param lambda Regularization constant for ridge regression.
+   * @param intercept Whether or not to include an intercept term.
+   */
+  LinearRegression(const arma::sp_mat& predictors,
+                   const arma::rowvec& responses,
+                   const double lambda = 0,
+                   const bool intercept = true);
+
+  /**
+   * Creates the model from sparse data with weighted learning.  See the sparse
+   * overload of Train() for details.
+   *
+   * @param predictors X, sparse matrix of data points.
+   * @param responses y, the measured data for each point in X.
+   * @param weights Observation weights (for boosting).
+   * @param lambda Regularization constant for ridge regression.
+   * @param intercept Whether or not to include an intercept term.
+   */
+  LinearRegression(const arma::sp_mat& predictors,
+                   const arma::rowvec& responses,
+                   const arma::rowvec& weights,
+                   const double lambda = 0,
+                   const bool intercept = true);
+
   /**
    * Empty constructor.  This gives a non-working model, so make sure Train() is
    * called (or make sure the model parameters are set) before calling
    * Predict()!
    */
-  LinearRegression() : lambda(0.0), intercept(true) { }
+  LinearRegression() :
+      lambda(0.0),
+      intercept(true),
+      maxIterations(0),
+      tolerance(1e-10)
+  { }
 
   /**
    * Train the LinearRegression model on the given data.  Careful!  This will
@@ -125,6 +160,40 @@ class LinearRegression
              const arma::rowvec& weights,
              const bool intercept = true);
 
+  /**
+   * Train the LinearRegression model on the given sparse data.  The QR
+   * decomposition used for dense data would fill in the predictors, so instead
+   * the (regularized) normal equations are solved with the conjugate gradient
+   * method, which only needs products with the sparse matrix.  The solver
+   * stops after MaxIterations() iterations, or when the residual of the normal
+   * equations is at most Tolerance() times its initial value; if it has not
+   * converged, a warning is printed.  The normal equations square the
+   * condition number of the predictors, so on ill-conditioned data the model
+   * may differ from the one trained on the same data in dense form.  Careful!
+   * This will completely ignore and overwrite the existing model.
+   *
+   * @param predictors X, the sparse matrix of data points to train on.
+   * @param responses y, the responses to the data points.
+   * @param intercept Whether or not to fit an intercept term.
+   */
+  void Train(const arma::sp_mat& predictors,
+             const arma::rowvec& responses,
+             const bool intercept = true);
+
+  /**
+   * Train the LinearRegression model on the given sparse data and weights.
+   * Careful!  This will completely ignore and overwrite the existing model.
+   *
+   * @param predictors X, the sparse matrix of data points to train on.
+   * @param responses y, the responses to the data points.
+   * @param weights Observation weights (for boosting).
+   * @param intercept Whether or not to fit an intercept term.
+   */
+  void Train(const arma::sp_mat& predictors,
+             const arma::rowvec& responses,
+             const arma::rowvec& weights,
+             const bool intercept = true);
+
   /**
    * Calculate y_i for each data point in points.
    *
@@ -142,6 +211,14 @@ class LinearRegression
    */
   void Predict(const arma::mat& points, arma::rowvec& predictions) const;
 
+  /**
+   * Calculate y_i for each data point in the sparse matrix points.
+   *
+   * @param points the data points to calculate with.
+   * @param predictions y, will contain calculated values on completion.
+   */
+  void Predict(const arma::sp_mat& points, arma::rowvec& predictions) const;
+
   /**
    * Calculate the L2 squared error on the given predictors and responses using
    * this linear regression model.  This calculation returns
@@ -182,6 +259,16 @@ class LinearRegression
   double ComputeError(const arma::mat& points,
                       const arma::rowvec& responses) const;
 
+  /**
+   * Calculate the L2 squared error on the given sparse predictors and
+   * responses using this linear regression model.
+   *
+   * @param points Sparse matrix of predictors (X).
+   * @param responses Transposed vector of responses (y^T).
+   */
+  double ComputeError(const arma::sp_mat& points,
+                      const arma::rowvec& responses) const;
+
   //! Return the parameters (the b vector).
   const arma::vec& Parameters() const { return parameters; }
   //! Modify the parameters (the b vector).
@@ -195,6 +282,20 @@ class LinearRegression
   //! Return whether or not an intercept term is used in the model.
   bool Intercept() const { return intercept; }
 
+  //! Get the maximum number of conjugate gradient iterations for sparse data
+  //! (0 means twice the number of parameters, plus 10).
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of conjugate gradient iterations for sparse
+  //! data (0 means twice the number of parameters, plus 10).
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the relative tolerance of the conjugate gradient solver for sparse
+  //! data.
+  double Tolerance() const { return tolerance; }
+  //! Modify the relative tolerance of the conjugate gradient solver for sparse
+  //! data.
+  double& Tolerance() { return tolerance; }
+
   /**
    * Serialize the model.
    */
@@ -207,6 +308,15 @@ class LinearRegression
   }
 
  private:
+  //! Compute the predictions for dense or sparse points.
+  template<typename MatType>
+  void PredictImpl(const MatType& points, arma::rowvec& predictions) const;
+
+  //! Compute the L2 squared error for dense or sparse predictors.
+  template<typename MatType>
+  double ComputeErrorImpl(const MatType& predictors,
+                          const arma::rowvec& responses) const;
+
   /**
    * The calculated B.
    * Initialized and filled by constructor to hold the least squares solution.
@@ -221,6 +331,12 @@ class LinearRegression
 
   //! Indicates whether first parameter is intercept.
   bool intercept;
+
+  //! The maximum number of conjugate gradient iterations for sparse data (0
+  //! for the default).
+  size_t maxIterations;
+  //! The relative tolerance of the conjugate gradient solver for sparse data.
+  double tolerance;
 };
 
 } // namespace regression
@@ -175,22 +175,15 @@ void mlpackMain()
     Timer::Start("regression");
     lr = LinearRegression(regressors, responses);
     Timer::Stop("regression");
-
-    // Save the parameters.
-    if (CLI::HasParam("output_model"))
-      CLI::GetParam<LinearRegression>("output_model") = std::move(lr);
   }
 
   // Did we want to predict, too?
   if (CLI::HasParam("test"))
   {
-    // A model file was passed in, so load it.
-    if (!computeModel)
-    {
-      Timer::Start("load_model");
-      lr = std::move(CLI::GetParam<LinearRegression>("input_model"));
-      Timer::Stop("load_model");
-    }
+    // If a model was passed in, it is used in place, so that it is not
+    // consumed.
+    const LinearRegression& model = computeModel ? lr :
+        CLI::GetParam<LinearRegression>("input_model");
 
     // Load the test file data.
     Timer::Start("load_test_points");
@@ -198,9 +191,9 @@ void mlpackMain()
     Timer::Stop("load_test_points");
 
     // Ensure that test file data has the right number of features.
-    if ((lr.Parameters().n_elem - 1) != points.n_rows)
+    if ((model.Parameters().n_elem - 1) != points.n_rows)
     {
-      Log::Fatal << "The model was trained on " << lr.Parameters().n_elem - 1
+      Log::Fatal << "The model was trained on " << model.Parameters().n_elem - 1
           << "-dimensional data, but the test points in '"
           << CLI::GetPrintableParam<mat>("test") << "' are " << points.n_rows
           << "-dimensional!" << endl;
@@ -209,11 +202,15 @@ void mlpackMain()
     // Perform the predictions using our model.
     rowvec predictions;
     Timer::Start("prediction");
-    lr.Predict(points, predictions);
+    model.Predict(points, predictions);
     Timer::Stop("prediction");
 
     // Save predictions.
     if (CLI::HasParam("output_predictions"))
       CLI::GetParam<vec>("output_predictions") = std::move(predictions);
   }
+
+  // Save the parameters.
+  if (computeModel && CLI::HasParam("output_model"))
+    CLI::GetParam<LinearRegression>("output_model") = std::move(lr);
 }
@@ -34,32 +34,60 @@ void LocalCoordinateCoding::Encode(const arma::mat& data, arma::mat& codes)
       data.n_cols) + repmat(sum(square(data)), atoms, 1) - 2 * trans(dictionary)
       * data);
 
-  arma::mat dictGram = trans(dictionary) * dictionary;
-  arma::mat dictGramTD(dictGram.n_rows, dictGram.n_cols);
+  // The Gram matrix of the dictionary is computed once; the Gram matrix of
+  // each weighted dictionary is obtained by scaling it.
+  const arma::mat dictGram = trans(dictionary) * dictionary;
 
   codes.set_size(atoms, data.n_cols);
-  for (size_t i = 0; i < data.n_cols; i++)
+  Log::Debug << "Encoding " << data.n_cols << " points." << std::endl;
+
+  // The points are coded independently, so each thread codes a different set
+  // of points.  The weighted dictionary and its Gram matrix are overwritten
+  // for each point, and the LARS object holds a reference to the Gram matrix,
+  // so none of them need to be reallocated.  The LARS objects are quiet, so the
+  // points where LARS hit a singularity are counted and reported once
+  // afterwards.
+  size_t singularPoints = 0;
+  #pragma omp parallel reduction(+:singularPoints)
   {
-    // Report progress.
-    if ((i % 100) == 0)
-    {
-      Log::Debug << "Optimization at point " << i << "." << std::endl;
-    }
-
-    arma::vec invW = invSqDists.unsafe_col(i);
-    arma::mat dictPrime = dictionary * diagmat(invW);
-
-    arma::mat dictGramTD = diagmat(invW) * dictGram * diagmat(invW);
+    arma::mat dictPrime(dictionary.n_rows, dictionary.n_cols);
+    arma::mat dictGramTD(dictGram.n_rows, dictGram.n_cols);
+    arma::rowvec responses(data.n_rows);
 
-    bool useCholesky = false;
+    const bool useCholesky = false;
     regression::LARS lars(useCholesky, dictGramTD, 0.5 * lambda);
+    lars.Quiet() = true;
 
-    // Run LARS for this point, by making an alias of the point and passing
-    // that.
-    arma::vec beta = codes.unsafe_col(i);
-    arma::rowvec responses = data.unsafe_col(i).t();
-    lars.Train(dictPrime, responses, beta, false);
-    beta %= invW; // Remember, beta is an alias of codes.col(i).
+    #pragma omp for schedule(dynamic, 16)
+    for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+    {
+      const arma::vec invW = invSqDists.unsafe_col(i);
+      const arma::rowvec invWT = invW.t();
+
+      // dictPrime = dictionary * diagmat(invW), and dictGramTD =
+      // diagmat(invW) * dictGram * diagmat(invW).
+      dictPrime = dictionary;
+      dictPrime.each_row() %= invWT;
+      dictGramTD = dictGram;
+      dictGramTD.each_col() %= invW;
+      dictGramTD.each_row() %= invWT;
+
+      // Run LARS for this point, by making an alias of the point and passing
+      // that.
+      arma::vec beta = codes.unsafe_col(i);
+      responses = data.col(i).t();
+      lars.Train(dictPrime, responses, beta, false);
+      beta %= invW; // Remember, beta is an alias of codes.col(i).
+      if (!lars.IgnoreSet().empty())
+        ++singularPoints;
+    }
+  }
+
+  if (singularPoints > 0)
+  {
+    Log::Warn << "LocalCoordinateCoding::Encode(): LARS encountered a "
+        << "singularity for " << singularPoints << " point(s); the offending "
+        << "atoms were not used for those points." << std::endl;
   }
 }
 
@@ -81,6 +81,20 @@ class LogisticRegressionFunction
    */
   double Evaluate(const arma::mat& parameters, const size_t i) const;
 
+  /**
+   * Evaluate the logistic regression log-likelihood function with the given
+   * parameters, using only the points begin, ..., begin + batchSize - 1.  This
+   * is the sum of Evaluate(parameters, i) over the points in the batch, but the
+   * points are processed together, which is much faster.
+   *
+   * @param parameters Vector of logistic regression parameters.
+   * @param begin Index of the first point in the batch.
+   * @param batchSize Number of points in the batch.
+   */
+  double Evaluate(const arma::mat& parameters,
+                  const size_t begin,
+                  const size_t batchSize) const;
+
   /**
    * Evaluate the gradient of the logistic regression log-likelihood function
    * with the given parameters.
@@ -107,6 +121,23 @@ class LogisticRegressionFunction
                 const size_t i,
                 GradType& gradient) const;
 
+  /**
+   * Evaluate the gradient of the logistic regression log-likelihood function
+   * with the given parameters, with respect to the points begin, ..., begin +
+   * batchSize - 1.  This is the sum of Gradient(parameters, i, gradient) over
+   * the points in the batch, but the points are processed together, which is
+   * much faster.
+   *
+   * @param parameters Vector of logistic regression parameters.
+   * @param begin Index of the first point in the batch.
+   * @param gradient Vector to output gradient into.
+   * @param batchSize Number of points in the batch.
+   */
+  void Gradient(const arma::mat& parameters,
+                const size_t begin,
+                arma::mat& gradient,
+                const size_t batchSize) const;
+
   /**
    * Evaluate the gradient of the logistic regression log-likelihood function
    * with the given parameters, and with respect to only one feature in the
@@ -126,6 +126,44 @@ double LogisticRegressionFunction<MatType>::Evaluate(
     return -log(1.0 - sigmoid) + regularization;
 }
 
+/**
+ * Evaluate the logistic regression objective function on a contiguous batch of
+ * points.  This is useful for optimizers that use batches of a separable
+ * objective function, such as mini-batch SGD.
+ */
+template<typename MatType>
+double LogisticRegressionFunction<MatType>::Evaluate(
+    const arma::mat& parameters,
+    const size_t begin,
+    const size_t batchSize) const
+{
+  // Calculate the regularization term.  Each point gets 1 / n of the full
+  // regularization, so that the sum over all batches is Evaluate(parameters).
+  const double regularization = lambda *
+      (batchSize / (2.0 * predictors.n_cols)) *
+      arma::dot(parameters.tail_cols(parameters.n_elem - 1),
+      parameters.tail_cols(parameters.n_elem - 1));
+
+  // Calculate the sigmoids of all points in the batch at once.  The columns of
+  // the batch are contiguous, so no copy of the data is needed.
+  const arma::rowvec exponents = parameters(0, 0) +
+      parameters.tail_cols(parameters.n_elem - 1) *
+      predictors.cols(begin, begin + batchSize - 1);
+  const arma::rowvec sigmoid = 1.0 / (1.0 + arma::exp(-exponents));
+
+  double result = 0.0;
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    if (responses[begin + i] == 1)
+      result += log(sigmoid[i]);
+    else
+      result += log(1.0 - sigmoid[i]);
+  }
+
+  // Invert the result, because it's a minimization.
+  return -result + regularization;
+}
+
 //! Evaluate the gradient of the logistic regression objective function.
 template<typename MatType>
 void LogisticRegressionFunction<MatType>::Gradient(
@@ -172,6 +210,35 @@ void LogisticRegressionFunction<MatType>::Gradient(
       * (responses[i] - sigmoid) + regularization;
 }
 
+/**
+ * Evaluate the gradient of the logistic regression objective function with
+ * respect to a contiguous batch of points.  This is useful for optimizers that
+ * use batches of a separable objective function, such as mini-batch SGD.
+ */
+template <typename MatType>
+void LogisticRegressionFunction<MatType>::Gradient(
+    const arma::mat& parameters,
+    const size_t begin,
+    arma::mat& gradient,
+    const size_t batchSize) const
+{
+  // Regularization term, with 1 / n of the full regularization for each point.
+  arma::mat regularization;
+  regularization = lambda * parameters.tail_cols(parameters.n_elem - 1) *
+      (double(batchSize) / predictors.n_cols);
+
+  const arma::rowvec sigmoids = (1 / (1 + arma::exp(-parameters(0, 0)
+      - parameters.tail_cols(parameters.n_elem - 1) *
+      predictors.cols(begin, begin + batchSize - 1))));
+  const arma::rowvec errors = sigmoids -
+      responses.subvec(begin, begin + batchSize - 1);
+
+  gradient.set_size(arma::size(parameters));
+  gradient[0] = arma::accu(errors);
+  gradient.tail_cols(parameters.n_elem - 1) = errors *
+      predictors.cols(begin, begin + batchSize - 1).t() + regularization;
+}
+
 /**
  * Evaluate the partial gradient of the logistic regression objective
  * function with respect to the individual features in the parameter.
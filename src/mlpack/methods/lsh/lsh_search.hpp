@@ -281,9 +281,34 @@ class LSHSearch
   //! Get the bucket size of the second hash.
   size_t BucketSize() const { return bucketSize; }
 
-  //! Get the second hash table.
-  const std::vector<arma::Col<size_t>>& SecondHashTable() const
-      { return secondHashTable; }
+  /**
+   * Get the offsets of each bucket of the second hash table.  The points in
+   * bucket i are held in BucketContents()[BucketOffsets()[i]] through
+   * BucketContents()[BucketOffsets()[i + 1] - 1].
+   */
+  const arma::Col<size_t>& BucketOffsets() const { return bucketOffsets; }
+
+  //! Get the points in each bucket of the second hash table, stored
+  //! contiguously (see BucketOffsets()).
+  const arma::Col<size_t>& BucketContents() const { return bucketContents; }
+
+  /**
+   * Get the second hash table, with one vector for each non-empty bucket.  This
+   * is built from BucketOffsets() and BucketContents(), so it is a copy.
+   */
+  mlpack_deprecated std::vector<arma::Col<size_t>> SecondHashTable() const
+  {
+    if (bucketOffsets.n_elem == 0)
+      return std::vector<arma::Col<size_t>>();
+
+    std::vector<arma::Col<size_t>> table(bucketOffsets.n_elem - 1);
+    for (size_t i = 0; i < table.size(); ++i)
+    {
+      table[i] = bucketContents.subvec(bucketOffsets[i],
+          bucketOffsets[i + 1] - 1);
+    }
+    return table;
+  }
 
   //! Get the projection tables.
   const arma::cube& Projections() { return projections; }
@@ -311,12 +336,16 @@ class LSHSearch
    *    0, all tables are searched.
    * @param T The number of additional probing bins for multiprobe LSH. If 0,
    *    single-probe is used.
+   * @param candidateMarks Bitset with one entry per reference point, used to
+   *    skip duplicate candidates.  It must be all false on input, and will be
+   *    all false on output; each thread should have its own.
    */
   template<typename VecType>
   void ReturnIndicesFromTable(const VecType& queryPoint,
                               arma::uvec& referenceIndices,
                               size_t numTablesToSearch,
-                              const size_t T) const;
+                              const size_t T,
+                              std::vector<bool>& candidateMarks) const;
 
   /**
    * This is a helper function that computes the distance of the query to the
@@ -443,16 +472,17 @@ class LSHSearch
   //! The bucket size of the second hash.
   size_t bucketSize;
 
-  //! The final hash table; should be (< secondHashSize) vectors each with
-  //! (<= bucketSize) elements.
-  std::vector<arma::Col<size_t>> secondHashTable;
+  //! The final hash table is stored in compressed form: bucket i (of
+  //! < secondHashSize non-empty buckets) holds the (<= bucketSize) points
+  //! bucketContents[bucketOffsets[i]] to bucketContents[bucketOffsets[i + 1] -
+  //! 1].  The length of bucketOffsets is the number of buckets plus one.
+  arma::Col<size_t> bucketOffsets;
 
-  //! The number of elements present in each hash bucket; should be
-  //! secondHashSize.
-  arma::Col<size_t> bucketContentSize;
+  //! The points in each bucket of the second hash table, stored contiguously.
+  arma::Col<size_t> bucketContents;
 
-  //! For a particular hash value, points to the row in secondHashTable
-  //! corresponding to this value. Length secondHashSize.
+  //! For a particular hash value, points to the bucket in the second hash
+  //! table corresponding to this value. Length secondHashSize.
   arma::Col<size_t> bucketRowInHashTable;
 
   //! The number of distance evaluations.
@@ -479,7 +509,7 @@ class LSHSearch
 
 //! Set the serialization version of the LSHSearch class.
 BOOST_TEMPLATE_CLASS_VERSION(template<typename SortPolicy>,
-    mlpack::neighbor::LSHSearch<SortPolicy>, 1);
+    mlpack::neighbor::LSHSearch<SortPolicy>, 2);
 
 // Include implementation.
 #include "lsh_search_impl.hpp"
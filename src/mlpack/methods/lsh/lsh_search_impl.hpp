@@ -90,8 +90,8 @@ LSHSearch<SortPolicy>::LSHSearch(const LSHSearch& other) :
     secondHashSize(other.secondHashSize),
     secondHashWeights(other.secondHashWeights),
     bucketSize(other.bucketSize),
-    secondHashTable(other.secondHashTable),
-    bucketContentSize(other.bucketContentSize),
+    bucketOffsets(other.bucketOffsets),
+    bucketContents(other.bucketContents),
     bucketRowInHashTable(other.bucketRowInHashTable),
     distanceEvaluations(other.distanceEvaluations)
 {
@@ -111,8 +111,8 @@ LSHSearch<SortPolicy>::LSHSearch(LSHSearch&& other) :
     secondHashSize(other.secondHashSize),
     secondHashWeights(std::move(other.secondHashWeights)),
     bucketSize(other.bucketSize),
-    secondHashTable(std::move(other.secondHashTable)),
-    bucketContentSize(std::move(other.bucketContentSize)),
+    bucketOffsets(std::move(other.bucketOffsets)),
+    bucketContents(std::move(other.bucketContents)),
     bucketRowInHashTable(std::move(other.bucketRowInHashTable)),
     distanceEvaluations(other.distanceEvaluations)
 {
@@ -144,8 +144,8 @@ LSHSearch<SortPolicy>& LSHSearch<SortPolicy>::operator=(const LSHSearch& other)
   secondHashSize = other.secondHashSize;
   secondHashWeights = other.secondHashWeights;
   bucketSize = other.bucketSize;
-  secondHashTable = other.secondHashTable;
-  bucketContentSize = other.bucketContentSize;
+  bucketOffsets = other.bucketOffsets;
+  bucketContents = other.bucketContents;
   bucketRowInHashTable = other.bucketRowInHashTable;
   distanceEvaluations = other.distanceEvaluations;
 
@@ -169,8 +169,8 @@ LSHSearch<SortPolicy>& LSHSearch<SortPolicy>::operator=(LSHSearch&& other)
   secondHashSize = other.secondHashSize;
   secondHashWeights = std::move(other.secondHashWeights);
   bucketSize = other.bucketSize;
-  secondHashTable = std::move(other.secondHashTable);
-  bucketContentSize = std::move(other.bucketContentSize);
+  bucketOffsets = std::move(other.bucketOffsets);
+  bucketContents = std::move(other.bucketContents);
   bucketRowInHashTable = std::move(other.bucketRowInHashTable);
   distanceEvaluations = other.distanceEvaluations;
 
@@ -286,7 +286,9 @@ void LSHSearch<SortPolicy>::Train(const arma::mat& referenceSet,
   // size_t, otherwise negative numbers are cast to 0.
   arma::Mat<size_t> secondHashVectors(numTables, referenceSet.n_cols);
 
-  for (size_t i = 0; i < numTables; i++)
+  // The tables are independent, so they can be hashed in parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) numTables; i++)
   {
     // Step IV: create the 'numProj'-dimensional key for each point in each
     // table.
@@ -299,10 +301,8 @@ void LSHSearch<SortPolicy>::Train(const arma::mat& referenceSet,
     // and the corresponding offset be 'offset_i'.  Then the key of a single
     // point is obtained as:
     // key = { floor((<proj_i, point> + offset_i) / 'hashWidth') forall i }
-    arma::mat offsetMat = arma::repmat(offsets.unsafe_col(i), 1,
-                                       referenceSet.n_cols);
     arma::mat hashMat = projections.slice(i).t() * (referenceSet);
-    hashMat += offsetMat;
+    hashMat.each_col() += offsets.unsafe_col(i);
     hashMat /= hashWidth;
 
     // Step V: Putting the points in the 'secondHashTable' by hashing the key.
@@ -326,8 +326,8 @@ void LSHSearch<SortPolicy>::Train(const arma::mat& referenceSet,
     }
   }
 
-  // Now, using the hash vectors for each table, count the number of rows we
-  // have in the second hash table.
+  // Now, using the hash vectors for each table, count the number of points in
+  // each bucket of the second hash table.
   arma::Row<size_t> secondHashBinCounts(secondHashSize, arma::fill::zeros);
   for (size_t i = 0; i < secondHashVectors.n_elem; ++i)
     secondHashBinCounts[secondHashVectors[i]]++;
@@ -337,39 +337,40 @@ void LSHSearch<SortPolicy>::Train(const arma::mat& referenceSet,
   secondHashBinCounts.transform([effectiveBucketSize](size_t val)
       { return std::min(val, effectiveBucketSize); });
 
+  // Assign each non-empty bucket a row, in the order that the buckets are first
+  // seen, and compute where each row starts in the flat list of contents.
   const size_t numRowsInTable = arma::accu(secondHashBinCounts > 0);
-  bucketContentSize.zeros(numRowsInTable);
-  secondHashTable.resize(numRowsInTable);
-
-  // Next we must assign each point in each table to the right second hash
-  // table.
+  bucketOffsets.set_size(numRowsInTable + 1);
+  bucketOffsets[0] = 0;
   size_t currentRow = 0;
   for (size_t i = 0; i < numTables; ++i)
   {
-    // Insert the point in the corresponding row to its bucket in the
-    // 'secondHashTable'.
-    for (size_t j = 0; j < secondHashVectors.n_cols; j++)
+    for (size_t j = 0; j < secondHashVectors.n_cols; ++j)
     {
-      // This is the bucket number.
-      size_t hashInd = (size_t) secondHashVectors(i, j);
-      // The point ID is 'j'.
-
-      // If this is currently an empty bucket, start a new row keep track of
-      // which row corresponds to the bucket.
-      const size_t maxSize = secondHashBinCounts[hashInd];
+      const size_t hashInd = secondHashVectors(i, j);
       if (bucketRowInHashTable[hashInd] == secondHashSize)
       {
         bucketRowInHashTable[hashInd] = currentRow;
-        secondHashTable[currentRow].set_size(maxSize);
+        bucketOffsets[currentRow + 1] = bucketOffsets[currentRow] +
+            secondHashBinCounts[hashInd];
         currentRow++;
       }
+    }
+  }
 
-      // If this vector in the hash table is not full, add the point.
-      const size_t index = bucketRowInHashTable[hashInd];
-      if (bucketContentSize[index] < maxSize)
-        secondHashTable[index](bucketContentSize[index]++) = j;
-    } // Loop over all points in the reference set.
-  } // Loop over tables.
+  // Next we must put each point in each table into its bucket, until the
+  // bucket is full.  bucketFill holds the next free position of each bucket.
+  bucketContents.set_size(bucketOffsets[numRowsInTable]);
+  arma::Col<size_t> bucketFill(bucketOffsets.head(numRowsInTable));
+  for (size_t i = 0; i < numTables; ++i)
+  {
+    for (size_t j = 0; j < secondHashVectors.n_cols; ++j)
+    {
+      const size_t row = bucketRowInHashTable[secondHashVectors(i, j)];
+      if (bucketFill[row] < bucketOffsets[row + 1])
+        bucketContents[bucketFill[row]++] = j;
+    }
+  }
 
   Log::Info << "Final hash table size: " << numRowsInTable << " rows, with a "
             << "maximum length of " << arma::max(secondHashBinCounts) << ", "
@@ -395,23 +396,34 @@ void LSHSearch<SortPolicy>::BaseCase(const size_t queryIndex,
   std::vector<Candidate> vect(k, def);
   CandidateList pqueue(CandidateCmp(), std::move(vect));
 
-  for (size_t j = 0; j < referenceIndices.n_elem; ++j)
+  // Compute the distances to the candidates a block at a time, so that the
+  // candidates are packed contiguously and the distance computation can be
+  // vectorized.
+  const size_t blockSize = 64;
+  arma::rowvec blockDistances;
+  for (size_t start = 0; start < referenceIndices.n_elem; start += blockSize)
   {
-    const size_t referenceIndex = referenceIndices[j];
-    // If the points are the same, skip this point.
-    if (queryIndex == referenceIndex)
-      continue;
-
-    const double distance = metric::EuclideanDistance::Evaluate(
-        referenceSet->unsafe_col(queryIndex),
-        referenceSet->unsafe_col(referenceIndex));
-
-    Candidate c = std::make_pair(distance, referenceIndex);
-    // If this distance is better than the worst candidate, let's insert it.
-    if (CandidateCmp()(c, pqueue.top()))
+    const size_t end = std::min(start + blockSize,
+        (size_t) referenceIndices.n_elem);
+    const arma::mat candidates = referenceSet->cols(
+        referenceIndices.subvec(start, end - 1));
+    blockDistances = arma::sqrt(arma::sum(arma::square(
+        candidates.each_col() - referenceSet->unsafe_col(queryIndex)), 0));
+
+    for (size_t j = start; j < end; ++j)
     {
-      pqueue.pop();
-      pqueue.push(c);
+      const size_t referenceIndex = referenceIndices[j];
+      // If the points are the same, skip this point.
+      if (queryIndex == referenceIndex)
+        continue;
+
+      Candidate c = std::make_pair(blockDistances[j - start], referenceIndex);
+      // If this distance is better than the worst candidate, let's insert it.
+      if (CandidateCmp()(c, pqueue.top()))
+      {
+        pqueue.pop();
+        pqueue.push(c);
+      }
     }
   }
 
@@ -441,19 +453,30 @@ void LSHSearch<SortPolicy>::BaseCase(const size_t queryIndex,
   std::vector<Candidate> vect(k, def);
   CandidateList pqueue(CandidateCmp(), std::move(vect));
 
-  for (size_t j = 0; j < referenceIndices.n_elem; ++j)
+  // Compute the distances to the candidates a block at a time, so that the
+  // candidates are packed contiguously and the distance computation can be
+  // vectorized.
+  const size_t blockSize = 64;
+  arma::rowvec blockDistances;
+  for (size_t start = 0; start < referenceIndices.n_elem; start += blockSize)
   {
-    const size_t referenceIndex = referenceIndices[j];
-    const double distance = metric::EuclideanDistance::Evaluate(
-        querySet.unsafe_col(queryIndex),
-        referenceSet->unsafe_col(referenceIndex));
-
-    Candidate c = std::make_pair(distance, referenceIndex);
-    // If this distance is better than the worst candidate, let's insert it.
-    if (CandidateCmp()(c, pqueue.top()))
+    const size_t end = std::min(start + blockSize,
+        (size_t) referenceIndices.n_elem);
+    const arma::mat candidates = referenceSet->cols(
+        referenceIndices.subvec(start, end - 1));
+    blockDistances = arma::sqrt(arma::sum(arma::square(
+        candidates.each_col() - querySet.unsafe_col(queryIndex)), 0));
+
+    for (size_t j = start; j < end; ++j)
     {
-      pqueue.pop();
-      pqueue.push(c);
+      Candidate c = std::make_pair(blockDistances[j - start],
+          (size_t) referenceIndices[j]);
+      // If this distance is better than the worst candidate, let's insert it.
+      if (CandidateCmp()(c, pqueue.top()))
+      {
+        pqueue.pop();
+        pqueue.push(c);
+      }
     }
   }
 
@@ -732,7 +755,8 @@ void LSHSearch<SortPolicy>::ReturnIndicesFromTable(
     const VecType& queryPoint,
     arma::uvec& referenceIndices,
     size_t numTablesToSearch,
-    const size_t T) const
+    const size_t T,
+    std::vector<bool>& candidateMarks) const
 {
   // Decide on the number of tables to look into.
   if (numTablesToSearch == 0) // If no user input is given, search all.
@@ -801,81 +825,43 @@ void LSHSearch<SortPolicy>::ReturnIndicesFromTable(
       const size_t hashInd = hashMat(p, i); // find query's bucket
       const size_t tableRow = bucketRowInHashTable[hashInd];
       if (tableRow < secondHashSize)
-        maxNumPoints += bucketContentSize[tableRow]; // count bucket contents
+        maxNumPoints += bucketOffsets[tableRow + 1] - bucketOffsets[tableRow];
     }
   }
 
-  // There are two ways to proceed here:
-  // Either allocate a maxNumPoints-size vector, place all candidates, and run
-  // unique on the vector to discard duplicates.
-  // Or allocate a referenceSet->n_cols size vector (i.e. number of reference
-  // points) of zeros, and mark found indices as 1.
-  // Option 1 runs faster for small maxNumPoints but worse for larger values, so
-  // we choose based on a heuristic.
-  const float cutoff = 0.1;
-  const float selectivity = static_cast<float>(maxNumPoints) /
-      static_cast<float>(referenceSet->n_cols);
-
-  if (selectivity > cutoff)
+  // Allocate space for the query's potential neighbors, and collect each
+  // candidate the first time it is seen.  candidateMarks holds the candidates
+  // we have already seen, so duplicates can be skipped without sorting.
+  referenceIndices.set_size(maxNumPoints);
+  size_t numCandidates = 0;
+  for (size_t i = 0; i < numTablesToSearch; ++i) // For all tables.
   {
-    // Heuristic: larger maxNumPoints means we should use find() because it
-    // should be faster.
-    // Reference points hashed in the same bucket as the query are set to >0.
-    arma::Col<size_t> refPointsConsidered;
-    refPointsConsidered.zeros(referenceSet->n_cols);
-
-    for (size_t i = 0; i < numTablesToSearch; ++i) // for all tables
+    for (size_t p = 0; p < T + 1; ++p) // For entire probing sequence.
     {
-      for (size_t p = 0; p < T + 1; ++p) // For entire probing sequence.
-      {
-        // get the sequence code
-        size_t hashInd = hashMat(p, i);
-        size_t tableRow = bucketRowInHashTable[hashInd];
+      const size_t hashInd = hashMat(p, i); // Find the query's bucket.
+      const size_t tableRow = bucketRowInHashTable[hashInd];
+      if (tableRow >= secondHashSize)
+        continue;
 
-        if (tableRow < secondHashSize && bucketContentSize[tableRow] > 0)
+      for (size_t j = bucketOffsets[tableRow]; j < bucketOffsets[tableRow + 1];
+          ++j)
+      {
+        const size_t index = bucketContents[j];
+        if (!candidateMarks[index])
         {
-          // Pick the indices in the bucket corresponding to hashInd.
-          for (size_t j = 0; j < bucketContentSize[tableRow]; ++j)
-            refPointsConsidered[ secondHashTable[tableRow](j) ]++;
+          candidateMarks[index] = true;
+          referenceIndices[numCandidates++] = index;
         }
       }
     }
-
-    // Only keep reference points found in at least one bucket.
-    referenceIndices = arma::find(refPointsConsidered > 0);
-    return;
   }
-  else
-  {
-    // Heuristic: smaller maxNumPoints means we should use unique() because it
-    // should be faster.
-    // Allocate space for the query's potential neighbors.
-    arma::uvec refPointsConsideredSmall;
-    refPointsConsideredSmall.zeros(maxNumPoints);
 
-    // Retrieve candidates.
-    size_t start = 0;
+  // Reset only the marks that we set, so the bitset can be reused for the next
+  // query without clearing all of it.
+  for (size_t i = 0; i < numCandidates; ++i)
+    candidateMarks[referenceIndices[i]] = false;
 
-    for (size_t i = 0; i < numTablesToSearch; ++i) // For all tables
-    {
-      for (size_t p = 0; p < T + 1; ++p)
-      {
-        const size_t hashInd =  hashMat(p, i); // Find the query's bucket.
-        const size_t tableRow = bucketRowInHashTable[hashInd];
-
-        if (tableRow < secondHashSize)
-        {
-          // Store all secondHashTable points in the candidates set.
-          for (size_t j = 0; j < bucketContentSize[tableRow]; ++j)
-            refPointsConsideredSmall(start++) = secondHashTable[tableRow](j);
-       }
-      }
-    }
-
-    // Keep only one copy of each candidate.
-    referenceIndices = arma::unique(refPointsConsideredSmall);
-    return;
-  }
+  referenceIndices.resize(numCandidates);
 }
 
 // Search for nearest neighbors in a given query set.
@@ -935,28 +921,31 @@ void LSHSearch<SortPolicy>::Search(const arma::mat& querySet,
   Timer::Start("computing_neighbors");
 
   // Parallelization to process more than one query at a time.
-  #pragma omp parallel for \
+  #pragma omp parallel \
       shared(resultingNeighbors, distances) \
-      schedule(dynamic)\
       reduction(+:avgIndicesReturned)
-  for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
   {
-    // Go through every query point.
-    // Hash every query into every hash table and eventually into the
-    // 'secondHashTable' to obtain the neighbor candidates.
+    // Each thread needs its own bitset to deduplicate candidates with.
+    std::vector<bool> candidateMarks(referenceSet->n_cols, false);
     arma::uvec refIndices;
-    ReturnIndicesFromTable(querySet.col(i), refIndices, numTablesToSearch,
-        Teffective);
-
-    // An informative book-keeping for the number of neighbor candidates
-    // returned on average.
-    // Make atomic to avoid race conditions when multiple threads are running
-    // #pragma omp atomic
-    avgIndicesReturned = avgIndicesReturned + refIndices.n_elem;
-
-    // Sequentially go through all the candidates and save the best 'k'
-    // candidates.
-    BaseCase(i, refIndices, k, querySet, resultingNeighbors, distances);
+
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+    {
+      // Go through every query point.
+      // Hash every query into every hash table and eventually into the
+      // 'secondHashTable' to obtain the neighbor candidates.
+      ReturnIndicesFromTable(querySet.col(i), refIndices, numTablesToSearch,
+          Teffective, candidateMarks);
+
+      // An informative book-keeping for the number of neighbor candidates
+      // returned on average.
+      avgIndicesReturned = avgIndicesReturned + refIndices.n_elem;
+
+      // Sequentially go through all the candidates and save the best 'k'
+      // candidates.
+      BaseCase(i, refIndices, k, querySet, resultingNeighbors, distances);
+    }
   }
 
   Timer::Stop("computing_neighbors");
@@ -1001,28 +990,31 @@ Search(const size_t k,
   Timer::Start("computing_neighbors");
 
   // Parallelization to process more than one query at a time.
-  #pragma omp parallel for \
+  #pragma omp parallel \
       shared(resultingNeighbors, distances) \
-      schedule(dynamic)\
       reduction(+:avgIndicesReturned)
-  for (omp_size_t i = 0; i < (omp_size_t) referenceSet->n_cols; ++i)
   {
-    // Go through every query point.
-    // Hash every query into every hash table and eventually into the
-    // 'secondHashTable' to obtain the neighbor candidates.
+    // Each thread needs its own bitset to deduplicate candidates with.
+    std::vector<bool> candidateMarks(referenceSet->n_cols, false);
     arma::uvec refIndices;
-    ReturnIndicesFromTable(referenceSet->col(i), refIndices, numTablesToSearch,
-        Teffective);
-
-    // An informative book-keeping for the number of neighbor candidates
-    // returned on average.
-    // Make atomic to avoid race conditions when multiple threads are running.
-    // #pragma omp atomic
-    avgIndicesReturned += refIndices.n_elem;
-
-    // Sequentially go through all the candidates and save the best 'k'
-    // candidates.
-    BaseCase(i, refIndices, k, resultingNeighbors, distances);
+
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) referenceSet->n_cols; ++i)
+    {
+      // Go through every query point.
+      // Hash every query into every hash table and eventually into the
+      // 'secondHashTable' to obtain the neighbor candidates.
+      ReturnIndicesFromTable(referenceSet->col(i), refIndices,
+          numTablesToSearch, Teffective, candidateMarks);
+
+      // An informative book-keeping for the number of neighbor candidates
+      // returned on average.
+      avgIndicesReturned += refIndices.n_elem;
+
+      // Sequentially go through all the candidates and save the best 'k'
+      // candidates.
+      BaseCase(i, refIndices, k, resultingNeighbors, distances);
+    }
   }
 
   Timer::Stop("computing_neighbors");
@@ -1106,78 +1098,98 @@ void LSHSearch<SortPolicy>::Serialize(Archive& ar,
   ar & CreateNVP(bucketSize, "bucketSize");
   // needs specific handling for new version
 
-  // Backward compatibility: in older versions of LSHSearch, the secondHashTable
-  // was stored as an arma::Mat<size_t>.  So we need to properly load that, then
-  // prune it down to size.
-  if (version == 0)
+  // Backward compatibility: older versions of LSHSearch stored the second hash
+  // table as a list of vectors, instead of in compressed form.  These can only
+  // be loaded, since we always save the current version.
+  if (version < 2)
   {
-    arma::Mat<size_t> tmpSecondHashTable;
-    ar & CreateNVP(tmpSecondHashTable, "secondHashTable");
+    std::vector<arma::Col<size_t>> secondHashTable;
+    arma::Col<size_t> bucketContentSize;
 
-    // The old secondHashTable was stored in row-major format, so we transpose
-    // it.
-    tmpSecondHashTable = tmpSecondHashTable.t();
-
-    secondHashTable.resize(tmpSecondHashTable.n_cols);
-    for (size_t i = 0; i < tmpSecondHashTable.n_cols; ++i)
+    // Backward compatibility: in older versions of LSHSearch, the
+    // secondHashTable was stored as an arma::Mat<size_t>.  So we need to
+    // properly load that, then prune it down to size.
+    if (version == 0)
     {
-      // Find length of each column.  We know we are at the end of the list when
-      // the value referenceSet->n_cols is seen.
+      arma::Mat<size_t> tmpSecondHashTable;
+      ar & CreateNVP(tmpSecondHashTable, "secondHashTable");
 
-      size_t len = 0;
-      for (; len < tmpSecondHashTable.n_rows; ++len)
-        if (tmpSecondHashTable(len, i) == referenceSet->n_cols)
-          break;
+      // The old secondHashTable was stored in row-major format, so we
+      // transpose it.
+      tmpSecondHashTable = tmpSecondHashTable.t();
 
-      // Set the size of the new column correctly.
-      secondHashTable[i].set_size(len);
-      for (size_t j = 0; j < len; ++j)
-        secondHashTable[i](j) = tmpSecondHashTable(j, i);
+      secondHashTable.resize(tmpSecondHashTable.n_cols);
+      for (size_t i = 0; i < tmpSecondHashTable.n_cols; ++i)
+      {
+        // Find length of each column.  We know we are at the end of the list
+        // when the value referenceSet->n_cols is seen.
+
+        size_t len = 0;
+        for (; len < tmpSecondHashTable.n_rows; ++len)
+          if (tmpSecondHashTable(len, i) == referenceSet->n_cols)
+            break;
+
+        // Set the size of the new column correctly.
+        secondHashTable[i].set_size(len);
+        for (size_t j = 0; j < len; ++j)
+          secondHashTable[i](j) = tmpSecondHashTable(j, i);
+      }
     }
-  }
-  else
-  {
-    size_t tables;
-    if (Archive::is_saving::value)
-      tables = secondHashTable.size();
-    ar & CreateNVP(tables, "numSecondHashTables");
-
-    // Set size of second hash table if needed.
-    if (Archive::is_loading::value)
+    else
     {
-      secondHashTable.clear();
+      size_t tables;
+      ar & CreateNVP(tables, "numSecondHashTables");
+
       secondHashTable.resize(tables);
+      for (size_t i = 0; i < secondHashTable.size(); ++i)
+      {
+        std::ostringstream oss;
+        oss << "secondHashTable" << i;
+        ar & CreateNVP(secondHashTable[i], oss.str());
+      }
     }
 
-    for (size_t i = 0; i < secondHashTable.size(); ++i)
+    // Backward compatibility: old versions of LSHSearch held bucketContentSize
+    // for all possible buckets (of size secondHashSize), but version 1 held a
+    // compressed representation.
+    if (version == 0)
     {
-      std::ostringstream oss;
-      oss << "secondHashTable" << i;
-      ar & CreateNVP(secondHashTable[i], oss.str());
+      // The vector was stored in the old uncompressed form.  So we need to
+      // shrink it.  But we can't do that until we have bucketRowInHashTable,
+      // so we also have to load that.
+      arma::Col<size_t> tmpBucketContentSize;
+      ar & CreateNVP(tmpBucketContentSize, "bucketContentSize");
+      ar & CreateNVP(bucketRowInHashTable, "bucketRowInHashTable");
+
+      // Compress into a smaller vector by just dropping all of the zeros.
+      bucketContentSize.zeros(secondHashTable.size());
+      for (size_t i = 0; i < tmpBucketContentSize.n_elem; ++i)
+        if (tmpBucketContentSize[i] > 0)
+          bucketContentSize[bucketRowInHashTable[i]] = tmpBucketContentSize[i];
+    }
+    else
+    {
+      ar & CreateNVP(bucketContentSize, "bucketContentSize");
+      ar & CreateNVP(bucketRowInHashTable, "bucketRowInHashTable");
     }
-  }
 
-  // Backward compatibility: old versions of LSHSearch held bucketContentSize
-  // for all possible buckets (of size secondHashSize), but now we hold a
-  // compressed representation.
-  if (version == 0)
-  {
-    // The vector was stored in the old uncompressed form.  So we need to shrink
-    // it.  But we can't do that until we have bucketRowInHashTable, so we also
-    // have to load that.
-    arma::Col<size_t> tmpBucketContentSize;
-    ar & CreateNVP(tmpBucketContentSize, "bucketContentSize");
-    ar & CreateNVP(bucketRowInHashTable, "bucketRowInHashTable");
+    // Now flatten the buckets into the compressed form.
+    bucketOffsets.set_size(secondHashTable.size() + 1);
+    bucketOffsets[0] = 0;
+    for (size_t i = 0; i < secondHashTable.size(); ++i)
+      bucketOffsets[i + 1] = bucketOffsets[i] + bucketContentSize[i];
 
-    // Compress into a smaller vector by just dropping all of the zeros.
-    bucketContentSize.set_size(secondHashTable.size());
-    for (size_t i = 0; i < tmpBucketContentSize.n_elem; ++i)
-      if (tmpBucketContentSize[i] > 0)
-        bucketContentSize[bucketRowInHashTable[i]] = tmpBucketContentSize[i];
+    bucketContents.set_size(bucketOffsets[secondHashTable.size()]);
+    for (size_t i = 0; i < secondHashTable.size(); ++i)
+    {
+      for (size_t j = 0; j < bucketContentSize[i]; ++j)
+        bucketContents[bucketOffsets[i] + j] = secondHashTable[i][j];
+    }
   }
   else
   {
-    ar & CreateNVP(bucketContentSize, "bucketContentSize");
+    ar & CreateNVP(bucketOffsets, "bucketOffsets");
+    ar & CreateNVP(bucketContents, "bucketContents");
     ar & CreateNVP(bucketRowInHashTable, "bucketRowInHashTable");
   }
 
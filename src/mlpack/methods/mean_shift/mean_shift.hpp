@@ -17,6 +17,7 @@
 #include <mlpack/core/kernels/gaussian_kernel.hpp>
 #include <mlpack/core/kernels/kernel_traits.hpp>
 #include <mlpack/core/metrics/lmetric.hpp>
+#include <mlpack/core/tree/binary_space_tree.hpp>
 #include <boost/utility.hpp>
 
 namespace mlpack {
@@ -27,6 +28,10 @@ namespace meanshift /** Mean shift clustering. */ {
  * apply mean shift algorithm until maximum iterations or convergence.  Then
  * remove duplicate centroids.
  *
+ * The seeds are shifted in parallel (if OpenMP is available); each thread
+ * shifts one seed at a time until it converges, finding the neighbors of the
+ * seed in a kd-tree built once on the dataset and shared by all threads.
+ *
  * A simple example of how to run mean shift clustering is shown below.
  *
  * @code
@@ -65,7 +70,11 @@ class MeanShift
             const KernelType kernel = KernelType());
 
   /**
-   * Give an estimation of radius based on given dataset.
+   * Give an estimation of radius based on given dataset.  This is the average
+   * distance from each point to its (ratio * n)-th nearest neighbor.  If the
+   * dataset has more than 5000 points, the estimate is computed on a random
+   * sample of 5000 points instead, since otherwise the number of neighbors
+   * to find grows quadratically with the size of the dataset.
    *
    * @param data Dataset for estimation.
    * @param ratio Percentage of dataset to use for nearest neighbor search.
@@ -120,6 +129,26 @@ class MeanShift
                 const int minFreq,
                 MatType& seeds);
 
+  //! The tree type used to find the neighbors of each centroid.
+  typedef tree::KDTree<metric::EuclideanDistance, tree::EmptyStatistic, MatType>
+      Tree;
+
+  /**
+   * Find all points in the given tree within the radius of the centroid, and
+   * their distances to it.  The results are appended to neighbors and
+   * distances.  This does not modify the tree, so many threads can search
+   * the same tree at once.
+   *
+   * @param node Node of the tree to search.
+   * @param centroid Centroid to find the neighbors of.
+   * @param neighbors Indices of the neighbors in the tree's dataset.
+   * @param distances Distances of the neighbors to the centroid.
+   */
+  void FindNeighbors(const Tree& node,
+                     const arma::colvec& centroid,
+                     std::vector<size_t>& neighbors,
+                     std::vector<double>& distances) const;
+
   /**
    * Use kernel to calculate new centroid given dataset and valid neighbors.
    *
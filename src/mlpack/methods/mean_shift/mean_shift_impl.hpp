@@ -16,7 +16,6 @@
 #include <mlpack/core/kernels/kernel_traits.hpp>
 #include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
-#include <mlpack/methods/range_search/range_search.hpp>
 
 #include "map"
 
@@ -52,6 +51,18 @@ template<bool UseKernel, typename KernelType, typename MatType>
 double MeanShift<UseKernel, KernelType, MatType>::
 EstimateRadius(const MatType& data, double ratio)
 {
+  // For large datasets, estimate the radius on a random sample instead.  The
+  // distance to the (ratio * m)-th neighbor in a sample of m points estimates
+  // the distance to the (ratio * n)-th neighbor in the whole dataset.
+  const size_t maxSampleSize = 5000;
+  if (data.n_cols > maxSampleSize)
+  {
+    const arma::uvec order = arma::shuffle(arma::linspace<arma::uvec>(0,
+        data.n_cols - 1, data.n_cols));
+    const MatType sample = data.cols(order.head(maxSampleSize));
+    return EstimateRadius(sample, ratio);
+  }
+
   neighbor::KNN neighborSearch(data);
 
   /**
@@ -129,6 +140,39 @@ void MeanShift<UseKernel, KernelType, MatType>::GenSeeds(
   seeds *= binSize;
 }
 
+// Find the neighbors of a centroid in the tree.
+template<bool UseKernel, typename KernelType, typename MatType>
+void MeanShift<UseKernel, KernelType, MatType>::FindNeighbors(
+    const Tree& node,
+    const arma::colvec& centroid,
+    std::vector<size_t>& neighbors,
+    std::vector<double>& distances) const
+{
+  // Prune nodes which have no points within the radius.
+  if (node.MinDistance(centroid) > radius)
+    return;
+
+  if (node.IsLeaf())
+  {
+    for (size_t i = 0; i < node.NumPoints(); ++i)
+    {
+      const size_t point = node.Point(i);
+      const double distance = metric::EuclideanDistance::Evaluate(
+          node.Dataset().unsafe_col(point), centroid);
+      if (distance <= radius)
+      {
+        neighbors.push_back(point);
+        distances.push_back(distance);
+      }
+    }
+
+    return;
+  }
+
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+    FindNeighbors(node.Child(i), centroid, neighbors, distances);
+}
+
 // Calculate new centroid with given kernel.
 template<bool UseKernel, typename KernelType, typename MatType>
 template<bool ApplyKernel>
@@ -139,24 +183,22 @@ CalculateCentroid(const MatType& data,
                   const std::vector<double>& distances,
                   arma::colvec& centroid)
 {
-  double sumWeight = 0;
+  // Points at the centroid itself get no weight.
+  arma::vec weights(neighbors.size());
   for (size_t i = 0; i < neighbors.size(); ++i)
   {
-    if (distances[i] > 0)
-    {
-      double dist = distances[i] / radius;
-      double weight = kernel.Gradient(dist) / dist;
-      sumWeight += weight;
-      centroid += weight * data.unsafe_col(neighbors[i]);
-    }
+    const double dist = distances[i] / radius;
+    weights[i] = (distances[i] > 0) ? kernel.Gradient(dist) / dist : 0.0;
   }
 
-  if (sumWeight != 0)
-  {
-    centroid /= sumWeight;
-    return true;
-  }
-  return false;
+  const double sumWeight = arma::accu(weights);
+  if (sumWeight == 0)
+    return false;
+
+  // The new centroid is the weighted mean of the neighbors.
+  centroid = data.cols(arma::conv_to<arma::uvec>::from(neighbors)) * weights /
+      sumWeight;
+  return true;
 }
 
 // Calculate new centroid by mean.
@@ -169,10 +211,8 @@ CalculateCentroid(const MatType& data,
                   const std::vector<double>&, /*unused*/
                   arma::colvec& centroid)
 {
-  for (size_t i = 0; i < neighbors.size(); ++i)
-    centroid += data.unsafe_col(neighbors[i]);
-
-  centroid /= neighbors.size();
+  centroid = arma::mean(data.cols(arma::conv_to<arma::uvec>::from(neighbors)),
+      1);
   return true;
 }
 
@@ -203,61 +243,79 @@ inline void MeanShift<UseKernel, KernelType, MatType>::Cluster(
 
   // Holds all centroids before removing duplicate ones.
   arma::mat allCentroids(pSeeds->n_rows, pSeeds->n_cols);
+  // Whether each seed converged (rather than running out of iterations or
+  // neighbors).
+  std::vector<char> converged(pSeeds->n_cols, 0);
 
   assignments.set_size(data.n_cols);
 
-  range::RangeSearch<> rangeSearcher(data);
-  math::Range validRadius(0, radius);
-  std::vector<std::vector<size_t> > neighbors;
-  std::vector<std::vector<double> > distances;
+  // Build one tree, which every thread searches.  The tree rearranges its own
+  // copy of the data, so the neighbors found are indices into that copy.
+  const Tree tree(data);
 
-  // For each seed, perform mean shift algorithm.
-  for (size_t i = 0; i < pSeeds->n_cols; ++i)
+  // For each seed, perform mean shift algorithm.  Each seed is independent of
+  // the others, so the seeds can be shifted in parallel; a seed stops using
+  // its thread as soon as it has converged.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) pSeeds->n_cols; ++i)
   {
+    std::vector<size_t> neighbors;
+    std::vector<double> distances;
+
     // Initial centroid is the seed itself.
-    allCentroids.col(i) = pSeeds->unsafe_col(i);
+    arma::colvec centroid = pSeeds->col(i);
     for (size_t completedIterations = 0; completedIterations < maxIterations;
          completedIterations++)
     {
-      // Store new centroid in this.
-      arma::colvec newCentroid = arma::zeros<arma::colvec>(pSeeds->n_rows);
-
-      rangeSearcher.Search(allCentroids.unsafe_col(i), validRadius,
-          neighbors, distances);
-      if (neighbors[0].size() <= 1)
+      neighbors.clear();
+      distances.clear();
+      FindNeighbors(tree, centroid, neighbors, distances);
+      if (neighbors.size() <= 1)
         break;
 
       // Calculate new centroid.
-      if (!CalculateCentroid(data, neighbors[0], distances[0], newCentroid))
-        newCentroid = allCentroids.unsafe_col(i);
+      arma::colvec newCentroid;
+      if (!CalculateCentroid(tree.Dataset(), neighbors, distances,
+          newCentroid))
+        newCentroid = centroid;
 
       // If the mean shift vector is small enough, it has converged.
-      if (metric::EuclideanDistance::Evaluate(newCentroid,
-          allCentroids.unsafe_col(i)) < 1e-3 * radius)
+      if (metric::EuclideanDistance::Evaluate(newCentroid, centroid) <
+          1e-3 * radius)
       {
-        // Determine if the new centroid is duplicate with old ones.
-        bool isDuplicated = false;
-        for (size_t k = 0; k < centroids.n_cols; ++k)
-        {
-          const double distance = metric::EuclideanDistance::Evaluate(
-              allCentroids.unsafe_col(i), centroids.unsafe_col(k));
-          if (distance < radius)
-          {
-            isDuplicated = true;
-            break;
-          }
-        }
-
-        if (!isDuplicated)
-          centroids.insert_cols(centroids.n_cols, allCentroids.unsafe_col(i));
-
-        // Get out of the loop.
+        converged[i] = 1;
         break;
       }
 
       // Update the centroid.
-      allCentroids.col(i) = newCentroid;
+      centroid = newCentroid;
+    }
+
+    allCentroids.col(i) = centroid;
+  }
+
+  // Remove duplicate centroids.  The seeds are visited in order, so this gives
+  // the same centroids as shifting the seeds one at a time.
+  for (size_t i = 0; i < pSeeds->n_cols; ++i)
+  {
+    if (!converged[i])
+      continue;
+
+    // Determine if the new centroid is duplicate with old ones.
+    bool isDuplicated = false;
+    for (size_t k = 0; k < centroids.n_cols; ++k)
+    {
+      const double distance = metric::EuclideanDistance::Evaluate(
+          allCentroids.unsafe_col(i), centroids.unsafe_col(k));
+      if (distance < radius)
+      {
+        isDuplicated = true;
+        break;
+      }
     }
+
+    if (!isDuplicated)
+      centroids.insert_cols(centroids.n_cols, allCentroids.unsafe_col(i));
   }
 
   // Assign centroids to each point.
@@ -125,6 +125,39 @@ void NaiveBayesClassifier<ModelMatType>::Train(
         variances.col(i) /= (probabilities[i] - 1);
     }
   }
+  else if (arma::is_arma_sparse_type<MatType>::value)
+  {
+    // For sparse data, the per-point loops below would densify every point, so
+    // instead we sum the points of each class with a product against a sparse
+    // class indicator matrix, which only touches the nonzero elements of the
+    // data.  The variances are then computed as sum(x^2) - n * mean^2.
+    probabilities.zeros();
+    arma::umat locations(2, data.n_cols);
+    for (size_t j = 0; j < data.n_cols; ++j)
+    {
+      locations(0, j) = j;
+      locations(1, j) = labels[j];
+      ++probabilities[labels[j]];
+    }
+    const arma::SpMat<ElemType> indicators(locations,
+        arma::ones<arma::Col<ElemType>>(data.n_cols), data.n_cols, numClasses);
+
+    means = data * indicators;
+    variances = arma::square(data) * indicators;
+    for (size_t i = 0; i < probabilities.n_elem; ++i)
+    {
+      if (probabilities[i] == 0.0)
+        continue;
+
+      means.col(i) /= probabilities[i];
+      variances.col(i) -= probabilities[i] * arma::square(means.col(i));
+      if (probabilities[i] > 1)
+        variances.col(i) /= (probabilities[i] - 1);
+    }
+
+    // Roundoff may make some variances slightly negative.
+    variances.elem(arma::find(variances < 0.0)).zeros();
+  }
   else
   {
     // Set all parameters to zero.
@@ -214,6 +247,26 @@ void NaiveBayesClassifier<ModelMatType>::LogLikelihood(
   // Calculate the joint log likelihood of point for each of the
   // means.n_cols.
 
+  if (arma::is_arma_sparse_type<MatType>::value)
+  {
+    // Subtracting the means would densify sparse data, so expand the square in
+    // the exponent instead:
+    //   -0.5 (x - mu)^T inv(Sigma) (x - mu) = (inv(Sigma) mu)^T x
+    //       - 0.5 inv(Sigma)^T (x % x) - 0.5 mu^T inv(Sigma) mu.
+    // The two products only touch the nonzero elements of the data.
+    const ModelMatType weightedMeans = means % invVar;
+    logLikelihoods += weightedMeans.t() * data;
+    const ModelMatType squaredTerms = invVar.t() * arma::square(data);
+    logLikelihoods -= 0.5 * squaredTerms;
+
+    const arma::Col<ElemType> constants = arma::trans(
+        -0.5 * arma::sum(means % weightedMeans, 0) -
+        0.5 * arma::sum(arma::log(variances), 0)) +
+        data.n_rows / -2.0 * log(2 * M_PI);
+    logLikelihoods.each_col() += constants;
+    return;
+  }
+
   // Loop over every class.
   for (size_t i = 0; i < means.n_cols; i++)
   {
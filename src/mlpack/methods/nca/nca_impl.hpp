@@ -39,7 +39,16 @@ void NCA<MetricType, OptimizerType>::LearnDistance(arma::mat& outputMatrix)
 
   Timer::Start("nca_sgd_optimization");
 
+  // The batch objectives may be evaluated in parallel, so they only count the
+  // points whose denominator of p_i is zero, and we warn once here.
+  errorFunction.ZeroDenominators() = 0;
   optimizer.Optimize(errorFunction, outputMatrix);
+  if (errorFunction.ZeroDenominators() > 0)
+  {
+    Log::Warn << "Denominator of p_i was 0 for "
+        << errorFunction.ZeroDenominators() << " point evaluations during "
+        << "optimization!" << std::endl;
+  }
 
   Timer::Stop("nca_sgd_optimization");
 }
@@ -78,6 +78,22 @@ class SoftmaxErrorFunction
    */
   double Evaluate(const arma::mat& covariance, const size_t i);
 
+  /**
+   * Evaluate the softmax objective function for the given covariance matrix on
+   * the points begin, ..., begin + batchSize - 1 of the dataset.  This is the
+   * sum of Evaluate(covariance, i) over the batch, but the stretched dataset is
+   * only computed once for the whole batch.  Several batches may be evaluated
+   * at once, so instead of warning, the points whose denominator of p_i is
+   * zero are added to ZeroDenominators().
+   *
+   * @param covariance Covariance matrix of Mahalanobis distance.
+   * @param begin Index of the first point in the batch.
+   * @param batchSize Number of points in the batch.
+   */
+  double Evaluate(const arma::mat& covariance,
+                  const size_t begin,
+                  const size_t batchSize);
+
   /**
    * Evaluate the gradient of the softmax function for the given covariance
    * matrix.  This is the non-separable implementation, where the objective
@@ -106,6 +122,23 @@ class SoftmaxErrorFunction
                 const size_t i,
                 GradType& gradient);
 
+  /**
+   * Evaluate the sum of the gradients of the softmax function for the given
+   * covariance matrix on the points begin, ..., begin + batchSize - 1 of the
+   * dataset.  The stretched dataset is only computed once for the whole batch.
+   * As for the batch Evaluate(), the points whose denominator of p_i is zero
+   * are added to ZeroDenominators() instead of causing a warning.
+   *
+   * @param covariance Covariance matrix of Mahalanobis distance.
+   * @param begin Index of the first point in the batch.
+   * @param gradient Matrix to store the calculated gradient in.
+   * @param batchSize Number of points in the batch.
+   */
+  void Gradient(const arma::mat& covariance,
+                const size_t begin,
+                arma::mat& gradient,
+                const size_t batchSize);
+
   /**
    * Get the initial point.
    */
@@ -117,6 +150,13 @@ class SoftmaxErrorFunction
    */
   size_t NumFunctions() const { return dataset.n_cols; }
 
+  //! Get the number of points with a zero denominator of p_i in the batch
+  //! Evaluate() and Gradient() calls.
+  size_t ZeroDenominators() const { return zeroDenominators; }
+  //! Modify the number of points with a zero denominator of p_i in the batch
+  //! Evaluate() and Gradient() calls.
+  size_t& ZeroDenominators() { return zeroDenominators; }
+
  private:
   //! The dataset.
   const arma::mat& dataset;
@@ -139,6 +179,11 @@ class SoftmaxErrorFunction
   //! False if nothing has ever been precalculated (only at construction time).
   bool precalculated;
 
+  //! The number of points with a zero denominator of p_i in the batch
+  //! Evaluate() and Gradient() calls, which don't warn because they may run
+  //! concurrently.
+  size_t zeroDenominators;
+
   /**
    * Precalculate the denominators and numerators that will make up the p_ij,
    * but only if the coordinates matrix is different than the last coordinates
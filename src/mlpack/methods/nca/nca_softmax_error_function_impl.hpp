@@ -27,7 +27,8 @@ SoftmaxErrorFunction<MetricType>::SoftmaxErrorFunction(
     dataset(dataset),
     labels(labels),
     metric(metric),
-    precalculated(false)
+    precalculated(false),
+    zeroDenominators(0)
 { /* nothing to do */ }
 
 //! The non-separable implementation, which uses Precalculate() to save time.
@@ -83,6 +84,60 @@ double SoftmaxErrorFunction<MetricType>::Evaluate(const arma::mat& coordinates,
                                      // minimizer.
 }
 
+//! The separated objective function on a batch of points.
+template<typename MetricType>
+double SoftmaxErrorFunction<MetricType>::Evaluate(const arma::mat& coordinates,
+                                                  const size_t begin,
+                                                  const size_t batchSize)
+{
+  // Stretch the dataset once for the whole batch, instead of once per point.
+  // This is a local so that batches can be evaluated concurrently.
+  const arma::mat stretched = coordinates * dataset;
+
+  double result = 0.0;
+  size_t zeros = 0;
+  for (size_t i = begin; i < begin + batchSize; ++i)
+  {
+    double denominator = 0;
+    double numerator = 0;
+    for (size_t k = 0; k < dataset.n_cols; ++k)
+    {
+      // Don't consider the case where the points are the same.
+      if (k == i)
+        continue;
+
+      // We want to evaluate exp(-D(A x_i, A x_k)).
+      double eval = std::exp(-metric.Evaluate(stretched.unsafe_col(i),
+                                              stretched.unsafe_col(k)));
+
+      // If they are in the same class, update the numerator.
+      if (labels[i] == labels[k])
+        numerator += eval;
+
+      denominator += eval;
+    }
+
+    // Batches may be evaluated concurrently, so the points with a zero
+    // denominator are only counted here.
+    if (denominator == 0.0)
+    {
+      ++zeros;
+      continue;
+    }
+
+    result -= (numerator / denominator); // Negate because the optimizer is a
+                                         // minimizer.
+  }
+
+  if (zeros > 0)
+  {
+    #pragma omp atomic
+    zeroDenominators += zeros;
+  }
+
+  return result;
+}
+
 //! The non-separable implementation, where Precalculate() is used.
 template<typename MetricType>
 void SoftmaxErrorFunction<MetricType>::Gradient(const arma::mat& coordinates,
@@ -202,6 +257,77 @@ void SoftmaxErrorFunction<MetricType>::Gradient(const arma::mat& coordinates,
   gradient = -2 * coordinates * (p * firstTerm - secondTerm);
 }
 
+//! The separable implementation on a batch of points.
+template <typename MetricType>
+void SoftmaxErrorFunction<MetricType>::Gradient(const arma::mat& coordinates,
+                                                const size_t begin,
+                                                arma::mat& gradient,
+                                                const size_t batchSize)
+{
+  // Stretch the dataset once for the whole batch, instead of once per point.
+  // This is a local so that batches can be evaluated concurrently.
+  const arma::mat stretched = coordinates * dataset;
+
+  // The sum of (p_i * firstTerm_i - secondTerm_i) over the batch; the final
+  // multiplication by -2 * A can be done once at the end.
+  arma::mat sum(dataset.n_rows, dataset.n_rows, arma::fill::zeros);
+  arma::mat firstTerm(dataset.n_rows, dataset.n_rows);
+  arma::mat secondTerm(dataset.n_rows, dataset.n_rows);
+  arma::vec x_ik(dataset.n_rows);
+
+  size_t zeros = 0;
+  for (size_t i = begin; i < begin + batchSize; ++i)
+  {
+    double numerator = 0;
+    double denominator = 0;
+    firstTerm.zeros();
+    secondTerm.zeros();
+
+    for (size_t k = 0; k < dataset.n_cols; ++k)
+    {
+      // Don't consider the case where the points are the same.
+      if (i == k)
+        continue;
+
+      // Calculate the numerator of p_ik.
+      double eval = exp(-metric.Evaluate(stretched.unsafe_col(i),
+                                         stretched.unsafe_col(k)));
+
+      // For x_ik we are not using stretched points.
+      x_ik = dataset.col(i) - dataset.col(k);
+      if (labels[i] == labels[k])
+      {
+        numerator += eval;
+        secondTerm += eval * x_ik * trans(x_ik);
+      }
+
+      denominator += eval;
+      firstTerm += eval * x_ik * trans(x_ik);
+    }
+
+    // If the denominator is zero, then all p_ik are zero and there is no
+    // gradient contribution from this point.  Batches may be evaluated
+    // concurrently, so these points are only counted here.
+    if (denominator == 0)
+    {
+      ++zeros;
+      continue;
+    }
+
+    const double p = numerator / denominator;
+    sum += (p * firstTerm - secondTerm) / denominator;
+  }
+
+  if (zeros > 0)
+  {
+    #pragma omp atomic
+    zeroDenominators += zeros;
+  }
+
+  // We negate the gradient, because our optimizer is a minimizer.
+  gradient = -2 * coordinates * sum;
+}
+
 template<typename MetricType>
 const arma::mat SoftmaxErrorFunction<MetricType>::GetInitialPoint() const
 {
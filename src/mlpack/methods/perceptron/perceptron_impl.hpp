@@ -106,14 +106,16 @@ void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Classify(
     const MatType& test,
     arma::Row<size_t>& predictedLabels)
 {
-  arma::vec tempLabelMat;
-  arma::uword maxIndex = 0;
+  // Compute the scores of all points at once; if MatType is sparse, this only
+  // touches the nonzero elements of the test data.
+  arma::mat scores = weights.t() * test;
+  scores.each_col() += biases;
 
-  // Could probably be faster if done in batch.
+  arma::uword maxIndex = 0;
+  predictedLabels.set_size(test.n_cols);
   for (size_t i = 0; i < test.n_cols; i++)
   {
-    tempLabelMat = weights.t() * test.col(i) + biases;
-    tempLabelMat.max(maxIndex);
+    scores.col(i).max(maxIndex);
     predictedLabels(0, i) = maxIndex;
   }
 }
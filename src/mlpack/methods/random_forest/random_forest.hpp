@@ -284,6 +284,20 @@ class RandomForest
              const size_t numTrees,
              const size_t minimumLeafSize);
 
+  /**
+   * Classify the given points in blocks; each block is passed through each
+   * tree as a batch, and the blocks are processed in parallel.  The averaged
+   * class probabilities are only stored if probabilities is not NULL.
+   *
+   * @param data Dataset to be classified.
+   * @param predictions Output predictions for each point in the dataset.
+   * @param probabilities Output matrix of class probabilities, or NULL.
+   */
+  template<typename MatType>
+  void ClassifyBlocks(const MatType& data,
+                      arma::Row<size_t>& predictions,
+                      arma::mat* probabilities) const;
+
   //! The trees in the forest.
   std::vector<DecisionTreeType> trees;
 };
@@ -282,10 +282,10 @@ void RandomForest<
   }
 
   probabilities.zeros(trees[0].NumClasses());
+  arma::vec treeProbs;
+  size_t treePrediction; // Ignored.
   for (size_t i = 0; i < trees.size(); ++i)
   {
-    arma::vec treeProbs;
-    size_t treePrediction; // Ignored.
     trees[i].Classify(point, treePrediction, treeProbs);
 
     probabilities += treeProbs;
@@ -326,11 +326,7 @@ void RandomForest<
         "trained!");
   }
 
-  predictions.set_size(data.n_cols);
-
-  #pragma omp parallel for
-  for (omp_size_t i = 0; i < data.n_cols; ++i)
-    predictions[i] = Classify(data.col(i));
+  ClassifyBlocks(data, predictions, NULL);
 }
 
 template<
@@ -362,12 +358,65 @@ void RandomForest<
   }
 
   probabilities.set_size(trees[0].NumClasses(), data.n_cols);
+  ClassifyBlocks(data, predictions, &probabilities);
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    typename ElemType
+>
+template<typename MatType>
+void RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    ElemType
+>::ClassifyBlocks(const MatType& data,
+                  arma::Row<size_t>& predictions,
+                  arma::mat* probabilities) const
+{
   predictions.set_size(data.n_cols);
-  #pragma omp parallel for
-  for (omp_size_t i = 0; i < data.n_cols; ++i)
+
+  // Classify the points in blocks.  Each block is passed through each tree as
+  // a batch, so the nodes of a tree are reused by all the points in the block
+  // while they are in cache, and the blocks are processed in parallel.  The
+  // probabilities of a block are accumulated in a matrix of its own, so that
+  // the probabilities of all the points are only held if they were asked for.
+  const size_t blockSize = 1024;
+  const size_t numBlocks = (data.n_cols + blockSize - 1) / blockSize;
+  const size_t numClasses = trees[0].NumClasses();
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
   {
-    arma::vec probs = probabilities.unsafe_col(i);
-    Classify(data.col(i), predictions[i], probs);
+    const size_t begin = b * blockSize;
+    const size_t end = std::min((size_t) data.n_cols, begin + blockSize);
+
+    arma::mat blockProbabilities(numClasses, end - begin, arma::fill::zeros);
+    arma::Row<size_t> treePredictions;
+    arma::mat treeProbabilities;
+    for (size_t i = 0; i < trees.size(); ++i)
+    {
+      trees[i].Classify(data.cols(begin, end - 1), treePredictions,
+          treeProbabilities);
+      blockProbabilities += treeProbabilities;
+    }
+
+    // Find maximum element after renormalizing probabilities.
+    blockProbabilities /= trees.size();
+    for (size_t j = 0; j < blockProbabilities.n_cols; ++j)
+    {
+      arma::uword maxIndex = 0;
+      blockProbabilities.unsafe_col(j).max(maxIndex);
+      predictions[begin + j] = (size_t) maxIndex;
+    }
+
+    if (probabilities)
+      probabilities->cols(begin, end - 1) = blockProbabilities;
   }
 }
 
@@ -17,6 +17,7 @@
 #include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/core/tree/binary_space_tree.hpp>
 #include "range_search_stat.hpp"
+#include "result_sinks.hpp"
 
 namespace mlpack {
 namespace range /** Range-search routines. */ {
@@ -299,6 +300,81 @@ class RangeSearch
               std::vector<std::vector<size_t>>& neighbors,
               std::vector<std::vector<double>>& distances);
 
+  /**
+   * Search for all reference points in the given range for each point in the
+   * query set, handing the results to the given result sink instead of storing
+   * them in vectors.  The sink receives the results with their original query
+   * and reference indices, as they are found.  For instance, a CSRResultSink
+   * stores all of the results in two flat arrays, and a CountResultSink only
+   * counts them.  See result_sinks.hpp for the API a sink must implement.
+   *
+   * In naive and single-tree mode, each query point is finished (with
+   * QueryFinished()) as soon as it has been searched.  In dual-tree mode, all
+   * query points are finished together after the traversal, so a sink that
+   * buffers the results of unfinished query points, like CallbackResultSink,
+   * holds all of the results at once.
+   *
+   * @param querySet Set of query points to search with.
+   * @param range Range of distances in which to search.
+   * @param sink Result sink to hand the results to.
+   */
+  template<typename SinkType>
+  void Search(const MatType& querySet,
+              const math::Range& range,
+              SinkType& sink);
+
+  /**
+   * Search for all reference points in the given range for each point in the
+   * query set, handing the results to the given result sink, without modifying
+   * this object.  Several threads may call this at once (each with its own
+   * sink), except for single-tree search with a tree whose first point is the
+   * centroid of the node (such as the cover tree), which stores distances in
+   * the reference tree.  The number of base cases and scores of the search are
+   * added to the given counters, instead of being returned by BaseCases() and
+   * Scores().
+   *
+   * @param querySet Set of query points to search with.
+   * @param range Range of distances in which to search.
+   * @param sink Result sink to hand the results to.
+   * @param numBaseCases Counter to add the number of base cases to.
+   * @param numScores Counter to add the number of scores to.
+   */
+  template<typename SinkType>
+  void Search(const MatType& querySet,
+              const math::Range& range,
+              SinkType& sink,
+              size_t& numBaseCases,
+              size_t& numScores) const;
+
+  /**
+   * Given a pre-built query tree, search for all reference points in the given
+   * range for each point in the query set, handing the results to the given
+   * result sink.  The query indices are the indices of the points in the query
+   * tree's dataset.  All query points are finished after the traversal.  If
+   * either naive or singleMode are set to true, this will throw an
+   * invalid_argument exception.
+   *
+   * @param queryTree Tree built on query points.
+   * @param range Range of distances in which to search.
+   * @param sink Result sink to hand the results to.
+   */
+  template<typename SinkType>
+  void Search(Tree* queryTree,
+              const math::Range& range,
+              SinkType& sink);
+
+  /**
+   * Search for all points in the given range for each point in the reference
+   * set, handing the results to the given result sink.  This means that the
+   * query set and the reference set are the same.  As for the other overloads,
+   * in dual-tree mode all query points are finished after the traversal.
+   *
+   * @param range Range of distances in which to search.
+   * @param sink Result sink to hand the results to.
+   */
+  template<typename SinkType>
+  void Search(const math::Range& range, SinkType& sink);
+
   //! Get whether single-tree search is being used.
   bool SingleMode() const { return singleMode; }
   //! Modify whether single-tree search is being used.
@@ -386,6 +386,70 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
     const math::Range& range,
     std::vector<std::vector<size_t>>& neighbors,
     std::vector<std::vector<double>>& distances)
+{
+  VectorResultSink sink(neighbors, distances);
+  Search(querySet, range, sink);
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    Tree* queryTree,
+    const math::Range& range,
+    std::vector<std::vector<size_t>>& neighbors,
+    std::vector<std::vector<double>>& distances)
+{
+  VectorResultSink sink(neighbors, distances);
+  Search(queryTree, range, sink);
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    const math::Range& range,
+    std::vector<std::vector<size_t>>& neighbors,
+    std::vector<std::vector<double>>& distances)
+{
+  VectorResultSink sink(neighbors, distances);
+  Search(range, sink);
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename SinkType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    const MatType& querySet,
+    const math::Range& range,
+    SinkType& sink)
+{
+  // Reset counts.
+  baseCases = 0;
+  scores = 0;
+
+  Search(querySet, range, sink, baseCases, scores);
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename SinkType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    const MatType& querySet,
+    const math::Range& range,
+    SinkType& sink,
+    size_t& numBaseCases,
+    size_t& numScores) const
 {
   if (querySet.n_rows != referenceSet->n_rows)
   {
@@ -396,77 +460,71 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
     throw std::invalid_argument(oss.str());
   }
 
-  // If there are no points, there is no search to be done.
+  // If there are no points, there is no search to be done, but every query
+  // point still has its (empty) results.
   if (referenceSet->n_cols == 0)
+  {
+    sink.Begin(querySet.n_cols);
+    for (size_t i = 0; i < querySet.n_cols; ++i)
+      sink.QueryFinished(i);
+    sink.End();
     return;
+  }
 
   Timer::Start("range_search/computing_neighbors");
 
   // This will hold mappings for query points, if necessary.
   std::vector<size_t> oldFromNewQueries;
 
-  // If we have built the trees ourselves, then we will have to map all the
-  // indices back to their original indices when this computation is finished.
-  // To avoid extra copies, we will store the unmapped neighbors and distances
-  // in a separate object.
-  std::vector<std::vector<size_t>>* neighborPtr = &neighbors;
-  std::vector<std::vector<double>>* distancePtr = &distances;
-
-  // Mapping is only necessary if the tree rearranges points.
-  if (tree::TreeTraits<Tree>::RearrangesDataset)
-  {
-    // Query indices only need to be mapped if we are building the query tree
-    // ourselves.
-    if (!singleMode && !naive)
-    {
-      distancePtr = new std::vector<std::vector<double>>;
-      neighborPtr = new std::vector<std::vector<size_t>>;
-    }
-
-    // Reference indices only need to be mapped if we built the reference tree
-    // ourselves.
-    else if (treeOwner)
-      neighborPtr = new std::vector<std::vector<size_t>>;
-  }
+  // If we have built the trees ourselves, then the results are mapped back to
+  // the original indices as they are passed to the sink.  Reference indices
+  // only need to be mapped if we built the reference tree ourselves.
+  const bool mapReferences = treeOwner &&
+      tree::TreeTraits<Tree>::RearrangesDataset;
+  const bool mapQueries = !singleMode && !naive &&
+      tree::TreeTraits<Tree>::RearrangesDataset;
+  MappedResultSink<SinkType> mappedSink(sink,
+      mapQueries ? &oldFromNewQueries : NULL,
+      mapReferences ? &oldFromNewReferences : NULL);
 
-  // Resize each vector.
-  neighborPtr->clear(); // Just in case there was anything in it.
-  neighborPtr->resize(querySet.n_cols);
-  distancePtr->clear();
-  distancePtr->resize(querySet.n_cols);
+  sink.Begin(querySet.n_cols);
 
   // Create the helper object for the traversal.
-  typedef RangeSearchRules<MetricType, Tree> RuleType;
+  typedef RangeSearchRules<MetricType, Tree, MappedResultSink<SinkType>>
+      RuleType;
 
-  // Reset counts.
-  baseCases = 0;
-  scores = 0;
+  // The rules need a metric they can modify, so the search uses its own copy.
+  MetricType searchMetric(metric);
 
   if (naive)
   {
-    RuleType rules(*referenceSet, querySet, range, *neighborPtr, *distancePtr,
-        metric);
+    RuleType rules(*referenceSet, querySet, range, mappedSink, searchMetric);
 
     // The naive brute-force solution.
     for (size_t i = 0; i < querySet.n_cols; ++i)
+    {
       for (size_t j = 0; j < referenceSet->n_cols; ++j)
         rules.BaseCase(i, j);
+      mappedSink.QueryFinished(i);
+    }
 
-    baseCases += (querySet.n_cols * referenceSet->n_cols);
+    numBaseCases += (querySet.n_cols * referenceSet->n_cols);
   }
   else if (singleMode)
   {
     // Create the traverser.
-    RuleType rules(*referenceSet, querySet, range, *neighborPtr, *distancePtr,
-        metric);
+    RuleType rules(*referenceSet, querySet, range, mappedSink, searchMetric);
     typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
 
     // Now have it traverse for each point.
     for (size_t i = 0; i < querySet.n_cols; ++i)
+    {
       traverser.Traverse(i, *referenceTree);
+      mappedSink.QueryFinished(i);
+    }
 
-    baseCases += rules.BaseCases();
-    scores += rules.Scores();
+    numBaseCases += rules.BaseCases();
+    numScores += rules.Scores();
   }
   else // Dual-tree recursion.
   {
@@ -478,86 +536,27 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
     Timer::Start("range_search/computing_neighbors");
 
     // Create the traverser.
-    RuleType rules(*referenceSet, queryTree->Dataset(), range, *neighborPtr,
-        *distancePtr, metric);
+    RuleType rules(*referenceSet, queryTree->Dataset(), range, mappedSink,
+        searchMetric);
     typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
 
     traverser.Traverse(*queryTree, *referenceTree);
 
-    baseCases += rules.BaseCases();
-    scores += rules.Scores();
+    // The results of every query point are now known; the query indices passed
+    // here are already the original ones.
+    for (size_t i = 0; i < querySet.n_cols; ++i)
+      sink.QueryFinished(i);
+
+    numBaseCases += rules.BaseCases();
+    numScores += rules.Scores();
 
     // Clean up tree memory.
     delete queryTree;
   }
 
-  Timer::Stop("range_search/computing_neighbors");
+  sink.End();
 
-  // Map points back to original indices, if necessary.
-  if (tree::TreeTraits<Tree>::RearrangesDataset)
-  {
-    if (!singleMode && !naive && treeOwner)
-    {
-      // We must map both query and reference indices.
-      neighbors.clear();
-      neighbors.resize(querySet.n_cols);
-      distances.clear();
-      distances.resize(querySet.n_cols);
-
-      for (size_t i = 0; i < distances.size(); i++)
-      {
-        // Map distances (copy a column).
-        const size_t queryMapping = oldFromNewQueries[i];
-        distances[queryMapping] = (*distancePtr)[i];
-
-        // Copy each neighbor individually, because we need to map it.
-        neighbors[queryMapping].resize(distances[queryMapping].size());
-        for (size_t j = 0; j < distances[queryMapping].size(); j++)
-          neighbors[queryMapping][j] =
-              oldFromNewReferences[(*neighborPtr)[i][j]];
-      }
-
-      // Finished with temporary objects.
-      delete neighborPtr;
-      delete distancePtr;
-    }
-    else if (!singleMode && !naive)
-    {
-      // We must map query indices only.
-      neighbors.clear();
-      neighbors.resize(querySet.n_cols);
-      distances.clear();
-      distances.resize(querySet.n_cols);
-
-      for (size_t i = 0; i < distances.size(); ++i)
-      {
-        // Map distances and neighbors (copy a column).
-        const size_t queryMapping = oldFromNewQueries[i];
-        distances[queryMapping] = (*distancePtr)[i];
-        neighbors[queryMapping] = (*neighborPtr)[i];
-      }
-
-      // Finished with temporary objects.
-      delete neighborPtr;
-      delete distancePtr;
-    }
-    else if (treeOwner)
-    {
-      // We must map reference indices only.
-      neighbors.clear();
-      neighbors.resize(querySet.n_cols);
-
-      for (size_t i = 0; i < neighbors.size(); i++)
-      {
-        neighbors[i].resize((*neighborPtr)[i].size());
-        for (size_t j = 0; j < neighbors[i].size(); j++)
-          neighbors[i][j] = oldFromNewReferences[(*neighborPtr)[i][j]];
-      }
-
-      // Finished with temporary object.
-      delete neighborPtr;
-    }
-  }
+  Timer::Stop("range_search/computing_neighbors");
 }
 
 template<typename MetricType,
@@ -565,70 +564,59 @@ template<typename MetricType,
          template<typename TreeMetricType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType>
+template<typename SinkType>
 void RangeSearch<MetricType, MatType, TreeType>::Search(
     Tree* queryTree,
     const math::Range& range,
-    std::vector<std::vector<size_t>>& neighbors,
-    std::vector<std::vector<double>>& distances)
+    SinkType& sink)
 {
-  // If there are no points, there is no search to be done.
-  if (referenceSet->n_cols == 0)
-    return;
-
-  Timer::Start("range_search/computing_neighbors");
-
-  // Get a reference to the query set.
-  const MatType& querySet = queryTree->Dataset();
-
   // Make sure we are in dual-tree mode.
   if (singleMode || naive)
     throw std::invalid_argument("cannot call RangeSearch::Search() with a "
         "query tree when naive or singleMode are set to true");
 
-  // We won't need to map query indices, but will we need to map distances?
-  std::vector<std::vector<size_t>>* neighborPtr = &neighbors;
+  // Get a reference to the query set.
+  const MatType& querySet = queryTree->Dataset();
 
-  if (treeOwner && tree::TreeTraits<Tree>::RearrangesDataset)
-    neighborPtr = new std::vector<std::vector<size_t>>;
+  // If there are no points, there is no search to be done, but every query
+  // point still has its (empty) results.
+  if (referenceSet->n_cols == 0)
+  {
+    sink.Begin(querySet.n_cols);
+    for (size_t i = 0; i < querySet.n_cols; ++i)
+      sink.QueryFinished(i);
+    sink.End();
+    return;
+  }
 
-  // Resize each vector.
-  neighborPtr->clear(); // Just in case there was anything in it.
-  neighborPtr->resize(querySet.n_cols);
-  distances.clear();
-  distances.resize(querySet.n_cols);
+  Timer::Start("range_search/computing_neighbors");
+
+  // We won't need to map query indices, but we may need to map reference
+  // indices.
+  MappedResultSink<SinkType> mappedSink(sink, NULL,
+      (treeOwner && tree::TreeTraits<Tree>::RearrangesDataset) ?
+      &oldFromNewReferences : NULL);
+
+  sink.Begin(querySet.n_cols);
 
   // Create the helper object for the traversal.
-  typedef RangeSearchRules<MetricType, Tree> RuleType;
-  RuleType rules(*referenceSet, queryTree->Dataset(), range, *neighborPtr,
-      distances, metric);
+  typedef RangeSearchRules<MetricType, Tree, MappedResultSink<SinkType>>
+      RuleType;
+  RuleType rules(*referenceSet, querySet, range, mappedSink, metric);
 
   // Create the traverser.
   typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
 
   traverser.Traverse(*queryTree, *referenceTree);
 
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+    sink.QueryFinished(i);
+  sink.End();
+
   Timer::Stop("range_search/computing_neighbors");
 
   baseCases = rules.BaseCases();
   scores = rules.Scores();
-
-  // Do we need to map indices?
-  if (treeOwner && tree::TreeTraits<Tree>::RearrangesDataset)
-  {
-    // We must map reference indices only.
-    neighbors.clear();
-    neighbors.resize(querySet.n_cols);
-
-    for (size_t i = 0; i < neighbors.size(); i++)
-    {
-      neighbors[i].resize((*neighborPtr)[i].size());
-      for (size_t j = 0; j < neighbors[i].size(); j++)
-        neighbors[i][j] = oldFromNewReferences[(*neighborPtr)[i][j]];
-    }
-
-    // Finished with temporary object.
-    delete neighborPtr;
-  }
 }
 
 template<typename MetricType,
@@ -636,45 +624,45 @@ template<typename MetricType,
          template<typename TreeMetricType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType>
+template<typename SinkType>
 void RangeSearch<MetricType, MatType, TreeType>::Search(
     const math::Range& range,
-    std::vector<std::vector<size_t>>& neighbors,
-    std::vector<std::vector<double>>& distances)
+    SinkType& sink)
 {
   // If there are no points, there is no search to be done.
   if (referenceSet->n_cols == 0)
+  {
+    sink.Begin(0);
+    sink.End();
     return;
+  }
 
   Timer::Start("range_search/computing_neighbors");
 
-  // Here, we will use the query set as the reference set.
-  std::vector<std::vector<size_t>>* neighborPtr = &neighbors;
-  std::vector<std::vector<double>>* distancePtr = &distances;
-
-  if (tree::TreeTraits<Tree>::RearrangesDataset && treeOwner)
-  {
-    // We will always need to rearrange in this case.
-    distancePtr = new std::vector<std::vector<double>>;
-    neighborPtr = new std::vector<std::vector<size_t>>;
-  }
+  // Here, we will use the query set as the reference set, so if we built the
+  // tree ourselves, both the query and reference indices must be mapped.
+  const std::vector<size_t>* mapping =
+      (treeOwner && tree::TreeTraits<Tree>::RearrangesDataset) ?
+      &oldFromNewReferences : NULL;
+  MappedResultSink<SinkType> mappedSink(sink, mapping, mapping);
 
-  // Resize each vector.
-  neighborPtr->clear(); // Just in case there was anything in it.
-  neighborPtr->resize(referenceSet->n_cols);
-  distancePtr->clear();
-  distancePtr->resize(referenceSet->n_cols);
+  sink.Begin(referenceSet->n_cols);
 
   // Create the helper object for the traversal.
-  typedef RangeSearchRules<MetricType, Tree> RuleType;
-  RuleType rules(*referenceSet, *referenceSet, range, *neighborPtr,
-      *distancePtr, metric, true /* don't return the query in the results */);
+  typedef RangeSearchRules<MetricType, Tree, MappedResultSink<SinkType>>
+      RuleType;
+  RuleType rules(*referenceSet, *referenceSet, range, mappedSink, metric,
+      true /* don't return the query in the results */);
 
   if (naive)
   {
     // The naive brute-force solution.
     for (size_t i = 0; i < referenceSet->n_cols; ++i)
+    {
       for (size_t j = 0; j < referenceSet->n_cols; ++j)
         rules.BaseCase(i, j);
+      mappedSink.QueryFinished(i);
+    }
 
     baseCases = (referenceSet->n_cols * referenceSet->n_cols);
     scores = 0;
@@ -686,7 +674,10 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
 
     // Now have it traverse for each point.
     for (size_t i = 0; i < referenceSet->n_cols; ++i)
+    {
       traverser.Traverse(i, *referenceTree);
+      mappedSink.QueryFinished(i);
+    }
 
     baseCases = rules.BaseCases();
     scores = rules.Scores();
@@ -698,38 +689,16 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
 
     traverser.Traverse(*referenceTree, *referenceTree);
 
+    for (size_t i = 0; i < referenceSet->n_cols; ++i)
+      sink.QueryFinished(i);
+
     baseCases = rules.BaseCases();
     scores = rules.Scores();
   }
 
-  Timer::Stop("range_search/computing_neighbors");
-
-  // Do we need to map the reference indices?
-  if (treeOwner && tree::TreeTraits<Tree>::RearrangesDataset)
-  {
-    neighbors.clear();
-    neighbors.resize(referenceSet->n_cols);
-    distances.clear();
-    distances.resize(referenceSet->n_cols);
-
-    for (size_t i = 0; i < distances.size(); i++)
-    {
-      // Map distances (copy a column).
-      const size_t refMapping = oldFromNewReferences[i];
-      distances[refMapping] = (*distancePtr)[i];
-
-      // Copy each neighbor individually, because we need to map it.
-      neighbors[refMapping].resize(distances[refMapping].size());
-      for (size_t j = 0; j < distances[refMapping].size(); j++)
-      {
-        neighbors[refMapping][j] = oldFromNewReferences[(*neighborPtr)[i][j]];
-      }
-    }
+  sink.End();
 
-    // Finished with temporary objects.
-    delete neighborPtr;
-    delete distancePtr;
-  }
+  Timer::Stop("range_search/computing_neighbors");
 }
 
 template<typename MetricType,
@@ -245,14 +245,18 @@ void mlpackMain()
     if (singleMode && naive)
       Log::Warn << "--single_mode ignored because --naive is present." << endl;
 
-    // Now run the search.
-    vector<vector<size_t>> neighbors;
-    vector<vector<double>> distances;
+    // Now run the search.  The results are stored in two flat arrays, instead
+    // of a vector for each point.
+    CSRResultSink results(CLI::HasParam("distances_file"));
 
     if (CLI::HasParam("query"))
-      rs.Search(std::move(queryData), r, neighbors, distances);
+      rs.Search(std::move(queryData), r, results);
     else
-      rs.Search(r, neighbors, distances);
+      rs.Search(r, results);
+
+    const vector<size_t>& offsets = results.Offsets();
+    const vector<size_t>& neighbors = results.Neighbors();
+    const vector<double>& distances = results.Distances();
 
     Log::Info << "Search complete." << endl;
 
@@ -269,15 +273,15 @@ void mlpackMain()
       else
       {
         // Loop over each point.
-        for (size_t i = 0; i < distances.size(); ++i)
+        for (size_t i = 0; i < results.NumQueries(); ++i)
         {
           // Store the distances of each point.  We may have 0 points to store,
           // so we must account for that possibility.
-          for (size_t j = 0; j + 1 < distances[i].size(); ++j)
-            distancesStr << distances[i][j] << ", ";
+          for (size_t j = offsets[i]; j + 1 < offsets[i + 1]; ++j)
+            distancesStr << distances[j] << ", ";
 
-          if (distances[i].size() > 0)
-            distancesStr << distances[i][distances[i].size() - 1];
+          if (offsets[i + 1] > offsets[i])
+            distancesStr << distances[offsets[i + 1] - 1];
 
           distancesStr << endl;
         }
@@ -298,15 +302,15 @@ void mlpackMain()
       else
       {
         // Loop over each point.
-        for (size_t i = 0; i < neighbors.size(); ++i)
+        for (size_t i = 0; i < results.NumQueries(); ++i)
         {
           // Store the neighbors of each point.  We may have 0 points to store,
           // so we must account for that possibility.
-          for (size_t j = 0; j + 1 < neighbors[i].size(); ++j)
-            neighborsStr << neighbors[i][j] << ", ";
+          for (size_t j = offsets[i]; j + 1 < offsets[i + 1]; ++j)
+            neighborsStr << neighbors[j] << ", ";
 
-          if (neighbors[i].size() > 0)
-            neighborsStr << neighbors[i][neighbors[i].size() - 1];
+          if (offsets[i + 1] > offsets[i])
+            neighborsStr << neighbors[offsets[i + 1] - 1];
 
           neighborsStr << endl;
         }
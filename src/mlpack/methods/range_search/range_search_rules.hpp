@@ -14,6 +14,8 @@
 
 #include <mlpack/core/tree/traversal_info.hpp>
 
+#include "result_sinks.hpp"
+
 namespace mlpack {
 namespace range {
 
@@ -23,8 +25,12 @@ namespace range {
  *
  * @tparam MetricType The metric to use for computation.
  * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ * @tparam SinkType The result sink that receives the results; see
+ *     result_sinks.hpp.  By default, the results are stored in vectors.
  */
-template<typename MetricType, typename TreeType>
+template<typename MetricType,
+         typename TreeType,
+         typename SinkType = VectorResultSink>
 class RangeSearchRules
 {
  public:
@@ -35,8 +41,7 @@ class RangeSearchRules
    * @param referenceSet Set of reference data.
    * @param querySet Set of query data.
    * @param range Range to search for.
-   * @param neighbors Vector to store resulting neighbors in.
-   * @param distances Vector to store resulting distances in.
+   * @param sink Result sink to hand the results to.
    * @param metric Instantiated metric.
    * @param sameSet If true, the query and reference set are taken to be the
    *      same, and a query point will not return itself in the results.
@@ -44,8 +49,7 @@ class RangeSearchRules
   RangeSearchRules(const arma::mat& referenceSet,
                    const arma::mat& querySet,
                    const math::Range& range,
-                   std::vector<std::vector<size_t> >& neighbors,
-                   std::vector<std::vector<double> >& distances,
+                   SinkType& sink,
                    MetricType& metric,
                    const bool sameSet = false);
 
@@ -127,11 +131,8 @@ class RangeSearchRules
   //! The range of distances for which we are searching.
   const math::Range& range;
 
-  //! The vector the resultant neighbor indices should be stored in.
-  std::vector<std::vector<size_t> >& neighbors;
-
-  //! The vector the resultant neighbor distances should be stored in.
-  std::vector<std::vector<double> >& distances;
+  //! The sink that receives the results.
+  SinkType& sink;
 
   //! The instantiated metric.
   MetricType& metric;
@@ -0,0 +1,426 @@
+/**
+ * @file result_sinks.hpp
+ *
+ * Result sinks for RangeSearch.  A result sink receives the results of a range
+ * search as they are found, so the caller can choose how (and whether) to store
+ * them.  Every result sink must implement the following API:
+ *
+ * @code
+ * // If false, RangeSearch may pass 0 instead of computing the distance of
+ * // results that are known to be in the range.
+ * static const bool NeedsDistances;
+ *
+ * // Called before the search with the number of query points.
+ * void Begin(const size_t numQueries);
+ *
+ * // Called for each reference point in the range of a query point.
+ * void Insert(const size_t queryIndex,
+ *             const size_t referenceIndex,
+ *             const double distance);
+ *
+ * // Called once for each query point, when all of its results have been
+ * // inserted.
+ * void QueryFinished(const size_t queryIndex);
+ *
+ * // Called after the search.
+ * void End();
+ * @endcode
+ *
+ * In naive and single-tree search, each query point is finished before the next
+ * one is searched.  In dual-tree search, the results of all query points are
+ * interleaved, and all of the query points are finished together after the
+ * traversal, so a sink cannot release the results of a query point early.
+ * Begin() and End() are always called, even if there are no reference points.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANGE_SEARCH_RESULT_SINKS_HPP
+#define MLPACK_METHODS_RANGE_SEARCH_RESULT_SINKS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <unordered_map>
+
+namespace mlpack {
+namespace range {
+
+/**
+ * Store the results of a range search as a vector of neighbors and a vector of
+ * distances for each query point.  This is the output format of the original
+ * RangeSearch::Search() overloads.
+ */
+class VectorResultSink
+{
+ public:
+  //! The distances are stored.
+  static const bool NeedsDistances = true;
+
+  /**
+   * Store the results in the given vectors.
+   *
+   * @param neighbors Will hold the neighbors of each query point.
+   * @param distances Will hold the distances of the neighbors of each query
+   *     point.
+   */
+  VectorResultSink(std::vector<std::vector<size_t>>& neighbors,
+                   std::vector<std::vector<double>>& distances) :
+      neighbors(neighbors),
+      distances(distances)
+  { }
+
+  //! Clear the results, and make room for the given number of query points.
+  void Begin(const size_t numQueries)
+  {
+    neighbors.clear();
+    neighbors.resize(numQueries);
+    distances.clear();
+    distances.resize(numQueries);
+  }
+
+  //! Store a result.
+  void Insert(const size_t queryIndex,
+              const size_t referenceIndex,
+              const double distance)
+  {
+    neighbors[queryIndex].push_back(referenceIndex);
+    distances[queryIndex].push_back(distance);
+  }
+
+  //! Nothing to do when a query point is finished.
+  void QueryFinished(const size_t /* queryIndex */) { }
+
+  //! Nothing to do at the end of the search.
+  void End() { }
+
+ private:
+  //! The neighbors of each query point.
+  std::vector<std::vector<size_t>>& neighbors;
+  //! The distances of each query point.
+  std::vector<std::vector<double>>& distances;
+};
+
+/**
+ * Store the results of a range search in compressed sparse row (CSR) form: the
+ * neighbors of query point i are Neighbors()[Offsets()[i]] to
+ * Neighbors()[Offsets()[i + 1] - 1], and likewise for the distances.  The
+ * results of all query points are stored in two flat arrays, so there is no
+ * allocation for each query point.
+ *
+ * If the query points are finished in order (as in naive or single-tree
+ * search), the results are stored in place.  Otherwise, the query index of each
+ * result is also stored until the end of the search, when the results are
+ * grouped by query point, in place, with a counting sort.  In that case, the
+ * results of each query point are not kept in the order they were found.
+ */
+class CSRResultSink
+{
+ public:
+  //! The distances are passed to Insert(), even if they are not stored.
+  static const bool NeedsDistances = true;
+
+  /**
+   * Create the CSRResultSink.
+   *
+   * @param storeDistances If false, only the neighbors are stored.
+   */
+  CSRResultSink(const bool storeDistances = true) :
+      storeDistances(storeDistances),
+      inOrder(true),
+      lastQuery(0)
+  { }
+
+  //! Clear the results, and make room for the given number of query points.
+  void Begin(const size_t numQueries)
+  {
+    counts.assign(numQueries, 0);
+    offsets.clear();
+    neighbors.clear();
+    distances.clear();
+    queries.clear();
+    inOrder = true;
+    lastQuery = 0;
+  }
+
+  //! Store a result.
+  void Insert(const size_t queryIndex,
+              const size_t referenceIndex,
+              const double distance)
+  {
+    if (inOrder && queryIndex < lastQuery)
+    {
+      // The results so far are grouped by query point in increasing order, so
+      // their query indices can be recovered from the counts.
+      inOrder = false;
+      queries.reserve(2 * neighbors.size());
+      for (size_t i = 0; i <= lastQuery; ++i)
+        queries.insert(queries.end(), counts[i], i);
+    }
+
+    if (!inOrder)
+      queries.push_back(queryIndex);
+    lastQuery = std::max(lastQuery, queryIndex);
+
+    ++counts[queryIndex];
+    neighbors.push_back(referenceIndex);
+    if (storeDistances)
+      distances.push_back(distance);
+  }
+
+  //! Nothing to do when a query point is finished.
+  void QueryFinished(const size_t /* queryIndex */) { }
+
+  //! Compute the offsets, and group the results by query point if necessary.
+  void End()
+  {
+    offsets.resize(counts.size() + 1);
+    offsets[0] = 0;
+    for (size_t i = 0; i < counts.size(); ++i)
+      offsets[i + 1] = offsets[i] + counts[i];
+
+    if (!inOrder)
+    {
+      // Counting sort, in place: each result that is not in the block of its
+      // query point is swapped into the next free position of that block, so
+      // no second copy of the results is needed.
+      std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+      for (size_t q = 0; q < counts.size(); ++q)
+      {
+        while (next[q] < offsets[q + 1])
+        {
+          const size_t i = next[q];
+          if (queries[i] == q)
+          {
+            ++next[q];
+            continue;
+          }
+
+          const size_t j = next[queries[i]]++;
+          std::swap(queries[i], queries[j]);
+          std::swap(neighbors[i], neighbors[j]);
+          if (storeDistances)
+            std::swap(distances[i], distances[j]);
+        }
+      }
+
+      std::vector<size_t>().swap(queries);
+    }
+
+    std::vector<size_t>().swap(counts);
+  }
+
+  //! Get the number of query points.
+  size_t NumQueries() const
+  {
+    return offsets.empty() ? 0 : offsets.size() - 1;
+  }
+  //! Get the number of neighbors of the given query point.
+  size_t NumNeighbors(const size_t queryIndex) const
+  {
+    return offsets[queryIndex + 1] - offsets[queryIndex];
+  }
+
+  //! Get the offset of the results of each query point (and the total number
+  //! of results, as the last element).
+  const std::vector<size_t>& Offsets() const { return offsets; }
+  //! Get the neighbors of all query points.
+  const std::vector<size_t>& Neighbors() const { return neighbors; }
+  //! Get the distances of all query points (empty if they are not stored).
+  const std::vector<double>& Distances() const { return distances; }
+
+ private:
+  //! Whether or not to store the distances.
+  bool storeDistances;
+  //! Whether the results so far are in order of query point.
+  bool inOrder;
+  //! The largest query index so far.
+  size_t lastQuery;
+
+  //! The number of results of each query point, during the search.
+  std::vector<size_t> counts;
+  //! The query index of each result, if they are not in order.
+  std::vector<size_t> queries;
+
+  //! The offsets of the results of each query point.
+  std::vector<size_t> offsets;
+  //! The neighbors.
+  std::vector<size_t> neighbors;
+  //! The distances.
+  std::vector<double> distances;
+};
+
+/**
+ * Only count the number of reference points in the range of each query point.
+ * The distances of reference points that are known to be in the range are not
+ * computed.
+ */
+class CountResultSink
+{
+ public:
+  //! The distances are not needed.
+  static const bool NeedsDistances = false;
+
+  //! Set the counts of the given number of query points to zero.
+  void Begin(const size_t numQueries) { counts.assign(numQueries, 0); }
+
+  //! Count a result.
+  void Insert(const size_t queryIndex,
+              const size_t /* referenceIndex */,
+              const double /* distance */)
+  {
+    ++counts[queryIndex];
+  }
+
+  //! Nothing to do when a query point is finished.
+  void QueryFinished(const size_t /* queryIndex */) { }
+
+  //! Nothing to do at the end of the search.
+  void End() { }
+
+  //! Get the number of results of each query point.
+  const std::vector<size_t>& Counts() const { return counts; }
+
+ private:
+  //! The number of results of each query point.
+  std::vector<size_t> counts;
+};
+
+/**
+ * Hand the results of each query point to a callback as soon as the query point
+ * is finished, with the signature
+ *
+ * @code
+ * void callback(const size_t queryIndex,
+ *               const std::vector<size_t>& neighbors,
+ *               const std::vector<double>& distances);
+ * @endcode
+ *
+ * The callback is called exactly once for each query point (possibly with no
+ * neighbors), and the results are then discarded.  In naive or single-tree
+ * search, only the results of one query point are held at a time; in dual-tree
+ * search, the results are held until the end of the traversal.
+ *
+ * @tparam CallbackType Type of the callback.
+ */
+template<typename CallbackType>
+class CallbackResultSink
+{
+ public:
+  //! The distances are handed to the callback.
+  static const bool NeedsDistances = true;
+
+  //! Create the sink with the given callback.
+  CallbackResultSink(CallbackType callback) : callback(callback) { }
+
+  //! Clear any pending results.
+  void Begin(const size_t /* numQueries */) { pending.clear(); }
+
+  //! Store a result until its query point is finished.
+  void Insert(const size_t queryIndex,
+              const size_t referenceIndex,
+              const double distance)
+  {
+    Results& results = pending[queryIndex];
+    results.first.push_back(referenceIndex);
+    results.second.push_back(distance);
+  }
+
+  //! Hand the results of the query point to the callback.
+  void QueryFinished(const size_t queryIndex)
+  {
+    typename std::unordered_map<size_t, Results>::iterator it =
+        pending.find(queryIndex);
+    if (it == pending.end())
+    {
+      callback(queryIndex, empty.first, empty.second);
+    }
+    else
+    {
+      callback(queryIndex, it->second.first, it->second.second);
+      pending.erase(it);
+    }
+  }
+
+  //! Nothing to do at the end of the search.
+  void End() { }
+
+ private:
+  //! The neighbors and distances of one query point.
+  typedef std::pair<std::vector<size_t>, std::vector<double>> Results;
+
+  //! The callback.
+  CallbackType callback;
+  //! The results of query points that are not finished yet.
+  std::unordered_map<size_t, Results> pending;
+  //! Empty results, for query points without neighbors.
+  Results empty;
+};
+
+/**
+ * Map the query and reference indices of the results to other indices before
+ * passing them to another sink.  This is used when a tree has rearranged the
+ * points.  The other sink is not begun or ended by this class; that is up to
+ * its owner.
+ *
+ * @tparam SinkType Type of the sink to pass the results to.
+ */
+template<typename SinkType>
+class MappedResultSink
+{
+ public:
+  //! The distances are needed if the other sink needs them.
+  static const bool NeedsDistances = SinkType::NeedsDistances;
+
+  /**
+   * Create the sink.
+   *
+   * @param sink Sink to pass the results to.
+   * @param queryMapping Mapping of query indices (NULL for none).
+   * @param referenceMapping Mapping of reference indices (NULL for none).
+   */
+  MappedResultSink(SinkType& sink,
+                   const std::vector<size_t>* queryMapping,
+                   const std::vector<size_t>* referenceMapping) :
+      sink(sink),
+      queryMapping(queryMapping),
+      referenceMapping(referenceMapping)
+  { }
+
+  //! The other sink is begun by its owner.
+  void Begin(const size_t /* numQueries */) { }
+
+  //! Map the indices of a result and pass it on.
+  void Insert(const size_t queryIndex,
+              const size_t referenceIndex,
+              const double distance)
+  {
+    sink.Insert(queryMapping ? (*queryMapping)[queryIndex] : queryIndex,
+        referenceMapping ? (*referenceMapping)[referenceIndex] :
+        referenceIndex, distance);
+  }
+
+  //! Map the query index and pass it on.
+  void QueryFinished(const size_t queryIndex)
+  {
+    sink.QueryFinished(queryMapping ? (*queryMapping)[queryIndex] :
+        queryIndex);
+  }
+
+  //! The other sink is ended by its owner.
+  void End() { }
+
+ private:
+  //! The sink to pass the results to.
+  SinkType& sink;
+  //! The mapping of query indices.
+  const std::vector<size_t>* queryMapping;
+  //! The mapping of reference indices.
+  const std::vector<size_t>* referenceMapping;
+};
+
+} // namespace range
+} // namespace mlpack
+
+#endif
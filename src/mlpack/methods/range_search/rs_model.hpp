@@ -41,16 +41,17 @@ struct RSModelName
 /**
  * MonoSearchVisitor executes a monochromatic range search on the given
  * RSType. Range Search is performed on the reference set itself, no querySet.
+ *
+ * @tparam SinkType The result sink that receives the results.
  */
+template<typename SinkType>
 class MonoSearchVisitor : public  boost::static_visitor<void>
 {
  private:
   //! The range to search for.
   const math::Range& range;
-  //! Output neighbors.
-  std::vector<std::vector<size_t>>& neighbors;
-  //! Output distances.
-  std::vector<std::vector<double>>& distances;
+  //! The result sink.
+  SinkType& sink;
 
  public:
   //! Perform monochromatic search with the given RangeSearch object.
@@ -58,12 +59,9 @@ class MonoSearchVisitor : public  boost::static_visitor<void>
   void operator()(RSType* rs) const;
 
   //! Construct the MonoSearchVisitor with the given parameters.
-  MonoSearchVisitor(const math::Range& range,
-                    std::vector<std::vector<size_t>>& neighbors,
-                    std::vector<std::vector<double>>& distances):
+  MonoSearchVisitor(const math::Range& range, SinkType& sink):
       range(range),
-      neighbors(neighbors),
-      distances(distances)
+      sink(sink)
   {};
 };
 
@@ -72,7 +70,10 @@ class MonoSearchVisitor : public  boost::static_visitor<void>
  * We use template specialization to differentiate those tree types that
  * accept leafSize as a parameter. In these cases, before doing range search,
  * a query tree with proper leafSize is built from the querySet.
+ *
+ * @tparam SinkType The result sink that receives the results.
  */
+template<typename SinkType>
 class BiSearchVisitor : public boost::static_visitor<void>
 {
  private:
@@ -80,10 +81,8 @@ class BiSearchVisitor : public boost::static_visitor<void>
   const arma::mat& querySet;
   //! Range to search neighbours for.
   const math::Range& range;
-  //! The result vector for neighbors.
-  std::vector<std::vector<size_t>>& neighbors;
-  //! The result vector for distances.
-  std::vector<std::vector<double>>& distances;
+  //! The result sink.
+  SinkType& sink;
   //! The number of points in a leaf (for BinarySpaceTrees).
   const size_t leafSize;
 
@@ -116,8 +115,7 @@ class BiSearchVisitor : public boost::static_visitor<void>
   //! Construct the BiSearchVisitor.
   BiSearchVisitor(const arma::mat& querySet,
                   const math::Range& range,
-                  std::vector<std::vector<size_t>>& neighbors,
-                  std::vector<std::vector<double>>& distances,
+                  SinkType& sink,
                   const size_t leafSize);
 };
 
@@ -404,6 +402,30 @@ class RSModel
               std::vector<std::vector<size_t>>& neighbors,
               std::vector<std::vector<double>>& distances);
 
+  /**
+   * Perform range search, handing the results to the given result sink.  This
+   * takes possession of the query set, so the query set will not be usable
+   * after the search.  See result_sinks.hpp for the available sinks.
+   *
+   * @param querySet Set of query points.
+   * @param range Range to search for.
+   * @param sink Result sink to hand the results to.
+   */
+  template<typename SinkType>
+  void Search(arma::mat&& querySet,
+              const math::Range& range,
+              SinkType& sink);
+
+  /**
+   * Perform monochromatic range search, with the reference set as the query
+   * set, handing the results to the given result sink.
+   *
+   * @param range Range to search for.
+   * @param sink Result sink to hand the results to.
+   */
+  template<typename SinkType>
+  void Search(const math::Range& range, SinkType& sink);
+
  private:
   /**
    * Return a string representing the name of the tree.  This is used for
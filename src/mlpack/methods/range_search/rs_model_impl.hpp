@@ -195,6 +195,25 @@ inline void RSModel::Search(arma::mat&& querySet,
                             const math::Range& range,
                             std::vector<std::vector<size_t>>& neighbors,
                             std::vector<std::vector<double>>& distances)
+{
+  VectorResultSink sink(neighbors, distances);
+  Search(std::move(querySet), range, sink);
+}
+
+// Perform range search (monochromatic case).
+inline void RSModel::Search(const math::Range& range,
+                            std::vector<std::vector<size_t>>& neighbors,
+                            std::vector<std::vector<double>>& distances)
+{
+  VectorResultSink sink(neighbors, distances);
+  Search(range, sink);
+}
+
+// Perform range search with a result sink.
+template<typename SinkType>
+void RSModel::Search(arma::mat&& querySet,
+                     const math::Range& range,
+                     SinkType& sink)
 {
   // We may need to map the query set randomly.
   if (randomBasis)
@@ -210,15 +229,13 @@ inline void RSModel::Search(arma::mat&& querySet,
     Log::Info << "brute-force (naive) search..." << std::endl;
 
 
-  BiSearchVisitor search(querySet, range, neighbors, distances,
-      leafSize);
+  BiSearchVisitor<SinkType> search(querySet, range, sink, leafSize);
   boost::apply_visitor(search, rSearch);
 }
 
-// Perform range search (monochromatic case).
-inline void RSModel::Search(const math::Range& range,
-                            std::vector<std::vector<size_t>>& neighbors,
-                            std::vector<std::vector<double>>& distances)
+// Perform range search with a result sink (monochromatic case).
+template<typename SinkType>
+void RSModel::Search(const math::Range& range, SinkType& sink)
 {
   Log::Info << "Search for points in the range [" << range.Lo() << ", "
       << range.Hi() << "] with ";
@@ -229,7 +246,7 @@ inline void RSModel::Search(const math::Range& range,
   else
     Log::Info << "brute-force (naive) search..." << std::endl;
 
-  MonoSearchVisitor search(range, neighbors, distances);
+  MonoSearchVisitor<SinkType> search(range, sink);
   boost::apply_visitor(search, rSearch);
 }
 
@@ -278,40 +295,42 @@ inline void RSModel::CleanMemory()
 }
 
 //! Monochromatic range search on the given RSType instance.
+template<typename SinkType>
 template<typename RSType>
-void MonoSearchVisitor::operator()(RSType* rs) const
+void MonoSearchVisitor<SinkType>::operator()(RSType* rs) const
 {
   if (rs)
-    return rs->Search(range, neighbors, distances);
+    return rs->Search(range, sink);
   throw std::runtime_error("no range search model initialized");
 }
 
 //! Save parameters for bichromatic range search.
-BiSearchVisitor::BiSearchVisitor(const arma::mat& querySet,
-                                 const math::Range& range,
-                                 std::vector<std::vector<size_t>>& neighbors,
-                                 std::vector<std::vector<double>>& distances,
-                                 const size_t leafSize):
+template<typename SinkType>
+BiSearchVisitor<SinkType>::BiSearchVisitor(const arma::mat& querySet,
+                                           const math::Range& range,
+                                           SinkType& sink,
+                                           const size_t leafSize):
     querySet(querySet),
     range(range),
-    neighbors(neighbors),
-    distances(distances),
+    sink(sink),
     leafSize(leafSize)
 {}
 
 //! Default Bichromatic range search on the given RSType instance.
+template<typename SinkType>
 template<template<typename TreeMetricType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType>
-void BiSearchVisitor::operator()(RSTypeT<TreeType>* rs) const
+void BiSearchVisitor<SinkType>::operator()(RSTypeT<TreeType>* rs) const
 {
   if (rs)
-    return rs->Search(querySet, range, neighbors, distances);
+    return rs->Search(querySet, range, sink);
   throw std::runtime_error("no range search model initialized");
 }
 
 //! Bichromatic range search on the given RSType specialized for KDTrees.
-void BiSearchVisitor::operator()(RSTypeT<tree::KDTree>* rs) const
+template<typename SinkType>
+void BiSearchVisitor<SinkType>::operator()(RSTypeT<tree::KDTree>* rs) const
 {
   if (rs)
     return SearchLeaf(rs);
@@ -319,7 +338,8 @@ void BiSearchVisitor::operator()(RSTypeT<tree::KDTree>* rs) const
 }
 
 //! Bichromatic range search on the given RSType specialized for BallTrees.
-void BiSearchVisitor::operator()(RSTypeT<tree::BallTree>* rs) const
+template<typename SinkType>
+void BiSearchVisitor<SinkType>::operator()(RSTypeT<tree::BallTree>* rs) const
 {
   if (rs)
     return SearchLeaf(rs);
@@ -327,7 +347,8 @@ void BiSearchVisitor::operator()(RSTypeT<tree::BallTree>* rs) const
 }
 
 //! Bichromatic range search specialized for Ocrees.
-void BiSearchVisitor::operator()(RSTypeT<tree::Octree>* rs) const
+template<typename SinkType>
+void BiSearchVisitor<SinkType>::operator()(RSTypeT<tree::Octree>* rs) const
 {
   if (rs)
     return SearchLeaf(rs);
@@ -335,8 +356,9 @@ void BiSearchVisitor::operator()(RSTypeT<tree::Octree>* rs) const
 }
 
 //! Bichromatic range search on the given RSType considering the leafSize.
+template<typename SinkType>
 template<typename RSType>
-void BiSearchVisitor::SearchLeaf(RSType* rs) const
+void BiSearchVisitor<SinkType>::SearchLeaf(RSType* rs) const
 {
   if (!rs->Naive() && !rs->SingleMode())
   {
@@ -349,21 +371,14 @@ void BiSearchVisitor::SearchLeaf(RSType* rs) const
     Log::Info << "Tree built." << std::endl;
     Timer::Stop("tree_building");
 
-    std::vector<std::vector<size_t>> neighborsOut;
-    std::vector<std::vector<double>> distancesOut;
-    rs->Search(&queryTree, range, neighborsOut, distancesOut);
-
-    // Remap the query points.
-    neighbors.resize(queryTree.Dataset().n_cols);
-    distances.resize(queryTree.Dataset().n_cols);
-    for (size_t i = 0; i < queryTree.Dataset().n_cols; ++i)
-    {
-      neighbors[oldFromNewQueries[i]] = neighborsOut[i];
-      distances[oldFromNewQueries[i]] = distancesOut[i];
-    }
+    // The query points are remapped as the results are found.
+    sink.Begin(queryTree.Dataset().n_cols);
+    MappedResultSink<SinkType> mappedSink(sink, &oldFromNewQueries, NULL);
+    rs->Search(&queryTree, range, mappedSink);
+    sink.End();
   }
   else
-    rs->Search(querySet, range, neighbors, distances);
+    rs->Search(querySet, range, sink);
 }
 
 //! Save parameters for Train.
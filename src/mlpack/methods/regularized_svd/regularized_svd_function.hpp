@@ -61,6 +61,18 @@ class RegularizedSVDFunction
   double Evaluate(const arma::mat& parameters,
                   const size_t i) const;
 
+  /**
+   * Evaluates the cost function for the training examples begin, ..., begin +
+   * batchSize - 1.  Useful for optimizers which use batches of examples.
+   *
+   * @param parameters Parameters(user/item matrices) of the decomposition.
+   * @param begin Index of the first training example in the batch.
+   * @param batchSize Number of training examples in the batch.
+   */
+  double Evaluate(const arma::mat& parameters,
+                  const size_t begin,
+                  const size_t batchSize) const;
+
   /**
    * Evaluates the full gradient of the cost function over all the training
    * examples.
@@ -87,6 +99,21 @@ class RegularizedSVDFunction
                 size_t id,
                 GradType& gradient) const;
 
+  /**
+   * Evaluates the sum of the gradients of the cost function over the training
+   * examples begin, ..., begin + batchSize - 1.  The gradient is only
+   * allocated and zeroed once for the whole batch.
+   *
+   * @param parameters Parameters(user/item matrices) of the decomposition.
+   * @param begin Index of the first training example in the batch.
+   * @param gradient Calculated gradient for the parameters.
+   * @param batchSize Number of training examples in the batch.
+   */
+  void Gradient(const arma::mat& parameters,
+                const size_t begin,
+                arma::mat& gradient,
+                const size_t batchSize) const;
+
   //! Return the initial point for the optimization.
   const arma::mat& GetInitialPoint() const { return initialPoint; }
 
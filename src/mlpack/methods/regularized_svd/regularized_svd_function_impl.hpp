@@ -95,6 +95,18 @@ double RegularizedSVDFunction<MatType>::Evaluate(const arma::mat& parameters,
   return (ratingErrorSquared + regularizationError);
 }
 
+template <typename MatType>
+double RegularizedSVDFunction<MatType>::Evaluate(const arma::mat& parameters,
+                                                 const size_t begin,
+                                                 const size_t batchSize) const
+{
+  double cost = 0.0;
+  for (size_t i = begin; i < begin + batchSize; ++i)
+    cost += Evaluate(parameters, i);
+
+  return cost;
+}
+
 template <typename MatType>
 void RegularizedSVDFunction<MatType>::Gradient(const arma::mat& parameters,
                                                arma::mat& gradient) const
@@ -154,6 +166,33 @@ void RegularizedSVDFunction<MatType>::Gradient(const arma::mat& parameters,
                              ratingError * parameters.col(user));
 }
 
+template <typename MatType>
+void RegularizedSVDFunction<MatType>::Gradient(const arma::mat& parameters,
+                                               const size_t begin,
+                                               arma::mat& gradient,
+                                               const size_t batchSize) const
+{
+  gradient.zeros(rank, numUsers + numItems);
+
+  for (size_t i = begin; i < begin + batchSize; ++i)
+  {
+    const size_t user = data(0, i);
+    const size_t item = data(1, i) + numUsers;
+
+    // Prediction error for the example.
+    const double rating = data(2, i);
+    double ratingError = rating - arma::dot(parameters.col(user),
+                                            parameters.col(item));
+
+    // Each example only contributes to the parameter columns of its user and
+    // item.
+    gradient.col(user) += 2 * (lambda * parameters.col(user) -
+                               ratingError * parameters.col(item));
+    gradient.col(item) += 2 * (lambda * parameters.col(item) -
+                               ratingError * parameters.col(user));
+  }
+}
+
 } // namespace svd
 } // namespace mlpack
 
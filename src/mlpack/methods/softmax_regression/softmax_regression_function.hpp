@@ -18,7 +18,16 @@
 namespace mlpack {
 namespace regression {
 
-class SoftmaxRegressionFunction
+/**
+ * The objective function of softmax regression.  The data may be dense or
+ * sparse; the MatType template parameter gives the type of the data matrix
+ * (for instance, arma::mat or arma::sp_mat).  For dense data, use the
+ * SoftmaxRegressionFunction typedef.
+ *
+ * @tparam MatType Type of data matrix.
+ */
+template<typename MatType = arma::mat>
+class SoftmaxRegressionFunctionType
 {
  public:
   /**
@@ -32,11 +41,11 @@ class SoftmaxRegressionFunction
    * @param lambda L2-regularization constant.
    * @param fitIntercept Intercept term flag.
    */
-  SoftmaxRegressionFunction(const arma::mat& data,
-                            const arma::Row<size_t>& labels,
-                            const size_t numClasses,
-                            const double lambda = 0.0001,
-                            const bool fitIntercept = false);
+  SoftmaxRegressionFunctionType(const MatType& data,
+                                const arma::Row<size_t>& labels,
+                                const size_t numClasses,
+                                const double lambda = 0.0001,
+                                const bool fitIntercept = false);
 
   //! Initializes the parameters of the model to suitable values.
   const arma::mat InitializeWeights();
@@ -89,6 +98,21 @@ class SoftmaxRegressionFunction
   void GetProbabilitiesMatrix(const arma::mat& parameters,
                               arma::mat& probabilities) const;
 
+  /**
+   * Evaluate the probabilities matrix with the passed parameters for the
+   * training examples begin, ..., begin + batchSize - 1 only.  Column j of
+   * the result holds the class probabilities of example begin + j.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param probabilities Pointer to arma::mat which stores the probabilities.
+   * @param begin Index of the first training example in the batch.
+   * @param batchSize Number of training examples in the batch.
+   */
+  void GetProbabilitiesMatrix(const arma::mat& parameters,
+                              arma::mat& probabilities,
+                              const size_t begin,
+                              const size_t batchSize) const;
+
   /**
    * Evaluates the objective function of the softmax regression model using the
    * given parameters. The cost function has terms for the log likelihood error
@@ -100,6 +124,20 @@ class SoftmaxRegressionFunction
    */
   double Evaluate(const arma::mat& parameters) const;
 
+  /**
+   * Evaluates the objective function of the softmax regression model on the
+   * training examples begin, ..., begin + batchSize - 1.  Each example gets
+   * 1 / n of the regularization cost, so the sum over batches covering all of
+   * the examples is Evaluate(parameters).
+   *
+   * @param parameters Current values of the model parameters.
+   * @param begin Index of the first training example in the batch.
+   * @param batchSize Number of training examples in the batch.
+   */
+  double Evaluate(const arma::mat& parameters,
+                  const size_t begin,
+                  const size_t batchSize) const;
+
   /**
    * Evaluates the gradient values of the objective function given the current
    * set of parameters. The function calculates the probabilities for each class
@@ -111,6 +149,22 @@ class SoftmaxRegressionFunction
    */
   void Gradient(const arma::mat& parameters, arma::mat& gradient) const;
 
+  /**
+   * Evaluates the gradient of the objective function on the training examples
+   * begin, ..., begin + batchSize - 1.  As with the batch Evaluate(), each
+   * example gets 1 / n of the regularization term, so the sum over batches
+   * covering all of the examples is the full gradient.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param begin Index of the first training example in the batch.
+   * @param gradient Matrix where gradient values will be stored.
+   * @param batchSize Number of training examples in the batch.
+   */
+  void Gradient(const arma::mat& parameters,
+                const size_t begin,
+                arma::mat& gradient,
+                const size_t batchSize) const;
+
   /**
    * Evaluates the gradient values of the objective function given the current
    * set of parameters for a single feature indexed by j.
@@ -127,6 +181,9 @@ class SoftmaxRegressionFunction
   //! Return the initial point for the optimization.
   const arma::mat& GetInitialPoint() const { return initialPoint; }
 
+  //! Return the number of separable functions (the number of examples).
+  size_t NumFunctions() const { return data.n_cols; }
+
   //! Gets the number of classes.
   size_t NumClasses() const { return numClasses; }
 
@@ -146,7 +203,7 @@ class SoftmaxRegressionFunction
 
  private:
   //! Training data matrix.
-  const arma::mat& data;
+  const MatType& data;
   //! Label matrix for the provided data.
   arma::sp_mat groundTruth;
   //! Initial parameter point.
@@ -159,7 +216,13 @@ class SoftmaxRegressionFunction
   bool fitIntercept;
 };
 
+//! The softmax regression objective function on dense data.
+typedef SoftmaxRegressionFunctionType<arma::mat> SoftmaxRegressionFunction;
+
 } // namespace regression
 } // namespace mlpack
 
+// Include implementation.
+#include "softmax_regression_function_impl.hpp"
+
 #endif
@@ -1,5 +1,5 @@
 /**
- * @file softmax_regression_function.cpp
+ * @file softmax_regression_function_impl.hpp
  * @author Siddharth Agrawal
  *
  * Implementation of function to be optimized for softmax regression.
@@ -9,13 +9,18 @@
  * 3-clause BSD license along with mlpack.  If not, see
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
+#ifndef MLPACK_METHODS_SOFTMAX_REGRESSION_SOFTMAX_REGRESSION_FUNCTION_IMPL_HPP
+#define MLPACK_METHODS_SOFTMAX_REGRESSION_SOFTMAX_REGRESSION_FUNCTION_IMPL_HPP
+
+// In case it hasn't been included yet.
 #include "softmax_regression_function.hpp"
 
-using namespace mlpack;
-using namespace mlpack::regression;
+namespace mlpack {
+namespace regression {
 
-SoftmaxRegressionFunction::SoftmaxRegressionFunction(
-    const arma::mat& data,
+template<typename MatType>
+SoftmaxRegressionFunctionType<MatType>::SoftmaxRegressionFunctionType(
+    const MatType& data,
     const arma::Row<size_t>& labels,
     const size_t numClasses,
     const double lambda,
@@ -37,12 +42,14 @@ SoftmaxRegressionFunction::SoftmaxRegressionFunction(
  * normal distribution. The weights cannot be initialized to zero, as that will
  * lead to each class output being the same.
  */
-const arma::mat SoftmaxRegressionFunction::InitializeWeights()
+template<typename MatType>
+const arma::mat SoftmaxRegressionFunctionType<MatType>::InitializeWeights()
 {
   return InitializeWeights(data.n_rows, numClasses, fitIntercept);
 }
 
-const arma::mat SoftmaxRegressionFunction::InitializeWeights(
+template<typename MatType>
+const arma::mat SoftmaxRegressionFunctionType<MatType>::InitializeWeights(
     const size_t featureSize,
     const size_t numClasses,
     const bool fitIntercept)
@@ -52,7 +59,8 @@ const arma::mat SoftmaxRegressionFunction::InitializeWeights(
     return parameters;
 }
 
-void SoftmaxRegressionFunction::InitializeWeights(
+template<typename MatType>
+void SoftmaxRegressionFunctionType<MatType>::InitializeWeights(
     arma::mat &weights,
     const size_t featureSize,
     const size_t numClasses,
@@ -73,7 +81,8 @@ void SoftmaxRegressionFunction::InitializeWeights(
  * labels. The output is in the form of a matrix, which leads to simpler
  * calculations in the Evaluate() and Gradient() methods.
  */
-void SoftmaxRegressionFunction::GetGroundTruthMatrix(
+template<typename MatType>
+void SoftmaxRegressionFunctionType<MatType>::GetGroundTruthMatrix(
     const arma::Row<size_t>& labels, arma::sp_mat& groundTruth)
 {
   // Calculate the ground truth matrix according to the labels passed. The
@@ -106,7 +115,8 @@ void SoftmaxRegressionFunction::GetGroundTruthMatrix(
  * Evaluate the probabilities matrix. If fitIntercept flag is true,
  * it should consider the parameters.cols(0) intercept term.
  */
-void SoftmaxRegressionFunction::GetProbabilitiesMatrix(
+template<typename MatType>
+void SoftmaxRegressionFunctionType<MatType>::GetProbabilitiesMatrix(
     const arma::mat& parameters,
     arma::mat& probabilities) const
 {
@@ -132,10 +142,40 @@ void SoftmaxRegressionFunction::GetProbabilitiesMatrix(
                                             numClasses, 1);
 }
 
+/**
+ * Evaluate the probabilities matrix of a contiguous batch of examples.
+ */
+template<typename MatType>
+void SoftmaxRegressionFunctionType<MatType>::GetProbabilitiesMatrix(
+    const arma::mat& parameters,
+    arma::mat& probabilities,
+    const size_t begin,
+    const size_t batchSize) const
+{
+  arma::mat hypothesis;
+
+  // The columns of the batch are contiguous, so no copy of the data is needed.
+  const size_t end = begin + batchSize - 1;
+  if (fitIntercept)
+  {
+    hypothesis = arma::exp(arma::repmat(parameters.col(0), 1, batchSize) +
+        parameters.cols(1, parameters.n_cols - 1) * data.cols(begin, end));
+  }
+  else
+  {
+    hypothesis = arma::exp(parameters * data.cols(begin, end));
+  }
+
+  probabilities = hypothesis / arma::repmat(arma::sum(hypothesis, 0),
+                                            numClasses, 1);
+}
+
 /**
  * Evaluates the objective function given the parameters.
  */
-double SoftmaxRegressionFunction::Evaluate(const arma::mat& parameters) const
+template<typename MatType>
+double SoftmaxRegressionFunctionType<MatType>::Evaluate(
+    const arma::mat& parameters) const
 {
   // The objective function is the negative log likelihood of the model
   // calculated over all the training examples. Mathematically it is as follows:
@@ -170,11 +210,35 @@ double SoftmaxRegressionFunction::Evaluate(const arma::mat& parameters) const
   return cost;
 }
 
+/**
+ * Evaluates the objective function on a batch of examples.
+ */
+template<typename MatType>
+double SoftmaxRegressionFunctionType<MatType>::Evaluate(
+    const arma::mat& parameters,
+    const size_t begin,
+    const size_t batchSize) const
+{
+  arma::mat probabilities;
+  GetProbabilitiesMatrix(parameters, probabilities, begin, batchSize);
+
+  const arma::sp_mat batchGroundTruth = groundTruth.cols(begin,
+      begin + batchSize - 1);
+  const double logLikelihood = arma::accu(batchGroundTruth %
+      arma::log(probabilities)) / data.n_cols;
+  const double weightDecay = 0.5 * lambda * (double(batchSize) / data.n_cols) *
+      arma::accu(parameters % parameters);
+
+  return -logLikelihood + weightDecay;
+}
+
 /**
  * Calculates and stores the gradient values given a set of parameters.
  */
-void SoftmaxRegressionFunction::Gradient(const arma::mat& parameters,
-                                         arma::mat& gradient) const
+template<typename MatType>
+void SoftmaxRegressionFunctionType<MatType>::Gradient(
+    const arma::mat& parameters,
+    arma::mat& gradient) const
 {
   // Calculate the class probabilities for each training example. The
   // probabilities for each of the classes are given by:
@@ -206,9 +270,42 @@ void SoftmaxRegressionFunction::Gradient(const arma::mat& parameters,
   }
 }
 
-void SoftmaxRegressionFunction::PartialGradient(const arma::mat& parameters,
-                                                const size_t j,
-                                                arma::sp_mat& gradient) const
+template<typename MatType>
+void SoftmaxRegressionFunctionType<MatType>::Gradient(
+    const arma::mat& parameters,
+    const size_t begin,
+    arma::mat& gradient,
+    const size_t batchSize) const
+{
+  arma::mat probabilities;
+  GetProbabilitiesMatrix(parameters, probabilities, begin, batchSize);
+
+  const size_t end = begin + batchSize - 1;
+  const double regularization = lambda * (double(batchSize) / data.n_cols);
+  const arma::sp_mat batchGroundTruth = groundTruth.cols(begin, end);
+  const arma::mat inner = probabilities - batchGroundTruth;
+
+  gradient.set_size(parameters.n_rows, parameters.n_cols);
+  if (fitIntercept)
+  {
+    gradient.col(0) = arma::sum(inner, 1) / data.n_cols +
+        regularization * parameters.col(0);
+    gradient.cols(1, parameters.n_cols - 1) =
+        inner * data.cols(begin, end).t() / data.n_cols +
+        regularization * parameters.cols(1, parameters.n_cols - 1);
+  }
+  else
+  {
+    gradient = inner * data.cols(begin, end).t() / data.n_cols +
+        regularization * parameters;
+  }
+}
+
+template<typename MatType>
+void SoftmaxRegressionFunctionType<MatType>::PartialGradient(
+    const arma::mat& parameters,
+    const size_t j,
+    arma::sp_mat& gradient) const
 {
   gradient.zeros(arma::size(parameters));
 
@@ -237,3 +334,8 @@ void SoftmaxRegressionFunction::PartialGradient(const arma::mat& parameters,
         parameters.col(j);
   }
 }
+
+} // namespace regression
+} // namespace mlpack
+
+#endif
@@ -37,25 +37,43 @@ SparseCoding::SparseCoding(
 void SparseCoding::Encode(const arma::mat& data, arma::mat& codes)
 {
   // When using the Cholesky version of LARS, this is correct even if
-  // lambda2 > 0.
-  arma::mat matGram = trans(dictionary) * dictionary;
+  // lambda2 > 0.  The Gram matrix is computed once and shared by all threads.
+  const arma::mat matGram = trans(dictionary) * dictionary;
 
   codes.set_size(atoms, data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
+  Log::Debug << "Encoding " << data.n_cols << " points." << std::endl;
+
+  // The points are coded independently, so each thread codes a different set
+  // of points with its own LARS object, which is reused for every point.  The
+  // LARS objects are quiet, so the points where LARS hit a singularity are
+  // counted and reported once afterwards.
+  size_t singularPoints = 0;
+  #pragma omp parallel reduction(+:singularPoints)
   {
-    // Report progress.
-    if ((i % 100) == 0)
-      Log::Debug << "Optimization at point " << i << "." << std::endl;
-
-    bool useCholesky = true;
+    const bool useCholesky = true;
     regression::LARS lars(useCholesky, matGram, lambda1, lambda2);
+    lars.Quiet() = true;
+    arma::rowvec responses(data.n_rows);
+
+    #pragma omp for schedule(dynamic, 16)
+    for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+    {
+      // Create an alias of the code (using the same memory), and then LARS
+      // will place the result directly into that; then we will not need to
+      // have an extra copy.
+      arma::vec code = codes.unsafe_col(i);
+      responses = data.col(i).t();
+      lars.Train(dictionary, responses, code, false);
+      if (!lars.IgnoreSet().empty())
+        ++singularPoints;
+    }
+  }
 
-    // Create an alias of the code (using the same memory), and then LARS will
-    // place the result directly into that; then we will not need to have an
-    // extra copy.
-    arma::vec code = codes.unsafe_col(i);
-    arma::rowvec responses = data.unsafe_col(i).t();
-    lars.Train(dictionary, responses, code, false);
+  if (singularPoints > 0)
+  {
+    Log::Warn << "SparseCoding::Encode(): LARS encountered a singularity for "
+        << singularPoints << " point(s); the offending atoms were not used for "
+        << "those points." << std::endl;
   }
 }
 
@@ -32,6 +32,20 @@ class SparseSVMFunction{
    */
   double Evaluate(const arma::mat& parameters, size_t id);
 
+  /**
+   * Evaluate the hinge loss function on the datapoints begin, ..., begin +
+   * batchSize - 1.  This is the sum of Evaluate(parameters, id) over the
+   * points in the batch.
+   *
+   * @param parameters The parameters of the SVM.
+   * @param begin Index of the first datapoint in the batch.
+   * @param batchSize Number of datapoints in the batch.
+   * @return The sum of the loss function over the batch.
+   */
+  double Evaluate(const arma::mat& parameters,
+                  const size_t begin,
+                  const size_t batchSize);
+
   /**
    * Evaluate the gradient the gradient of the hinge loss function, following
    * the SparseFunctionType requirements on the Gradient function.
@@ -43,6 +57,20 @@ class SparseSVMFunction{
   template <typename GradType>
   void Gradient(const arma::mat& parameters, size_t id, GradType& gradient);
 
+  /**
+   * Evaluate the sum of the gradients of the hinge loss function on the
+   * datapoints begin, ..., begin + batchSize - 1.
+   *
+   * @param parameters The parameters of the SVM.
+   * @param begin Index of the first datapoint in the batch.
+   * @param gradient Matrix to output the gradient into.
+   * @param batchSize Number of datapoints in the batch.
+   */
+  void Gradient(const arma::mat& parameters,
+                const size_t begin,
+                arma::mat& gradient,
+                const size_t batchSize);
+
   //! Return the initial point for the optimization.
   const arma::mat& InitialPoint() const { return initialPoint; }
   //! Modify the initial point for the optimization.
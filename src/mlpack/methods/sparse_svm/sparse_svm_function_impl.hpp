@@ -27,6 +27,19 @@ double SparseSVMFunction::Evaluate(const arma::mat& parameters, size_t id)
   return std::max(0.0, 1 - labels(id) * arma::dot(dataset.col(id), parameters));
 }
 
+double SparseSVMFunction::Evaluate(const arma::mat& parameters,
+                                   const size_t begin,
+                                   const size_t batchSize)
+{
+  // Compute the margins of the whole batch at once; the columns of the batch
+  // are contiguous in the sparse matrix.
+  const arma::rowvec margins = 1 - labels.subvec(begin,
+      begin + batchSize - 1).t() % (parameters.t() *
+      dataset.cols(begin, begin + batchSize - 1));
+
+  return arma::accu(arma::clamp(margins, 0.0, DBL_MAX));
+}
+
 template <typename GradType>
 void SparseSVMFunction::Gradient(
     const arma::mat& parameters, size_t id, GradType& gradient)
@@ -37,6 +50,27 @@ void SparseSVMFunction::Gradient(
     (-1 * GradType(dataset.col(id) * labels(id)));
 }
 
+void SparseSVMFunction::Gradient(const arma::mat& parameters,
+                                 const size_t begin,
+                                 arma::mat& gradient,
+                                 const size_t batchSize)
+{
+  // Each point with a non-negative margin contributes -y_i x_i to the gradient,
+  // so the gradient of the batch is a weighted sum of its columns.
+  const arma::vec batchLabels = labels.subvec(begin, begin + batchSize - 1);
+  const arma::rowvec margins = 1 - batchLabels.t() % (parameters.t() *
+      dataset.cols(begin, begin + batchSize - 1));
+
+  arma::vec weights = -batchLabels;
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    if (margins[i] < 0)
+      weights[i] = 0.0;
+  }
+
+  gradient = dataset.cols(begin, begin + batchSize - 1) * weights;
+}
+
 size_t SparseSVMFunction::NumFunctions()
 {
   // The number of points in the dataset is the number of functions, as this
@@ -1120,4 +1120,52 @@ BOOST_AUTO_TEST_CASE(CppNameTest)
   BOOST_REQUIRE_EQUAL(CLI::Parameters().at("double").cppType, "double");
 }
 
+/**
+ * Make sure that each CLIContext has its own parameters and timers, and that
+ * the process-wide parameters are not touched while contexts are used.
+ */
+BOOST_AUTO_TEST_CASE(CLIContextTest)
+{
+  AddRequiredCLIOptions();
+
+  PARAM_INT_IN("int", "Test int", "i", 0);
+  CLI::StoreSettings("cli_context_test");
+
+  // Run several "programs" at once, each with a different value.
+  const size_t numContexts = 16;
+  arma::Col<size_t> values(numContexts);
+  arma::Col<size_t> passed(numContexts);
+  arma::Col<size_t> timers(numContexts);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) numContexts; ++i)
+  {
+    CLIContext context("cli_context_test");
+    CLI::GetParam<int>("int") += (int) i;
+    CLI::SetPassed("int");
+    Timer::Start("context_timer");
+    Timer::Stop("context_timer");
+
+    values[i] = (size_t) CLI::GetParam<int>("int");
+    passed[i] = CLI::HasParam("int") ? 1 : 0;
+    timers[i] = CLI::GetSingleton().timer.GetAllTimers().size();
+  }
+
+  for (size_t i = 0; i < numContexts; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(values[i], i);
+    BOOST_REQUIRE_EQUAL(passed[i], 1);
+    BOOST_REQUIRE_EQUAL(timers[i], 1);
+  }
+
+  // The process-wide parameters and timers are unchanged.
+  BOOST_REQUIRE_EQUAL(CLI::Parameters().count("int"), 0);
+  BOOST_REQUIRE_EQUAL(
+      CLI::GetSingleton().timer.GetAllTimers().count("context_timer"), 0);
+
+  // The stored settings are unchanged too.
+  CLI::RestoreSettings("cli_context_test");
+  BOOST_REQUIRE(!CLI::HasParam("int"));
+  BOOST_REQUIRE_EQUAL(CLI::GetParam<int>("int"), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
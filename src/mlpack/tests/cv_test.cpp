@@ -522,4 +522,50 @@ BOOST_AUTO_TEST_CASE(KFoldCVWithDTTest)
   }
 }
 
+/**
+ * Make sure that k-fold cross-validation gives the same results whether the
+ * folds are run in parallel or not, for a model that draws random numbers
+ * during training (SoftmaxRegression initializes its parameters randomly).
+ */
+BOOST_AUTO_TEST_CASE(KFoldCVParallelTest)
+{
+  arma::mat data = arma::randu<arma::mat>(5, 200);
+  arma::Row<size_t> labels(200);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    labels[i] = (data(0, i) + data(1, i) > 1.0) ? 1 : 0;
+  const size_t numClasses = 2;
+
+  KFoldCV<SoftmaxRegression, Accuracy> cv(5, data, labels, numClasses);
+  BOOST_REQUIRE_EQUAL(cv.Parallel(), false);
+
+  math::RandomSeed(42);
+  const double serialAccuracy = cv.Evaluate(0.01);
+  const arma::mat serialParameters = cv.Model().Parameters();
+
+#ifdef HAS_OPENMP
+  // Use at least four threads, even on machines with few cores.
+  const size_t prevNumThreads = omp_get_max_threads();
+  omp_set_num_threads(std::max(prevNumThreads, (size_t) 4));
+#endif
+
+  cv.Parallel() = true;
+  math::RandomSeed(42);
+  const double parallelAccuracy = cv.Evaluate(0.01);
+  const arma::mat parallelParameters = cv.Model().Parameters();
+
+#ifdef HAS_OPENMP
+  omp_set_num_threads(prevNumThreads);
+#endif
+
+  BOOST_REQUIRE_CLOSE(parallelAccuracy, serialAccuracy, 1e-10);
+  BOOST_REQUIRE_EQUAL(parallelParameters.n_elem, serialParameters.n_elem);
+  for (size_t i = 0; i < serialParameters.n_elem; ++i)
+  {
+    if (std::abs(serialParameters[i]) < 1e-10)
+      BOOST_REQUIRE_SMALL(parallelParameters[i], 1e-10);
+    else
+      BOOST_REQUIRE_CLOSE(parallelParameters[i], serialParameters[i], 1e-10);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -271,4 +271,90 @@ BOOST_AUTO_TEST_CASE(GaussiansSingleModeTest)
   }
 }
 
+/**
+ * Make sure that a non-core point between two clusters doesn't merge them, and
+ * is assigned to the cluster of its lowest-index core neighbor.
+ */
+BOOST_AUTO_TEST_CASE(BorderPointTest)
+{
+  arma::mat points("0.7 0.0 0.1 0.2 0.3 1.1 1.2 1.3 1.4");
+
+  DBSCAN<> d(0.45, 4);
+
+  arma::Row<size_t> assignments;
+  const size_t clusters = d.Cluster(points, assignments);
+
+  BOOST_REQUIRE_EQUAL(clusters, 2);
+  for (size_t i = 1; i < 5; ++i)
+    BOOST_REQUIRE_EQUAL(assignments[i], 0);
+  for (size_t i = 5; i < 9; ++i)
+    BOOST_REQUIRE_EQUAL(assignments[i], 1);
+
+  // The point at 0.7 is within epsilon of 0.3 and 1.1, but it only has three
+  // points in its neighborhood.
+  BOOST_REQUIRE_EQUAL(assignments[0], 0);
+}
+
+/**
+ * Check that batch and single mode give exactly the same results when the
+ * dataset is large enough to be processed in multiple blocks.
+ */
+BOOST_AUTO_TEST_CASE(BatchSingleModeBlockTest)
+{
+  arma::mat points(2, 10000, arma::fill::randu);
+
+  DBSCAN<> d1(0.02, 5);
+  DBSCAN<> d2(0.02, 5, false);
+
+  arma::Row<size_t> assignments1, assignments2;
+  const size_t clusters1 = d1.Cluster(points, assignments1);
+  const size_t clusters2 = d2.Cluster(points, assignments2);
+
+  BOOST_REQUIRE_GT(clusters1, 0);
+  BOOST_REQUIRE_EQUAL(clusters1, clusters2);
+  BOOST_REQUIRE_EQUAL(assignments1.n_elem, assignments2.n_elem);
+  for (size_t i = 0; i < assignments1.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(assignments1[i], assignments2[i]);
+}
+
+#ifdef HAS_OPENMP
+
+/**
+ * Check that searching the sub-blocks of each block in parallel gives the same
+ * results as searching them with a single thread, in batch and single mode.
+ */
+BOOST_AUTO_TEST_CASE(ParallelSearchTest)
+{
+  arma::mat points(2, 10000, arma::fill::randu);
+
+  // Use at least four threads, so that each block is split even on machines
+  // with few cores.
+  const size_t prevNumThreads = omp_get_max_threads();
+  omp_set_num_threads(std::max(prevNumThreads, (size_t) 4));
+
+  DBSCAN<> batch(0.02, 5);
+  DBSCAN<> single(0.02, 5, false);
+  arma::Row<size_t> batchAssignments, singleAssignments;
+  const size_t batchClusters = batch.Cluster(points, batchAssignments);
+  const size_t singleClusters = single.Cluster(points, singleAssignments);
+
+  omp_set_num_threads(1);
+  DBSCAN<> sequential(0.02, 5);
+  arma::Row<size_t> sequentialAssignments;
+  const size_t sequentialClusters = sequential.Cluster(points,
+      sequentialAssignments);
+  omp_set_num_threads(prevNumThreads);
+
+  BOOST_REQUIRE_GT(sequentialClusters, 0);
+  BOOST_REQUIRE_EQUAL(batchClusters, sequentialClusters);
+  BOOST_REQUIRE_EQUAL(singleClusters, sequentialClusters);
+  for (size_t i = 0; i < sequentialAssignments.n_elem; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(batchAssignments[i], sequentialAssignments[i]);
+    BOOST_REQUIRE_EQUAL(singleAssignments[i], sequentialAssignments[i]);
+  }
+}
+
+#endif
+
 BOOST_AUTO_TEST_SUITE_END();
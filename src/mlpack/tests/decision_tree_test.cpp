@@ -13,6 +13,7 @@
 #include <mlpack/methods/decision_tree/decision_tree.hpp>
 #include <mlpack/methods/decision_tree/information_gain.hpp>
 #include <mlpack/methods/decision_tree/gini_gain.hpp>
+#include <mlpack/methods/decision_tree/histogram_numeric_split.hpp>
 #include <mlpack/methods/decision_tree/random_dimension_select.hpp>
 #include <mlpack/methods/decision_tree/multiple_random_dimension_select.hpp>
 
@@ -367,6 +368,182 @@ BOOST_AUTO_TEST_CASE(BestBinaryNumericSplitNoGainTest)
   BOOST_REQUIRE_EQUAL(classProbabilities.n_elem, 0);
 }
 
+/**
+ * Check that the HistogramNumericSplit will split on an obviously splittable
+ * dimension, and that the split point lies between the two groups.
+ */
+BOOST_AUTO_TEST_CASE(HistogramNumericSplitSimpleSplitTest)
+{
+  arma::vec values("0.0 0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8 0.9 1.0");
+  arma::Row<size_t> labels("0 0 0 0 0 1 1 1 1 1 1");
+  arma::rowvec weights(labels.n_elem);
+  weights.ones();
+
+  arma::vec classProbabilities;
+  Histogram256NumericSplit<GiniGain>::template AuxiliarySplitInfo<double> aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain = Histogram256NumericSplit<GiniGain>::SplitIfBetter<false>(
+      bestGain, values, labels, 2, weights, 3, classProbabilities, aux);
+  const double weightedGain =
+      Histogram256NumericSplit<GiniGain>::SplitIfBetter<true>(bestGain, values,
+      labels, 2, weights, 3, classProbabilities, aux);
+
+  // Make sure that a split was made, and that it is perfect.
+  BOOST_REQUIRE_GT(gain, bestGain);
+  BOOST_REQUIRE_EQUAL(gain, weightedGain);
+  BOOST_REQUIRE_SMALL(gain, 1e-5);
+
+  BOOST_REQUIRE_EQUAL(classProbabilities.n_elem, 1);
+  BOOST_REQUIRE_GT(classProbabilities[0], 0.4);
+  BOOST_REQUIRE_LT(classProbabilities[0], 0.5);
+
+  // With only a few bins, the same split must still be found, since 0.4 and 0.5
+  // fall into different bins.
+  HistogramNumericSplit<GiniGain, 4>::template AuxiliarySplitInfo<double> aux4;
+  const double gain4 = HistogramNumericSplit<GiniGain, 4>::SplitIfBetter<false>(
+      bestGain, values, labels, 2, weights, 3, classProbabilities, aux4);
+  BOOST_REQUIRE_SMALL(gain4, 1e-5);
+}
+
+/**
+ * Check that the HistogramNumericSplit won't split if not enough points are
+ * given.
+ */
+BOOST_AUTO_TEST_CASE(HistogramNumericSplitMinSamplesTest)
+{
+  arma::vec values("0.0 0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8 0.9 1.0");
+  arma::Row<size_t> labels("0 0 0 0 0 1 1 1 1 1 1");
+  arma::rowvec weights(labels.n_elem, arma::fill::ones);
+
+  arma::vec classProbabilities;
+  Histogram256NumericSplit<GiniGain>::template AuxiliarySplitInfo<double> aux;
+
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain = Histogram256NumericSplit<GiniGain>::SplitIfBetter<false>(
+      bestGain, values, labels, 2, weights, 8, classProbabilities, aux);
+
+  // Make sure that no split was made.
+  BOOST_REQUIRE_EQUAL(gain, bestGain);
+  BOOST_REQUIRE_EQUAL(classProbabilities.n_elem, 0);
+}
+
+/**
+ * Make sure a decision tree built with the histogram split generalizes about as
+ * well as one built with the exact split.
+ */
+BOOST_AUTO_TEST_CASE(HistogramSplitGeneralizationTest)
+{
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    BOOST_FAIL("Cannot load test dataset vc2.csv!");
+
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    BOOST_FAIL("Cannot load labels for vc2_labels.txt");
+
+  DecisionTree<GiniGain, Histogram256NumericSplit> d(inputData, labels, 3, 10);
+
+  arma::mat testData;
+  if (!data::Load("vc2_test.csv", testData))
+    BOOST_FAIL("Cannot load test dataset vc2_test.csv!");
+
+  arma::Mat<size_t> trueTestLabels;
+  if (!data::Load("vc2_test_labels.txt", trueTestLabels))
+    BOOST_FAIL("Cannot load labels for vc2_test_labels.txt");
+
+  arma::Row<size_t> predictions;
+  d.Classify(testData, predictions);
+
+  BOOST_REQUIRE_EQUAL(predictions.n_elem, testData.n_cols);
+
+  double correct = 0.0;
+  for (size_t i = 0; i < predictions.n_elem; ++i)
+    if (predictions[i] == trueTestLabels[i])
+      ++correct;
+  correct /= predictions.n_elem;
+
+  BOOST_REQUIRE_GT(correct, 0.75);
+}
+
+/**
+ * Check that HistogramNumericSplit::Bin() gives each distinct value its own bin
+ * when there are few distinct values, and that the codes match the thresholds.
+ */
+BOOST_AUTO_TEST_CASE(HistogramNumericSplitBinTest)
+{
+  arma::mat data("3 1 2 1 3 2 2;"
+                 "5 5 5 5 5 5 5");
+
+  arma::Mat<uint8_t> codes;
+  std::vector<arma::vec> thresholds;
+  Histogram256NumericSplit<GiniGain>::Bin(data, codes, thresholds);
+
+  BOOST_REQUIRE_EQUAL(codes.n_rows, 2);
+  BOOST_REQUIRE_EQUAL(codes.n_cols, 7);
+  BOOST_REQUIRE_EQUAL(thresholds.size(), 2);
+
+  // The first dimension has three distinct values, so two boundaries.
+  BOOST_REQUIRE_EQUAL(thresholds[0].n_elem, 2);
+  BOOST_REQUIRE_CLOSE(thresholds[0][0], 1.5, 1e-5);
+  BOOST_REQUIRE_CLOSE(thresholds[0][1], 2.5, 1e-5);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    BOOST_REQUIRE_EQUAL((size_t) codes(0, i), (size_t) data(0, i) - 1);
+
+  // The second dimension is constant, so it has a single bin.
+  BOOST_REQUIRE_EQUAL(thresholds[1].n_elem, 0);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    BOOST_REQUIRE_EQUAL((size_t) codes(1, i), 0);
+}
+
+/**
+ * Make sure a tree with the histogram split, which is trained on pre-binned
+ * data, can fit a training set exactly when every value has its own bin.
+ */
+BOOST_AUTO_TEST_CASE(HistogramSplitPerfectTrainingSet)
+{
+  // Completely random dataset with no structure.
+  arma::mat dataset(10, 200, arma::fill::randu);
+  arma::Row<size_t> labels(200);
+  for (size_t i = 0; i < 200; ++i)
+    labels[i] = i % 3; // 3 classes.
+  arma::rowvec weights(labels.n_elem);
+  weights.ones();
+
+  // Minimum leaf size of 1.
+  DecisionTree<GiniGain, Histogram256NumericSplit> d(dataset, labels, 3, 1);
+  DecisionTree<GiniGain, Histogram256NumericSplit> dw(dataset, labels, 3,
+      weights, 1);
+
+  // Make sure that we can get perfect accuracy on the training set.
+  for (size_t i = 0; i < 200; ++i)
+  {
+    size_t prediction, weightedPrediction;
+    arma::vec probabilities, weightedProbabilities;
+    d.Classify(dataset.col(i), prediction, probabilities);
+    dw.Classify(dataset.col(i), weightedPrediction, weightedProbabilities);
+
+    BOOST_REQUIRE_EQUAL(prediction, labels[i]);
+    BOOST_REQUIRE_EQUAL(weightedPrediction, labels[i]);
+    BOOST_REQUIRE_EQUAL(probabilities.n_elem, 3);
+    BOOST_REQUIRE_EQUAL(weightedProbabilities.n_elem, 3);
+    for (size_t j = 0; j < 3; ++j)
+    {
+      if (labels[i] == j)
+      {
+        BOOST_REQUIRE_CLOSE(probabilities[j], 1.0, 1e-5);
+        BOOST_REQUIRE_CLOSE(weightedProbabilities[j], 1.0, 1e-5);
+      }
+      else
+      {
+        BOOST_REQUIRE_SMALL(probabilities[j], 1e-5);
+        BOOST_REQUIRE_SMALL(weightedProbabilities[j], 1e-5);
+      }
+    }
+  }
+}
+
 /**
  * Check that the AllCategoricalSplit will split when the split is obviously
  * better.
@@ -1082,4 +1259,134 @@ BOOST_AUTO_TEST_CASE(ConstDataTest)
       constWeights);
 }
 
+/**
+ * Make sure that a tree with large nodes (which are split using the parallel
+ * dimension search) is built correctly, both with and without categorical
+ * information.
+ */
+BOOST_AUTO_TEST_CASE(LargeNodeSplitTest)
+{
+  // The label depends only on dimension 7, so every tree should be able to
+  // perfectly classify the training set.
+  arma::mat data(10, 10000, arma::fill::randu);
+  arma::Row<size_t> labels(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    labels[i] = (data(7, i) > 0.5) ? 1 : 0;
+
+  data::DatasetInfo datasetInfo(data.n_rows);
+
+  DecisionTree<> dt(data, labels, 2, 5);
+  DecisionTree<> dt2(data, datasetInfo, labels, 2, 5);
+
+  arma::Row<size_t> predictions, predictions2;
+  dt.Classify(data, predictions);
+  dt2.Classify(data, predictions2);
+
+  for (size_t i = 0; i < labels.n_elem; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(predictions[i], labels[i]);
+    BOOST_REQUIRE_EQUAL(predictions2[i], labels[i]);
+  }
+
+  // The perfect split should be found at the root.
+  BOOST_REQUIRE_EQUAL(dt.NumChildren(), 2);
+  BOOST_REQUIRE_EQUAL(dt.Child(0).NumChildren(), 0);
+  BOOST_REQUIRE_EQUAL(dt.Child(1).NumChildren(), 0);
+}
+
+/**
+ * Make sure that classification with the flattened layout of the root gives the
+ * same leaf as walking down the children, also for copied and moved trees.
+ */
+BOOST_AUTO_TEST_CASE(FlattenedTreeClassifyTest)
+{
+  arma::mat dataset(5, 1000, arma::fill::randu);
+  arma::Row<size_t> labels(1000);
+  for (size_t i = 0; i < 1000; ++i)
+    labels[i] = (dataset(0, i) + dataset(1, i) > 1.0) ? 1 : 0;
+
+  DecisionTree<> d(dataset, labels, 2, 5);
+  DecisionTree<> copy(d);
+  DecisionTree<> tmp(d);
+  DecisionTree<> moved(std::move(tmp));
+
+  arma::Row<size_t> predictions, copyPredictions, movedPredictions;
+  arma::mat probabilities;
+  d.Classify(dataset, predictions, probabilities);
+  copy.Classify(dataset, copyPredictions);
+  moved.Classify(dataset, movedPredictions);
+
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    // Find the leaf by hand.
+    const DecisionTree<>* node = &d;
+    while (node->NumChildren() > 0)
+      node = &node->Child(node->CalculateDirection(dataset.col(i)));
+
+    size_t prediction;
+    arma::vec leafProbabilities;
+    node->Classify(dataset.col(i), prediction, leafProbabilities);
+
+    BOOST_REQUIRE_EQUAL(predictions[i], prediction);
+    BOOST_REQUIRE_EQUAL(copyPredictions[i], prediction);
+    BOOST_REQUIRE_EQUAL(movedPredictions[i], prediction);
+    BOOST_REQUIRE_EQUAL(d.Classify(dataset.col(i)), prediction);
+    for (size_t j = 0; j < 2; ++j)
+    {
+      BOOST_REQUIRE_CLOSE(probabilities(j, i) + 1.0,
+          leafProbabilities[j] + 1.0, 1e-5);
+    }
+  }
+}
+
+/**
+ * Make sure that a deep tree is laid out correctly for classification when it
+ * is loaded.
+ */
+BOOST_AUTO_TEST_CASE(DeepTreeSerializationClassifyTest)
+{
+  // Alternating runs of labels along a single dimension force a deep tree.
+  arma::mat dataset(1, 1024);
+  arma::Row<size_t> labels(1024);
+  for (size_t i = 0; i < 1024; ++i)
+  {
+    dataset(0, i) = i;
+    labels[i] = (i / 4) % 2;
+  }
+
+  DecisionTree<> d(dataset, labels, 2, 1);
+
+  // Find the depth of the tree.
+  size_t depth = 0;
+  std::vector<std::pair<const DecisionTree<>*, size_t>> stack;
+  stack.push_back(std::make_pair(&d, 1));
+  while (!stack.empty())
+  {
+    const DecisionTree<>* node = stack.back().first;
+    const size_t nodeDepth = stack.back().second;
+    stack.pop_back();
+    depth = std::max(depth, nodeDepth);
+    for (size_t i = 0; i < node->NumChildren(); ++i)
+      stack.push_back(std::make_pair(&node->Child(i), nodeDepth + 1));
+  }
+  BOOST_REQUIRE_GT(depth, 7);
+
+  DecisionTree<> xmlTree, textTree, binaryTree;
+  SerializeObjectAll(d, xmlTree, textTree, binaryTree);
+
+  arma::Row<size_t> predictions, xmlPredictions, textPredictions,
+      binaryPredictions;
+  arma::mat probabilities, xmlProbabilities, textProbabilities,
+      binaryProbabilities;
+  d.Classify(dataset, predictions, probabilities);
+  xmlTree.Classify(dataset, xmlPredictions, xmlProbabilities);
+  textTree.Classify(dataset, textPredictions, textProbabilities);
+  binaryTree.Classify(dataset, binaryPredictions, binaryProbabilities);
+
+  CheckMatrices(predictions, xmlPredictions, textPredictions,
+      binaryPredictions);
+  CheckMatrices(probabilities, xmlProbabilities, textProbabilities,
+      binaryProbabilities);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -278,4 +278,56 @@ BOOST_AUTO_TEST_CASE(BallTreeTest)
   }
 }
 
+#ifdef HAS_OPENMP
+
+/**
+ * Make sure that the parallel Boruvka rounds give the same spanning tree as a
+ * single thread, with both the kd-tree and the cover tree.
+ */
+BOOST_AUTO_TEST_CASE(ParallelVsSequential)
+{
+  arma::mat inputData;
+  if (!data::Load("test_data_3_1000.csv", inputData))
+    BOOST_FAIL("Cannot load test dataset test_data_3_1000.csv!");
+
+  // Use at least four threads, so that the query tree is split even on
+  // machines with few cores.
+  const size_t prevNumThreads = omp_get_max_threads();
+  omp_set_num_threads(std::max(prevNumThreads, (size_t) 4));
+
+  arma::mat parallelResults, parallelCoverResults;
+  DualTreeBoruvka<> dtb(inputData);
+  dtb.ComputeMST(parallelResults);
+  DualTreeBoruvka<EuclideanDistance, arma::mat, StandardCoverTree>
+      ct(inputData);
+  ct.ComputeMST(parallelCoverResults);
+
+  omp_set_num_threads(1);
+  arma::mat sequentialResults, sequentialCoverResults;
+  DualTreeBoruvka<> dtbSequential(inputData);
+  dtbSequential.ComputeMST(sequentialResults);
+  DualTreeBoruvka<EuclideanDistance, arma::mat, StandardCoverTree>
+      ctSequential(inputData);
+  ctSequential.ComputeMST(sequentialCoverResults);
+  omp_set_num_threads(prevNumThreads);
+
+  BOOST_REQUIRE_EQUAL(parallelResults.n_cols, sequentialResults.n_cols);
+  BOOST_REQUIRE_EQUAL(parallelCoverResults.n_cols, sequentialResults.n_cols);
+  for (size_t i = 0; i < sequentialResults.n_cols; i++)
+  {
+    BOOST_REQUIRE_EQUAL(parallelResults(0, i), sequentialResults(0, i));
+    BOOST_REQUIRE_EQUAL(parallelResults(1, i), sequentialResults(1, i));
+    BOOST_REQUIRE_CLOSE(parallelResults(2, i), sequentialResults(2, i), 1e-5);
+
+    BOOST_REQUIRE_EQUAL(parallelCoverResults(0, i),
+        sequentialCoverResults(0, i));
+    BOOST_REQUIRE_EQUAL(parallelCoverResults(1, i),
+        sequentialCoverResults(1, i));
+    BOOST_REQUIRE_CLOSE(parallelCoverResults(2, i),
+        sequentialCoverResults(2, i), 1e-5);
+  }
+}
+
+#endif
+
 BOOST_AUTO_TEST_SUITE_END();
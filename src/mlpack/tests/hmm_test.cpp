@@ -1173,5 +1173,116 @@ BOOST_AUTO_TEST_CASE(DiscreteHMMLoadSaveTest)
           hmm2.Emission()[j].Probabilities()[i], 1e-3);
 }
 
+/**
+ * Make sure that batch prediction over many sequences gives the same results as
+ * predicting each sequence separately.
+ */
+BOOST_AUTO_TEST_CASE(GaussianHMMBatchPredictTest)
+{
+  HMM<GaussianDistribution> hmm(3, GaussianDistribution(2));
+  hmm.Transition() = arma::mat("0.4 0.6 0.8; 0.2 0.2 0.1; 0.4 0.2 0.1");
+  hmm.Emission()[0] = GaussianDistribution("0.0 0.0", "1.0 0.0; 0.0 1.0");
+  hmm.Emission()[1] = GaussianDistribution("2.0 2.0", "1.0 0.5; 0.5 1.2");
+  hmm.Emission()[2] = GaussianDistribution("-2.0 1.0", "2.0 0.1; 0.1 1.0");
+
+  // Generate a handful of sequences of different lengths.
+  std::vector<arma::mat> observations(20);
+  for (size_t i = 0; i < observations.size(); ++i)
+  {
+    arma::Row<size_t> states;
+    hmm.Generate(50 + 10 * i, observations[i], states, i % 3);
+  }
+
+  std::vector<arma::Row<size_t> > batchStates;
+  arma::vec batchLogLikelihoods;
+  hmm.Predict(observations, batchStates, batchLogLikelihoods);
+
+  BOOST_REQUIRE_EQUAL(batchStates.size(), observations.size());
+  BOOST_REQUIRE_EQUAL(batchLogLikelihoods.n_elem, observations.size());
+  for (size_t i = 0; i < observations.size(); ++i)
+  {
+    arma::Row<size_t> states;
+    const double logLikelihood = hmm.Predict(observations[i], states);
+
+    BOOST_REQUIRE_CLOSE(batchLogLikelihoods[i], logLikelihood, 1e-5);
+    BOOST_REQUIRE_EQUAL(batchStates[i].n_elem, states.n_elem);
+    for (size_t j = 0; j < states.n_elem; ++j)
+      BOOST_REQUIRE_EQUAL(batchStates[i][j], states[j]);
+  }
+}
+
+#ifdef HAS_OPENMP
+
+/**
+ * Make sure that Baum-Welch training with several threads gives the same model
+ * as training with a single thread.
+ */
+BOOST_AUTO_TEST_CASE(GaussianHMMParallelTrainTest)
+{
+  HMM<GaussianDistribution> hmm(3, GaussianDistribution(2));
+  hmm.Transition() = arma::mat("0.4 0.6 0.8; 0.2 0.2 0.1; 0.4 0.2 0.1");
+  hmm.Emission()[0] = GaussianDistribution("0.0 0.0", "1.0 0.0; 0.0 1.0");
+  hmm.Emission()[1] = GaussianDistribution("2.0 2.0", "1.0 0.5; 0.5 1.2");
+  hmm.Emission()[2] = GaussianDistribution("-2.0 1.0", "2.0 0.1; 0.1 1.0");
+
+  std::vector<arma::mat> observations(30);
+  for (size_t i = 0; i < observations.size(); ++i)
+  {
+    arma::Row<size_t> states;
+    hmm.Generate(50 + 5 * i, observations[i], states, i % 3);
+  }
+
+  // Use at least four threads, so that the sequences are split between threads
+  // even on machines with few cores.
+  const size_t prevNumThreads = omp_get_max_threads();
+  omp_set_num_threads(std::max(prevNumThreads, (size_t) 4));
+
+  HMM<GaussianDistribution> parallelHMM(3, GaussianDistribution(2));
+  parallelHMM.Transition() = hmm.Transition();
+  parallelHMM.Emission() = hmm.Emission();
+  HMM<GaussianDistribution> sequentialHMM(parallelHMM);
+  parallelHMM.Train(observations);
+
+  omp_set_num_threads(1);
+  sequentialHMM.Train(observations);
+  omp_set_num_threads(prevNumThreads);
+
+  // The reductions may be done in a different order, so the results are only
+  // equal up to rounding.
+  BOOST_REQUIRE_CLOSE(parallelHMM.LogLikelihood(observations[0]),
+      sequentialHMM.LogLikelihood(observations[0]), 1e-5);
+  CheckMatrices(parallelHMM.Initial(), sequentialHMM.Initial(), 1e-5);
+  CheckMatrices(parallelHMM.Transition(), sequentialHMM.Transition(), 1e-5);
+  for (size_t j = 0; j < 3; ++j)
+  {
+    CheckMatrices(parallelHMM.Emission()[j].Mean(),
+        sequentialHMM.Emission()[j].Mean(), 1e-5);
+    CheckMatrices(parallelHMM.Emission()[j].Covariance(),
+        sequentialHMM.Emission()[j].Covariance(), 1e-5);
+  }
+}
+
+#endif
+
+/**
+ * An invalid observation in one of the sequences must surface as an exception
+ * from Train() and from the batch Predict(), even though the sequences are
+ * processed in parallel.
+ */
+BOOST_AUTO_TEST_CASE(DiscreteHMMInvalidObservationTest)
+{
+  HMM<DiscreteDistribution> hmm(2, DiscreteDistribution(2));
+
+  std::vector<arma::mat> observations(8, arma::mat("0 1 1 0 1 0"));
+  observations[5] = arma::mat("0 1 5 0");
+
+  Log::Fatal.ignoreInput = true;
+  BOOST_REQUIRE_THROW(hmm.Train(observations), std::runtime_error);
+
+  std::vector<arma::Row<size_t> > states;
+  BOOST_REQUIRE_THROW(hmm.Predict(observations, states), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
+
 BOOST_AUTO_TEST_SUITE_END();
 
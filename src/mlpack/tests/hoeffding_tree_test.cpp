@@ -1052,6 +1052,53 @@ BOOST_AUTO_TEST_CASE(BatchTrainingTest)
   BOOST_REQUIRE_GE(batchCorrect, streamCorrect);
 }
 
+/**
+ * Training in streaming mode on a whole matrix (which routes the points to the
+ * leaves and trains the leaves in parallel) must give the same tree as training
+ * on each point one at a time.
+ */
+BOOST_AUTO_TEST_CASE(StreamingMatrixTrainingTest)
+{
+  // Three numeric dimensions and one categorical dimension with 3 categories.
+  arma::mat dataset(4, 9000);
+  arma::Row<size_t> labels(9000);
+  data::DatasetInfo info(4);
+  info.MapString<double>("0", 3);
+  info.MapString<double>("1", 3);
+  info.MapString<double>("2", 3);
+  for (size_t i = 0; i < 9000; ++i)
+  {
+    labels[i] = mlpack::math::RandInt(3);
+    dataset(0, i) = mlpack::math::Random() + 0.5 * labels[i];
+    dataset(1, i) = mlpack::math::Random();
+    dataset(2, i) = mlpack::math::Random() - 0.3 * labels[i];
+    dataset(3, i) = (mlpack::math::Random() < 0.7) ? labels[i] :
+        mlpack::math::RandInt(3);
+  }
+
+  HoeffdingTree<> matrixTree(info, 3, 0.9, 0, 50, 50);
+  matrixTree.Train(dataset, labels, false);
+
+  HoeffdingTree<> pointTree(info, 3, 0.9, 0, 50, 50);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    pointTree.Train(dataset.col(i), labels[i]);
+
+  // Make sure the trees actually split.
+  BOOST_REQUIRE_GT(pointTree.NumChildren(), 0);
+  BOOST_REQUIRE_EQUAL(matrixTree.NumDescendants(), pointTree.NumDescendants());
+
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    size_t matrixPrediction, pointPrediction;
+    double matrixProbability, pointProbability;
+    matrixTree.Classify(dataset.col(i), matrixPrediction, matrixProbability);
+    pointTree.Classify(dataset.col(i), pointPrediction, pointProbability);
+
+    BOOST_REQUIRE_EQUAL(matrixPrediction, pointPrediction);
+    BOOST_REQUIRE_CLOSE(matrixProbability, pointProbability, 1e-5);
+  }
+}
+
 // Make sure that changing the confidence properly propagates to all leaves.
 BOOST_AUTO_TEST_CASE(ConfidenceChangeTest)
 {
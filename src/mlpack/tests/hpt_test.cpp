@@ -17,6 +17,7 @@
 #include <mlpack/core/hpt/hpt.hpp>
 #include <mlpack/core/optimizers/grid_search/grid_search.hpp>
 #include <mlpack/core/optimizers/gradient_descent/gradient_descent.cpp>
+#include <mlpack/core/optimizers/successive_halving/successive_halving.hpp>
 #include <mlpack/methods/lars/lars.hpp>
 #include <mlpack/methods/logistic_regression/logistic_regression.hpp>
 
@@ -99,6 +100,51 @@ class QuadraticFunction
   double a, b, c, d, xMin, yMin, zMin;
 };
 
+/**
+ * This class provides the interface of CV classes with a training fraction, but
+ * its evaluation always throws.
+ */
+template<typename MLAlgorithm,
+         typename Metric = void,
+         typename MatType = void,
+         typename PredictionsType = void,
+         typename WeightsType = void>
+class ThrowingCV
+{
+ public:
+  ThrowingCV() : trainingFraction(1.0) {}
+
+  double Evaluate(double /* x */)
+  {
+    throw std::runtime_error("ThrowingCV::Evaluate()");
+  }
+
+  MLAlgorithm Model()
+  {
+    return MLAlgorithm();
+  }
+
+  double TrainingFraction() const { return trainingFraction; }
+  double& TrainingFraction() { return trainingFraction; }
+
+ private:
+  double trainingFraction;
+};
+
+/**
+ * Make sure that CVFunction restores the training fraction of the CV object
+ * when an evaluation with a budget throws.
+ */
+BOOST_AUTO_TEST_CASE(CVFunctionBudgetExceptionTest)
+{
+  ThrowingCV<LARS> cv;
+  CVFunction<decltype(cv), LARS, 1> cvFun(cv, 0.01, 0.001);
+
+  BOOST_REQUIRE_THROW(cvFun.Evaluate(arma::vec("1.0"), 0.25),
+      std::runtime_error);
+  BOOST_REQUIRE_CLOSE(cv.TrainingFraction(), 1.0, 1e-5);
+}
+
 /**
  * Test CVFunction approximates gradient in the expected way.
  */
@@ -267,6 +313,57 @@ BOOST_AUTO_TEST_CASE(HPTTest)
   BOOST_REQUIRE_CLOSE(expectedObjective, objective, 1e-5);
 }
 
+/**
+ * Test HyperParameterTuner with SuccessiveHalving finds the same parameters as
+ * grid search when the first round has the full budget, and that the returned
+ * objective and model are trained on all of the training data otherwise.
+ */
+BOOST_AUTO_TEST_CASE(HPTSuccessiveHalvingTest)
+{
+  arma::mat xs;
+  arma::rowvec ys;
+  double validationSize;
+  InitProneToOverfittingData(xs, ys, validationSize);
+
+  bool transposeData = true;
+  bool useCholesky = false;
+  arma::vec lambda1Set("0 0.001 0.01 0.1 1.0 10.0 100.0");
+  arma::vec lambda2Set("0.0 0.05 0.5 5.0");
+
+  double expectedLambda1, expectedLambda2, expectedObjective;
+  FindLARSBestLambdas(xs, ys, validationSize, transposeData, useCholesky,
+      lambda1Set, lambda2Set, expectedLambda1, expectedLambda2,
+      expectedObjective);
+
+  double actualLambda1, actualLambda2;
+  HyperParameterTuner<LARS, MSE, SimpleCV, SuccessiveHalving>
+      hpt(validationSize, xs, ys);
+  hpt.Optimizer().MinBudget() = 1.0;
+  std::tie(actualLambda1, actualLambda2) = hpt.Optimize(Fixed(transposeData),
+      Fixed(useCholesky), lambda1Set, lambda2Set);
+
+  BOOST_REQUIRE_CLOSE(expectedObjective, hpt.BestObjective(), 1e-5);
+  BOOST_REQUIRE_CLOSE(expectedLambda1, actualLambda1, 1e-5);
+  BOOST_REQUIRE_CLOSE(expectedLambda2, actualLambda2, 1e-5);
+
+  // Now start with the default (small) budget.
+  HyperParameterTuner<LARS, MSE, SimpleCV, SuccessiveHalving>
+      hpt2(validationSize, xs, ys);
+  std::tie(actualLambda1, actualLambda2) = hpt2.Optimize(Fixed(transposeData),
+      Fixed(useCholesky), lambda1Set, lambda2Set);
+
+  SimpleCV<LARS, MSE> cv(validationSize, xs, ys);
+  double objective = cv.Evaluate(transposeData, useCholesky, actualLambda1,
+      actualLambda2);
+  BOOST_REQUIRE_CLOSE(objective, hpt2.BestObjective(), 1e-5);
+
+  size_t validationFirstColumn = round(xs.n_cols * (1.0 - validationSize));
+  arma::mat validationXs = xs.cols(validationFirstColumn, xs.n_cols - 1);
+  arma::rowvec validationYs = ys.cols(validationFirstColumn, ys.n_cols - 1);
+  BOOST_REQUIRE_CLOSE(objective,
+      MSE::Evaluate(hpt2.BestModel(), validationXs, validationYs), 1e-5);
+}
+
 /**
  * Test HyperParamterTuner maximizes Accuracy rather than minimizes it.
  */
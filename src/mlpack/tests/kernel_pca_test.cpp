@@ -12,6 +12,7 @@
 #include <mlpack/core.hpp>
 #include <mlpack/core/kernels/gaussian_kernel.hpp>
 #include <mlpack/methods/kernel_pca/kernel_rules/nystroem_method.hpp>
+#include <mlpack/methods/kernel_pca/kernel_rules/random_features_method.hpp>
 #include <mlpack/methods/kernel_pca/kernel_pca.hpp>
 
 #include <boost/test/unit_test.hpp>
@@ -150,4 +151,114 @@ BOOST_AUTO_TEST_CASE(CircleTransformationTestNystroem)
   BOOST_REQUIRE_EQUAL(ranges[1].Contains(ranges[2]), false);
 }
 
+/**
+ * Create a dataset with three concentric rings of 250 points in three
+ * dimensions, of radius 0, 2 and 5.
+ */
+static arma::mat CreateRingsDataset()
+{
+  arma::mat dataset;
+  dataset.randn(3, 750);
+  dataset *= 0.05;
+
+  for (size_t i = 250; i < 750; ++i)
+  {
+    const double radius = (i < 500) ? 2.0 : 5.0;
+    dataset.col(i) += radius * (dataset.col(i) / norm(dataset.col(i), 2));
+  }
+
+  return dataset;
+}
+
+/**
+ * With random Fourier features, the first kernel principal component should
+ * separate the inner ring from the outer rings, whose points are too far apart
+ * to be told apart by the approximate Gaussian kernel.  Check this for both
+ * ways of finding the components.
+ */
+BOOST_AUTO_TEST_CASE(CircleTransformationTestRandomFeatures)
+{
+  for (size_t i = 0; i < 2; ++i)
+  {
+    arma::mat dataset = CreateRingsDataset();
+
+    KernelPCA<GaussianKernel, RandomFourierFeaturesRule<GaussianKernel>> p(
+        GaussianKernel(), false,
+        RandomFourierFeaturesRule<GaussianKernel>(256, (i == 1), 100));
+    p.Apply(dataset, 1);
+
+    BOOST_REQUIRE_EQUAL(dataset.n_rows, 1);
+    BOOST_REQUIRE_EQUAL(dataset.n_cols, 750);
+
+    Range inner, outer;
+    for (size_t j = 0; j < 250; ++j)
+      inner |= dataset(0, j);
+    for (size_t j = 250; j < 750; ++j)
+      outer |= dataset(0, j);
+
+    BOOST_REQUIRE_EQUAL(inner.Contains(outer), false);
+  }
+}
+
+/**
+ * Transforming the training points after Apply() should give the transformed
+ * data computed by Apply().
+ */
+BOOST_AUTO_TEST_CASE(RandomFeaturesTransformTest)
+{
+  arma::mat dataset = CreateRingsDataset();
+
+  KernelPCA<LaplacianKernel, RandomFourierFeaturesRule<LaplacianKernel>> p(
+      LaplacianKernel(2.0), false,
+      RandomFourierFeaturesRule<LaplacianKernel>(64, false, 100));
+
+  arma::mat transformedData, eigvec, transformedPoints;
+  arma::vec eigval;
+  p.Apply(dataset, transformedData, eigval, eigvec, 5);
+  p.Transform(dataset, transformedPoints);
+
+  BOOST_REQUIRE_EQUAL(eigval.n_elem, 5);
+  BOOST_REQUIRE_EQUAL(eigvec.n_rows, 64);
+  BOOST_REQUIRE_EQUAL(eigvec.n_cols, 5);
+  BOOST_REQUIRE_EQUAL(transformedPoints.n_rows, 5);
+  BOOST_REQUIRE_EQUAL(transformedPoints.n_cols, 750);
+
+  // The eigenvalues are sorted, and the transformed data is centered.
+  for (size_t i = 1; i < eigval.n_elem; ++i)
+    BOOST_REQUIRE_LE(eigval[i], eigval[i - 1]);
+  for (size_t i = 0; i < transformedData.n_rows; ++i)
+    BOOST_REQUIRE_SMALL(arma::mean(transformedData.row(i)), 1e-8);
+
+  CheckMatrices(transformedData, transformedPoints, 1e-5);
+
+  // Points of the wrong dimensionality can't be transformed.
+  arma::mat points(2, 10, arma::fill::randu);
+  BOOST_REQUIRE_THROW(p.Transform(points, transformedPoints),
+      std::invalid_argument);
+}
+
+/**
+ * With the same random features, the randomized SVD should find the same
+ * leading eigenvalue as the eigendecomposition of the covariance.
+ */
+BOOST_AUTO_TEST_CASE(RandomFeaturesRandomizedSVDTest)
+{
+  arma::mat dataset = CreateRingsDataset();
+
+  arma::mat transformedData, eigvec;
+  arma::vec eigval, rsvdEigval;
+
+  math::RandomSeed(42);
+  RandomFourierFeaturesRule<GaussianKernel> exact(256, false);
+  exact.ApplyKernelMatrix(dataset, transformedData, eigval, eigvec, 3);
+
+  math::RandomSeed(42);
+  RandomFourierFeaturesRule<GaussianKernel> rsvd(256, true);
+  rsvd.ApplyKernelMatrix(dataset, transformedData, rsvdEigval, eigvec, 3);
+
+  BOOST_REQUIRE_EQUAL(rsvdEigval.n_elem, 3);
+  BOOST_REQUIRE_EQUAL(transformedData.n_rows, 3);
+  BOOST_REQUIRE_CLOSE(rsvdEigval[0], eigval[0], 1.0);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
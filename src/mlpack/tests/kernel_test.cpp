@@ -14,6 +14,7 @@
 #include <mlpack/core/kernels/epanechnikov_kernel.hpp>
 #include <mlpack/core/kernels/gaussian_kernel.hpp>
 #include <mlpack/core/kernels/hyperbolic_tangent_kernel.hpp>
+#include <mlpack/core/kernels/kernel_matrix.hpp>
 #include <mlpack/core/kernels/laplacian_kernel.hpp>
 #include <mlpack/core/kernels/linear_kernel.hpp>
 #include <mlpack/core/kernels/polynomial_kernel.hpp>
@@ -608,4 +609,69 @@ BOOST_AUTO_TEST_CASE(PSpectrumStringEvaluateTest)
   BOOST_REQUIRE_CLOSE(p.Evaluate(b, a), 11.0, 1e-5);
 }
 
+/**
+ * Compare the tiled kernel matrices with kernel evaluations of each pair of
+ * points.  The tiles are small, so that the last ones are partial.
+ */
+template<typename KernelType>
+void CheckKernelMatrix(KernelType& kernel)
+{
+  arma::mat a = arma::randu<arma::mat>(4, 50);
+  arma::mat b = arma::randu<arma::mat>(4, 23);
+
+  arma::mat expected(a.n_cols, a.n_cols);
+  for (size_t i = 0; i < a.n_cols; ++i)
+    for (size_t j = 0; j < a.n_cols; ++j)
+      expected(i, j) = kernel.Evaluate(a.col(i), a.col(j));
+
+  arma::mat kernelMatrix;
+  KernelMatrix(a, kernelMatrix, kernel, 7);
+  CheckMatrices(expected, kernelMatrix);
+  BOOST_REQUIRE_EQUAL(arma::accu(kernelMatrix != kernelMatrix.t()), 0);
+
+  // The tiles cover the upper triangle of tiles exactly once.
+  arma::Mat<size_t> covered(a.n_cols, a.n_cols, arma::fill::zeros);
+  KernelMatrixTiles(a, kernel, [&](const size_t rowBegin,
+                                   const size_t colBegin,
+                                   const arma::mat& tile)
+  {
+    #pragma omp critical
+    covered.submat(rowBegin, colBegin, rowBegin + tile.n_rows - 1,
+        colBegin + tile.n_cols - 1) += 1;
+  }, 7);
+  for (size_t i = 0; i < a.n_cols; ++i)
+    for (size_t j = 0; j < a.n_cols; ++j)
+      BOOST_REQUIRE_EQUAL(covered(i, j), (size_t) ((i / 7 <= j / 7) ? 1 : 0));
+
+  expected.set_size(a.n_cols, b.n_cols);
+  for (size_t i = 0; i < a.n_cols; ++i)
+    for (size_t j = 0; j < b.n_cols; ++j)
+      expected(i, j) = kernel.Evaluate(a.col(i), b.col(j));
+
+  KernelMatrix(a, b, kernelMatrix, kernel, 7);
+  CheckMatrices(expected, kernelMatrix);
+}
+
+/**
+ * Test the kernel matrix of kernels with specialized (matrix product) tiles and
+ * of a kernel with the default tiles.
+ */
+BOOST_AUTO_TEST_CASE(KernelMatrixTest)
+{
+  LinearKernel linear;
+  CheckKernelMatrix(linear);
+
+  PolynomialKernel polynomial(3.0, 0.5);
+  CheckKernelMatrix(polynomial);
+
+  HyperbolicTangentKernel tanhKernel(0.5, 0.2);
+  CheckKernelMatrix(tanhKernel);
+
+  GaussianKernel gaussian(0.7);
+  CheckKernelMatrix(gaussian);
+
+  LaplacianKernel laplacian(0.7);
+  CheckKernelMatrix(laplacian);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
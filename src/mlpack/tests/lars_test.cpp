@@ -157,6 +157,33 @@ BOOST_AUTO_TEST_CASE(NoCholeskySingularityTest)
   }
 }
 
+// Make sure that a quiet LARS object gives the same solution on data with a
+// singularity, without being timed.
+BOOST_AUTO_TEST_CASE(QuietSingularityTest)
+{
+  arma::mat X;
+  arma::mat Y;
+
+  data::Load("lars_dependent_x.csv", X);
+  data::Load("lars_dependent_y.csv", Y);
+
+  arma::rowvec y = Y.row(0);
+
+  LARS lars(true, 0.1, 0.0);
+  arma::vec beta;
+  lars.Train(X, y, beta);
+  const std::chrono::microseconds time = Timer::Get("lars_regression");
+
+  LARS quietLars(true, 0.1, 0.0);
+  quietLars.Quiet() = true;
+  arma::vec quietBeta;
+  quietLars.Train(X, y, quietBeta);
+
+  BOOST_REQUIRE_EQUAL(Timer::Get("lars_regression").count(), time.count());
+  BOOST_REQUIRE_EQUAL(quietLars.IgnoreSet().size(), lars.IgnoreSet().size());
+  CheckMatrices(beta, quietBeta);
+}
+
 // Make sure that Predict() provides reasonable enough solutions.
 BOOST_AUTO_TEST_CASE(PredictTest)
 {
@@ -280,6 +307,45 @@ BOOST_AUTO_TEST_CASE(RetrainCholeskyTest)
   LARSVerifyCorrectness(betaOpt, errCorr, 0.1);
 }
 
+/**
+ * The storage of the Cholesky factor is reused between calls to Train(), so
+ * make sure that the factor is still that of the Gram matrix of the active set
+ * after many retrainings, with variables entering and leaving it.
+ */
+BOOST_AUTO_TEST_CASE(RetrainCholeskyFactorTest)
+{
+  const double lambda2 = 0.05;
+  LARS lars(true, 0.5, lambda2);
+
+  arma::mat X;
+  arma::rowvec y;
+  for (size_t i = 0; i < 20; i++)
+  {
+    GenerateProblem(X, y, 100, 10 + (i % 3) * 10);
+    arma::vec betaOpt;
+    lars.Train(X, y, betaOpt);
+
+    const std::vector<size_t>& activeSet = lars.ActiveSet();
+    const arma::uvec active = arma::conv_to<arma::uvec>::from(activeSet);
+    const arma::mat activeX = X.rows(active);
+    const arma::mat gram = activeX * trans(activeX) + lambda2 *
+        arma::eye(active.n_elem, active.n_elem);
+
+    const arma::mat factor = lars.MatUtriCholFactor();
+    BOOST_REQUIRE_EQUAL(factor.n_rows, active.n_elem);
+    BOOST_REQUIRE_EQUAL(factor.n_cols, active.n_elem);
+
+    const arma::mat product = trans(factor) * factor;
+    for (size_t j = 0; j < gram.n_elem; j++)
+    {
+      if (std::abs(gram[j]) < 1e-8)
+        BOOST_REQUIRE_SMALL(product[j], 1e-8);
+      else
+        BOOST_REQUIRE_CLOSE(product[j], gram[j], 1e-5);
+    }
+  }
+}
+
 /**
  * Make sure that we get correct solution coefficients when running training
  * and accessing solution coefficients separately.
@@ -352,4 +418,38 @@ BOOST_AUTO_TEST_CASE(TrainingConstructorWithNonDefaultsTest)
     BOOST_REQUIRE_CLOSE(beta[i], lars2.Beta()[i], 1e-5);
 }
 
+/**
+ * Make sure that LARS gives the same solution on sparse data as on dense data.
+ */
+BOOST_AUTO_TEST_CASE(SparseLARSTest)
+{
+  arma::sp_mat sparseX;
+  sparseX.sprandu(30, 200, 0.2);
+  const arma::mat denseX(sparseX);
+  const arma::rowvec y = arma::randu<arma::rowvec>(200);
+
+  for (const bool useCholesky : { true, false })
+  {
+    LARS dense(useCholesky, 0.01, 0.005);
+    LARS sparse(useCholesky, 0.01, 0.005);
+    dense.Train(denseX, y);
+    sparse.Train(sparseX, y);
+
+    BOOST_REQUIRE_EQUAL(sparse.Beta().n_elem, dense.Beta().n_elem);
+    for (size_t i = 0; i < dense.Beta().n_elem; ++i)
+    {
+      if (std::abs(dense.Beta()[i]) < 1e-6)
+        BOOST_REQUIRE_SMALL(sparse.Beta()[i], 1e-6);
+      else
+        BOOST_REQUIRE_CLOSE(sparse.Beta()[i], dense.Beta()[i], 1e-5);
+    }
+
+    arma::rowvec densePredictions, sparsePredictions;
+    dense.Predict(denseX, densePredictions);
+    sparse.Predict(sparseX, sparsePredictions);
+    for (size_t i = 0; i < densePredictions.n_elem; ++i)
+      BOOST_REQUIRE_CLOSE(sparsePredictions[i], densePredictions[i], 1e-5);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -199,4 +199,84 @@ BOOST_AUTO_TEST_CASE(LinearRegressionTrainTest)
     BOOST_REQUIRE_CLOSE(lr.Parameters()[i], lrTrain.Parameters()[i], 1e-5);
 }
 
+/**
+ * Check that training on sparse data (which uses conjugate gradient instead of
+ * the QR decomposition) gives the same model as dense training, with and
+ * without regularization and weights.
+ */
+BOOST_AUTO_TEST_CASE(LinearRegressionSparseTest)
+{
+  arma::sp_mat sparseData;
+  sparseData.sprandu(20, 500, 0.2);
+  const arma::mat denseData(sparseData);
+
+  arma::vec trueParameters = arma::randu<arma::vec>(20);
+  const arma::rowvec responses = 2.0 + trueParameters.t() * denseData +
+      0.01 * arma::randn<arma::rowvec>(500);
+  const arma::rowvec weights = arma::randu<arma::rowvec>(500) + 0.5;
+
+  for (const double lambda : { 0.0, 0.5 })
+  {
+    for (const bool intercept : { true, false })
+    {
+      LinearRegression dense(denseData, responses, weights, lambda, intercept);
+      LinearRegression sparse(sparseData, responses, weights, lambda,
+          intercept);
+
+      BOOST_REQUIRE_EQUAL(sparse.Parameters().n_elem,
+          dense.Parameters().n_elem);
+      for (size_t i = 0; i < dense.Parameters().n_elem; ++i)
+        BOOST_REQUIRE_CLOSE(sparse.Parameters()[i], dense.Parameters()[i],
+            1e-3);
+
+      BOOST_REQUIRE_CLOSE(sparse.ComputeError(sparseData, responses),
+          dense.ComputeError(denseData, responses), 1e-3);
+
+      arma::rowvec sparsePredictions, densePredictions;
+      sparse.Predict(sparseData, sparsePredictions);
+      dense.Predict(denseData, densePredictions);
+      for (size_t i = 0; i < densePredictions.n_elem; ++i)
+        BOOST_REQUIRE_CLOSE(sparsePredictions[i], densePredictions[i], 1e-3);
+    }
+  }
+}
+
+/**
+ * Check that sparse training still matches dense training on ill-conditioned
+ * data, and that the number of conjugate gradient iterations can be limited.
+ */
+BOOST_AUTO_TEST_CASE(LinearRegressionSparseIllConditionedTest)
+{
+  // The scales of the dimensions range from 0.01 to 100, so the condition
+  // number of the normal equations is large.
+  arma::sp_mat sparseData;
+  sparseData.sprandu(5, 300, 0.5);
+  for (size_t i = 0; i < 5; ++i)
+    sparseData.row(i) *= std::pow(10.0, (double) i - 2.0);
+  const arma::mat denseData(sparseData);
+
+  const arma::vec trueParameters = "1.0 -2.0 0.5 0.1 -0.01";
+  const arma::rowvec responses = 1.0 + trueParameters.t() * denseData +
+      0.01 * arma::randn<arma::rowvec>(300);
+
+  LinearRegression dense(denseData, responses);
+  LinearRegression sparse;
+  sparse.MaxIterations() = 100;
+  sparse.Train(sparseData, responses);
+
+  arma::rowvec sparsePredictions, densePredictions;
+  sparse.Predict(sparseData, sparsePredictions);
+  dense.Predict(denseData, densePredictions);
+  for (size_t i = 0; i < densePredictions.n_elem; ++i)
+    BOOST_REQUIRE_SMALL(sparsePredictions[i] - densePredictions[i], 1e-5);
+
+  // With a single iteration, the solver can't have converged (and warns), so
+  // the model is worse than the dense one.
+  LinearRegression limited;
+  limited.MaxIterations() = 1;
+  limited.Train(sparseData, responses);
+  BOOST_REQUIRE_GT(limited.ComputeError(sparseData, responses),
+      dense.ComputeError(denseData, responses) * 1.01);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -1994,4 +1994,206 @@ BOOST_AUTO_TEST_CASE(DatasetMapperNonUniqueTest)
   BOOST_REQUIRE_EQUAL(dm.UnmapString(nan, 0, 2), "cheese");
 }
 
+/**
+ * Make sure DatasetMapper handles many mappings, in several dimensions.
+ */
+BOOST_AUTO_TEST_CASE(DatasetMapperManyMappingsTest)
+{
+  DatasetInfo info(3);
+
+  // Map the same strings in dimensions 0 and 2, in a different order.
+  const size_t numStrings = 10000;
+  for (size_t i = 0; i < numStrings; ++i)
+  {
+    const std::string s = "id" + std::to_string(i);
+    BOOST_REQUIRE_EQUAL(info.MapString<size_t>(s, 0), i);
+    BOOST_REQUIRE_EQUAL(info.MapString<size_t>("id" +
+        std::to_string(numStrings - 1 - i), 2), i);
+  }
+
+  BOOST_REQUIRE(info.Type(0) == Datatype::categorical);
+  BOOST_REQUIRE(info.Type(1) == Datatype::numeric);
+  BOOST_REQUIRE(info.Type(2) == Datatype::categorical);
+  BOOST_REQUIRE_EQUAL(info.NumMappings(0), numStrings);
+  BOOST_REQUIRE_EQUAL(info.NumMappings(1), 0);
+  BOOST_REQUIRE_EQUAL(info.NumMappings(2), numStrings);
+
+  // Mapping the strings again must give the same values.
+  for (size_t i = 0; i < numStrings; ++i)
+  {
+    const std::string s = "id" + std::to_string(i);
+    BOOST_REQUIRE_EQUAL(info.MapString<size_t>(s, 0), i);
+    BOOST_REQUIRE_EQUAL(info.MapString<size_t>(s, 2), numStrings - 1 - i);
+    BOOST_REQUIRE_EQUAL(info.UnmapString(i, 0), s);
+    BOOST_REQUIRE_EQUAL(info.UnmapString(numStrings - 1 - i, 2), s);
+    BOOST_REQUIRE_EQUAL(info.UnmapValue(s, 2), numStrings - 1 - i);
+  }
+
+  BOOST_REQUIRE_EQUAL(info.NumMappings(0), numStrings);
+  BOOST_REQUIRE_THROW(info.UnmapString(numStrings, 0), std::invalid_argument);
+  BOOST_REQUIRE_THROW(info.UnmapValue("id", 0), std::invalid_argument);
+}
+
+/**
+ * Make sure that a sparse coordinate list file is loaded (and transposed)
+ * correctly.
+ */
+BOOST_AUTO_TEST_CASE(LoadSparseCoordinateListTest)
+{
+  fstream f;
+  f.open("test_file.coo", fstream::out);
+
+  f << "0 0 1.5" << endl;
+  f << "2 1 -3" << endl;
+  f << "4 3 2.25" << endl;
+
+  f.close();
+
+  arma::sp_mat test;
+  BOOST_REQUIRE(data::Load("test_file.coo", test) == true);
+
+  BOOST_REQUIRE_EQUAL(test.n_rows, 4);
+  BOOST_REQUIRE_EQUAL(test.n_cols, 5);
+  BOOST_REQUIRE_EQUAL(test.n_nonzero, 3);
+
+  BOOST_REQUIRE_CLOSE((double) test(0, 0), 1.5, 1e-5);
+  BOOST_REQUIRE_CLOSE((double) test(1, 2), -3.0, 1e-5);
+  BOOST_REQUIRE_CLOSE((double) test(3, 4), 2.25, 1e-5);
+  BOOST_REQUIRE_SMALL((double) test(2, 1), 1e-5);
+
+  // Without transposition the matrix is loaded as-is.
+  BOOST_REQUIRE(data::Load("test_file.coo", test, false, false) == true);
+  BOOST_REQUIRE_EQUAL(test.n_rows, 5);
+  BOOST_REQUIRE_EQUAL(test.n_cols, 4);
+  BOOST_REQUIRE_CLOSE((double) test(2, 1), -3.0, 1e-5);
+
+  // Remove the file.
+  remove("test_file.coo");
+}
+
+/**
+ * Make sure that a libsvm file is loaded correctly, with its labels.
+ */
+BOOST_AUTO_TEST_CASE(LoadLibSVMTest)
+{
+  fstream f;
+  f.open("test_file.svm", fstream::out);
+
+  f << "# A comment line." << endl;
+  f << "1 1:0.5 3:-2" << endl;
+  f << "0 qid:4 2:1.25 # A trailing comment." << endl;
+  f << "2" << endl;
+  f << "1 4:3 1:0" << endl;
+
+  f.close();
+
+  arma::sp_mat test;
+  arma::Row<size_t> labels;
+  BOOST_REQUIRE(data::Load("test_file.svm", test, labels) == true);
+
+  // The indices start at 1.
+  BOOST_REQUIRE_EQUAL(test.n_rows, 4);
+  BOOST_REQUIRE_EQUAL(test.n_cols, 4);
+  BOOST_REQUIRE_EQUAL(test.n_nonzero, 4);
+
+  BOOST_REQUIRE_CLOSE((double) test(0, 0), 0.5, 1e-5);
+  BOOST_REQUIRE_CLOSE((double) test(2, 0), -2.0, 1e-5);
+  BOOST_REQUIRE_CLOSE((double) test(1, 1), 1.25, 1e-5);
+  BOOST_REQUIRE_CLOSE((double) test(3, 3), 3.0, 1e-5);
+  BOOST_REQUIRE_SMALL((double) test(0, 3), 1e-5);
+
+  BOOST_REQUIRE_EQUAL(labels.n_elem, 4);
+  BOOST_REQUIRE_EQUAL(labels[0], 1);
+  BOOST_REQUIRE_EQUAL(labels[1], 0);
+  BOOST_REQUIRE_EQUAL(labels[2], 2);
+  BOOST_REQUIRE_EQUAL(labels[3], 1);
+
+  // Loading without labels gives the same matrix.
+  arma::sp_mat test2;
+  BOOST_REQUIRE(data::Load("test_file.svm", test2) == true);
+  BOOST_REQUIRE_EQUAL(test2.n_nonzero, 4);
+  BOOST_REQUIRE_CLOSE((double) test2(1, 1), 1.25, 1e-5);
+
+  // -1/+1 labels can't be loaded into size_t labels, but can be loaded into a
+  // rowvec.
+  f.open("test_file.svm", fstream::out);
+  f << "-1 0:1 2:2" << endl;
+  f << "+1 1:3" << endl;
+  f.close();
+
+  BOOST_REQUIRE(data::Load("test_file.svm", test, labels) == false);
+
+  // This file has 0-based indices, so it can only be loaded as such.
+  arma::rowvec realLabels;
+  BOOST_REQUIRE(data::Load("test_file.svm", test, realLabels) == false);
+  data::LoadLibSVM("test_file.svm", test, realLabels, true, true);
+  BOOST_REQUIRE_CLOSE(realLabels[0], -1.0, 1e-5);
+  BOOST_REQUIRE_CLOSE(realLabels[1], 1.0, 1e-5);
+
+  BOOST_REQUIRE_EQUAL(test.n_rows, 3);
+  BOOST_REQUIRE_CLOSE((double) test(0, 0), 1.0, 1e-5);
+  BOOST_REQUIRE_CLOSE((double) test(1, 1), 3.0, 1e-5);
+
+  // The dimensionality can be given, but not smaller than that of the file.
+  data::LoadLibSVM("test_file.svm", test, realLabels, true, true, 5);
+  BOOST_REQUIRE_EQUAL(test.n_rows, 5);
+  BOOST_REQUIRE_EQUAL(test.n_cols, 2);
+  BOOST_REQUIRE_CLOSE((double) test(2, 0), 2.0, 1e-5);
+  BOOST_REQUIRE_THROW(data::LoadLibSVM("test_file.svm", test, realLabels,
+      true, true, 2), std::runtime_error);
+
+  // Malformed lines are an error.
+  f.open("test_file.svm", fstream::out);
+  f << "1 1:2 3" << endl;
+  f.close();
+
+  BOOST_REQUIRE(data::Load("test_file.svm", test, realLabels) == false);
+
+  // Remove the file.
+  remove("test_file.svm");
+}
+
+/**
+ * Make sure that a symmetric Matrix Market file is loaded correctly.
+ */
+BOOST_AUTO_TEST_CASE(LoadMatrixMarketTest)
+{
+  fstream f;
+  f.open("test_file.mtx", fstream::out);
+
+  f << "%%MatrixMarket matrix coordinate real symmetric" << endl;
+  f << "% A comment." << endl;
+  f << "3 3 3" << endl;
+  f << "1 1 2.5" << endl;
+  f << "3 1 -1" << endl;
+  f << "2 2 4" << endl;
+
+  f.close();
+
+  arma::sp_mat test;
+  BOOST_REQUIRE(data::Load("test_file.mtx", test) == true);
+
+  BOOST_REQUIRE_EQUAL(test.n_rows, 3);
+  BOOST_REQUIRE_EQUAL(test.n_cols, 3);
+  BOOST_REQUIRE_EQUAL(test.n_nonzero, 4);
+
+  BOOST_REQUIRE_CLOSE((double) test(0, 0), 2.5, 1e-5);
+  BOOST_REQUIRE_CLOSE((double) test(2, 0), -1.0, 1e-5);
+  BOOST_REQUIRE_CLOSE((double) test(0, 2), -1.0, 1e-5);
+  BOOST_REQUIRE_CLOSE((double) test(1, 1), 4.0, 1e-5);
+
+  // A file with the wrong number of entries is an error.
+  f.open("test_file.mtx", fstream::out);
+  f << "%%MatrixMarket matrix coordinate pattern general" << endl;
+  f << "3 2 3" << endl;
+  f << "1 2" << endl;
+  f << "3 1" << endl;
+  f.close();
+
+  BOOST_REQUIRE(data::Load("test_file.mtx", test) == false);
+
+  // Remove the file.
+  remove("test_file.mtx");
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -483,6 +483,76 @@ BOOST_AUTO_TEST_CASE(LogisticRegressionFunctionRegularizationSeparableGradient)
   }
 }
 
+/**
+ * Make sure the batch Evaluate() and Gradient() functions give the same results
+ * as the sum of the separable versions over the batch, for both dense and
+ * sparse data.
+ */
+BOOST_AUTO_TEST_CASE(LogisticRegressionFunctionBatchEvaluateGradient)
+{
+  const size_t points = 1000;
+  const size_t dimension = 10;
+
+  arma::mat data;
+  data.randu(dimension, points);
+  arma::sp_mat sparseData;
+  sparseData.sprandu(dimension, points, 0.3);
+  arma::Row<size_t> responses(points);
+  for (size_t i = 0; i < points; ++i)
+    responses[i] = math::RandInt(0, 2);
+
+  // The separable results on sparse data are computed with a dense copy.
+  const arma::mat denseSparseData(sparseData);
+
+  LogisticRegressionFunction<> lrf(data, responses, 0.5);
+  LogisticRegressionFunction<> denseSparseLrf(denseSparseData, responses, 0.5);
+  LogisticRegressionFunction<arma::sp_mat> sparseLrf(sparseData, responses,
+      0.5);
+
+  arma::rowvec parameters(dimension + 1);
+  parameters.randu();
+
+  // Check a few batches, including one of size 1 and the last points.
+  const size_t begins[] = { 0, 17, 500, 999 };
+  const size_t batchSizes[] = { 1, 100, 250, 1 };
+  for (size_t b = 0; b < 4; ++b)
+  {
+    double objective = 0.0;
+    double sparseObjective = 0.0;
+    arma::mat gradient(1, dimension + 1, arma::fill::zeros);
+    arma::mat sparseGradient(1, dimension + 1, arma::fill::zeros);
+    for (size_t i = begins[b]; i < begins[b] + batchSizes[b]; ++i)
+    {
+      objective += lrf.Evaluate(parameters, i);
+      sparseObjective += denseSparseLrf.Evaluate(parameters, i);
+
+      arma::mat pointGradient;
+      lrf.Gradient(parameters, i, pointGradient);
+      gradient += pointGradient;
+      denseSparseLrf.Gradient(parameters, i, pointGradient);
+      sparseGradient += pointGradient;
+    }
+
+    BOOST_REQUIRE_CLOSE(lrf.Evaluate(parameters, begins[b], batchSizes[b]),
+        objective, 1e-5);
+    BOOST_REQUIRE_CLOSE(sparseLrf.Evaluate(parameters, begins[b],
+        batchSizes[b]), sparseObjective, 1e-5);
+
+    arma::mat batchGradient, sparseBatchGradient;
+    lrf.Gradient(parameters, begins[b], batchGradient, batchSizes[b]);
+    sparseLrf.Gradient(parameters, begins[b], sparseBatchGradient,
+        batchSizes[b]);
+
+    BOOST_REQUIRE_EQUAL(batchGradient.n_elem, parameters.n_elem);
+    BOOST_REQUIRE_EQUAL(sparseBatchGradient.n_elem, parameters.n_elem);
+    for (size_t j = 0; j < parameters.n_elem; ++j)
+    {
+      BOOST_REQUIRE_CLOSE(batchGradient[j], gradient[j], 1e-5);
+      BOOST_REQUIRE_CLOSE(sparseBatchGradient[j], sparseGradient[j], 1e-5);
+    }
+  }
+}
+
 // Test training of logistic regression on a simple dataset.
 BOOST_AUTO_TEST_CASE(LogisticRegressionLBFGSSimpleTest)
 {
@@ -641,6 +641,47 @@ BOOST_AUTO_TEST_CASE(LSHTrainTest)
   BOOST_REQUIRE_EQUAL(distances.n_rows, 3);
 }
 
+/**
+ * Make sure that the compressed second hash table holds every point once per
+ * table when the bucket size is unlimited, and that the bucket size is respected
+ * otherwise.
+ */
+BOOST_AUTO_TEST_CASE(BucketStructureTest)
+{
+  arma::mat referenceData = arma::randu<arma::mat>(5, 300);
+
+  LSHSearch<> lsh(referenceData, 3, 6, 0.5, 101, 0);
+
+  const arma::Col<size_t>& offsets = lsh.BucketOffsets();
+  const arma::Col<size_t>& contents = lsh.BucketContents();
+  BOOST_REQUIRE_EQUAL(offsets[0], 0);
+  BOOST_REQUIRE_EQUAL(offsets[offsets.n_elem - 1], contents.n_elem);
+  BOOST_REQUIRE_EQUAL(contents.n_elem, 6 * referenceData.n_cols);
+  for (size_t i = 1; i < offsets.n_elem; ++i)
+    BOOST_REQUIRE_GT(offsets[i], offsets[i - 1]);
+
+  arma::Col<size_t> counts(referenceData.n_cols, arma::fill::zeros);
+  for (size_t i = 0; i < contents.n_elem; ++i)
+    counts[contents[i]]++;
+  for (size_t i = 0; i < counts.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(counts[i], 6);
+
+  // Now limit the size of each bucket.
+  lsh.Train(referenceData, 3, 6, 0.5, 101, 4);
+  for (size_t i = 1; i < lsh.BucketOffsets().n_elem; ++i)
+  {
+    BOOST_REQUIRE_GT(lsh.BucketOffsets()[i], lsh.BucketOffsets()[i - 1]);
+    BOOST_REQUIRE_LE(lsh.BucketOffsets()[i] - lsh.BucketOffsets()[i - 1], 4);
+  }
+
+  // Searching should still give a result for every query.
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  lsh.Search(2, neighbors, distances);
+  BOOST_REQUIRE_EQUAL(neighbors.n_cols, referenceData.n_cols);
+  BOOST_REQUIRE_EQUAL(neighbors.n_rows, 2);
+}
+
 /**
  * Test: this verifies ComputeRecall works correctly by providing two identical
  * vectors and requiring that Recall is equal to 1.
@@ -144,4 +144,46 @@ BOOST_AUTO_TEST_CASE(GaussianClustering)
       BOOST_REQUIRE_NE(minIndices[i], minIndices[j]);
 }
 
+#ifdef HAS_OPENMP
+
+/**
+ * Make sure that shifting the seeds in parallel gives exactly the same
+ * centroids and assignments as shifting them with one thread.
+ */
+BOOST_AUTO_TEST_CASE(ParallelMeanShiftTest)
+{
+  GaussianDistribution g1("0.0 0.0 0.0", arma::eye<arma::mat>(3, 3));
+  GaussianDistribution g2("5.0 5.0 5.0", 2 * arma::eye<arma::mat>(3, 3));
+
+  arma::mat dataset(3, 2000);
+  for (size_t i = 0; i < 1000; ++i)
+    dataset.col(i) = g1.Random();
+  for (size_t i = 1000; i < 2000; ++i)
+    dataset.col(i) = g2.Random();
+
+  MeanShift<true> meanShift(2.5);
+
+  // Use at least four threads, even on machines with few cores.
+  const size_t prevNumThreads = omp_get_max_threads();
+  omp_set_num_threads(std::max(prevNumThreads, (size_t) 4));
+  arma::Col<size_t> parallelAssignments;
+  arma::mat parallelCentroids;
+  meanShift.Cluster(dataset, parallelAssignments, parallelCentroids, false);
+
+  omp_set_num_threads(1);
+  arma::Col<size_t> assignments;
+  arma::mat centroids;
+  meanShift.Cluster(dataset, assignments, centroids, false);
+  omp_set_num_threads(prevNumThreads);
+
+  BOOST_REQUIRE_EQUAL(parallelCentroids.n_cols, centroids.n_cols);
+  for (size_t i = 0; i < centroids.n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(parallelCentroids[i], centroids[i], 1e-5);
+
+  for (size_t i = 0; i < assignments.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(parallelAssignments[i], assignments[i]);
+}
+
+#endif
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -314,4 +314,37 @@ BOOST_AUTO_TEST_CASE(SeparateTrainIndividualIncrementalTest)
   }
 }
 
+/**
+ * Make sure that training and classifying with sparse data gives the same model
+ * and the same predictions as with dense data.
+ */
+BOOST_AUTO_TEST_CASE(NaiveBayesSparseTest)
+{
+  arma::sp_mat sparseData;
+  sparseData.sprandu(20, 400, 0.3);
+  const arma::mat denseData(sparseData);
+
+  arma::Row<size_t> labels(400);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    labels[i] = i % 3;
+
+  NaiveBayesClassifier<> dense(denseData, labels, 3);
+  NaiveBayesClassifier<> sparse(sparseData, labels, 3);
+
+  for (size_t i = 0; i < dense.Means().n_elem; ++i)
+  {
+    BOOST_REQUIRE_CLOSE(sparse.Means()[i], dense.Means()[i], 1e-5);
+    BOOST_REQUIRE_CLOSE(sparse.Variances()[i], dense.Variances()[i], 1e-5);
+  }
+
+  arma::Row<size_t> densePredictions, sparsePredictions;
+  arma::mat denseProbabilities, sparseProbabilities;
+  dense.Classify(denseData, densePredictions, denseProbabilities);
+  sparse.Classify(sparseData, sparsePredictions, sparseProbabilities);
+  for (size_t i = 0; i < densePredictions.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(sparsePredictions[i], densePredictions[i]);
+  for (size_t i = 0; i < denseProbabilities.n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(sparseProbabilities[i], denseProbabilities[i], 1e-5);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
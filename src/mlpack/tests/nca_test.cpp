@@ -249,6 +249,67 @@ BOOST_AUTO_TEST_CASE(SoftmaxSeparableGradient)
   BOOST_REQUIRE_CLOSE(gradient(1, 1), -2.0 * -0.1435886, 0.01);
 }
 
+/**
+ * Ensure the batch objective and gradient are the sums of the separable
+ * objectives and gradients.
+ */
+BOOST_AUTO_TEST_CASE(SoftmaxBatchObjectiveGradient)
+{
+  // Useful but simple dataset with six points and two classes.
+  arma::mat data           = "-0.1 -0.1 -0.1  0.1  0.1  0.1;"
+                             " 1.0  0.0 -1.0  1.0  0.0 -1.0 ";
+  arma::Row<size_t> labels = " 0    0    0    1    1    1   ";
+
+  SoftmaxErrorFunction<SquaredEuclideanDistance> sef(data, labels);
+
+  arma::mat coordinates = "1.0 0.2; -0.3 0.8";
+
+  double objective = 0.0;
+  arma::mat gradient(2, 2, arma::fill::zeros);
+  arma::mat pointGradient;
+  for (size_t i = 1; i < 5; ++i)
+  {
+    objective += sef.Evaluate(coordinates, i);
+    sef.Gradient(coordinates, i, pointGradient);
+    gradient += pointGradient;
+  }
+
+  BOOST_REQUIRE_CLOSE(sef.Evaluate(coordinates, 1, 4), objective, 1e-5);
+
+  arma::mat batchGradient;
+  sef.Gradient(coordinates, 1, batchGradient, 4);
+  BOOST_REQUIRE_EQUAL(batchGradient.n_rows, 2);
+  BOOST_REQUIRE_EQUAL(batchGradient.n_cols, 2);
+  for (size_t i = 0; i < 4; ++i)
+    BOOST_REQUIRE_CLOSE(batchGradient[i], gradient[i], 1e-5);
+}
+
+/**
+ * Ensure the batch objective and gradient count the points whose denominator of
+ * p_i is zero, instead of warning about them.
+ */
+BOOST_AUTO_TEST_CASE(SoftmaxBatchZeroDenominators)
+{
+  // The last point is so far from the others that exp(-distance) is 0.
+  arma::mat data           = "0.0 0.1 0.2 1000.0;"
+                             "0.0 0.1 0.0 1000.0 ";
+  arma::Row<size_t> labels = "0   0   1   1      ";
+
+  SoftmaxErrorFunction<SquaredEuclideanDistance> sef(data, labels);
+  arma::mat coordinates = arma::eye<arma::mat>(2, 2);
+
+  BOOST_REQUIRE_EQUAL(sef.ZeroDenominators(), 0);
+  sef.Evaluate(coordinates, 0, 4);
+  BOOST_REQUIRE_EQUAL(sef.ZeroDenominators(), 1);
+
+  arma::mat gradient;
+  sef.Gradient(coordinates, 1, gradient, 3);
+  BOOST_REQUIRE_EQUAL(sef.ZeroDenominators(), 2);
+
+  sef.Evaluate(coordinates, 0, 3);
+  BOOST_REQUIRE_EQUAL(sef.ZeroDenominators(), 2);
+}
+
 //
 // Tests for the NCA algorithm.
 //
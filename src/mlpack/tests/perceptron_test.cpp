@@ -255,4 +255,30 @@ BOOST_AUTO_TEST_CASE(SecondaryConstructor)
   Perceptron<> p2(p1);
 }
 
+/**
+ * Training and classifying with a sparse matrix should give the same results
+ * as with the equivalent dense matrix.
+ */
+BOOST_AUTO_TEST_CASE(SparsePerceptronTest)
+{
+  sp_mat sparseData;
+  sparseData.sprandu(30, 200, 0.1);
+  const mat denseData(sparseData);
+
+  Row<size_t> labels(200);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    labels[i] = (accu(denseData.col(i).subvec(0, 14)) >
+        accu(denseData.col(i).subvec(15, 29))) ? 1 : 0;
+
+  Perceptron<> densePerceptron(denseData, labels, 2, 100);
+  Perceptron<SimpleWeightUpdate, ZeroInitialization, sp_mat>
+      sparsePerceptron(sparseData, labels, 2, 100);
+
+  Row<size_t> denseResults(200), sparseResults(200);
+  densePerceptron.Classify(denseData, denseResults);
+  sparsePerceptron.Classify(sparseData, sparseResults);
+  for (size_t i = 0; i < denseResults.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(sparseResults[i], denseResults[i]);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
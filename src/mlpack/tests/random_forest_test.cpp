@@ -395,4 +395,49 @@ BOOST_AUTO_TEST_CASE(SerializationTest)
       binaryProbabilities);
 }
 
+/**
+ * Make sure that batch classification (which pushes blocks of points through
+ * each tree together) gives the same results as classifying each point
+ * individually, for both numeric and categorical data.
+ */
+BOOST_AUTO_TEST_CASE(BatchClassifyMatchesPointClassifyTest)
+{
+  arma::mat d;
+  arma::Row<size_t> l;
+  data::DatasetInfo di;
+  MockCategoricalData(d, l, di);
+
+  // Use more points than fit in a single block.
+  arma::mat trainingData = d.cols(0, 1999);
+  arma::mat testData = d.cols(2000, 3999);
+  arma::Row<size_t> trainingLabels = l.subvec(0, 1999);
+
+  RandomForest<> rf(trainingData, di, trainingLabels, 5, 10 /* 10 trees */, 5);
+  DecisionTree<> dt(trainingData, di, trainingLabels, 5, 5);
+
+  arma::Row<size_t> rfPredictions, dtPredictions;
+  arma::mat rfProbabilities, dtProbabilities;
+  rf.Classify(testData, rfPredictions, rfProbabilities);
+  dt.Classify(testData, dtPredictions, dtProbabilities);
+
+  BOOST_REQUIRE_EQUAL(rfProbabilities.n_cols, testData.n_cols);
+  BOOST_REQUIRE_EQUAL(dtProbabilities.n_cols, testData.n_cols);
+  for (size_t i = 0; i < testData.n_cols; ++i)
+  {
+    size_t prediction;
+    arma::vec probabilities;
+    rf.Classify(testData.col(i), prediction, probabilities);
+    BOOST_REQUIRE_EQUAL(rfPredictions[i], prediction);
+    for (size_t j = 0; j < probabilities.n_elem; ++j)
+      BOOST_REQUIRE_CLOSE(rfProbabilities(j, i) + 1.0, probabilities[j] + 1.0,
+          1e-5);
+
+    dt.Classify(testData.col(i), prediction, probabilities);
+    BOOST_REQUIRE_EQUAL(dtPredictions[i], prediction);
+    for (size_t j = 0; j < probabilities.n_elem; ++j)
+      BOOST_REQUIRE_CLOSE(dtProbabilities(j, i) + 1.0, probabilities[j] + 1.0,
+          1e-5);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -1696,4 +1696,162 @@ BOOST_AUTO_TEST_CASE(MoveOperatorNaiveTest)
   }
 }
 
+/**
+ * Make sure that the CSRResultSink holds the same results as the vectors, for
+ * naive, single-tree and dual-tree search, both bichromatic and monochromatic.
+ */
+BOOST_AUTO_TEST_CASE(CSRResultSinkTest)
+{
+  arma::mat referenceData = arma::randu<arma::mat>(3, 300);
+  arma::mat queryData = arma::randu<arma::mat>(3, 150);
+  const math::Range range(0.1, 0.3);
+
+  for (size_t mode = 0; mode < 3; ++mode)
+  {
+    RangeSearch<> rs(referenceData, mode == 0, mode == 1);
+
+    for (size_t mono = 0; mono < 2; ++mono)
+    {
+      vector<vector<size_t>> neighbors;
+      vector<vector<double>> distances;
+      CSRResultSink sink;
+      if (mono == 1)
+      {
+        rs.Search(range, neighbors, distances);
+        rs.Search(range, sink);
+      }
+      else
+      {
+        rs.Search(queryData, range, neighbors, distances);
+        rs.Search(queryData, range, sink);
+      }
+
+      vector<vector<pair<double, size_t>>> sorted;
+      SortResults(neighbors, distances, sorted);
+
+      BOOST_REQUIRE_EQUAL(sink.NumQueries(), neighbors.size());
+      BOOST_REQUIRE_EQUAL(sink.Offsets().back(), sink.Neighbors().size());
+      BOOST_REQUIRE_EQUAL(sink.Distances().size(), sink.Neighbors().size());
+      for (size_t i = 0; i < sink.NumQueries(); ++i)
+      {
+        BOOST_REQUIRE_EQUAL(sink.NumNeighbors(i), sorted[i].size());
+
+        vector<pair<double, size_t>> sinkSorted;
+        for (size_t j = sink.Offsets()[i]; j < sink.Offsets()[i + 1]; ++j)
+        {
+          sinkSorted.push_back(make_pair(sink.Distances()[j],
+              sink.Neighbors()[j]));
+        }
+        sort(sinkSorted.begin(), sinkSorted.end());
+
+        for (size_t j = 0; j < sinkSorted.size(); ++j)
+        {
+          BOOST_REQUIRE_EQUAL(sinkSorted[j].second, sorted[i][j].second);
+          BOOST_REQUIRE_CLOSE(sinkSorted[j].first, sorted[i][j].first, 1e-5);
+        }
+      }
+    }
+  }
+}
+
+/**
+ * Make sure that the CountResultSink counts the same number of results as the
+ * vectors hold.
+ */
+BOOST_AUTO_TEST_CASE(CountResultSinkTest)
+{
+  arma::mat referenceData = arma::randu<arma::mat>(3, 300);
+  arma::mat queryData = arma::randu<arma::mat>(3, 150);
+
+  // A large range, so that many nodes are entirely in the range.
+  const math::Range range(0.0, 0.8);
+
+  for (size_t mode = 0; mode < 3; ++mode)
+  {
+    RangeSearch<> rs(referenceData, mode == 0, mode == 1);
+
+    vector<vector<size_t>> neighbors;
+    vector<vector<double>> distances;
+    rs.Search(queryData, range, neighbors, distances);
+
+    CountResultSink sink;
+    rs.Search(queryData, range, sink);
+
+    BOOST_REQUIRE_EQUAL(sink.Counts().size(), neighbors.size());
+    for (size_t i = 0; i < neighbors.size(); ++i)
+      BOOST_REQUIRE_EQUAL(sink.Counts()[i], neighbors[i].size());
+  }
+}
+
+/**
+ * Make sure that a sink is begun and ended, and that every query point is
+ * finished, even if there are no reference points.
+ */
+BOOST_AUTO_TEST_CASE(EmptyReferenceSinkTest)
+{
+  arma::mat referenceData(3, 0);
+  RangeSearch<> rs(referenceData, true);
+  arma::mat queryData = arma::randu<arma::mat>(3, 10);
+
+  CSRResultSink sink;
+  rs.Search(queryData, math::Range(0.0, 10.0), sink);
+
+  BOOST_REQUIRE_EQUAL(sink.NumQueries(), 10);
+  BOOST_REQUIRE_EQUAL(sink.Offsets().size(), 11);
+  BOOST_REQUIRE_EQUAL(sink.Neighbors().size(), 0);
+  for (size_t i = 0; i < sink.NumQueries(); ++i)
+    BOOST_REQUIRE_EQUAL(sink.NumNeighbors(i), 0);
+}
+
+/**
+ * Make sure that the CallbackResultSink calls the callback exactly once for
+ * each query point, with the same results as the vectors hold.
+ */
+BOOST_AUTO_TEST_CASE(CallbackResultSinkTest)
+{
+  arma::mat referenceData = arma::randu<arma::mat>(3, 300);
+  arma::mat queryData = arma::randu<arma::mat>(3, 150);
+  const math::Range range(0.1, 0.3);
+
+  for (size_t mode = 0; mode < 3; ++mode)
+  {
+    RangeSearch<> rs(referenceData, mode == 0, mode == 1);
+
+    vector<vector<size_t>> neighbors;
+    vector<vector<double>> distances;
+    rs.Search(queryData, range, neighbors, distances);
+
+    vector<size_t> calls(queryData.n_cols, 0);
+    vector<vector<size_t>> callbackNeighbors(queryData.n_cols);
+    vector<vector<double>> callbackDistances(queryData.n_cols);
+    auto callback = [&](const size_t queryIndex,
+                        const vector<size_t>& queryNeighbors,
+                        const vector<double>& queryDistances)
+    {
+      ++calls[queryIndex];
+      callbackNeighbors[queryIndex] = queryNeighbors;
+      callbackDistances[queryIndex] = queryDistances;
+    };
+
+    CallbackResultSink<decltype(callback)> sink(callback);
+    rs.Search(queryData, range, sink);
+
+    vector<vector<pair<double, size_t>>> sorted, callbackSorted;
+    SortResults(neighbors, distances, sorted);
+    SortResults(callbackNeighbors, callbackDistances, callbackSorted);
+
+    for (size_t i = 0; i < queryData.n_cols; ++i)
+    {
+      BOOST_REQUIRE_EQUAL(calls[i], 1);
+      BOOST_REQUIRE_EQUAL(callbackSorted[i].size(), sorted[i].size());
+      for (size_t j = 0; j < sorted[i].size(); ++j)
+      {
+        BOOST_REQUIRE_EQUAL(callbackSorted[i][j].second, sorted[i][j].second);
+        BOOST_REQUIRE_CLOSE(callbackSorted[i][j].first, sorted[i][j].first,
+            1e-5);
+      }
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
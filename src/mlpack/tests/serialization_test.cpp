@@ -236,6 +236,41 @@ BOOST_AUTO_TEST_CASE(GaussianDistributionTest)
   }
 }
 
+/**
+ * Make sure the mappings of a DatasetInfo survive serialization.
+ */
+BOOST_AUTO_TEST_CASE(DatasetInfoTest)
+{
+  data::DatasetInfo info(3);
+  info.MapString<double>("1.5", 0); // Numeric; no mapping.
+  info.MapString<double>("hello", 1);
+  info.MapString<double>("goodbye", 1);
+  info.MapString<double>("cheese", 2);
+
+  data::DatasetInfo xmlInfo, textInfo, binaryInfo;
+
+  SerializeObjectAll(info, xmlInfo, textInfo, binaryInfo);
+
+  data::DatasetInfo* infos[3] = { &xmlInfo, &textInfo, &binaryInfo };
+  for (size_t i = 0; i < 3; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(infos[i]->Dimensionality(), 3);
+    BOOST_REQUIRE(infos[i]->Type(0) == data::Datatype::numeric);
+    BOOST_REQUIRE(infos[i]->Type(1) == data::Datatype::categorical);
+    BOOST_REQUIRE(infos[i]->Type(2) == data::Datatype::categorical);
+    BOOST_REQUIRE_EQUAL(infos[i]->NumMappings(0), 0);
+    BOOST_REQUIRE_EQUAL(infos[i]->NumMappings(1), 2);
+    BOOST_REQUIRE_EQUAL(infos[i]->NumMappings(2), 1);
+    BOOST_REQUIRE_EQUAL(infos[i]->UnmapString(0, 1), "hello");
+    BOOST_REQUIRE_EQUAL(infos[i]->UnmapString(1, 1), "goodbye");
+    BOOST_REQUIRE_EQUAL(infos[i]->UnmapString(0, 2), "cheese");
+
+    // New strings get the next mapping.
+    BOOST_REQUIRE_EQUAL(infos[i]->MapString<size_t>("goodbye", 1), 1);
+    BOOST_REQUIRE_EQUAL(infos[i]->MapString<size_t>("moo", 1), 2);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(LaplaceDistributionTest)
 {
   vec mean(20);
@@ -1232,16 +1267,10 @@ BOOST_AUTO_TEST_CASE(LSHTest)
   BOOST_REQUIRE_EQUAL(lsh.BucketSize(), textLsh.BucketSize());
   BOOST_REQUIRE_EQUAL(lsh.BucketSize(), binaryLsh.BucketSize());
 
-  BOOST_REQUIRE_EQUAL(lsh.SecondHashTable().size(),
-      xmlLsh.SecondHashTable().size());
-  BOOST_REQUIRE_EQUAL(lsh.SecondHashTable().size(),
-      textLsh.SecondHashTable().size());
-  BOOST_REQUIRE_EQUAL(lsh.SecondHashTable().size(),
-      binaryLsh.SecondHashTable().size());
-
-  for (size_t i = 0; i < lsh.SecondHashTable().size(); ++i)
-  CheckMatrices(lsh.SecondHashTable()[i], xmlLsh.SecondHashTable()[i],
-      textLsh.SecondHashTable()[i], binaryLsh.SecondHashTable()[i]);
+  CheckMatrices(lsh.BucketOffsets(), xmlLsh.BucketOffsets(),
+      textLsh.BucketOffsets(), binaryLsh.BucketOffsets());
+  CheckMatrices(lsh.BucketContents(), xmlLsh.BucketContents(),
+      textLsh.BucketContents(), binaryLsh.BucketContents());
 }
 
 // Make sure serialization works for the decision stump.
@@ -11,6 +11,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/softmax_regression/softmax_regression.hpp>
+#include <mlpack/core/optimizers/parallel_function/parallel_function.hpp>
 
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
@@ -172,6 +173,65 @@ BOOST_AUTO_TEST_CASE(SoftmaxRegressionFunctionGradient)
   }
 }
 
+/**
+ * Make sure that the batch overloads of Evaluate() and Gradient() sum to the
+ * full objective and gradient, and that evaluating the function in parallel
+ * shards with ParallelFunction gives the same results as the serial
+ * implementation.
+ */
+BOOST_AUTO_TEST_CASE(SoftmaxRegressionFunctionParallelEvaluateGradient)
+{
+  const size_t points = 1000;
+  const size_t inputSize = 10;
+  const size_t numClasses = 5;
+
+  // Initialize a random dataset.
+  arma::mat data;
+  data.randu(inputSize, points);
+
+  // Create random class labels.
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points; i++)
+    labels(i) = math::RandInt(0, numClasses);
+
+  for (size_t fitIntercept = 0; fitIntercept < 2; ++fitIntercept)
+  {
+    SoftmaxRegressionFunction srf(data, labels, numClasses, 0.5,
+        (fitIntercept == 1));
+
+    arma::mat parameters;
+    parameters.randu(numClasses, inputSize + fitIntercept);
+
+    const double objective = srf.Evaluate(parameters);
+    arma::mat gradient;
+    srf.Gradient(parameters, gradient);
+
+    // Sum the batch overloads over batches of uneven size.
+    double batchObjective = 0.0;
+    arma::mat batchGradient(arma::size(parameters), arma::fill::zeros);
+    arma::mat g;
+    for (size_t begin = 0; begin < points; begin += 300)
+    {
+      const size_t batchSize = std::min((size_t) 300, points - begin);
+      batchObjective += srf.Evaluate(parameters, begin, batchSize);
+      srf.Gradient(parameters, begin, g, batchSize);
+      batchGradient += g;
+    }
+
+    BOOST_REQUIRE_CLOSE(batchObjective, objective, 1e-5);
+    for (size_t i = 0; i < gradient.n_elem; ++i)
+      BOOST_REQUIRE_CLOSE(batchGradient[i], gradient[i], 1e-5);
+
+    // Use shards as small as possible so that every available thread is used.
+    ParallelFunction<SoftmaxRegressionFunction> pf(srf, 1);
+    BOOST_REQUIRE_CLOSE(pf.Evaluate(parameters), objective, 1e-5);
+    arma::mat parallelGradient;
+    pf.Gradient(parameters, parallelGradient);
+    for (size_t i = 0; i < gradient.n_elem; ++i)
+      BOOST_REQUIRE_CLOSE(parallelGradient[i], gradient[i], 1e-5);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(SoftmaxRegressionTwoClasses)
 {
   const size_t points = 1000;
@@ -669,4 +729,40 @@ BOOST_AUTO_TEST_CASE(SoftmaxRegressionComputeProbabilitiesAndLabelsTest)
   }
 }
 
+/**
+ * Make sure that training on a sparse matrix gives the same model as training
+ * on the same data in a dense matrix.
+ */
+BOOST_AUTO_TEST_CASE(SoftmaxRegressionSparseTest)
+{
+  arma::sp_mat sparseData;
+  sparseData.sprandu(50, 300, 0.1);
+  const arma::mat denseData(sparseData);
+
+  arma::Row<size_t> labels(300);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    labels[i] = (arma::accu(denseData.col(i).subvec(0, 24)) >
+        arma::accu(denseData.col(i).subvec(25, 49))) ? 1 : 0;
+
+  SoftmaxRegression denseSr(denseData, labels, 2, 0.001);
+  SoftmaxRegression sparseSr(sparseData, labels, 2, 0.001);
+
+  BOOST_REQUIRE_EQUAL(sparseSr.Parameters().n_elem,
+      denseSr.Parameters().n_elem);
+  for (size_t i = 0; i < denseSr.Parameters().n_elem; ++i)
+  {
+    if (std::abs(denseSr.Parameters()[i]) < 1e-4)
+      BOOST_REQUIRE_SMALL(sparseSr.Parameters()[i], 1e-4);
+    else
+      BOOST_REQUIRE_CLOSE(sparseSr.Parameters()[i], denseSr.Parameters()[i],
+          1e-3);
+  }
+
+  arma::Row<size_t> denseResults, sparseResults;
+  denseSr.Classify(denseData, denseResults);
+  sparseSr.Classify(sparseData, sparseResults);
+  for (size_t i = 0; i < denseResults.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(sparseResults[i], denseResults[i]);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -138,6 +138,46 @@ BOOST_AUTO_TEST_CASE(SparseCodingTestDictionaryStep)
   BOOST_REQUIRE_SMALL(normGradient, tol);
 }
 
+/**
+ * The LARS workspace is reused between points when encoding, so make sure that
+ * encoding many points at once gives the same codes as encoding each point on
+ * its own.
+ */
+BOOST_AUTO_TEST_CASE(SparseCodingTestEncodePointsIndependently)
+{
+  double lambda1 = 0.1;
+  uword nAtoms = 25;
+
+  mat X;
+  X.load("mnist_first250_training_4s_and_9s.arm");
+  uword nPoints = X.n_cols;
+
+  // Normalize each point since these are images.
+  for (uword i = 0; i < nPoints; ++i)
+    X.col(i) /= norm(X.col(i), 2);
+
+  SparseCoding sc(nAtoms, lambda1);
+  DataDependentRandomInitializer::Initialize(X, 25, sc.Dictionary());
+
+  mat Z;
+  sc.Encode(X, Z);
+
+  BOOST_REQUIRE_EQUAL(Z.n_rows, nAtoms);
+  BOOST_REQUIRE_EQUAL(Z.n_cols, nPoints);
+  for (uword i = 0; i < nPoints; i += 25)
+  {
+    mat pointZ;
+    sc.Encode(X.col(i), pointZ);
+    for (uword j = 0; j < nAtoms; ++j)
+    {
+      if (std::abs(pointZ(j)) < 1e-10)
+        BOOST_REQUIRE_SMALL(Z(j, i), 1e-10);
+      else
+        BOOST_REQUIRE_CLOSE(Z(j, i), pointZ(j), 1e-5);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_CASE(SerializationTest)
 {
   mat X = randu<mat>(100, 100);
@@ -90,4 +90,102 @@ BOOST_AUTO_TEST_CASE(TwiceStartTimerTest)
   BOOST_REQUIRE_THROW(Timer::Start("test_timer"), std::runtime_error);
 }
 
+/**
+ * Make sure that named timers can be started and stopped from many threads at
+ * once.
+ */
+BOOST_AUTO_TEST_CASE(ParallelNamedTimerTest)
+{
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < 100; ++i)
+  {
+    Timer::Start("parallel_test_timer");
+    Timer::Stop("parallel_test_timer");
+  }
+
+  BOOST_REQUIRE_GE(Timer::Get("parallel_test_timer").count(), 0);
+  BOOST_REQUIRE_THROW(Timer::Stop("parallel_test_timer"), std::runtime_error);
+}
+
+/**
+ * Check that scoped timers record time, and that nested scoped timers are
+ * exported as children.
+ */
+BOOST_AUTO_TEST_CASE(ScopedTimerTest)
+{
+  const size_t outerID = Timer::GetID("scoped_test_outer");
+  const size_t innerID = Timer::GetID("scoped_test_inner");
+  BOOST_REQUIRE_NE(outerID, innerID);
+  BOOST_REQUIRE_EQUAL(Timer::GetID("scoped_test_outer"), outerID);
+
+  {
+    ScopedTimer outer(outerID);
+
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < 4; ++i)
+    {
+      ScopedTimer inner(innerID);
+    }
+
+    {
+      ScopedTimer inner(innerID);
+      #ifdef _WIN32
+      Sleep(10);
+      #else
+      usleep(10000);
+      #endif
+    }
+  }
+
+  BOOST_REQUIRE_GE(Timer::GetScoped(outerID).count(), 10000000);
+  BOOST_REQUIRE_GE(Timer::GetScoped(innerID).count(), 10000000);
+
+  std::ostringstream oss;
+  Timer::ExportJSON(oss);
+  const std::string json = oss.str();
+
+  // The inner timer should be nested under the outer timer.
+  const size_t outerPos = json.find("\"scoped_test_outer\"");
+  const size_t innerPos = json.find("\"scoped_test_inner\"");
+  BOOST_REQUIRE_NE(outerPos, std::string::npos);
+  BOOST_REQUIRE_NE(innerPos, std::string::npos);
+  BOOST_REQUIRE_GT(innerPos, outerPos);
+  BOOST_REQUIRE_NE(json.find("\"children\"", outerPos), std::string::npos);
+}
+
+/**
+ * Make sure that timers can be exported while other threads start and stop
+ * named timers, and that timer names are escaped in the JSON output.
+ */
+BOOST_AUTO_TEST_CASE(ParallelExportJSONTest)
+{
+  Timer::Start("export \"quoted\" timer");
+  Timer::Stop("export \"quoted\" timer");
+
+  std::vector<std::string> outputs(100);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < 100; ++i)
+  {
+    std::ostringstream name;
+    name << "export_test_timer_" << (i % 10);
+    if (i % 2 == 0)
+    {
+      std::ostringstream oss;
+      Timer::ExportJSON(oss);
+      outputs[i] = oss.str();
+    }
+    else
+    {
+      Timer::Start(name.str());
+      Timer::Stop(name.str());
+    }
+  }
+
+  for (size_t i = 0; i < 100; i += 2)
+  {
+    BOOST_REQUIRE_NE(outputs[i].find("\"export \\\"quoted\\\" timer\""),
+        std::string::npos);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();